@@ -284,6 +284,18 @@ typedef struct LCEVC_HDRStaticInfo
 
 } LCEVC_HDRStaticInfo;
 
+/*!
+ * Flags for the ways that decoding of a picture was reduced so that it could meet its deadline.
+ * Reported in LCEVC_DecodeInformation when the `deadline_policy` option is enabled.
+ */
+typedef enum LCEVC_Degradation
+{
+    LCEVC_Degradation_None              = 0,
+    LCEVC_Degradation_SkipLOQ0          = 1,  /**< Full resolution (LOQ0) residuals were not applied */
+    LCEVC_Degradation_SkipTemporal      = 2,  /**< The temporal buffer was not used - temporal prediction resumes at the next refresh */
+    LCEVC_Degradation_ScaledPassthrough = 4,  /**< No residuals were applied - the base was only upscaled */
+} LCEVC_Degradation;
+
 /*!
  * This structure captures properties related to the decoding process at a particular timestamp.
  */
@@ -298,10 +310,41 @@ typedef struct LCEVC_DecodeInformation
     uint32_t  baseWidth;          /**< Width of base picture */
     uint32_t  baseHeight;         /**< Height of base picture */
     uint8_t   baseBitdepth;       /**< Bitdepth of base picture */
+    uint8_t   degradation;        /**< Combination of LCEVC_Degradation flags applied to this picture */
 
     void*     baseUserData;       /**< User data associated with picture via LCEVC_SendDecoderBase or LCEVC_SetPictureUserData */
 } LCEVC_DecodeInformation;
 
+/*!
+ * The categories that a decoder's memory use is accounted to.
+ */
+typedef enum LCEVC_MemoryCategory
+{
+    LCEVC_Memory_Frames       = 0,  /**< Picture buffers, frame state and enhancement data */
+    LCEVC_Memory_Temporal     = 1,  /**< Temporal residual buffers */
+    LCEVC_Memory_Intermediate = 2,  /**< Intermediate planes between upscale and residual stages */
+    LCEVC_Memory_CmdBuffers   = 3,  /**< Decoded residual command buffers */
+    LCEVC_Memory_Tasks        = 4,  /**< Task pool and task graphs */
+    LCEVC_Memory_Other        = 5,  /**< Everything else held by the decoder */
+
+    LCEVC_Memory_Count,
+
+    LCEVC_Memory_ForceInt32 = 0x7fffffff,
+} LCEVC_MemoryCategory;
+
+/*!
+ * A snapshot of the memory held by a decoder, as returned by LCEVC_GetDecoderMemoryUsage.
+ */
+typedef struct LCEVC_MemoryUsage
+{
+    uint64_t  current[LCEVC_Memory_Count];  /**< Bytes currently held, by LCEVC_MemoryCategory */
+    uint64_t  peak[LCEVC_Memory_Count];     /**< Most bytes ever held at once, by LCEVC_MemoryCategory */
+    uint64_t  total;                        /**< Bytes currently held across all categories */
+    uint64_t  totalPeak;                    /**< Most bytes ever held at once across all categories */
+    uint64_t  budget;                       /**< Configured memory budget in bytes, or 0 for none */
+    bool      degraded;                     /**< The decoder is over budget, and is reducing latency and enhancement to recover */
+} LCEVC_MemoryUsage;
+
 /*!
  * The color formats that can be used in a picture.
  *
@@ -331,6 +374,10 @@ typedef enum LCEVC_ColorFormat
 
     LCEVC_NV12_8                = 2001, /**< 8 bit 4:2:0 YUV SemiPlanar color format: Y plane and UV interleaved plane */
     LCEVC_NV21_8                = 2002, /**< 8 bit 4:2:0 YUV SemiPlanar color format: Y plane and VU interleaved plane */
+    LCEVC_NV16_8                = 2003, /**< 8 bit 4:2:2 YUV SemiPlanar color format: Y plane and UV interleaved plane */
+    LCEVC_P010_LE               = 2004, /**< 10 bit Little Endian 4:2:0 YUV SemiPlanar color format: as NV12, with samples in the high bits of 16 bit words */
+    LCEVC_P016_LE               = 2005, /**< 16 bit Little Endian 4:2:0 YUV SemiPlanar color format: as NV12, with 16 bit samples */
+    LCEVC_P210_LE               = 2006, /**< 10 bit Little Endian 4:2:2 YUV SemiPlanar color format: as NV16, with samples in the high bits of 16 bit words */
 
     LCEVC_RGB_8                 = 3001, /**< 8 bit Interleaved R, G, B planes 24 bit per sample */
     LCEVC_BGR_8                 = 3002, /**< 8 bit Interleaved R, G, B planes 24 bit per sample */
@@ -913,6 +960,26 @@ LCEVC_ReturnCode LCEVC_SynchronizeDecoder( LCEVC_DecoderHandle decHandle,
 LCEVC_API
 LCEVC_ReturnCode LCEVC_FlushDecoder( LCEVC_DecoderHandle decHandle );
 
+/*!
+ * Get the memory currently held by a decoder, broken down by category.
+ *
+ * When a budget is configured with "memory_budget_mb", allocations are never refused for going
+ * over it. Instead, the decoder accepts fewer frames in flight and upscales frames without
+ * residuals until usage drops back under the budget.
+ *
+ * @param[in]    decHandle           LCEVC Decoder instance
+ * @param[out]   memoryUsage         Pointer to memory usage structure that the LCEVC Decoder will
+ *                                   fill
+ * Memory is only accounted when "memory_budget_mb" or "memory_usage" is configured.
+ *
+ * @return                           LCEVC_InvalidParam for an invalid decHandle or memoryUsage;
+ *                                   LCEVC_NotSupported if the decoder does not account for its
+ *                                   memory. Otherwise returns LCEVC_Success.
+ */
+LCEVC_API
+LCEVC_ReturnCode LCEVC_GetDecoderMemoryUsage( LCEVC_DecoderHandle decHandle,
+                                              LCEVC_MemoryUsage* memoryUsage );
+
 /*!
  * Events generated by Decoder
  *
@@ -973,6 +1040,49 @@ LCEVC_ReturnCode LCEVC_SetDecoderEventCallback( LCEVC_DecoderHandle decHandle,
                                                 LCEVC_EventCallback callback,
                                                 void* userData );
 
+/*!
+ * A user provided function that the decoder calls with each completed output picture, instead of
+ * the picture being returned by LCEVC_ReceiveDecoderPicture.
+ *
+ * Pictures are completed in timestamp order, exactly as LCEVC_ReceiveDecoderPicture would have
+ * returned them. The callback is made directly from the decoder thread that finished the picture,
+ * and later pictures wait for it to return, so:
+ * - It must not block, or do significant work - hand the picture on (e.g. to a queue) and return.
+ * - It must not call any LCEVC_ function for the same decoder instance.
+ *
+ * Ownership of the picture passes to the client, as for LCEVC_ReceiveDecoderPicture.
+ *
+ * @param[in]    decHandle           LCEVC Decoder instance
+ * @param[in]    picHandle           The completed output picture
+ * @param[in]    decodeInformation   Decode information for the picture - only valid for the
+ *                                   duration of the callback
+ * @param[in]    userData            A user pointer that was passed in to
+ *                                   SetDecoderCompletionCallback
+ */
+typedef void (*LCEVC_CompletionCallback)( LCEVC_DecoderHandle decHandle,
+                                          LCEVC_PictureHandle picHandle,
+                                          const LCEVC_DecodeInformation* decodeInformation,
+                                          void* userData );
+
+/*!
+ * Set a completion callback in a decoder instance. Must be called before LCEVC_InitializeDecoder.
+ *
+ * When set, LCEVC_ReceiveDecoderPicture will return LCEVC_Again from pipelines that support
+ * completion callbacks (currently the CPU pipeline); other pipelines ignore the callback and
+ * continue to return pictures from LCEVC_ReceiveDecoderPicture.
+ *
+ * @param[in]    decHandle           LCEVC Decoder instance
+ * @param[in]    callback            An LCEVC_CompletionCallback which will be called with each
+ *                                   completed output picture, or NULL for none.
+ * @param[in]    userData            A pointer to any associated data
+ * @return                           LCEVC_Success unless the decoder can't be locked or has
+ *                                   already been initialized
+ */
+LCEVC_API
+LCEVC_ReturnCode LCEVC_SetDecoderCompletionCallback( LCEVC_DecoderHandle decHandle,
+                                                     LCEVC_CompletionCallback callback,
+                                                     void* userData );
+
 
 #ifdef __cplusplus
 }
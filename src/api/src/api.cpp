@@ -30,6 +30,7 @@
 //
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -37,6 +38,12 @@
 using namespace lcevc_dec::decoder;
 using namespace lcevc_dec;
 
+namespace {
+// Diagnostics are shared by every decoder in the process, so are only released with the last one
+std::mutex diagnosticsMutex; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+uint32_t diagnosticsUsers = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+} // namespace
+
 // - API Functions --------------------------------------------------------------------------------
 
 // Decoder lifetime
@@ -48,7 +55,11 @@ LCEVC_API LCEVC_ReturnCode LCEVC_CreateDecoder(LCEVC_DecoderHandle* decHandle,
         return LCEVC_InvalidParam;
     }
 
-    ldcDiagnosticsInitialize(NULL);
+    {
+        std::scoped_lock lock(diagnosticsMutex);
+        ldcDiagnosticsInitialize(NULL);
+        diagnosticsUsers++;
+    }
     ldcAccelerationInitialize(true);
 
     // Make the new decoder context
@@ -82,7 +93,10 @@ LCEVC_API void LCEVC_DestroyDecoder(LCEVC_DecoderHandle decHandle)
     // Nobody should be able to get a pointer to this decoder from here on - destroy at our leisure
     ptr.reset();
 
-    ldcDiagnosticsRelease();
+    std::scoped_lock lock(diagnosticsMutex);
+    if (--diagnosticsUsers == 0) {
+        ldcDiagnosticsRelease();
+    }
 }
 
 // Picture
@@ -537,6 +551,10 @@ LCEVC_API LCEVC_ReturnCode LCEVC_SendDecoderPicture(LCEVC_DecoderHandle decHandl
 
     return withLockedDecoder(decHandle.hdl, [&output](DecoderContext* context) {
         LdpPicture* outputPicture = context->picturePool().lookup(output.hdl);
+        if (context->eventDispatcher()->isCompletionEnabled()) {
+            // Before sending, as the picture may be completed before sendOutputPicture() returns
+            context->eventDispatcher()->outputPictureSent(outputPicture, output.hdl);
+        }
         return fromLdcReturnCode(context->pipeline()->sendOutputPicture(outputPicture));
     });
 }
@@ -598,6 +616,19 @@ LCEVC_API LCEVC_ReturnCode LCEVC_FlushDecoder(LCEVC_DecoderHandle decHandle)
     });
 }
 
+LCEVC_API LCEVC_ReturnCode LCEVC_GetDecoderMemoryUsage(LCEVC_DecoderHandle decHandle,
+                                                       LCEVC_MemoryUsage* memoryUsage)
+{
+    if (memoryUsage == nullptr) {
+        return LCEVC_InvalidParam;
+    }
+
+    return withLockedDecoder(decHandle.hdl, [&memoryUsage](DecoderContext* context) {
+        return fromLdcReturnCode(
+            context->pipeline()->getMemoryUsage(*toLdpMemoryUsagePtr(memoryUsage)));
+    });
+}
+
 // Events
 //
 LCEVC_API
@@ -609,3 +640,13 @@ LCEVC_ReturnCode LCEVC_SetDecoderEventCallback(LCEVC_DecoderHandle decHandle,
         return LCEVC_Success;
     });
 }
+
+LCEVC_ReturnCode LCEVC_SetDecoderCompletionCallback(LCEVC_DecoderHandle decHandle,
+                                                    LCEVC_CompletionCallback callback,
+                                                    void* userData)
+{
+    return withLockedUninitializedDecoder(decHandle.hdl, [&callback, &userData](DecoderContext* context) {
+        context->eventDispatcher()->setCompletionCallback(callback, userData);
+        return LCEVC_Success;
+    });
+}
@@ -19,6 +19,8 @@
 #include <LCEVC/common/configure.hpp>
 #include <LCEVC/common/diagnostics.h>
 #include <LCEVC/common/log.h>
+#include <LCEVC/common/task_pool.h>
+#include <LCEVC/common/threads.h>
 
 #if VN_SDK_STATIC
 #if VN_SDK_PIPELINE(CPU)
@@ -52,6 +54,42 @@ namespace lcevc_dec::decoder {
 namespace {
     Pool<DecoderContext> decoderPool(16); // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
     std::mutex decoderPoolMutex; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    constexpr uint32_t kSharedTaskPoolReservedTasks = 64;
+
+    // The task pool shared by all decoders that set "shared_task_pool", whatever their pipeline.
+    // Created on first use, and destroyed along with the last decoder using it.
+    //
+    // The pool outlives any one decoder, so it is sized by the core count rather than any decoder's
+    // "threads", and allocates from the heap rather than a decoder's tracked task allocators - its
+    // tasks are not counted against a decoder's memory usage or budget.
+    std::shared_ptr<LdcTaskPool> sharedTaskPool()
+    {
+        static std::mutex sharedMutex;
+        static std::weak_ptr<LdcTaskPool> sharedPool;
+
+        const std::scoped_lock lock(sharedMutex);
+        std::shared_ptr<LdcTaskPool> pool = sharedPool.lock();
+        if (pool) {
+            return pool;
+        }
+
+        // A pool thread per core, as for a CPU pipeline with the default number of threads
+        auto taskPool = std::make_unique<LdcTaskPool>();
+        LdcMemoryAllocator* const allocator = ldcMemoryAllocatorMalloc();
+        if (!ldcTaskPoolInitialize(taskPool.get(), allocator, allocator,
+                                   static_cast<uint32_t>(threadNumCores()),
+                                   kSharedTaskPoolReservedTasks)) {
+            VNLogError("Failed to initialize shared task pool");
+            return nullptr;
+        }
+        pool = std::shared_ptr<LdcTaskPool>(taskPool.release(), [](LdcTaskPool* taskPool) {
+            ldcTaskPoolDestroy(taskPool);
+            delete taskPool; // NOLINT(cppcoreguidelines-owning-memory)
+        });
+        sharedPool = pool;
+        return pool;
+    }
 } // namespace
 
 // Locked add to decoder pool - take ownership of the pointer.
@@ -186,6 +224,15 @@ bool DecoderContext::initialize()
 
     assert(!m_pipeline);
 
+    if (m_useSharedTaskPool) {
+        m_sharedTaskPool = sharedTaskPool();
+        if (m_sharedTaskPool && !builder->setTaskPool(m_sharedTaskPool.get())) {
+            VNLogWarningF("Pipeline %s cannot share a task pool: shared_task_pool is ignored.",
+                          m_pipelineName.c_str());
+            m_sharedTaskPool.reset();
+        }
+    }
+
     m_pipeline = builder->finish(m_eventDispatcher.get());
     if (!m_pipeline) {
         return false;
@@ -200,7 +247,7 @@ bool DecoderContext::initialize()
 // General pattern is:
 //
 // 1) Try common (global) config
-// 2) Try Context specific config (pipeline and events)
+// 2) Try Context specific config (pipeline, events and event thread)
 // 3) Try pipeline builder config
 //
 bool DecoderContext::configure(std::string_view name, const std::string& val)
@@ -238,7 +285,23 @@ bool DecoderContext::configure(std::string_view name, const std::vector<int32_t>
 
 bool DecoderContext::configure(std::string_view name, bool val)
 {
-    return m_commonConfiguration->configure(name, val) || pipelineBuilder()->configure(name, val);
+    if (m_commonConfiguration->configure(name, val)) {
+        return true;
+    }
+
+    if (name == "shared_event_thread") {
+        if (!m_eventDispatcher->useSharedThread(val)) {
+            VNLogWarning("Events already generated: shared_event_thread is ignored.");
+        }
+        return true;
+    }
+
+    if (name == "shared_task_pool") {
+        m_useSharedTaskPool = val;
+        return true;
+    }
+
+    return pipelineBuilder()->configure(name, val);
 }
 
 bool DecoderContext::configure(std::string_view name, int32_t val)
@@ -124,6 +124,10 @@ private:
     // Event management
     std::unique_ptr<EventDispatcher> m_eventDispatcher;
 
+    // The task pool shared with other decoders, if enabled - must outlive the pipeline
+    bool m_useSharedTaskPool = false;
+    std::shared_ptr<LdcTaskPool> m_sharedTaskPool;
+
     // The underlying pipeline
     std::unique_ptr<pipeline::PipelineBuilder> m_pipelineBuilder;
     std::unique_ptr<pipeline::Pipeline> m_pipeline;
@@ -24,11 +24,14 @@
 #include "interface.h"
 #include "pool.h"
 //
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <vector>
 
@@ -43,6 +46,152 @@ static constexpr uint8_t kFlushEvent = LCEVC_EventCount + 2;
 bool Event::isValid() const { return (eventType > 0) && (eventType < LCEVC_EventCount); }
 bool Event::isFlush() const { return eventType == kFlushEvent; }
 
+// Events that can be queued per dispatcher before falling back to a locked overflow queue - must
+// be a power of 2.
+static constexpr uint32_t kEventRingCapacity = 256;
+
+// Events delivered for one dispatcher before moving on to the next one sharing its thread
+static constexpr uint32_t kEventBatchSize = 64;
+
+// A can-send event says that the next send will not return LCEVC_Again. One that is queued and not
+// yet delivered says all that another would, so these are coalesced.
+static bool isCoalesced(uint8_t eventType)
+{
+    return eventType == LCEVC_CanSendBase || eventType == LCEVC_CanSendEnhancement ||
+           eventType == LCEVC_CanSendPicture;
+}
+
+// - EventRing ------------------------------------------------------------------------------------
+
+// A fixed capacity queue of events, that any number of threads push to without locking, and a
+// single thread pops from. Each slot has a sequence number, which says whether the slot is free for
+// the push at a given position, or holds the event for the pop at that position.
+//
+class EventRing
+{
+public:
+    explicit EventRing(uint32_t capacity)
+        : m_slots(new Slot[capacity])
+        , m_mask(capacity - 1)
+    {
+        assert((capacity & m_mask) == 0);
+        for (uint32_t idx = 0; idx < capacity; ++idx) {
+            m_slots[idx].sequence.store(idx, std::memory_order_relaxed);
+        }
+    }
+
+    // Returns false if the ring is full
+    bool tryPush(const Event& event)
+    {
+        uint32_t position = m_pushPosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = m_slots[position & m_mask];
+            const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<int32_t>(sequence - position);
+            if (difference == 0) {
+                if (m_pushPosition.compare_exchange_weak(position, position + 1,
+                                                         std::memory_order_relaxed)) {
+                    slot.event = event;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only. Returns false if the ring is empty, or the next push is not complete.
+    bool tryPop(Event& event)
+    {
+        Slot& slot = m_slots[m_popPosition & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_popPosition + 1) {
+            return false;
+        }
+        event = slot.event;
+        slot.sequence.store(m_popPosition + m_mask + 1, std::memory_order_release);
+        m_popPosition++;
+        return true;
+    }
+
+    // Consumer thread only
+    bool isEmpty() const
+    {
+        const Slot& slot = m_slots[m_popPosition & m_mask];
+        return slot.sequence.load(std::memory_order_acquire) != m_popPosition + 1;
+    }
+
+    // Consumer thread only. True if any slot has been claimed by a push and not yet popped,
+    // including slots that a push is still writing.
+    bool isClaimed() const
+    {
+        return m_pushPosition.load(std::memory_order_acquire) != m_popPosition;
+    }
+
+    VNNoCopyNoMove(EventRing);
+
+private:
+    struct Slot
+    {
+        std::atomic<uint32_t> sequence{0};
+        Event event{kInvalidEvent};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    const uint32_t m_mask;
+    std::atomic<uint32_t> m_pushPosition{0};
+    uint32_t m_popPosition = 0;
+};
+
+// - EventThread ----------------------------------------------------------------------------------
+
+class EventDispatcherImpl;
+
+// A thread that delivers the events of one or more dispatchers. It sleeps when all of them are
+// empty, and a dispatcher only takes the lock to wake it when it is asleep.
+//
+class EventThread
+{
+public:
+    EventThread();
+    ~EventThread();
+
+    // The thread shared by all dispatchers that use one, created on first use
+    static std::shared_ptr<EventThread> shared();
+
+    void add(EventDispatcherImpl* dispatcher);
+
+    // Deliver any events still queued for the dispatcher, then stop serving it
+    void remove(EventDispatcherImpl* dispatcher);
+
+    // Call after queuing an event
+    void wake();
+
+    VNNoCopyNoMove(EventThread);
+
+private:
+    void loop();
+    void sleep();
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCv;
+    std::condition_variable m_removedCv;
+
+    // Protected by m_mutex
+    std::vector<EventDispatcherImpl*> m_dispatchers;
+    std::vector<EventDispatcherImpl*> m_removing;
+    bool m_wakeRequested = false;
+    bool m_stop = false;
+
+    // The dispatchers being served by the current pass of the loop (event thread only)
+    std::vector<EventDispatcherImpl*> m_passDispatchers;
+
+    std::atomic<bool> m_sleeping{false};
+    std::thread m_thread;
+};
+
 // - EventDispatcher ---------------------------------------------------------------------------------
 
 EventDispatcher::~EventDispatcher() = default;
@@ -61,12 +210,27 @@ public:
 
     void setEventCallback(LCEVC_EventCallback callback, void* userData) override;
 
+    bool isCompletionEnabled() const final { return m_completionCallback != nullptr; }
+    void completePicture(struct LdpPicture* picture,
+                         const LdpDecodeInformation* decodeInfo) override;
+
+    void setCompletionCallback(LCEVC_CompletionCallback callback, void* userData) override;
+    void outputPictureSent(const LdpPicture* picture, Handle<LdpPicture> handle) override;
+
+    bool useSharedThread(bool shared) override;
+
+    // Event thread only - deliver up to maxEvents queued events, returning the number delivered
+    uint32_t deliverEvents(uint32_t maxEvents);
+    bool hasEvents() const;
+
     VNNoCopyNoMove(EventDispatcherImpl);
 
 private:
     void release() noexcept;
-    void eventLoop();
-    bool getNextEvent(Event& event);
+    void attachThread();
+    void push(const Event& event);
+    bool pop(Event& event);
+    void deliver(const Event& event);
 
     DecoderContext* m_context = nullptr;
 
@@ -74,19 +238,35 @@ private:
     LCEVC_EventCallback m_eventCallback = nullptr;
     void* m_eventCallbackUserData = nullptr;
 
-    // Threading. The event queue is protected by m_eventQueueMutex, and when it changes, it
-    // notifies m_eventQueueCv.
-    std::queue<Event> m_eventQueue;
-    std::mutex m_eventQueueMutex;
-    std::condition_variable m_eventQueueCv;
-    std::thread m_eventThread;
-    bool m_threadExists = false;
+    // Queued events. Any thread pushes to the ring without locking, and the event thread pops from
+    // it. If the ring fills up, events go to m_overflow until the event thread has emptied that,
+    // so that no event is lost and the events from any one thread stay in order.
+    EventRing m_ring{kEventRingCapacity};
+    std::deque<Event> m_overflow;
+    std::mutex m_overflowMutex;
+    std::atomic<bool> m_overflowing{false};
+
+    // Coalesced event types that have been queued and not yet delivered
+    std::array<std::atomic<bool>, LCEVC_EventCount> m_coalescedQueued{};
+
+    // The thread that delivers events - attached when the first event is generated
+    bool m_useSharedThread = false;
+    std::once_flag m_threadOnce;
+    std::atomic<bool> m_threadAttached{false};
+    std::shared_ptr<EventThread> m_thread;
+
+    // Completion callback (set once before initialize and never changed)
+    LCEVC_CompletionCallback m_completionCallback = nullptr;
+    void* m_completionCallbackUserData = nullptr;
+
+    // Handles of output pictures that have been sent to the pipeline. This has its own mutex, as
+    // pictures are completed on worker threads, which cannot take the decoder lock.
+    std::vector<std::pair<const LdpPicture*, Handle<LdpPicture>>> m_sentPictures;
+    std::mutex m_sentPicturesMutex;
 };
 
 EventDispatcherImpl::EventDispatcherImpl(DecoderContext* context)
     : m_context{context}
-    , m_eventThread{std::thread(&EventDispatcherImpl::eventLoop, this)}
-    , m_threadExists{true}
 {
     assert(8 * sizeof(m_eventMask) >=
            std::max(static_cast<uint8_t>(LCEVC_EventCount), std::max(kInvalidEvent, kFlushEvent)));
@@ -101,39 +281,120 @@ void EventDispatcherImpl::enableEvents(const std::vector<int32_t>& enabledEvents
     }
 }
 
+bool EventDispatcherImpl::useSharedThread(bool shared)
+{
+    if (m_threadAttached.load(std::memory_order_acquire)) {
+        return false;
+    }
+    m_useSharedThread = shared;
+    return true;
+}
+
+void EventDispatcherImpl::attachThread()
+{
+    m_thread = m_useSharedThread ? EventThread::shared() : std::make_shared<EventThread>();
+    m_thread->add(this);
+    m_threadAttached.store(true, std::memory_order_release);
+}
+
 void EventDispatcherImpl::release() noexcept
 {
-    // Prevent double-release
-    if (!m_threadExists) {
+    // Prevent double-release, and nothing to do if no event was ever generated
+    if (!m_thread) {
         return;
     }
 
-    // Send ourselves a flushing event, to force any prior events out of the queue and break out
-    // of our loop.
-    //
-    // NB: Explicit qualification of method as this will be called during a destructor.
-    EventDispatcherImpl::generate(kFlushEvent, nullptr, nullptr, nullptr, 0);
-
-    m_eventThread.join();
-    m_eventThread = std::thread();
-    m_threadExists = false;
+    // Deliver any events that are still queued, then leave the thread, which stops if this was the
+    // last dispatcher using it.
+    m_thread->remove(this);
+    m_thread.reset();
 }
 
 void EventDispatcherImpl::generate(uint8_t eventType, struct LdpPicture* picture,
                                    const LdpDecodeInformation* decodeInfo, const uint8_t* data,
                                    uint32_t dataSize)
 {
-    Event event(eventType, picture, decodeInfo, data, dataSize);
+    if (!isEventEnabled(eventType)) {
+        return;
+    }
+
+    if (isCoalesced(eventType) && !picture && !data &&
+        m_coalescedQueued[eventType].exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
 
-    const std::scoped_lock lock(m_eventQueueMutex);
+    std::call_once(m_threadOnce, [this]() { attachThread(); });
 
-    if (isEventEnabled(event.eventType) || event.isFlush()) {
-        // This may throw an exception if m_eventQueue.size() > SIZE_MAX, needs to be caught when
-        // this function is used in a class destructor.
-        m_eventQueue.push(event);
+    push(Event(eventType, picture, decodeInfo, data, dataSize));
+    m_thread->wake();
+}
 
-        m_eventQueueCv.notify_all();
+void EventDispatcherImpl::push(const Event& event)
+{
+    if (!m_overflowing.load(std::memory_order_acquire) && m_ring.tryPush(event)) {
+        return;
     }
+
+    // The ring is full, or was recently - check again under the lock, as the event thread may
+    // have emptied the overflow in the meantime.
+    const std::scoped_lock lock(m_overflowMutex);
+    if (!m_overflowing.load(std::memory_order_relaxed) && m_ring.tryPush(event)) {
+        return;
+    }
+    m_overflowing.store(true, std::memory_order_release);
+    m_overflow.push_back(event);
+}
+
+bool EventDispatcherImpl::pop(Event& event)
+{
+    if (m_ring.tryPop(event)) {
+        return true;
+    }
+    if (!m_overflowing.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    // Any event in the ring was pushed before those in the overflow, so empty the ring first -
+    // including any slot that a push has claimed but not yet written.
+    while (m_ring.isClaimed()) {
+        if (m_ring.tryPop(event)) {
+            return true;
+        }
+        std::this_thread::yield();
+    }
+
+    const std::scoped_lock lock(m_overflowMutex);
+    if (m_overflow.empty()) {
+        m_overflowing.store(false, std::memory_order_release);
+        return m_ring.tryPop(event);
+    }
+    event = m_overflow.front();
+    m_overflow.pop_front();
+    if (m_overflow.empty()) {
+        m_overflowing.store(false, std::memory_order_release);
+    }
+    return true;
+}
+
+bool EventDispatcherImpl::hasEvents() const
+{
+    return !m_ring.isEmpty() || m_overflowing.load(std::memory_order_acquire);
+}
+
+uint32_t EventDispatcherImpl::deliverEvents(uint32_t maxEvents)
+{
+    uint32_t count = 0;
+    Event event{kInvalidEvent};
+    while (count < maxEvents && pop(event)) {
+        // Clear before the callback, so that a can-send event generated by the callback, or while
+        // it runs, is queued again.
+        if (isCoalesced(event.eventType)) {
+            m_coalescedQueued[event.eventType].store(false, std::memory_order_release);
+        }
+        deliver(event);
+        count++;
+    }
+    return count;
 }
 
 void EventDispatcherImpl::setEventCallback(LCEVC_EventCallback callback, void* userData)
@@ -142,54 +403,219 @@ void EventDispatcherImpl::setEventCallback(LCEVC_EventCallback callback, void* u
     m_eventCallbackUserData = userData;
 }
 
-void EventDispatcherImpl::eventLoop()
+void EventDispatcherImpl::setCompletionCallback(LCEVC_CompletionCallback callback, void* userData)
 {
-    Event event = kInvalidEvent;
-    while (getNextEvent(event)) {
-        if (!event.isValid()) {
-            // Break loop: if we got an invalid event off the queue, that's the signal to shut
-            // down the thread.
+    m_completionCallback = callback;
+    m_completionCallbackUserData = userData;
+}
+
+void EventDispatcherImpl::outputPictureSent(const LdpPicture* picture, Handle<LdpPicture> handle)
+{
+    const std::scoped_lock lock(m_sentPicturesMutex);
+
+    // A picture that is sent again (or reallocated at the same address) replaces its old entry
+    for (auto& sent : m_sentPictures) {
+        if (sent.first == picture) {
+            sent.second = handle;
             return;
         }
+    }
+    m_sentPictures.emplace_back(picture, handle);
+}
 
-        if (m_eventCallback != nullptr) {
-            const LCEVC_DecoderHandle decoderHandle =
-                m_context ? m_context->handle() : LCEVC_DecoderHandle{kInvalidHandle};
-
-            const LCEVC_DecodeInformation* const decodeInfo =
-                (event.decodeInfo.timestamp != kInvalidTimestamp)
-                    ? fromLdpDecodeInformationPtr(&event.decodeInfo)
-                    : nullptr;
+void EventDispatcherImpl::completePicture(struct LdpPicture* picture,
+                                          const LdpDecodeInformation* decodeInfo)
+{
+    if (m_completionCallback == nullptr) {
+        return;
+    }
 
-            Handle<LdpPicture> pictureHandle{kInvalidHandle};
-            if (event.picture) {
-                m_context->lock();
-                pictureHandle = m_context->picturePool().reverseLookup(event.picture);
-                m_context->unlock();
+    Handle<LdpPicture> pictureHandle{kInvalidHandle};
+    {
+        const std::scoped_lock lock(m_sentPicturesMutex);
+        for (auto it = m_sentPictures.begin(); it != m_sentPictures.end(); ++it) {
+            if (it->first == picture) {
+                pictureHandle = it->second;
+                m_sentPictures.erase(it);
+                break;
             }
+        }
+    }
+
+    // Called directly on the completing thread - no queue or thread hop
+    const LCEVC_DecoderHandle decoderHandle =
+        m_context ? m_context->handle() : LCEVC_DecoderHandle{kInvalidHandle};
+    m_completionCallback(decoderHandle, {pictureHandle.handle},
+                         fromLdpDecodeInformationPtr(decodeInfo), m_completionCallbackUserData);
+}
+
+void EventDispatcherImpl::deliver(const Event& event)
+{
+    if (m_eventCallback == nullptr) {
+        return;
+    }
+
+    const LCEVC_DecoderHandle decoderHandle =
+        m_context ? m_context->handle() : LCEVC_DecoderHandle{kInvalidHandle};
+
+    const LCEVC_DecodeInformation* const decodeInfo =
+        (event.decodeInfo.timestamp != kInvalidTimestamp)
+            ? fromLdpDecodeInformationPtr(&event.decodeInfo)
+            : nullptr;
+
+    Handle<LdpPicture> pictureHandle{kInvalidHandle};
+    if (event.picture) {
+        m_context->lock();
+        pictureHandle = m_context->picturePool().reverseLookup(event.picture);
+        m_context->unlock();
+    }
+
+    m_eventCallback(decoderHandle, static_cast<LCEVC_Event>(event.eventType),
+                    {pictureHandle.handle}, decodeInfo, event.data, event.dataSize,
+                    m_eventCallbackUserData);
+}
+
+// - EventThread ----------------------------------------------------------------------------------
 
-            m_eventCallback(decoderHandle, static_cast<LCEVC_Event>(event.eventType),
-                            {pictureHandle.handle}, decodeInfo, event.data, event.dataSize,
-                            m_eventCallbackUserData);
+EventThread::EventThread()
+    : m_thread{std::thread(&EventThread::loop, this)}
+{}
+
+EventThread::~EventThread()
+{
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeCv.notify_one();
+    m_thread.join();
+}
+
+std::shared_ptr<EventThread> EventThread::shared()
+{
+    static std::mutex sharedMutex;
+    static std::weak_ptr<EventThread> sharedThread;
+
+    const std::scoped_lock lock(sharedMutex);
+    std::shared_ptr<EventThread> thread = sharedThread.lock();
+    if (!thread) {
+        thread = std::make_shared<EventThread>();
+        sharedThread = thread;
+    }
+    return thread;
+}
+
+void EventThread::add(EventDispatcherImpl* dispatcher)
+{
+    // Wake the thread, as the dispatcher is not in its current pass - it could otherwise go to
+    // sleep without seeing an event that is queued before the next pass.
+    {
+        const std::scoped_lock lock(m_mutex);
+        m_dispatchers.push_back(dispatcher);
+        m_wakeRequested = true;
+    }
+    m_wakeCv.notify_one();
+}
+
+void EventThread::remove(EventDispatcherImpl* dispatcher)
+{
+    // Released from a callback on this thread, e.g. one decoder destroying another that shares the
+    // thread - deliver its events here, and make sure that the current pass skips it.
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+        while (dispatcher->deliverEvents(kEventBatchSize) > 0) {
         }
+        std::replace(m_passDispatchers.begin(), m_passDispatchers.end(), dispatcher,
+                     static_cast<EventDispatcherImpl*>(nullptr));
+        const std::scoped_lock lock(m_mutex);
+        m_dispatchers.erase(std::remove(m_dispatchers.begin(), m_dispatchers.end(), dispatcher),
+                            m_dispatchers.end());
+        return;
     }
+
+    std::unique_lock lock(m_mutex);
+    m_removing.push_back(dispatcher);
+    m_wakeRequested = true;
+    m_wakeCv.notify_one();
+    m_removedCv.wait(lock, [this, dispatcher]() {
+        return std::find(m_dispatchers.begin(), m_dispatchers.end(), dispatcher) ==
+               m_dispatchers.end();
+    });
 }
 
-bool EventDispatcherImpl::getNextEvent(Event& event)
+void EventThread::wake()
 {
-    // Lock on our own mutex, to ensure that events are sent strictly in order. This may mean we
-    // trigger a callback while still inside some API call, but that should be fine: if the
-    // callback itself uses the API, then THAT call will wait for the API lock.
-    std::unique_lock lock(m_eventQueueMutex);
+    // Pairs with the fence in sleep(): either this sees that the thread is going to sleep, or the
+    // thread sees the event that was just queued.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed)) {
+        {
+            const std::scoped_lock lock(m_mutex);
+            m_wakeRequested = true;
+        }
+        m_wakeCv.notify_one();
+    }
+}
 
-    // If the event queue is empty, wait here until we're notified. So, wait here until notified
-    // AND m_eventQueue is non-empty (the condition prevents spurious unblocks)
-    m_eventQueueCv.wait(lock, [this]() { return !m_eventQueue.empty(); });
+void EventThread::sleep()
+{
+    m_sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const bool hasEvents =
+        std::any_of(m_passDispatchers.begin(), m_passDispatchers.end(),
+                    [](const EventDispatcherImpl* dispatcher) { return dispatcher->hasEvents(); });
+    if (!hasEvents) {
+        std::unique_lock lock(m_mutex);
+        m_wakeCv.wait(lock, [this]() { return m_wakeRequested || m_stop; });
+        m_wakeRequested = false;
+    }
 
-    event = m_eventQueue.front();
-    m_eventQueue.pop();
+    m_sleeping.store(false, std::memory_order_relaxed);
+}
 
-    return true;
+void EventThread::loop()
+{
+    std::vector<EventDispatcherImpl*> removing;
+
+    for (;;) {
+        {
+            const std::scoped_lock lock(m_mutex);
+            if (m_stop && m_dispatchers.empty()) {
+                return;
+            }
+            m_passDispatchers = m_dispatchers;
+            removing.swap(m_removing);
+        }
+
+        bool delivered = false;
+        for (EventDispatcherImpl* dispatcher : m_passDispatchers) {
+            if (dispatcher && dispatcher->deliverEvents(kEventBatchSize) > 0) {
+                delivered = true;
+            }
+        }
+
+        if (!removing.empty()) {
+            for (EventDispatcherImpl* dispatcher : removing) {
+                while (dispatcher->deliverEvents(kEventBatchSize) > 0) {
+                }
+            }
+            {
+                const std::scoped_lock lock(m_mutex);
+                for (EventDispatcherImpl* dispatcher : removing) {
+                    m_dispatchers.erase(
+                        std::remove(m_dispatchers.begin(), m_dispatchers.end(), dispatcher),
+                        m_dispatchers.end());
+                }
+            }
+            removing.clear();
+            m_removedCv.notify_all();
+            continue;
+        }
+
+        if (!delivered) {
+            sleep();
+        }
+    }
 }
 
 std::unique_ptr<EventDispatcher> createEventDispatcher(DecoderContext* context)
@@ -40,6 +40,17 @@ public:
 
     virtual void setEventCallback(LCEVC_EventCallback callback, void* userData) = 0;
 
+    virtual void setCompletionCallback(LCEVC_CompletionCallback callback, void* userData) = 0;
+
+    // Record the handle of an output picture that is being sent to the pipeline, so that it can
+    // be passed to the completion callback without taking the decoder lock.
+    virtual void outputPictureSent(const LdpPicture* picture, Handle<LdpPicture> handle) = 0;
+
+    // Deliver events from a thread shared with every other dispatcher that uses it, rather than
+    // from a thread of this dispatcher's own. Returns false if events have already been generated,
+    // in which case the thread is not changed.
+    virtual bool useSharedThread(bool shared) = 0;
+
     VNNoCopyNoMove(EventDispatcher);
 
 private:
@@ -30,4 +30,7 @@ static_assert(sizeof(LdpDecodeInformation) == sizeof(LCEVC_DecodeInformation),
 static_assert(sizeof(LdpPictureDesc) == sizeof(LCEVC_PictureDesc),
               "Please keep LdpPictureDesc up to date with LCEVC_PictureDesc.");
 
+static_assert(sizeof(LdpMemoryUsage) == sizeof(LCEVC_MemoryUsage),
+              "Please keep LdpMemoryUsage up to date with LCEVC_MemoryUsage.");
+
 } // namespace lcevc_dec::decoder
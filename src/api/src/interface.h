@@ -88,6 +88,16 @@ static inline const LdpDecodeInformation* toLdpDecodeInformationPtr(const LCEVC_
     return reinterpret_cast<const LdpDecodeInformation*>(ptr); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
 }
 
+static inline const LCEVC_DecodeInformation* fromLdpDecodeInformationPtr(const LdpDecodeInformation* ptr)
+{
+    return reinterpret_cast<const LCEVC_DecodeInformation*>(ptr); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+static inline LdpMemoryUsage* toLdpMemoryUsagePtr(LCEVC_MemoryUsage* ptr)
+{
+    return reinterpret_cast<LdpMemoryUsage*>(ptr); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
 // LCEVC_ enum helpers
 //
 // Not strictly necessary, but makes is clear what is going on.
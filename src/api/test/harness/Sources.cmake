@@ -15,6 +15,8 @@
 list(
     APPEND
     SOURCES
+    "src/benchmark.cpp"
+    "src/benchmark.h"
     "src/hash.cpp"
     "src/hash.h"
     "src/trickplay.cpp"
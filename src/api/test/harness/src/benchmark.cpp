@@ -0,0 +1,453 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Benchmark mode - decode preloaded frames repeatedly, with one or more decoder instances.
+//
+// All input is read into memory before decoding starts, and base pictures are bound directly onto
+// that memory, so the numbers reflect the decoder rather than file I/O or copies. Instances wait
+// for decoder events when they cannot make progress, rather than polling, so the process CPU time
+// that is reported is the decoder's, plus the harness's relatively small cost of driving the API.
+//
+#include "benchmark.h"
+
+#include <fmt/core.h>
+#include <LCEVC/api_utility/chrono.h>
+#include <LCEVC/build_config.h>
+#include <LCEVC/lcevc_dec.h>
+#include <LCEVC/utility/base_decoder.h>
+#include <LCEVC/utility/check.h>
+#include <LCEVC/utility/timestamp.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#if VN_OS(WINDOWS)
+#include <windows.h>
+
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using json = nlohmann::json;
+using namespace lcevc_dec::utility;
+
+namespace {
+
+// A base image and its enhancement data
+struct Frame
+{
+    int64_t pts = 0;
+    std::vector<uint8_t> enhancement;
+    std::vector<uint8_t> image;
+};
+
+struct InstanceResult
+{
+    int status = EXIT_SUCCESS;
+    uint64_t frameCount = 0;
+    double seconds = 0.0;
+    std::vector<double> latencies; /**< Milliseconds from sending enhancement to receiving output */
+};
+
+// Process-wide resource usage
+struct Usage
+{
+    double cpuSeconds = 0.0;
+    uint64_t peakRssKiB = 0;
+};
+
+Usage getUsage()
+{
+    Usage usage;
+#if VN_OS(WINDOWS)
+    FILETIME creation;
+    FILETIME exit;
+    FILETIME kernel;
+    FILETIME user;
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        const auto ticks = [](const FILETIME& ft) {
+            return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+        };
+        usage.cpuSeconds = static_cast<double>(ticks(kernel) + ticks(user)) * 100e-9;
+    }
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        usage.peakRssKiB = counters.PeakWorkingSetSize / 1024;
+    }
+#else
+    struct rusage ru = {};
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        usage.cpuSeconds = static_cast<double>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) +
+                           static_cast<double>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e-6;
+#if VN_OS(APPLE)
+        // Bytes on Apple platforms, KiB elsewhere
+        usage.peakRssKiB = static_cast<uint64_t>(ru.ru_maxrss) / 1024;
+#else
+        usage.peakRssKiB = static_cast<uint64_t>(ru.ru_maxrss);
+#endif
+    }
+#endif
+    return usage;
+}
+
+// Read frames from the base decoder until `count` have both an image and enhancement data, and
+// return them in presentation order.
+std::vector<Frame> preloadFrames(BaseDecoder& baseDecoder, uint32_t count)
+{
+    std::map<int64_t, Frame> frames;
+    uint32_t complete = 0;
+
+    const auto addPart = [&](const BaseDecoder::Data& data, bool image) {
+        Frame& frame = frames[data.pts];
+        std::vector<uint8_t>& part = image ? frame.image : frame.enhancement;
+        const bool wasComplete = !frame.image.empty() && !frame.enhancement.empty();
+
+        frame.pts = data.pts;
+        part.assign(data.ptr, data.ptr + data.size);
+        if (!wasComplete && !frame.image.empty() && !frame.enhancement.empty()) {
+            complete++;
+        }
+    };
+
+    bool running = true;
+    while (running && complete < count) {
+        running = baseDecoder.update();
+
+        // NB: Fetch both parts before clearing either - the linear BIN reader clears them together
+        BaseDecoder::Data data;
+        if (baseDecoder.getEnhancement(data)) {
+            addPart(data, false);
+        }
+        if (baseDecoder.getImage(data)) {
+            addPart(data, true);
+        }
+        baseDecoder.clearEnhancement();
+        baseDecoder.clearImage();
+    }
+
+    std::vector<Frame> result;
+    for (auto& [pts, frame] : frames) {
+        if (result.size() < count && !frame.image.empty() && !frame.enhancement.empty()) {
+            result.push_back(std::move(frame));
+        }
+    }
+
+    return result;
+}
+
+template <typename H>
+inline bool isNull(H handle)
+{
+    return handle.hdl == 0;
+}
+
+// Holds instance threads until all of them have created their decoders
+class StartBarrier
+{
+public:
+    explicit StartBarrier(uint32_t count)
+        : m_remaining(count)
+    {}
+
+    void arriveAndWait()
+    {
+        std::unique_lock lock(m_mutex);
+        if (--m_remaining == 0) {
+            m_condition.notify_all();
+            return;
+        }
+        m_condition.wait(lock, [this] { return m_remaining == 0; });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    uint32_t m_remaining;
+};
+
+// Counts events from one decoder, so that its instance can sleep until something changes
+class EventWaiter
+{
+public:
+    static void callback(LCEVC_DecoderHandle /*decHandle*/, LCEVC_Event /*event*/,
+                         LCEVC_PictureHandle /*picHandle*/,
+                         const LCEVC_DecodeInformation* /*decodeInformation*/,
+                         const uint8_t* /*data*/, uint32_t /*dataSize*/, void* userData)
+    {
+        auto* waiter = static_cast<EventWaiter*>(userData);
+        {
+            std::scoped_lock lock(waiter->m_mutex);
+            waiter->m_count++;
+        }
+        waiter->m_condition.notify_one();
+    }
+
+    uint64_t count()
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_count;
+    }
+
+    // Wait for an event after `count` was read. The timeout only guards against a state change
+    // that the decoder does not signal.
+    void waitAfter(uint64_t count)
+    {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait_for(lock, std::chrono::milliseconds(10),
+                             [this, count] { return m_count != count; });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    uint64_t m_count = 0;
+};
+
+// Decode all preloaded frames `iterations` times with a new decoder instance
+//
+void runInstance(const std::vector<Frame>& frames, const LCEVC_PictureDesc& baseDesc,
+                 const BenchmarkConfig& config, const BenchmarkCreateDecoder& createDecoder,
+                 StartBarrier& startBarrier, InstanceResult& result)
+{
+    EventWaiter events;
+    LCEVC_DecoderHandle decoder = {};
+    if (createDecoder(decoder, &EventWaiter::callback, &events) != EXIT_SUCCESS) {
+        result.status = EXIT_FAILURE;
+    }
+
+    // Start all instances together
+    startBarrier.arriveAndWait();
+
+    if (result.status != EXIT_SUCCESS) {
+        LCEVC_DestroyDecoder(decoder);
+        return;
+    }
+
+    const uint64_t total = static_cast<uint64_t>(frames.size()) * config.iterations;
+    std::map<uint64_t, TimePoint> sendTimes;
+    result.latencies.reserve(total);
+
+    uint64_t next = 0;
+    bool enhancementSent = false;
+    bool synchronized = false;
+    LCEVC_PictureHandle basePicture{};
+    LCEVC_PictureHandle outputPicture{};
+
+    const TimePoint start = getTimePoint();
+
+    while (result.frameCount < total) {
+        // Read before trying each call, so that an event that arrives part way through still wakes
+        // the wait below
+        const uint64_t eventCount = events.count();
+        bool progress = false;
+
+        if (next < total) {
+            // Each pass over the frames uses the next discontinuity count to keep timestamps unique
+            const Frame& frame = frames[next % frames.size()];
+            const uint64_t timestamp =
+                getUniqueTimestamp(static_cast<uint16_t>(next / frames.size()), frame.pts);
+
+            if (!enhancementSent &&
+                VN_LCEVC_AGAIN(LCEVC_SendDecoderEnhancementData(
+                    decoder, timestamp, frame.enhancement.data(),
+                    static_cast<uint32_t>(frame.enhancement.size())))) {
+                sendTimes[timestamp] = getTimePoint();
+                enhancementSent = true;
+                progress = true;
+            }
+
+            if (enhancementSent) {
+                if (isNull(basePicture)) {
+                    // Bind onto the preloaded image - shared, read only, between instances
+                    LCEVC_PictureBufferDesc bufferDesc = {const_cast<uint8_t*>(frame.image.data()),
+                                                          static_cast<uint32_t>(frame.image.size()),
+                                                          {0},
+                                                          LCEVC_Access_Read};
+                    VN_LCEVC_CHECK(LCEVC_AllocPictureExternal(decoder, &baseDesc, &bufferDesc,
+                                                              nullptr, &basePicture));
+                }
+                if (VN_LCEVC_AGAIN(LCEVC_SendDecoderBase(decoder, timestamp, basePicture,
+                                                         std::numeric_limits<uint32_t>::max(),
+                                                         nullptr))) {
+                    basePicture = LCEVC_PictureHandle{};
+                    enhancementSent = false;
+                    next++;
+                    progress = true;
+                }
+            }
+        } else if (!synchronized) {
+            VN_LCEVC_CHECK(LCEVC_SynchronizeDecoder(decoder, false));
+            synchronized = true;
+            progress = true;
+        }
+
+        // Keep the decoder supplied with an output picture
+        if (isNull(outputPicture)) {
+            LCEVC_PictureDesc desc{};
+            VN_LCEVC_CHECK(LCEVC_DefaultPictureDesc(&desc, baseDesc.colorFormat, 2, 2));
+            VN_LCEVC_CHECK(LCEVC_AllocPicture(decoder, &desc, &outputPicture));
+        }
+        if (VN_LCEVC_AGAIN(LCEVC_SendDecoderPicture(decoder, outputPicture))) {
+            outputPicture = LCEVC_PictureHandle{};
+            progress = true;
+        }
+
+        LCEVC_PictureHandle doneBase{};
+        while (VN_LCEVC_AGAIN(LCEVC_ReceiveDecoderBase(decoder, &doneBase))) {
+            VN_LCEVC_CHECK(LCEVC_FreePicture(decoder, doneBase));
+            progress = true;
+        }
+
+        LCEVC_PictureHandle decodedPicture{};
+        LCEVC_DecodeInformation decodeInformation{};
+        if (VN_LCEVC_AGAIN(
+                LCEVC_ReceiveDecoderPicture(decoder, &decodedPicture, &decodeInformation))) {
+            const TimePoint end = getTimePoint();
+            if (auto it = sendTimes.find(decodeInformation.timestamp); it != sendTimes.end()) {
+                result.latencies.push_back(MilliSecondF64(end - it->second).count());
+                sendTimes.erase(it);
+            }
+            VN_LCEVC_CHECK(LCEVC_FreePicture(decoder, decodedPicture));
+            result.frameCount++;
+            progress = true;
+        }
+
+        if (!progress) {
+            events.waitAfter(eventCount);
+        }
+    }
+
+    result.seconds = std::chrono::duration<double>(getTimePoint() - start).count();
+
+    if (!isNull(outputPicture)) {
+        VN_LCEVC_CHECK(LCEVC_FreePicture(decoder, outputPicture));
+    }
+    LCEVC_DestroyDecoder(decoder);
+}
+
+// Nearest-rank percentile of sorted values
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+} // namespace
+
+int runBenchmark(BaseDecoder& baseDecoder, const BenchmarkConfig& config,
+                 const BenchmarkCreateDecoder& createDecoder)
+{
+    if (config.iterations == 0 || config.instances == 0 ||
+        config.iterations > std::numeric_limits<uint16_t>::max()) {
+        fmt::print("Benchmark iterations must be 1-65535, and instances at least 1\n");
+        return EXIT_FAILURE;
+    }
+
+    const std::vector<Frame> frames = preloadFrames(baseDecoder, config.frames);
+    if (frames.empty()) {
+        fmt::print("Benchmark could not preload any frames\n");
+        return EXIT_FAILURE;
+    }
+    if (frames.size() < config.frames) {
+        fmt::print("Benchmark preloaded only {} frames\n", frames.size());
+    }
+
+    const Usage startUsage = getUsage();
+    const TimePoint start = getTimePoint();
+
+    std::vector<InstanceResult> results(config.instances);
+    std::vector<std::thread> threads;
+    StartBarrier startBarrier(config.instances);
+    for (uint32_t i = 0; i < config.instances; ++i) {
+        threads.emplace_back(runInstance, std::cref(frames), std::cref(baseDecoder.description()),
+                             std::cref(config), std::cref(createDecoder), std::ref(startBarrier),
+                             std::ref(results[i]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const double seconds = std::chrono::duration<double>(getTimePoint() - start).count();
+    const Usage endUsage = getUsage();
+
+    // Gather results from all instances
+    std::vector<double> latencies;
+    json perInstanceFps = json::array();
+    uint64_t frameCount = 0;
+    for (const InstanceResult& result : results) {
+        if (result.status != EXIT_SUCCESS) {
+            return result.status;
+        }
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        perInstanceFps.push_back(result.seconds > 0.0 ? result.frameCount / result.seconds : 0.0);
+        frameCount += result.frameCount;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    const double meanLatency =
+        latencies.empty() ? 0.0
+                          : std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+                                static_cast<double>(latencies.size());
+    const double fps = seconds > 0.0 ? frameCount / seconds : 0.0;
+
+    json report = {
+        {"frames", frames.size()},
+        {"iterations", config.iterations},
+        {"instances", config.instances},
+        {"decoded_frames", frameCount},
+        {"seconds", seconds},
+        {"fps", fps},
+        {"fps_per_instance", perInstanceFps},
+        {"latency_ms",
+         {{"mean", meanLatency},
+          {"p50", percentile(latencies, 50.0)},
+          {"p90", percentile(latencies, 90.0)},
+          {"p99", percentile(latencies, 99.0)},
+          {"max", latencies.empty() ? 0.0 : latencies.back()}}},
+        {"cpu_ms_per_frame",
+         frameCount ? (endUsage.cpuSeconds - startUsage.cpuSeconds) * 1000.0 / frameCount : 0.0},
+        {"peak_rss_kib", endUsage.peakRssKiB},
+    };
+
+    if (config.output.empty()) {
+        fmt::print("{}\n", report.dump(4));
+    } else {
+        std::ofstream file(config.output);
+        if (!file) {
+            fmt::print("Could not open benchmark output {}\n", config.output);
+            return EXIT_FAILURE;
+        }
+        file << report.dump(4) << "\n";
+    }
+
+    // Same summary as a normal decode
+    fmt::print("Average frame latency: {:.4}ms, frame time (1 / throughput): {:.4}ms\n",
+               meanLatency, fps > 0.0 ? 1000.0 / fps : 0.0);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,48 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Benchmark mode - decode preloaded frames repeatedly, with one or more decoder instances.
+//
+#ifndef VN_LCEVC_API_BENCHMARK_H
+#define VN_LCEVC_API_BENCHMARK_H
+
+#include <LCEVC/lcevc_dec.h>
+#include <LCEVC/utility/base_decoder.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+struct BenchmarkConfig
+{
+    uint32_t frames;     /**< Number of frames to preload from the base decoder */
+    uint32_t iterations; /**< Number of times each instance decodes the preloaded frames */
+    uint32_t instances;  /**< Number of decoders running concurrently */
+    std::string output;  /**< JSON results file - stdout if empty */
+};
+
+// Creates and initializes a decoder, returning EXIT_SUCCESS or EXIT_FAILURE. The decoder must call
+// eventCallback, with userData, for each of the kBenchmarkEvents.
+using BenchmarkCreateDecoder = std::function<int(
+    LCEVC_DecoderHandle& decoder, LCEVC_EventCallback eventCallback, void* userData)>;
+
+// Events that tell a benchmark instance waiting on its decoder that it may be able to progress
+inline constexpr int32_t kBenchmarkEvents[] = {LCEVC_CanSendBase,     LCEVC_CanSendEnhancement,
+                                               LCEVC_CanSendPicture,  LCEVC_CanReceive,
+                                               LCEVC_BasePictureDone, LCEVC_OutputPictureDone};
+
+int runBenchmark(lcevc_dec::utility::BaseDecoder& baseDecoder, const BenchmarkConfig& config,
+                 const BenchmarkCreateDecoder& createDecoder);
+
+#endif // VN_LCEVC_API_BENCHMARK_H
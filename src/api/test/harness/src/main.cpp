@@ -12,6 +12,7 @@
  * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
  * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
 
+#include "benchmark.h"
 #include "bin_writer.h"
 #include "hash.h"
 #include "trickplay.h"
@@ -30,6 +31,8 @@
 #include <LCEVC/utility/timestamp.h>
 
 #include <cstdlib>
+#include <iterator>
+#include <vector>
 
 using namespace lcevc_dec::utility;
 
@@ -44,6 +47,7 @@ struct Config
     bool baseExternal{false};
     bool readBinLinearly = false;
     bool simulatePadding{false};
+    uint32_t readAhead{0};
     // Outputs
     std::string outputRawFile;
     std::string outputBaseRawFile;
@@ -61,6 +65,11 @@ struct Config
     std::string trickplayJson;
     bool verbose{false};
     bool repeat{false};
+    // Benchmarking
+    uint32_t benchmarkFrames{0};
+    uint32_t benchmarkIterations{10};
+    uint32_t benchmarkInstances{1};
+    std::string benchmarkOutput;
 };
 
 struct Stats
@@ -125,6 +134,8 @@ int setupConfig(int argc, char** argv, Config& cfgOut)
                  cfgOut.readBinLinearly, "Use this to measure LCEVC Decode performance. If true, then .bin+.yuv streams are decoded in presentation order (rather than decode order, as with encapsulated files)");
     app.add_flag("--simulate-padding", cfgOut.simulatePadding,
                  "Pad input stride rounded to the next power of 2 of the surface width");
+    app.add_option("--read-ahead", cfgOut.readAhead,
+                   "Number of RAW base frames to read ahead on a background thread");
     // Output
     app.add_option("-o,--output", cfgOut.outputRawFile, "Output file, RAW");
     app.add_option("--output-base", cfgOut.outputBaseRawFile, "Output base file, RAW");
@@ -146,6 +157,18 @@ int setupConfig(int argc, char** argv, Config& cfgOut)
     app.add_flag("-v,--verbose", cfgOut.verbose, "Enable verbose logging");
     app.add_flag("--repeat", cfgOut.repeat, "Repeat decoding task for ever");
     app.add_flag("--pending-limit", cfgOut.pendingLimit, "Maximum number of frames to keep pending.");
+    // Benchmarking
+    app.add_option("--benchmark", cfgOut.benchmarkFrames,
+                   "Preload this many frames into memory, then decode them repeatedly and report "
+                   "throughput, latency, process CPU time and peak memory as JSON");
+    app.add_option("--benchmark-iterations", cfgOut.benchmarkIterations,
+                   "Number of times each decoder decodes the preloaded frames")
+        ->default_val(10);
+    app.add_option("--benchmark-instances", cfgOut.benchmarkInstances,
+                   "Number of decoders to run concurrently")
+        ->default_val(1);
+    app.add_option("--benchmark-output", cfgOut.benchmarkOutput,
+                   "Output benchmark JSON file, otherwise printed to stdout");
 
     try {
         app.parse(argc, argv);
@@ -176,9 +199,11 @@ static std::unique_ptr<BaseDecoder> createBaseDecoder(const Config& cfg)
     if (!cfg.inputLcevcFile.empty() && !cfg.inputBaseFile.empty()) {
         std::unique_ptr<BaseDecoder> baseDecoderBin;
         if (cfg.readBinLinearly) {
-            baseDecoderBin = createBaseDecoderBinLinear(cfg.inputBaseFile, cfg.inputLcevcFile);
+            baseDecoderBin =
+                createBaseDecoderBinLinear(cfg.inputBaseFile, cfg.inputLcevcFile, cfg.readAhead);
         } else {
-            baseDecoderBin = createBaseDecoderBinNonLinear(cfg.inputBaseFile, cfg.inputLcevcFile);
+            baseDecoderBin =
+                createBaseDecoderBinNonLinear(cfg.inputBaseFile, cfg.inputLcevcFile, cfg.readAhead);
         }
         if (!baseDecoderBin) {
             fmt::print("Could not open input.\nBase: {}\nLCEVC: {}\n", cfg.inputBaseFile, cfg.inputLcevcFile);
@@ -191,7 +216,10 @@ static std::unique_ptr<BaseDecoder> createBaseDecoder(const Config& cfg)
 }
 
 static int createAndInitDecoder(const std::string_view configurationJson, bool verbose,
-                                LCEVC_DecoderHandle& decoderOut)
+                                LCEVC_DecoderHandle& decoderOut,
+                                LCEVC_EventCallback eventCallback = nullptr,
+                                void* eventUserData = nullptr,
+                                const std::vector<int32_t>& events = {})
 {
     VN_LCEVC_CHECK(LCEVC_CreateDecoder(&decoderOut, LCEVC_AccelContextHandle{}));
 
@@ -210,6 +238,13 @@ static int createAndInitDecoder(const std::string_view configurationJson, bool v
         VN_LCEVC_CHECK(LCEVC_ConfigureDecoderInt(decoderOut, "log_level", LCEVC_LogTrace));
     }
 
+    if (eventCallback) {
+        VN_LCEVC_CHECK(LCEVC_ConfigureDecoderIntArray(decoderOut, "events",
+                                                      static_cast<uint32_t>(events.size()),
+                                                      events.data()));
+        VN_LCEVC_CHECK(LCEVC_SetDecoderEventCallback(decoderOut, eventCallback, eventUserData));
+    }
+
     VN_LCEVC_CHECK(LCEVC_InitializeDecoder(decoderOut));
     return EXIT_SUCCESS;
 }
@@ -359,6 +394,10 @@ static int decode(const Config& cfg)
         return EXIT_FAILURE;
     }
 
+    // External base pictures can use the base decoder's images directly, if those outlive them
+    const bool baseInPlace =
+        cfg.baseExternal && !cfg.simulatePadding && baseDecoder->imagePersistent();
+
     // RAW outputs - initialized once picture layouts are known
     std::unique_ptr<RawWriter> outputBaseRaw;
     std::unique_ptr<RawWriter> outputRaw;
@@ -455,6 +494,11 @@ static int decode(const Config& cfg)
                     VN_LCEVC_CHECK(LCEVC_AllocPictureExternal(decoder, &baseDecoder->description(),
                                                               &pictureBufferDesc, picturePlaneDesc,
                                                               &basePicture));
+                } else if (baseInPlace) {
+                    // Bind the picture directly onto the base decoder's (copy-on-write) image
+                    pictureBufferDesc.data = const_cast<uint8_t*>(baseImage.ptr);
+                    VN_LCEVC_CHECK(LCEVC_AllocPictureExternal(decoder, &baseDecoder->description(),
+                                                              &pictureBufferDesc, nullptr, &basePicture));
                 } else {
                     pictureBufferDesc.data = new uint8_t[baseImage.size]; // NOLINT:cppcoreguidelines-owning-memory
                     VN_LCEVC_CHECK(LCEVC_AllocPictureExternal(decoder, &baseDecoder->description(),
@@ -500,7 +544,9 @@ static int decode(const Config& cfg)
                     LCEVC_PictureBufferDesc pictureBufferDesc;
                     VN_LCEVC_CHECK(LCEVC_GetPictureBuffer(decoder, doneBasePicture, &pictureBufferDesc));
                     VN_LCEVC_CHECK(LCEVC_FreePicture(decoder, doneBasePicture));
-                    delete[] pictureBufferDesc.data; // NOLINT:cppcoreguidelines-owning-memory
+                    if (!baseInPlace) {
+                        delete[] pictureBufferDesc.data; // NOLINT:cppcoreguidelines-owning-memory
+                    }
                 } else {
                     VN_LCEVC_CHECK(LCEVC_FreePicture(decoder, doneBasePicture));
                 }
@@ -571,6 +617,25 @@ static int decode(const Config& cfg)
     return EXIT_SUCCESS;
 }
 
+static int benchmark(const Config& cfg)
+{
+    std::unique_ptr<BaseDecoder> baseDecoder = createBaseDecoder(cfg);
+    if (baseDecoder == nullptr) {
+        return EXIT_FAILURE;
+    }
+
+    const BenchmarkConfig benchmarkConfig{cfg.benchmarkFrames, cfg.benchmarkIterations,
+                                          cfg.benchmarkInstances, cfg.benchmarkOutput};
+
+    const std::vector<int32_t> events(std::begin(kBenchmarkEvents), std::end(kBenchmarkEvents));
+    return runBenchmark(*baseDecoder, benchmarkConfig,
+                        [&cfg, &events](LCEVC_DecoderHandle& decoder,
+                                        LCEVC_EventCallback eventCallback, void* userData) {
+                            return createAndInitDecoder(cfg.configurationJson, cfg.verbose,
+                                                        decoder, eventCallback, userData, events);
+                        });
+}
+
 int main(int argc, char** argv)
 {
     Config cfg;
@@ -578,6 +643,10 @@ int main(int argc, char** argv)
         return res;
     }
 
+    if (cfg.benchmarkFrames > 0) {
+        return benchmark(cfg);
+    }
+
     do {
         if (int ret = decode(cfg); ret != EXIT_SUCCESS) {
             return ret;
@@ -25,6 +25,11 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace lcevc_dec::decoder;
 
@@ -130,3 +135,244 @@ TEST(eventManagerInit, noCallbackUntilInit)
     atomicWaitUntil(wasTimeout, equal, callbackCounts[LCEVC_Exit], 1);
     EXPECT_FALSE(wasTimeout);
 }
+
+// Queueing
+
+// Records events, and blocks in the callback while the gate is closed
+struct GatedRecorder
+{
+    static void callback(LCEVC_DecoderHandle, LCEVC_Event event, LCEVC_PictureHandle,
+                         const LCEVC_DecodeInformation*, const uint8_t* data, uint32_t,
+                         void* userData)
+    {
+        auto* recorder = static_cast<GatedRecorder*>(userData);
+        {
+            const std::scoped_lock lock(recorder->mutex);
+            recorder->threads.push_back(std::this_thread::get_id());
+            recorder->data.push_back(reinterpret_cast<uintptr_t>(data));
+        }
+        recorder->entered++;
+        while (!recorder->open) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        recorder->counts[event]++;
+    }
+
+    std::atomic<bool> open{true};
+    std::atomic<uint32_t> entered{0};
+    EventCountArr counts = {};
+    std::mutex mutex;
+    std::vector<std::thread::id> threads;
+    std::vector<uintptr_t> data;
+};
+
+TEST(eventManagerQueue, coalescesCanSendEvents)
+{
+    GatedRecorder recorder;
+    recorder.open = false;
+
+    std::unique_ptr<EventDispatcher> dispatcher(createEventDispatcher(nullptr));
+    dispatcher->enableEvents(kArbitraryEvents);
+    dispatcher->setEventCallback(GatedRecorder::callback, &recorder);
+
+    // Hold the event thread in the callback of the first event
+    dispatcher->generate(LCEVC_CanSendBase);
+    bool wasTimeout = false;
+    atomicWaitUntil(wasTimeout, equal, recorder.entered, 1);
+    ASSERT_FALSE(wasTimeout);
+
+    // Only one more can-send event is queued behind it, but every exit event is
+    for (uint32_t idx = 0; idx < 100; ++idx) {
+        dispatcher->generate(LCEVC_CanSendBase);
+        dispatcher->generate(LCEVC_Exit);
+    }
+    recorder.open = true;
+
+    atomicWaitUntil(wasTimeout, equal, recorder.counts[LCEVC_Exit], 100);
+    EXPECT_FALSE(wasTimeout);
+    EXPECT_EQ(recorder.counts[LCEVC_CanSendBase], 2);
+
+    // Once delivered, the next can-send event is queued again
+    dispatcher->generate(LCEVC_CanSendBase);
+    atomicWaitUntil(wasTimeout, equal, recorder.counts[LCEVC_CanSendBase], 3);
+    EXPECT_FALSE(wasTimeout);
+}
+
+TEST(eventManagerQueue, keepsOrderBeyondCapacity)
+{
+    // Well beyond the capacity of the lock-free ring
+    constexpr uint32_t kNumEvents = 2000;
+
+    GatedRecorder recorder;
+    recorder.open = false;
+
+    std::unique_ptr<EventDispatcher> dispatcher(createEventDispatcher(nullptr));
+    dispatcher->enableEvents(kArbitraryEvents);
+    dispatcher->setEventCallback(GatedRecorder::callback, &recorder);
+
+    // Events carry their sequence number in the data pointer
+    for (uintptr_t idx = 0; idx < kNumEvents; ++idx) {
+        dispatcher->generate(LCEVC_Exit, nullptr, nullptr, reinterpret_cast<const uint8_t*>(idx));
+    }
+    recorder.open = true;
+
+    // Destroying the dispatcher delivers everything still queued
+    dispatcher.reset();
+    EXPECT_EQ(recorder.counts[LCEVC_Exit], kNumEvents);
+    ASSERT_EQ(recorder.data.size(), kNumEvents);
+    for (uintptr_t idx = 0; idx < kNumEvents; ++idx) {
+        EXPECT_EQ(recorder.data[idx], idx);
+    }
+}
+
+TEST(eventManagerQueue, keepsOrderPerThread)
+{
+    // Enough events from each thread to overflow the lock-free ring while it is being drained
+    constexpr uintptr_t kNumThreads = 4;
+    constexpr uintptr_t kNumEvents = 5000;
+
+    GatedRecorder recorder;
+    recorder.open = false;
+
+    std::unique_ptr<EventDispatcher> dispatcher(createEventDispatcher(nullptr));
+    dispatcher->enableEvents(kArbitraryEvents);
+    dispatcher->setEventCallback(GatedRecorder::callback, &recorder);
+
+    // Events carry their thread and sequence number in the data pointer
+    std::vector<std::thread> threads;
+    for (uintptr_t thread = 0; thread < kNumThreads; ++thread) {
+        threads.emplace_back([&dispatcher, thread]() {
+            for (uintptr_t idx = 0; idx < kNumEvents; ++idx) {
+                dispatcher->generate(LCEVC_Exit, nullptr, nullptr,
+                                     reinterpret_cast<const uint8_t*>((thread << 16) | idx));
+            }
+        });
+    }
+    recorder.open = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    dispatcher.reset();
+    EXPECT_EQ(recorder.counts[LCEVC_Exit], kNumThreads * kNumEvents);
+    std::array<uintptr_t, kNumThreads> next = {};
+    for (const uintptr_t data : recorder.data) {
+        const uintptr_t thread = data >> 16;
+        ASSERT_LT(thread, kNumThreads);
+        ASSERT_EQ(data & 0xffff, next[thread]);
+        next[thread]++;
+    }
+    for (const uintptr_t count : next) {
+        EXPECT_EQ(count, kNumEvents);
+    }
+}
+
+TEST(eventManagerQueue, firstEventIsDelivered)
+{
+    // Keep the shared thread running, so that dispatchers join it as well as starting their own
+    GatedRecorder anchorRecorder;
+    std::unique_ptr<EventDispatcher> anchor(createEventDispatcher(nullptr));
+    EXPECT_TRUE(anchor->useSharedThread(true));
+    anchor->enableEvents(kArbitraryEvents);
+    anchor->setEventCallback(GatedRecorder::callback, &anchorRecorder);
+    anchor->generate(LCEVC_Exit);
+
+    // The first event is queued just as the thread attaches - repeat to catch it going to sleep
+    // without seeing that event.
+    for (const bool shared : {false, true}) {
+        for (uint32_t iteration = 0; iteration < 200; ++iteration) {
+            GatedRecorder recorder;
+
+            std::unique_ptr<EventDispatcher> dispatcher(createEventDispatcher(nullptr));
+            EXPECT_TRUE(dispatcher->useSharedThread(shared));
+            dispatcher->enableEvents(kArbitraryEvents);
+            dispatcher->setEventCallback(GatedRecorder::callback, &recorder);
+            dispatcher->generate(LCEVC_Exit);
+
+            bool wasTimeout = false;
+            atomicWaitUntil(wasTimeout, equal, recorder.counts[LCEVC_Exit], 1);
+            ASSERT_FALSE(wasTimeout) << "shared " << shared << " iteration " << iteration;
+        }
+    }
+}
+
+TEST(eventManagerQueue, sharedThread)
+{
+    GatedRecorder recorder;
+
+    std::unique_ptr<EventDispatcher> first(createEventDispatcher(nullptr));
+    std::unique_ptr<EventDispatcher> second(createEventDispatcher(nullptr));
+    std::unique_ptr<EventDispatcher> own(createEventDispatcher(nullptr));
+    EXPECT_TRUE(first->useSharedThread(true));
+    EXPECT_TRUE(second->useSharedThread(true));
+
+    for (EventDispatcher* dispatcher : {first.get(), second.get(), own.get()}) {
+        dispatcher->enableEvents(kArbitraryEvents);
+        dispatcher->setEventCallback(GatedRecorder::callback, &recorder);
+        dispatcher->generate(LCEVC_Exit);
+    }
+
+    bool wasTimeout = false;
+    atomicWaitUntil(wasTimeout, equal, recorder.counts[LCEVC_Exit], 3);
+    EXPECT_FALSE(wasTimeout);
+
+    // The thread cannot change once events have been generated
+    EXPECT_FALSE(own->useSharedThread(true));
+
+    // Callbacks are in order per dispatcher, but not across dispatchers, so find the own thread as
+    // the odd one out.
+    ASSERT_EQ(recorder.threads.size(), 3);
+    std::vector<std::thread::id> threads = recorder.threads;
+    std::sort(threads.begin(), threads.end());
+    const auto distinct = std::unique(threads.begin(), threads.end()) - threads.begin();
+    EXPECT_EQ(distinct, 2);
+}
+
+// Completion callback
+
+TEST(eventManagerCompletion, completesOnCallingThread)
+{
+    struct Completion
+    {
+        std::thread::id thread;
+        uintptr_t picture;
+        uint64_t timestamp;
+    };
+    std::vector<Completion> completions;
+
+    std::unique_ptr<EventDispatcher> dispatcher(createEventDispatcher(nullptr));
+    EXPECT_FALSE(dispatcher->isCompletionEnabled());
+
+    auto callback = [](LCEVC_DecoderHandle, LCEVC_PictureHandle picHandle,
+                       const LCEVC_DecodeInformation* decodeInformation, void* userData) {
+        auto* out = static_cast<std::vector<Completion>*>(userData);
+        out->push_back({std::this_thread::get_id(), picHandle.hdl, decodeInformation->timestamp});
+    };
+    dispatcher->setCompletionCallback(callback, &completions);
+    EXPECT_TRUE(dispatcher->isCompletionEnabled());
+
+    std::array<LdpPicture, 2> pictures = {};
+    dispatcher->outputPictureSent(&pictures[0], 10);
+    dispatcher->outputPictureSent(&pictures[1], 11);
+    // Sending a picture again replaces its handle
+    dispatcher->outputPictureSent(&pictures[0], 12);
+
+    LdpDecodeInformation decodeInfo = {};
+    decodeInfo.timestamp = 100;
+    dispatcher->completePicture(&pictures[1], &decodeInfo);
+    decodeInfo.timestamp = 101;
+    dispatcher->completePicture(&pictures[0], &decodeInfo);
+
+    // Synchronous - no waiting for a dispatcher thread
+    ASSERT_EQ(completions.size(), 2);
+    EXPECT_EQ(completions[0].thread, std::this_thread::get_id());
+    EXPECT_EQ(completions[0].picture, 11);
+    EXPECT_EQ(completions[0].timestamp, 100);
+    EXPECT_EQ(completions[1].picture, 12);
+    EXPECT_EQ(completions[1].timestamp, 101);
+
+    // A picture's handle is used by one completion only
+    dispatcher->completePicture(&pictures[0], &decodeInfo);
+    ASSERT_EQ(completions.size(), 3);
+    EXPECT_EQ(completions[2].picture, kInvalidHandle);
+}
@@ -73,6 +73,10 @@ TEST(PipelineTypes, EnumColorFormat)
 
     ASSERT_EQ(LdpColorFormatNV12_8, LCEVC_NV12_8);
     ASSERT_EQ(LdpColorFormatNV21_8, LCEVC_NV21_8);
+    ASSERT_EQ(LdpColorFormatNV16_8, LCEVC_NV16_8);
+    ASSERT_EQ(LdpColorFormatP010_LE, LCEVC_P010_LE);
+    ASSERT_EQ(LdpColorFormatP016_LE, LCEVC_P016_LE);
+    ASSERT_EQ(LdpColorFormatP210_LE, LCEVC_P210_LE);
 
     ASSERT_EQ(LdpColorFormatRGB_8, LCEVC_RGB_8);
     ASSERT_EQ(LdpColorFormatBGR_8, LCEVC_BGR_8);
@@ -159,6 +163,17 @@ TEST(PipelineTypes, EnumMatrixCoefficients)
     ASSERT_EQ(LdpMatrixCoefficientsICTCP, LCEVC_MatrixCoefficients_ICTCP);
 }
 
+TEST(PipelineTypes, EnumMemoryCategory)
+{
+    ASSERT_EQ(LdpMemoryCategoryFrames, LCEVC_Memory_Frames);
+    ASSERT_EQ(LdpMemoryCategoryTemporal, LCEVC_Memory_Temporal);
+    ASSERT_EQ(LdpMemoryCategoryIntermediate, LCEVC_Memory_Intermediate);
+    ASSERT_EQ(LdpMemoryCategoryCmdBuffers, LCEVC_Memory_CmdBuffers);
+    ASSERT_EQ(LdpMemoryCategoryTasks, LCEVC_Memory_Tasks);
+    ASSERT_EQ(LdpMemoryCategoryOther, LCEVC_Memory_Other);
+    ASSERT_EQ(LdpMemoryCategoryCount, LCEVC_Memory_Count);
+}
+
 TEST(PipelineTypes, StructDecodeInformation)
 {
     ASSERT_EQ(offsetof(LdpDecodeInformation, timestamp), offsetof(LCEVC_DecodeInformation, timestamp));
@@ -236,3 +251,13 @@ TEST(PipelineTypes, StructPictureDesc)
     ASSERT_EQ(offsetof(LdpPictureDesc, cropLeft), offsetof(LCEVC_PictureDesc, cropLeft));
     ASSERT_EQ(offsetof(LdpPictureDesc, cropRight), offsetof(LCEVC_PictureDesc, cropRight));
 }
+
+TEST(PipelineTypes, StructMemoryUsage)
+{
+    ASSERT_EQ(offsetof(LdpMemoryUsage, current), offsetof(LCEVC_MemoryUsage, current));
+    ASSERT_EQ(offsetof(LdpMemoryUsage, peak), offsetof(LCEVC_MemoryUsage, peak));
+    ASSERT_EQ(offsetof(LdpMemoryUsage, total), offsetof(LCEVC_MemoryUsage, total));
+    ASSERT_EQ(offsetof(LdpMemoryUsage, totalPeak), offsetof(LCEVC_MemoryUsage, totalPeak));
+    ASSERT_EQ(offsetof(LdpMemoryUsage, budget), offsetof(LCEVC_MemoryUsage, budget));
+    ASSERT_EQ(offsetof(LdpMemoryUsage, degraded), offsetof(LCEVC_MemoryUsage, degraded));
+}
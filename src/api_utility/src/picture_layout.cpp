@@ -59,6 +59,10 @@ const struct PictureLayout::Info PictureLayout::kPictureLayoutInfo[] = {
 
     {LCEVC_NV12_8,     YUV,       3, 1, 1, {0, 1},    {0, 1},    {0, 0},    {1, 2, 2},    {0, 0, 1},    8,  ".nv12"},
     {LCEVC_NV21_8,     YUV,       3, 1, 1, {0, 1},    {0, 1},    {0, 0},    {1, 2, 2},    {0, 1, 0},    8,  ".nv21"},
+    {LCEVC_NV16_8,     YUV,       3, 1, 0, {0, 1},    {0, 0},    {0, 0},    {1, 2, 2},    {0, 0, 1},    8,  ".nv16"},
+    {LCEVC_P010_LE,    YUV,       3, 1, 1, {0, 1},    {0, 1},    {0, 0},    {1, 2, 2},    {0, 0, 2},    16, ".p010"},
+    {LCEVC_P016_LE,    YUV,       3, 1, 1, {0, 1},    {0, 1},    {0, 0},    {1, 2, 2},    {0, 0, 2},    16, ".p016"},
+    {LCEVC_P210_LE,    YUV,       3, 1, 0, {0, 1},    {0, 0},    {0, 0},    {1, 2, 2},    {0, 0, 2},    16, ".p210"},
 
     {LCEVC_RGB_8,      RGB,       3, 0, 0, {0},       {0},       {0},       {3, 3, 3},    {0, 1, 2},    8,  ".rgb"},
     {LCEVC_BGR_8,      RGB,       3, 0, 0, {0},       {0},       {0},       {3, 3, 3},    {2, 1, 0},    8,  ".bgr"},
@@ -25,6 +25,7 @@ list(
     "src/diagnostics_tracefile.c"
     "src/memory.c"
     "src/memory_malloc.c"
+    "src/memory_tracker.c"
     "src/random.c"
     "src/ring_buffer.c"
     "src/rolling_arena.c"
@@ -60,6 +61,7 @@ list(
     "include/LCEVC/common/limit.h"
     "include/LCEVC/common/log.h"
     "include/LCEVC/common/memory.h"
+    "include/LCEVC/common/memory_tracker.h"
     "include/LCEVC/common/neon.h"
     "include/LCEVC/common/platform.h"
     "include/LCEVC/common/printf_macros.h"
@@ -78,6 +80,7 @@ list(
     "include/LCEVC/common/detail/deque.h"
     "include/LCEVC/common/detail/diagnostics.h"
     "include/LCEVC/common/detail/diagnostics_buffer.h"
+    "include/LCEVC/common/detail/memory_tracker.h"
     "include/LCEVC/common/detail/ring_buffer.h"
     "include/LCEVC/common/detail/rolling_arena.h"
     "include/LCEVC/common/detail/task_pool.h"
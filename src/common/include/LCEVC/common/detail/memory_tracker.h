@@ -0,0 +1,57 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#ifndef VN_LCEVC_COMMON_DETAIL_MEMORY_TRACKER_H
+#define VN_LCEVC_COMMON_DETAIL_MEMORY_TRACKER_H
+
+#include <LCEVC/common/memory.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Counters are atomic, and only updated in memory_tracker.c. C++ code embeds the tracker without
+// touching them, so it sees plain storage of the same size.
+#ifdef __cplusplus
+typedef size_t LdcMemoryTrackerCounter;
+#else
+#include <stdatomic.h>
+typedef atomic_size_t LdcMemoryTrackerCounter;
+#endif
+
+struct LdcMemoryTrackerCategory
+{
+    // Allocator handed out for this category - allocatorData points back at the tracker
+    LdcMemoryAllocator allocator;
+
+    // Bytes currently held, and the most ever held at once
+    LdcMemoryTrackerCounter current;
+    LdcMemoryTrackerCounter peak;
+};
+
+struct LdcMemoryTracker
+{
+    // Where allocations actually come from
+    LdcMemoryAllocator* parentAllocator;
+
+    // Budget across all categories in bytes, or 0 for none
+    size_t budget;
+
+    // Bytes held across all categories, and the most ever held at once
+    LdcMemoryTrackerCounter total;
+    LdcMemoryTrackerCounter totalPeak;
+
+    uint32_t categoryCount;
+    struct LdcMemoryTrackerCategory categories[kMemoryTrackerMaxCategories];
+};
+
+#endif // VN_LCEVC_COMMON_DETAIL_MEMORY_TRACKER_H
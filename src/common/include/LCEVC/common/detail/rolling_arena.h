@@ -23,6 +23,10 @@
 //
 #define kRollingArenaMaxBuffers 16
 
+// Number of per-thread regions - threads beyond this share regions
+//
+#define kRollingArenaMaxRegions 16
+
 struct LdcRollingArenaSlot
 {
     uint32_t beginOffset; // First offset in chunk covered by slot - NB: returned pointer may be further along to account for alignment and wrapping
@@ -81,6 +85,14 @@ struct LdcMemoryAllocatorRollingArena
     struct LdcRollingArenaBuffer buffers[kRollingArenaMaxBuffers];
 
     uint32_t bufferCount;
+
+    // Per-thread regions, if enabled - otherwise NULL
+    struct LdcRollingArenaRegionSlot* regionSlots;
+    LdcMemoryAllocation regionSlotsAllocation;
+
+    // Size of each region's chunk, and the largest allocation served from a region
+    uint32_t regionSize;
+    uint32_t regionAllocationMax;
 };
 
 #endif // VN_LCEVC_COMMON_DETAIL_ROLLING_ARENA_H
@@ -50,6 +50,9 @@ typedef struct LdcTaskPool
     // A deque of ready task parts
     // This will move to per-thread later when work stealing is sorted (and the reason
     // why this is a deque vs. a simple list)
+    //
+    // A part with a zero count is a claim on a multi-iteration task - the worker that pops it
+    // takes the next part of the task, and puts the claim back if there is more to do.
     LdcDeque readyParts;
 
     // Mutex for locking whole pool
@@ -132,6 +135,16 @@ typedef struct LdcTask
     // Updated by threads as task progresses
     uint32_t iterationsCompletedCount;
 
+    // Iterations that have been handed out to parts so far
+    uint32_t iterationsClaimedCount;
+
+    // Smallest part size, and alignment of part starts (power of 2 or 0)
+    uint32_t partGrain;
+    uint32_t partAlignment;
+
+    // If not NULL, running total of iteration costs - iterationsTotalCount + 1 entries
+    const uint64_t* iterationCosts;
+
     LdcTaskState state;
     LdcTaskDependency lowestUnmetDependency;
 
@@ -203,7 +216,52 @@ typedef struct LdcTaskGroup
     uint32_t waitingTasksCount;
     LdcTask** waitingTasks;
 
+    // If not NULL, added tasks are also recorded into this template
+    struct LdcTaskGraphTemplate* recording;
+
 } LdcDependencies;
 
+/*! A task as recorded in a task graph template
+ */
+typedef struct LdcTaskTemplate
+{
+    const char* name;
+
+    LdcTaskFunction taskFunction;
+    LdcTaskFunction completionFunction;
+
+    LdcTaskDependency output;
+    uint32_t inputsCount;
+
+    uint32_t iterationsTotalCount;
+    uint32_t maxIterationsPerPart;
+
+    size_t dataSize; // Size of per-task parameter data
+    uint8_t data[1]; // Task data, followed by input dependencies - as for LdcTask
+    // NB: DO NOT PUT ANY MORE MEMBERS HERE
+} LdcTaskTemplate;
+
+/*! A recorded graph of tasks and dependencies that can be added to a group in one go
+ */
+typedef struct LdcTaskGraphTemplate
+{
+    LdcMemoryAllocator* allocator;
+
+    // Vector of allocations of LdcTaskTemplate, in the order they were added
+    LdcVector tasks;
+
+    // Number of group dependencies when recording started
+    uint32_t firstDependency;
+
+    // Number of dependencies added whilst recording
+    uint32_t dependenciesCount;
+
+    // True once recording has finished successfully
+    bool recorded;
+
+    // True if anything could not be recorded
+    bool failed;
+} LdcTaskGraphTemplate;
+
 // NOLINTEND(modernize-use-using)
 #endif // VN_LCEVC_COMMON_DETAIL_TASK_POOL_H
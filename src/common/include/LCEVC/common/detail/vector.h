@@ -59,6 +59,12 @@ static inline uint32_t ldcVectorAppend(LdcVector* vector, const void* element)
     return vector->size++;
 }
 
+static inline void ldcVectorClear(LdcVector* vector)
+{
+    assert(vector);
+    vector->size = 0;
+}
+
 static inline void* ldcVectorAt(const LdcVector* vector, uint32_t index)
 {
     if (index >= vector->size) {
@@ -0,0 +1,98 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#ifndef VN_LCEVC_COMMON_MEMORY_TRACKER_H
+#define VN_LCEVC_COMMON_MEMORY_TRACKER_H
+
+#include <LCEVC/common/memory.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*! @file
+ * @brief Per-category accounting of the memory held through a parent allocator
+ *
+ * Thread safe
+ *
+ * The tracker hands out one allocator per category. Each of these passes allocations straight
+ * through to the parent allocator, and records how many bytes the category currently holds, and
+ * its peak.
+ *
+ * An optional budget can be set. The tracker never fails an allocation because of the budget -
+ * it is up to the owner to check `ldcMemoryTrackerOverBudget` and cut back on what it asks for.
+ */
+
+/*! Maximum number of categories a tracker can account for. */
+#define kMemoryTrackerMaxCategories 8
+
+typedef struct LdcMemoryTracker LdcMemoryTracker;
+
+/*! Initialize a memory tracker.
+ *
+ * @param[out]      tracker             The tracker to be initialized.
+ * @param[in]       parentAllocator     The underlying allocator that allocations are passed to.
+ * @param[in]       categoryCount       Number of categories to track, up to
+ *                                      kMemoryTrackerMaxCategories.
+ * @param[in]       budget              Budget in bytes across all categories, or 0 for none.
+ */
+void ldcMemoryTrackerInitialize(LdcMemoryTracker* tracker, LdcMemoryAllocator* parentAllocator,
+                                uint32_t categoryCount, size_t budget);
+
+/*! Destroy a previously initialized memory tracker.
+ *
+ * All allocations made through the tracker's allocators should have been freed first.
+ */
+void ldcMemoryTrackerDestroy(LdcMemoryTracker* tracker);
+
+/*! Get the allocator that accounts allocations to the given category.
+ *
+ * @param[in]       tracker             An initialized tracker.
+ * @param[in]       category            Category index, less than the tracker's category count.
+ *
+ * @return          The category's allocator - valid until the tracker is destroyed.
+ */
+LdcMemoryAllocator* ldcMemoryTrackerAllocator(LdcMemoryTracker* tracker, uint32_t category);
+
+/*! Bytes currently allocated in a category. */
+size_t ldcMemoryTrackerCurrent(LdcMemoryTracker* tracker, uint32_t category);
+
+/*! Highest number of bytes that have been allocated at once in a category. */
+size_t ldcMemoryTrackerPeak(LdcMemoryTracker* tracker, uint32_t category);
+
+/*! Bytes currently allocated across all categories. */
+size_t ldcMemoryTrackerTotal(LdcMemoryTracker* tracker);
+
+/*! Highest number of bytes that have been allocated at once across all categories. */
+size_t ldcMemoryTrackerTotalPeak(LdcMemoryTracker* tracker);
+
+/*! The budget the tracker was initialized with, or 0 for none. */
+size_t ldcMemoryTrackerBudget(const LdcMemoryTracker* tracker);
+
+/*! True if there is a budget, and the bytes allocated across all categories exceed it. */
+bool ldcMemoryTrackerOverBudget(LdcMemoryTracker* tracker);
+
+// Tracker definition
+//
+#include "detail/memory_tracker.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VN_LCEVC_COMMON_MEMORY_TRACKER_H
@@ -58,6 +58,15 @@
 #define VnAlign(v, a) v __attribute__((aligned(a)))
 #endif
 
+// Force a function to be inlined, for bodies that are specialised on compile time constant
+// arguments by thin wrappers.
+//
+#if VN_COMPILER(MSVC)
+#define VNForceInline __forceinline
+#else
+#define VNForceInline inline __attribute__((always_inline))
+#endif
+
 #if defined(__cplusplus)
 #define VNAlignof(T) alignof(T)
 #else
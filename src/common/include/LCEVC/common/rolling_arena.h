@@ -47,6 +47,11 @@ extern "C"
  *
  * The intended use is for the intermediate data of the pipeline - unencapsulated bytes, command buffers, etc.
  * that will only live for the pipeline latency, and are roughly consumed in order of production.
+ *
+ * Optionally, small allocations can be served from per-thread 'regions' - chunks of the ring that
+ * a thread bumps through without taking the arena lock. A chunk goes back to the ring once its
+ * region has been closed and all its allocations have been freed. Regions are closed when full,
+ * or when their thread has stopped allocating from them.
  */
 
 typedef struct LdcMemoryAllocatorRollingArena LdcMemoryAllocatorRollingArena;
@@ -68,6 +73,22 @@ LdcMemoryAllocator* ldcRollingArenaInitialize(LdcMemoryAllocatorRollingArena* ro
  */
 void ldcRollingArenaDestroy(LdcMemoryAllocatorRollingArena* arena);
 
+/*! Serve small allocations from per-thread regions, without taking the arena lock.
+ *
+ * Must be called before the arena is shared between threads.
+ *
+ * @param[in]       arena                   An initialized arena with no allocations.
+ * @param[in]       regionSize              Size of each region in bytes, a power of two.
+ *
+ * @return          True if the regions were set up.
+ */
+bool ldcRollingArenaEnableThreadRegions(LdcMemoryAllocatorRollingArena* arena, uint32_t regionSize);
+
+/*! Close any regions that are not in use, so that their chunks can be released once their
+ *  allocations are freed. Regions are reopened on demand.
+ */
+void ldcRollingArenaCloseThreadRegions(LdcMemoryAllocatorRollingArena* arena);
+
 // Specializations of the memory macros that can be adjusted later to call directly into the arena code (which can then be inlined)
 
 /**! Helper for performing malloc for a single object. */
@@ -86,7 +107,7 @@ void ldcRollingArenaDestroy(LdcMemoryAllocatorRollingArena* arena);
     VNReallocateArray(allocator, allocation, type, count)
 
 /**! Helper for freeing an allocation performed with one of the above macros. */
-#define VNRollingArenaFree(allocator, allocation) VNRollingArenaFree(allocator, allocation)
+#define VNRollingArenaFree(allocator, allocation) VNFree(allocator, allocation)
 
 // Allocator definition and inline fast paths
 //
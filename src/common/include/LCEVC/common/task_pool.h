@@ -39,6 +39,7 @@ extern "C"
 typedef struct LdcTaskPool LdcTaskPool;
 typedef struct LdcTask LdcTask;
 typedef struct LdcTaskGroup LdcTaskGroup;
+typedef struct LdcTaskGraphTemplate LdcTaskGraphTemplate;
 
 /*! Passed to taskFunction to describe the task and which iterations it is responsible for.
  */
@@ -185,6 +186,9 @@ void ldcTaskNoWait(LdcTask* task);
 bool ldcTaskGroupInitialize(LdcTaskGroup* taskGroup, LdcTaskPool* taskPool, uint32_t maxDependenciesCount);
 
 /*! Release the task group
+ *
+ * Tasks that are still waiting for dependencies are dropped, and any that are ready or running
+ * are waited for - so this must not be called from one of the group's own tasks.
  *
  *  @param[in]      taskGroup        The TaskGroup to destroy.
  */
@@ -320,6 +324,22 @@ bool ldcTaskCollectInputs(const LdcTask* task, size_t numInputs, void** inputs);
  */
 LdcTaskDependency ldcTaskRemoveOutput(LdcTask* task);
 
+/*! Hints for how a sliced task is split into parts.
+ *
+ * Parts are handed out to worker threads as they become free, each taking a share of the work
+ * that remains, so the sizes of parts shrink towards the end of the task.
+ */
+typedef struct LdcTaskSliceHints
+{
+    // Smallest number of iterations in a part - the final part of a task may be smaller
+    uint32_t minGrain;
+    // Parts start on a multiple of this number of iterations - must be a power of 2, or 0
+    uint32_t alignment;
+    // If not NULL, returns the relative cost of an iteration - parts are then balanced by cost
+    // rather than by count. Called with the caller's argument whilst the task is added.
+    uint32_t (*weight)(const void* argument, uint32_t iteration);
+} LdcTaskSliceHints;
+
 /*! A number of slices - all given same base argument, with per-slide offset and count
  *
  *  Creates the task with the given group and output dependency, and returns immediately.
@@ -331,13 +351,15 @@ LdcTaskDependency ldcTaskRemoveOutput(LdcTask* task);
  *  @param[in]     argument     Data that is copied and passed as an argument to `function` and `completion`
  *  @param[in]     argumentSize Size in bytes of argument data to be copied.
  *  @param[in]     totalSize    Number of iterations for this task.
+ *  @param[in]     hints        If not NULL, hints for how the iterations are split into parts.
  *
  *  @return                     True if task was successfully created.
  */
 bool ldcTaskPoolAddSlicedDeferred(LdcTaskPool* pool, LdcTask* parent,
                                   bool (*function)(void* argument, uint32_t offset, uint32_t count),
                                   bool (*completion)(void* argument, uint32_t count),
-                                  void* argument, uint32_t argumentSize, uint32_t totalSize);
+                                  void* argument, uint32_t argumentSize, uint32_t totalSize,
+                                  const LdcTaskSliceHints* hints);
 
 /*! Block a task group - will stop new tasks being scheduled
  *
@@ -354,6 +376,59 @@ void ldcTaskGroupBlock(LdcTaskGroup* taskGroup);
  */
 void ldcTaskGroupUnblock(LdcTaskGroup* taskGroup);
 
+/*! Initialize an empty task graph template
+ *
+ * A template records the tasks and dependencies added to a group, so that the same graph can
+ * later be added to another group in a single operation.
+ *
+ *  @param[out]     graph       The template to initialize.
+ *  @param[in]      allocator   The memory allocator to use for recorded tasks.
+ */
+void ldcTaskGraphTemplateInitialize(LdcTaskGraphTemplate* graph, LdcMemoryAllocator* allocator);
+
+/*! Release all memory associated with a task graph template
+ *
+ *  @param[in]      graph       The template to destroy.
+ */
+void ldcTaskGraphTemplateDestroy(LdcTaskGraphTemplate* graph);
+
+/*! Start recording a task group into a template
+ *
+ * Any previous contents of the template are discarded. Until ldcTaskGroupRecordEnd(), every task
+ * added with ldcTaskGroupAdd() and every dependency added with ldcTaskDependencyAdd() is also
+ * appended to the template. Dependencies met whilst recording are not recorded.
+ *
+ *  @param[in]      taskGroup   The task group to record.
+ *  @param[in]      graph       The template to record into.
+ */
+void ldcTaskGroupRecordBegin(LdcTaskGroup* taskGroup, LdcTaskGraphTemplate* graph);
+
+/*! Stop recording a task group
+ *
+ *  @param[in]      taskGroup   The task group being recorded.
+ *
+ *  @return                     True if the template holds a complete recording.
+ */
+bool ldcTaskGroupRecordEnd(LdcTaskGroup* taskGroup);
+
+/*! Add all the tasks and dependencies of a recorded template to a group
+ *
+ * The group must have the same number of dependencies as the recorded group had when recording
+ * started. Everything is added under a single lock of the pool.
+ *
+ * The first `headerSize` bytes of each task's data are replaced with `header`, so tasks can be
+ * pointed at the state that they should work on for this instance of the graph.
+ *
+ *  @param[in]      taskGroup   The task group to add to.
+ *  @param[in]      graph       The recorded template.
+ *  @param[in]      header      Data to be placed at the start of each task's data.
+ *  @param[in]      headerSize  Size in bytes of header - must not exceed any recorded task data.
+ *
+ *  @return                     True if successful.
+ */
+bool ldcTaskGroupAddTemplate(LdcTaskGroup* taskGroup, const LdcTaskGraphTemplate* graph,
+                             const void* header, size_t headerSize);
+
 #ifdef VN_SDK_LOG_ENABLE_DEBUG
 
 /*! Utility function to dump state of task pool to log
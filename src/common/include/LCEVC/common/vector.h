@@ -80,6 +80,12 @@ static inline bool ldcVectorIsEmpty(const LdcVector* vector);
  */
 static inline uint32_t ldcVectorAppend(LdcVector* vector, const void* element);
 
+/*! Remove all elements from vector, keeping the reserved storage
+ *
+ * @param[in] vector            An initialized vector.
+ */
+static inline void ldcVectorClear(LdcVector* vector);
+
 /*! Remove element from vector by pointer, preserving order
  *
  * The addresses of remaining elements may change.
@@ -0,0 +1,176 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include <LCEVC/common/memory_tracker.h>
+//
+#include <LCEVC/common/check.h>
+#include <LCEVC/common/log.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/common/platform.h>
+#include <LCEVC/common/printf_macros.h>
+//
+#include <assert.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+// C++ code sees the counters as plain size_t
+static_assert(sizeof(LdcMemoryTrackerCounter) == sizeof(size_t),
+              "Memory tracker counters must be the size of size_t");
+
+static const LdcMemoryAllocatorFunctions kMemoryTrackerFunctions;
+
+// Raise a peak to `value` if it is lower.
+//
+static void memoryTrackerRaisePeak(LdcMemoryTrackerCounter* peak, size_t value)
+{
+    size_t previous = atomic_load_explicit(peak, memory_order_relaxed);
+    while (value > previous &&
+           !atomic_compare_exchange_weak_explicit(peak, &previous, value, memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+// Adjust the counters for a category after an allocation changes size from `before` to `after`.
+//
+// The counters are independent relaxed atomics, so a snapshot taken while other threads allocate
+// may not add up exactly - each counter is correct once those allocations return.
+//
+static void memoryTrackerAccount(LdcMemoryAllocator* allocator, size_t before, size_t after)
+{
+    LdcMemoryTracker* tracker = (LdcMemoryTracker*)allocator->allocatorData;
+    struct LdcMemoryTrackerCategory* category = (struct LdcMemoryTrackerCategory*)allocator;
+
+    if (after > before) {
+        const size_t delta = after - before;
+        const size_t current =
+            atomic_fetch_add_explicit(&category->current, delta, memory_order_relaxed) + delta;
+        const size_t total =
+            atomic_fetch_add_explicit(&tracker->total, delta, memory_order_relaxed) + delta;
+        memoryTrackerRaisePeak(&category->peak, current);
+        memoryTrackerRaisePeak(&tracker->totalPeak, total);
+    } else if (after < before) {
+        const size_t delta = before - after;
+        const size_t previousCurrent =
+            atomic_fetch_sub_explicit(&category->current, delta, memory_order_relaxed);
+        const size_t previousTotal =
+            atomic_fetch_sub_explicit(&tracker->total, delta, memory_order_relaxed);
+        assert(previousCurrent >= delta && previousTotal >= delta);
+        VNUnused(previousCurrent);
+        VNUnused(previousTotal);
+    }
+}
+
+static void* memoryTrackerAllocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
+                                   size_t size, size_t alignment)
+{
+    const LdcMemoryTracker* tracker = (const LdcMemoryTracker*)allocator->allocatorData;
+
+    void* ptr = tracker->parentAllocator->functions->allocate(tracker->parentAllocator, allocation,
+                                                              size, alignment);
+    if (ptr) {
+        memoryTrackerAccount(allocator, 0, allocation->size);
+    }
+    return ptr;
+}
+
+static void* memoryTrackerReallocate(LdcMemoryAllocator* allocator,
+                                     LdcMemoryAllocation* allocation, size_t size)
+{
+    const LdcMemoryTracker* tracker = (const LdcMemoryTracker*)allocator->allocatorData;
+
+    const size_t before = allocation->ptr ? allocation->size : 0;
+    void* ptr =
+        tracker->parentAllocator->functions->reallocate(tracker->parentAllocator, allocation, size);
+    const size_t after = allocation->ptr ? allocation->size : 0;
+
+    memoryTrackerAccount(allocator, before, after);
+    return ptr;
+}
+
+static void memoryTrackerFree(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation)
+{
+    const LdcMemoryTracker* tracker = (const LdcMemoryTracker*)allocator->allocatorData;
+
+    const size_t before = allocation->ptr ? allocation->size : 0;
+    tracker->parentAllocator->functions->free(tracker->parentAllocator, allocation);
+
+    memoryTrackerAccount(allocator, before, 0);
+}
+
+void ldcMemoryTrackerInitialize(LdcMemoryTracker* tracker, LdcMemoryAllocator* parentAllocator,
+                                uint32_t categoryCount, size_t budget)
+{
+    VNCheck(categoryCount <= kMemoryTrackerMaxCategories);
+
+    VNClear(tracker);
+    tracker->parentAllocator = parentAllocator;
+    tracker->budget = budget;
+    tracker->categoryCount = categoryCount;
+
+    for (uint32_t category = 0; category < categoryCount; ++category) {
+        tracker->categories[category].allocator.functions = &kMemoryTrackerFunctions;
+        tracker->categories[category].allocator.allocatorData = tracker;
+    }
+}
+
+void ldcMemoryTrackerDestroy(LdcMemoryTracker* tracker)
+{
+    const size_t total = atomic_load_explicit(&tracker->total, memory_order_relaxed);
+    if (total != 0) {
+        VNLogWarning("Memory tracker destroyed with %" PRIu64 " bytes still allocated",
+                     (uint64_t)total);
+    }
+}
+
+LdcMemoryAllocator* ldcMemoryTrackerAllocator(LdcMemoryTracker* tracker, uint32_t category)
+{
+    assert(category < tracker->categoryCount);
+    return &tracker->categories[category].allocator;
+}
+
+size_t ldcMemoryTrackerCurrent(LdcMemoryTracker* tracker, uint32_t category)
+{
+    assert(category < tracker->categoryCount);
+
+    return atomic_load_explicit(&tracker->categories[category].current, memory_order_relaxed);
+}
+
+size_t ldcMemoryTrackerPeak(LdcMemoryTracker* tracker, uint32_t category)
+{
+    assert(category < tracker->categoryCount);
+
+    return atomic_load_explicit(&tracker->categories[category].peak, memory_order_relaxed);
+}
+
+size_t ldcMemoryTrackerTotal(LdcMemoryTracker* tracker)
+{
+    return atomic_load_explicit(&tracker->total, memory_order_relaxed);
+}
+
+size_t ldcMemoryTrackerTotalPeak(LdcMemoryTracker* tracker)
+{
+    return atomic_load_explicit(&tracker->totalPeak, memory_order_relaxed);
+}
+
+size_t ldcMemoryTrackerBudget(const LdcMemoryTracker* tracker) { return tracker->budget; }
+
+bool ldcMemoryTrackerOverBudget(LdcMemoryTracker* tracker)
+{
+    return tracker->budget != 0 && ldcMemoryTrackerTotal(tracker) > tracker->budget;
+}
+
+/* Memory Allocator function table
+ */
+static const LdcMemoryAllocatorFunctions kMemoryTrackerFunctions = {
+    memoryTrackerAllocate, memoryTrackerReallocate, memoryTrackerFree};
@@ -20,12 +20,45 @@
 #include <LCEVC/common/threads.h>
 //
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <string.h>
 
 // Minimum alignment of allocations in bytes
 #define kMinAlignment 64
 
+// Locked allocations between sweeps for regions that have gone idle
+#define kRegionSweepInterval 64
+
+// Low bit of an allocation's allocatorData is set if it came from a region, in which case the rest
+// is the region pointer, otherwise the rest is the allocation index.
+#define kRegionTag 1
+
+// A region - lives at the start of the chunk of ring that it allocates from
+//
+typedef struct LdcRollingArenaRegion
+{
+    LdcMemoryAllocation chunk; // The arena allocation holding this region
+    atomic_uint references;    // Live allocations, plus one whilst the region is open
+    uint32_t offset;           // Next free byte in chunk - only touched by the slot owner
+} LdcRollingArenaRegion;
+
+#define kRegionHeaderSize VNAlignSize(sizeof(LdcRollingArenaRegion), kMinAlignment)
+
+// A thread's way into its current region - padded to avoid false sharing between threads
+//
+struct LdcRollingArenaRegionSlot
+{
+    atomic_uint busy;              // Set whilst a thread is using or sweeping the slot
+    uint32_t used;                 // Set on allocation, cleared by sweeps - protected by 'busy'
+    LdcRollingArenaRegion* region; // Open region, or NULL - protected by 'busy'
+    uint8_t padding[kMinAlignment - sizeof(atomic_uint) - sizeof(uint32_t) - sizeof(void*)];
+};
+
+// Each thread picks a region slot on its first region allocation, shared by all arenas
+static atomic_uint gRegionThreadCount;
+static VNThreadLocal() uint32_t tlRegionSlot;
+
 static const LdcMemoryAllocatorFunctions kRollingArenaFunctions;
 
 static void rollingArenaDoubleSlots(LdcMemoryAllocatorRollingArena* arena)
@@ -118,6 +151,12 @@ void ldcRollingArenaDestroy(LdcMemoryAllocatorRollingArena* arena)
 
     // Release slots
     VNFree(arena->parentAllocator, &arena->slotsAllocation);
+
+    // Regions live inside the buffers, so only the slots need releasing
+    if (arena->regionSlots) {
+        VNFree(arena->parentAllocator, &arena->regionSlotsAllocation);
+        arena->regionSlots = NULL;
+    }
 }
 
 static inline void* internalAllocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
@@ -149,8 +188,9 @@ static inline void* internalAllocate(LdcMemoryAllocator* allocator, LdcMemoryAll
             // Requested buffer will fit in remaining part of buffer
             offset = arena->bufferFront;
             arena->bufferFront = (arena->bufferFront + alignedSize) & arena->bufferMask;
-        } else if (freeSize >= alignedSize && arena->bufferBack >= alignedSize) {
-            // Requested buffer can fit at start of buffer
+        } else if (freeSize >= alignedSize && arena->bufferBack > alignedSize) {
+            // Requested buffer can fit at start of buffer - NB: must stop short of the back, or
+            // the buffer would look empty
             offset = 0;
             arena->bufferFront = (uint32_t)alignedSize;
         } else {
@@ -191,7 +231,7 @@ static inline void* internalAllocate(LdcMemoryAllocator* allocator, LdcMemoryAll
     // Fill in allocation
     allocation->ptr = ptr;
     allocation->size = (uint32_t)size;
-    allocation->allocatorData = allocationIndex;
+    allocation->allocatorData = (uintptr_t)allocationIndex << 1;
 
     return ptr;
 }
@@ -203,7 +243,8 @@ static inline void internalFree(LdcMemoryAllocator* allocator, LdcMemoryAllocati
     LdcMemoryAllocatorRollingArena* arena = (LdcMemoryAllocatorRollingArena*)allocator;
 
     // Get allocation's index and wrap it back into current slot ring buffer
-    const uint32_t allocationIndex = (uint32_t)allocation->allocatorData;
+    assert((allocation->allocatorData & kRegionTag) == 0);
+    const uint32_t allocationIndex = (uint32_t)(allocation->allocatorData >> 1);
     assert(allocationIndex >= arena->allocationIndexOldest);
     assert(allocationIndex < arena->allocationIndexNext);
 
@@ -250,17 +291,166 @@ static inline void internalFree(LdcMemoryAllocator* allocator, LdcMemoryAllocati
     }
 }
 
+// Regions
+//
+// Open a region in a new chunk of the ring - called with the arena mutex held
+static LdcRollingArenaRegion* regionOpen(LdcMemoryAllocatorRollingArena* arena)
+{
+    LdcMemoryAllocation chunk = {0};
+    LdcRollingArenaRegion* region = internalAllocate(&arena->allocator, &chunk, arena->regionSize);
+
+    region->chunk = chunk;
+    atomic_init(&region->references, 1);
+    region->offset = kRegionHeaderSize;
+    return region;
+}
+
+// Drop one reference to a region, releasing its chunk back to the ring on the last one
+static void regionRelease(LdcMemoryAllocatorRollingArena* arena, LdcRollingArenaRegion* region,
+                          bool locked)
+{
+    if (atomic_fetch_sub_explicit(&region->references, 1, memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    // NB: the chunk description lives in the chunk, so take a copy before freeing it
+    LdcMemoryAllocation chunk = region->chunk;
+    if (!locked) {
+        threadMutexLock(&arena->mutex);
+    }
+    internalFree(&arena->allocator, &chunk);
+    if (!locked) {
+        threadMutexUnlock(&arena->mutex);
+    }
+}
+
+// Close regions that have not been allocated from since the last sweep, so that an idle thread
+// does not hold the back of the ring - called with the arena mutex held
+static void regionSweep(LdcMemoryAllocatorRollingArena* arena, bool all)
+{
+    for (uint32_t idx = 0; idx < kRollingArenaMaxRegions; ++idx) {
+        struct LdcRollingArenaRegionSlot* regionSlot = &arena->regionSlots[idx];
+
+        // A slot in use is not idle
+        if (atomic_exchange_explicit(&regionSlot->busy, 1, memory_order_acquire)) {
+            continue;
+        }
+
+        if (regionSlot->region && (all || !regionSlot->used)) {
+            regionRelease(arena, regionSlot->region, true);
+            regionSlot->region = NULL;
+        }
+        regionSlot->used = 0;
+
+        atomic_store_explicit(&regionSlot->busy, 0, memory_order_release);
+    }
+}
+
+// Allocate from the calling thread's region - returns NULL if the caller should use the ring
+static void* regionAllocate(LdcMemoryAllocatorRollingArena* arena, LdcMemoryAllocation* allocation,
+                            size_t size)
+{
+    if (tlRegionSlot == 0) {
+        tlRegionSlot = atomic_fetch_add_explicit(&gRegionThreadCount, 1, memory_order_relaxed) + 1;
+    }
+
+    struct LdcRollingArenaRegionSlot* regionSlot =
+        &arena->regionSlots[(tlRegionSlot - 1) % kRollingArenaMaxRegions];
+
+    // Slot is shared with another thread that is using it, or being swept
+    if (atomic_exchange_explicit(&regionSlot->busy, 1, memory_order_acquire)) {
+        return NULL;
+    }
+
+    const uint32_t alignedSize = VNAlignSize((uint32_t)size, kMinAlignment);
+    LdcRollingArenaRegion* region = regionSlot->region;
+
+    if (!region || region->offset + alignedSize > arena->regionSize) {
+        // Swap for a new region
+        threadMutexLock(&arena->mutex);
+        if (region) {
+            regionRelease(arena, region, true);
+        }
+        region = regionOpen(arena);
+        regionSweep(arena, false);
+        threadMutexUnlock(&arena->mutex);
+
+        regionSlot->region = region;
+    }
+
+    void* ptr = (uint8_t*)region + region->offset;
+    region->offset += alignedSize;
+    atomic_fetch_add_explicit(&region->references, 1, memory_order_relaxed);
+    regionSlot->used = 1;
+
+    atomic_store_explicit(&regionSlot->busy, 0, memory_order_release);
+
+    allocation->ptr = ptr;
+    allocation->size = size;
+    allocation->allocatorData = (uintptr_t)region | kRegionTag;
+    return ptr;
+}
+
+bool ldcRollingArenaEnableThreadRegions(LdcMemoryAllocatorRollingArena* arena, uint32_t regionSize)
+{
+    assert(arena->allocationIndexNext == arena->allocationIndexOldest);
+    VNCheck(VNIsPowerOfTwo(regionSize));
+
+    if (regionSize <= kRegionHeaderSize || arena->regionSlots) {
+        return false;
+    }
+
+    arena->regionSlots =
+        VNAllocateAlignedZeroArray(arena->parentAllocator, &arena->regionSlotsAllocation,
+                                   struct LdcRollingArenaRegionSlot, kMinAlignment,
+                                   kRollingArenaMaxRegions);
+    if (!arena->regionSlots) {
+        return false;
+    }
+
+    arena->regionSize = regionSize;
+    arena->regionAllocationMax = (regionSize - (uint32_t)kRegionHeaderSize) / 4;
+    return true;
+}
+
+void ldcRollingArenaCloseThreadRegions(LdcMemoryAllocatorRollingArena* arena)
+{
+    if (!arena->regionSlots) {
+        return;
+    }
+
+    threadMutexLock(&arena->mutex);
+    regionSweep(arena, true);
+    threadMutexUnlock(&arena->mutex);
+}
+
+// Allocator functions
+//
 static void* rollingArenaAllocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
                                   size_t size, size_t alignment)
 {
     assert(allocator);
     assert(allocation);
     LdcMemoryAllocatorRollingArena* arena = (LdcMemoryAllocatorRollingArena*)allocator;
-    threadMutexLock(&arena->mutex);
 
     allocation->alignment = alignment;
+
+    // Small allocations come from the thread's region, if any
+    if (arena->regionSlots && size <= arena->regionAllocationMax && alignment <= kMinAlignment) {
+        void* ptr = regionAllocate(arena, allocation, size);
+        if (ptr) {
+            return ptr;
+        }
+    }
+
+    threadMutexLock(&arena->mutex);
+
     void* ptr = internalAllocate(allocator, allocation, size);
 
+    if (arena->regionSlots && (arena->allocationIndexNext % kRegionSweepInterval) == 0) {
+        regionSweep(arena, false);
+    }
+
     threadMutexUnlock(&arena->mutex);
     return ptr;
 }
@@ -270,6 +460,17 @@ static void rollingArenaFree(LdcMemoryAllocator* allocator, LdcMemoryAllocation*
     assert(allocator);
     assert(allocation);
     LdcMemoryAllocatorRollingArena* arena = (LdcMemoryAllocatorRollingArena*)allocator;
+
+    if (!VNIsAllocated(*allocation)) {
+        return;
+    }
+
+    if (allocation->allocatorData & kRegionTag) {
+        const uintptr_t region = allocation->allocatorData & ~(uintptr_t)kRegionTag;
+        regionRelease(arena, (LdcRollingArenaRegion*)region, false);
+        return;
+    }
+
     threadMutexLock(&arena->mutex);
 
     internalFree(allocator, allocation);
@@ -281,10 +482,35 @@ static void* rollingArenaReallocate(LdcMemoryAllocator* allocator, LdcMemoryAllo
                                     size_t size)
 {
     LdcMemoryAllocatorRollingArena* arena = (LdcMemoryAllocatorRollingArena*)allocator;
+
+    if (!VNIsAllocated(*allocation)) {
+        return rollingArenaAllocate(allocator, allocation, size, allocation->alignment);
+    }
+
+    if (allocation->allocatorData & kRegionTag) {
+        // Region allocations can only change size within their aligned extent
+        if (size <= VNAlignSize(allocation->size, kMinAlignment)) {
+            allocation->size = size;
+            return allocation->ptr;
+        }
+
+        const size_t preservedSize = (size < allocation->size) ? size : (allocation->size);
+
+        LdcMemoryAllocation newAllocation = {0};
+        uint8_t* const newPtr =
+            rollingArenaAllocate(allocator, &newAllocation, size, allocation->alignment);
+        VNCheck(newPtr);
+        memcpy(newPtr, allocation->ptr, preservedSize);
+
+        rollingArenaFree(allocator, allocation);
+        *allocation = newAllocation;
+        return newPtr;
+    }
+
     threadMutexLock(&arena->mutex);
 
     // Get slot number for this allocation
-    const uint32_t allocationIndex = (uint32_t)allocation->allocatorData;
+    const uint32_t allocationIndex = (uint32_t)(allocation->allocatorData >> 1);
     assert(allocationIndex >= arena->allocationIndexOldest);
     assert(allocationIndex < arena->allocationIndexNext);
     const uint32_t slot =
@@ -295,12 +521,13 @@ static void* rollingArenaReallocate(LdcMemoryAllocator* allocator, LdcMemoryAllo
     const uint32_t allocationOffset =
         (uint32_t)((uint8_t*)allocation->ptr - (uint8_t*)arena->buffers[buffer].memory.ptr);
 
-    // How much space is available in current allocation?
+    // How much space is available in current allocation? - it runs up to the slot's end, which is
+    // zero if it ends exactly at the end of the buffer. NB: an allocation that was wrapped to the
+    // start of the buffer also ends at the slot's end.
     size_t currentSize = 0;
-    if (arena->slots[slot].endOffset > arena->slots[slot].beginOffset) {
+    if (arena->slots[slot].endOffset != 0) {
         currentSize = arena->slots[slot].endOffset - allocationOffset;
     } else {
-        // Allocation wraps over buffer - only consider end to end of buffer
         currentSize = arena->buffers[buffer].memory.size - allocationOffset;
     }
 
@@ -38,12 +38,14 @@ static void scheduleTask(LdcTaskPool* pool, LdcTask* task, LdcTask** head);
 static void taskPoolDump(LdcTaskPool* pool, const LdcTaskGroup* group);
 #endif
 
-// Common task creation
+// Common task creation - fill in a new task, but do not schedule it
 //
-static LdcTask* addTask(LdcTaskPool* pool, LdcTaskGroup* group, const LdcTaskDependency* inputs,
-                        uint32_t inputsCount, LdcTaskDependency output, LdcTaskFunction function,
-                        LdcTaskFunction completion, uint32_t iterations, uint32_t maxIterationsPerPart,
-                        size_t dataSize, const void* data, const char* name)
+static LdcTask* allocateTask(LdcTaskPool* pool, LdcTaskGroup* group,
+                             const LdcTaskDependency* inputs, uint32_t inputsCount,
+                             LdcTaskDependency output, LdcTaskFunction function,
+                             LdcTaskFunction completion, uint32_t iterations,
+                             uint32_t maxIterationsPerPart, size_t dataSize, const void* data,
+                             const char* name)
 {
     assert(pool);
     assert(pool->running);
@@ -106,11 +108,80 @@ static LdcTask* addTask(LdcTaskPool* pool, LdcTaskGroup* group, const LdcTaskDep
     // Debugging Name
     task->name = name;
 
-    scheduleTask(pool, task, NULL);
+    return task;
+}
+
+static LdcTask* addTask(LdcTaskPool* pool, LdcTaskGroup* group, const LdcTaskDependency* inputs,
+                        uint32_t inputsCount, LdcTaskDependency output, LdcTaskFunction function,
+                        LdcTaskFunction completion, uint32_t iterations, uint32_t maxIterationsPerPart,
+                        size_t dataSize, const void* data, const char* name)
+{
+    LdcTask* task = allocateTask(pool, group, inputs, inputsCount, output, function, completion,
+                                 iterations, maxIterationsPerPart, dataSize, data, name);
+    if (task) {
+        scheduleTask(pool, task, NULL);
+    }
 
     return task;
 }
 
+// Append a task to a template that is being recorded
+//
+// NB: Called with task pool locked
+//
+static void recordTask(LdcTaskGraphTemplate* graph, const LdcTaskDependency* inputs,
+                       uint32_t inputsCount, LdcTaskDependency output, LdcTaskFunction function,
+                       LdcTaskFunction completion, uint32_t iterations,
+                       uint32_t maxIterationsPerPart, size_t dataSize, const void* data,
+                       const char* name)
+{
+    LdcMemoryAllocation allocation = {0};
+
+    dataSize = VNAlignSize(dataSize, sizeof(uint32_t));
+    LdcTaskTemplate* task = (LdcTaskTemplate*)VNAllocateZeroArray(
+        graph->allocator, &allocation, uint8_t,
+        sizeof(LdcTaskTemplate) + dataSize + sizeof(uint32_t) * inputsCount);
+
+    if (task == NULL) {
+        VNLogError("Cannot allocate task template.");
+        graph->failed = true;
+        return;
+    }
+
+    task->name = name;
+    task->taskFunction = function;
+    task->completionFunction = completion;
+    task->output = output;
+    task->inputsCount = inputsCount;
+    task->iterationsTotalCount = iterations;
+    task->maxIterationsPerPart = maxIterationsPerPart;
+    task->dataSize = dataSize;
+
+    if (dataSize) {
+        memcpy(task->data, data, dataSize);
+    }
+    if (inputsCount) {
+        memcpy(task->data + dataSize, inputs, sizeof(uint32_t) * inputsCount);
+    }
+
+    ldcVectorAppend(&graph->tasks, &allocation);
+}
+
+// Free all recorded tasks in a template
+//
+static void clearTemplate(LdcTaskGraphTemplate* graph)
+{
+    for (uint32_t i = 0; i < ldcVectorSize(&graph->tasks); ++i) {
+        VNFree(graph->allocator, (LdcMemoryAllocation*)ldcVectorAt(&graph->tasks, i));
+    }
+    ldcVectorClear(&graph->tasks);
+
+    graph->firstDependency = 0;
+    graph->dependenciesCount = 0;
+    graph->recorded = false;
+    graph->failed = false;
+}
+
 // Try to remove from head of list, given pointer to head
 //
 // NB: Called with task pool locked
@@ -313,6 +384,54 @@ static inline void runTask(LdcTaskPool* pool, LdcTaskPart* taskPart)
     }
 }
 
+// Turn a claim on a task into the next part of that task. Each part takes a share of the work
+// that is left (guided scheduling), so threads that finish early pick up more of the task and
+// the final parts are small. If there is more to do, the claim goes back on the front of the
+// ready deque for the next free worker.
+//
+// Task pool mutex should be locked at this point
+//
+static void claimTaskPart(LdcTaskPool* pool, LdcTaskPart* part)
+{
+    LdcTask* const task = part->task;
+    const uint32_t start = task->iterationsClaimedCount;
+    const uint32_t total = task->iterationsTotalCount;
+    assert(start < total);
+
+    uint32_t count = 0;
+    if (task->iterationCosts) {
+        // Find the first iteration at which this part's share of the remaining cost is reached
+        const uint64_t* costs = task->iterationCosts;
+        const uint64_t target = costs[start] + (costs[total] - costs[start]) / pool->threadCount;
+        uint32_t low = start + 1;
+        uint32_t high = total;
+        while (low < high) {
+            const uint32_t mid = low + (high - low) / 2;
+            if (costs[mid] >= target) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        count = low - start;
+    } else {
+        count = (total - start + pool->threadCount - 1) / pool->threadCount;
+    }
+
+    count = alignU32(maxU32(count, task->partGrain), task->partAlignment);
+    count = minU32(count, total - start);
+
+    part->start = start;
+    part->count = count;
+    task->iterationsClaimedCount = start + count;
+
+    if (task->iterationsClaimedCount < total) {
+        const LdcTaskPart claim = {task, 0, 0};
+        ldcDequeFrontPush(&pool->readyParts, &claim);
+        threadCondVarSignal(&pool->condVarReady);
+    }
+}
+
 // Task is ready to run
 //
 // Task pool mutex should be locked at this point
@@ -337,21 +456,11 @@ static inline void readyTask(LdcTaskPool* pool, LdcTask* task, bool grouped)
         if (task->iterationsTotalCount == 1) {
             // Simple task - single part
             part.count = task->iterationsTotalCount;
-            ldcDequeBackPush(&pool->readyParts, &part);
         } else {
-            // Split by number of threads
-            // NB: THis should really happen dynamically at thread level via work stealing
-            const uint32_t perPart =
-                (task->iterationsTotalCount + pool->threadCount - 1) / pool->threadCount;
-            uint32_t remaining = task->iterationsTotalCount;
-            while (remaining > 0) {
-                part.count = minU32(remaining, perPart);
-                ldcDequeBackPush(&pool->readyParts, &part);
-
-                part.start += part.count;
-                remaining -= part.count;
-            }
+            // Add a claim on the task - parts are sized by workers as they pick it up
+            part.count = 0;
         }
+        ldcDequeBackPush(&pool->readyParts, &part);
         threadCondVarBroadcast(&pool->condVarReady);
     } else {
         // Single threaded - run task now
@@ -464,6 +573,10 @@ static intptr_t taskThreadWorker(void* argument)
             // Wait for something to be ready ...
             threadCondVarWait(&pool->condVarReady, &pool->mutex);
         } else {
+            if (taskThread->part.count == 0) {
+                claimTaskPart(pool, &taskThread->part);
+            }
+
             // Run it
             runTask(pool, &taskThread->part);
             taskThread->part.task = NULL;
@@ -550,7 +663,7 @@ void ldcTaskPoolDestroy(struct LdcTaskPool* pool)
     // Release any remaining tasks
     //
     for (uint32_t task = 0; task < ldcVectorSize(&pool->tasks); ++task) {
-        VNFree(pool->longTermAllocator, ldcVectorAt(&pool->tasks, task));
+        VNFree(pool->shortTermAllocator, ldcVectorAt(&pool->tasks, task));
     }
 
     ldcVectorDestroy(&pool->tasks);
@@ -620,6 +733,11 @@ bool ldcTaskGroupAdd(LdcTaskGroup* group, const LdcTaskDependency* inputs, uint3
     LdcTask* task = addTask(group->pool, group, inputs, inputsCount, output, function, completion,
                             iterations, iterations, dataSize, data, name);
 
+    if (task && group->recording) {
+        recordTask(group->recording, inputs, inputsCount, output, function, completion, iterations,
+                   iterations, dataSize, data, name);
+    }
+
     threadMutexUnlock(&group->pool->mutex);
 
     if (!task) {
@@ -813,6 +931,18 @@ bool ldcTaskGroupInitialize(LdcTaskGroup* group, LdcTaskPool* pool, uint32_t dep
     return true;
 }
 
+// Remove a list of tasks that have not been scheduled to run
+//
+// NB: Called with task pool locked
+static void discardTasks(LdcTaskPool* pool, LdcTask** head)
+{
+    while (*head != NULL) {
+        LdcTask* const task = getNextTask(head);
+        pool->pendingTaskCount--;
+        removeTask(pool, task);
+    }
+}
+
 void ldcTaskGroupDestroy(struct LdcTaskGroup* group)
 {
     assert(group);
@@ -820,6 +950,20 @@ void ldcTaskGroupDestroy(struct LdcTaskGroup* group)
     LdcTaskPool* pool = group->pool;
     threadMutexLock(&pool->mutex);
 
+    // Tasks still waiting for dependencies, or blocked, can never run now - drop them, so that
+    // they do not stay in a pool that outlives the group.
+    for (uint32_t dependency = 0; dependency < group->dependenciesCount; ++dependency) {
+        discardTasks(pool, &group->waitingTasks[dependency]);
+    }
+    group->waitingTasksCount = 0;
+    discardTasks(pool, &group->blockedTasks);
+    group->blockedTasksCount = 0;
+
+    // Any others are ready or running - let them finish before the dependencies go
+    while (group->tasksCount != 0) {
+        threadCondVarWait(&pool->condVarCompleted, &pool->mutex);
+    }
+
     VNFree(pool->shortTermAllocator, &group->dependencyAllocation);
 
     group->pool = NULL;
@@ -943,6 +1087,11 @@ LdcTaskDependency ldcTaskDependencyAddMet(LdcTaskGroup* group, void* value)
     } else {
         taskGroupReserve(group, group->dependenciesReserved * 2);
     }
+    // Pre-met dependencies cannot be reproduced from a template
+    if (group->recording) {
+        group->recording->failed = true;
+    }
+
     // Mark dependency as set
     group->dependencyValues[dependency] = value;
     dependencyMetBitSet(group, dependency);
@@ -1104,7 +1253,8 @@ static void* taskWrapperSlicedDeferComplete(LdcTask* task, const LdcTaskPart* pa
 bool ldcTaskPoolAddSlicedDeferred(LdcTaskPool* pool, LdcTask* parent,
                                   bool (*function)(void* argument, uint32_t offset, uint32_t count),
                                   bool (*completion)(void* argument, uint32_t count),
-                                  void* argument, uint32_t argumentSize, uint32_t totalSize)
+                                  void* argument, uint32_t argumentSize, uint32_t totalSize,
+                                  const LdcTaskSliceHints* hints)
 {
     assert(pool);
 
@@ -1125,21 +1275,46 @@ bool ldcTaskPoolAddSlicedDeferred(LdcTaskPool* pool, LdcTask* parent,
         parent->output = kTaskDependencyInvalid;
     }
 
-    /// Append Sliced argument block onto the end of the task block
+    /// Append Sliced argument block onto the end of the task block, followed by the running
+    /// total of iteration costs if the caller has given them
+    const uint32_t costsOffset =
+        alignU32(sizeof(TaskWrapperSlicedDefer) + argumentSize, sizeof(uint64_t));
+    const bool hasCosts = hints && hints->weight;
     uint32_t dataSize = sizeof(TaskWrapperSlicedDefer) + argumentSize;
+    if (hasCosts) {
+        dataSize = costsOffset + (totalSize + 1) * sizeof(uint64_t);
+    }
     uint8_t* dataAllocation = alloca(dataSize);
     TaskWrapperSlicedDefer* data = (TaskWrapperSlicedDefer*)dataAllocation;
     data->function = function;
     data->completion = completion;
     memcpy(data->argument, argument, argumentSize);
 
+    if (hasCosts) {
+        uint64_t* costs = (uint64_t*)(dataAllocation + costsOffset);
+        costs[0] = 0;
+        for (uint32_t i = 0; i < totalSize; ++i) {
+            costs[i + 1] = costs[i] + hints->weight(argument, i);
+        }
+    }
+
     if (!parent) {
         threadMutexLock(&pool->mutex);
     }
 
-    LdcTask* task = addTask(pool, group, inputs, inputsCount, output, taskWrapperSlicedDefer,
-                            completion ? taskWrapperSlicedDeferComplete : NULL, totalSize,
-                            totalSize, dataSize, dataAllocation, "slicedDefer");
+    LdcTask* task = allocateTask(pool, group, inputs, inputsCount, output, taskWrapperSlicedDefer,
+                                 completion ? taskWrapperSlicedDeferComplete : NULL, totalSize,
+                                 totalSize, dataSize, dataAllocation, "slicedDefer");
+    if (task) {
+        if (hints) {
+            task->partGrain = hints->minGrain;
+            task->partAlignment = hints->alignment;
+        }
+        if (hasCosts) {
+            task->iterationCosts = (const uint64_t*)(task->data + costsOffset);
+        }
+        scheduleTask(pool, task, NULL);
+    }
 
     threadMutexUnlock(&pool->mutex);
 
@@ -1160,6 +1335,121 @@ bool ldcTaskPoolAddSlicedDeferred(LdcTaskPool* pool, LdcTask* parent,
     return true;
 }
 
+// Task graph templates
+//
+void ldcTaskGraphTemplateInitialize(LdcTaskGraphTemplate* graph, LdcMemoryAllocator* allocator)
+{
+    assert(graph);
+    assert(allocator);
+
+    VNClear(graph);
+    graph->allocator = allocator;
+    ldcVectorInitialize(&graph->tasks, sizeof(LdcMemoryAllocation), 32, allocator);
+}
+
+void ldcTaskGraphTemplateDestroy(LdcTaskGraphTemplate* graph)
+{
+    assert(graph);
+
+    clearTemplate(graph);
+    ldcVectorDestroy(&graph->tasks);
+}
+
+void ldcTaskGroupRecordBegin(LdcTaskGroup* group, LdcTaskGraphTemplate* graph)
+{
+    assert(group);
+    assert(group->pool);
+    assert(graph);
+    threadMutexLock(&group->pool->mutex);
+
+    assert(!group->recording);
+
+    clearTemplate(graph);
+    graph->firstDependency = group->dependenciesCount;
+    group->recording = graph;
+
+    threadMutexUnlock(&group->pool->mutex);
+}
+
+bool ldcTaskGroupRecordEnd(LdcTaskGroup* group)
+{
+    assert(group);
+    assert(group->pool);
+    threadMutexLock(&group->pool->mutex);
+
+    LdcTaskGraphTemplate* graph = group->recording;
+    assert(graph);
+
+    graph->dependenciesCount = group->dependenciesCount - graph->firstDependency;
+    graph->recorded = !graph->failed;
+    group->recording = NULL;
+
+    threadMutexUnlock(&group->pool->mutex);
+    return graph->recorded;
+}
+
+bool ldcTaskGroupAddTemplate(LdcTaskGroup* group, const LdcTaskGraphTemplate* graph,
+                             const void* header, size_t headerSize)
+{
+    assert(group);
+    assert(group->pool);
+    assert(graph);
+    assert(header || headerSize == 0);
+
+    if (!graph->recorded) {
+        return false;
+    }
+
+    LdcTaskPool* pool = group->pool;
+    threadMutexLock(&pool->mutex);
+
+    // Dependencies in the template are only valid if the group is in the same starting state
+    if (group->dependenciesCount != graph->firstDependency) {
+        threadMutexUnlock(&pool->mutex);
+        return false;
+    }
+
+    // Add all the dependencies at once
+    const uint32_t dependenciesCount = graph->firstDependency + graph->dependenciesCount;
+    uint32_t reserve = group->dependenciesReserved;
+    while (reserve < dependenciesCount) {
+        reserve *= 2;
+    }
+    if (reserve > group->dependenciesReserved) {
+        taskGroupReserve(group, reserve);
+    }
+    group->dependenciesCount = dependenciesCount;
+
+    // Create and schedule each task, with the instance header over the start of its data
+    bool r = true;
+    for (uint32_t i = 0; i < ldcVectorSize(&graph->tasks); ++i) {
+        const LdcMemoryAllocation* alloc = ldcVectorAt(&graph->tasks, i);
+        const LdcTaskTemplate* tt = VNAllocationPtr(*alloc, LdcTaskTemplate);
+        assert(headerSize <= tt->dataSize);
+
+        LdcTask* task = allocateTask(
+            pool, group, (const LdcTaskDependency*)(tt->data + tt->dataSize), tt->inputsCount,
+            tt->output, tt->taskFunction, tt->completionFunction, tt->iterationsTotalCount,
+            tt->maxIterationsPerPart, tt->dataSize, tt->data, tt->name);
+        if (!task) {
+            r = false;
+            break;
+        }
+
+        if (headerSize) {
+            memcpy(task->data, header, headerSize);
+        }
+
+        // Group tasks are never waited for
+        task->detached = true;
+
+        scheduleTask(pool, task, NULL);
+    }
+
+    threadMutexUnlock(&pool->mutex);
+    return r;
+}
+
 // Debugging
 //
 #ifdef VN_SDK_LOG_ENABLE_DEBUG
@@ -0,0 +1,160 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Several threads allocating and freeing small blocks from one rolling arena, each keeping a
+// window of live blocks as the pipeline does with per-frame data. Compares the locked path of the
+// arena with per-thread regions, and with taking each block from the heap, for increasing numbers
+// of threads.
+//
+// The arena's parent allocator counts the blocks it hands out, reported as "HeapAllocations" per
+// iteration, so the heap allocations that the arena saves can be read off against Source:0.
+//
+#include <benchmark/benchmark.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/common/rolling_arena.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kSlotCount = 512;
+constexpr uint32_t kCapacity = 1024 * 1024;
+constexpr uint32_t kRegionSize = 65536;
+
+constexpr uint32_t kAllocations = 20000;
+constexpr uint32_t kLive = 32;
+
+// Where the blocks come from
+enum class Source
+{
+    Heap,
+    Arena,
+    ArenaRegions,
+};
+
+// A malloc allocator that counts the blocks it allocates or reallocates
+struct CountingAllocator
+{
+    static void* allocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
+                          size_t size, size_t alignment)
+    {
+        LdcMemoryAllocator* const parent{ldcMemoryAllocatorMalloc()};
+        static_cast<CountingAllocator*>(allocator->allocatorData)->count++;
+        return parent->functions->allocate(parent, allocation, size, alignment);
+    }
+    static void* reallocate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
+                            size_t size)
+    {
+        LdcMemoryAllocator* const parent{ldcMemoryAllocatorMalloc()};
+        static_cast<CountingAllocator*>(allocator->allocatorData)->count++;
+        return parent->functions->reallocate(parent, allocation, size);
+    }
+    static void free(LdcMemoryAllocator* /*allocator*/, LdcMemoryAllocation* allocation)
+    {
+        LdcMemoryAllocator* const parent{ldcMemoryAllocatorMalloc()};
+        parent->functions->free(parent, allocation);
+    }
+
+    static constexpr LdcMemoryAllocatorFunctions kFunctions{allocate, reallocate, free};
+
+    LdcMemoryAllocator allocator{&kFunctions, this};
+    std::atomic<uint64_t> count{0};
+};
+
+// Arguments are the thread count, and the Source of blocks
+class RollingArenaFixture : public benchmark::Fixture
+{
+public:
+    void SetUp(const benchmark::State& state) override
+    {
+        ldcRollingArenaInitialize(&arena, &counting.allocator, kSlotCount, kCapacity);
+        source = static_cast<Source>(state.range(1));
+        if (source == Source::ArenaRegions) {
+            ldcRollingArenaEnableThreadRegions(&arena, kRegionSize);
+        }
+        // Count only what the benchmark allocates, not the arena's initial buffer
+        counting.count = 0;
+    }
+
+    void TearDown(const benchmark::State& /*state*/) override
+    {
+        if (source == Source::ArenaRegions) {
+            ldcRollingArenaCloseThreadRegions(&arena);
+        }
+        ldcRollingArenaDestroy(&arena);
+    }
+
+    // Allocate blocks of random sizes, freeing the oldest once the window is full
+    void allocateAndFree(uint32_t seed)
+    {
+        LdcMemoryAllocator* const allocator{source == Source::Heap ? &counting.allocator
+                                                                   : &arena.allocator};
+        std::minstd_rand gen(seed);
+        std::deque<LdcMemoryAllocation> live;
+
+        for (uint32_t i = 0; i < kAllocations; ++i) {
+            LdcMemoryAllocation allocation = {};
+            const uint32_t size = 16 + gen() % 512;
+            uint8_t* ptr = VNAllocateArray(allocator, &allocation, uint8_t, size);
+            ptr[0] = ptr[size - 1] = static_cast<uint8_t>(i);
+            live.push_back(allocation);
+
+            if (live.size() > kLive) {
+                VNFree(allocator, &live.front());
+                live.pop_front();
+            }
+        }
+        for (LdcMemoryAllocation& allocation : live) {
+            VNFree(allocator, &allocation);
+        }
+    }
+
+    CountingAllocator counting;
+    LdcMemoryAllocatorRollingArena arena = {};
+    Source source = Source::Heap;
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(RollingArenaFixture, Contention)(benchmark::State& state)
+{
+    const auto threadCount = static_cast<uint32_t>(state.range(0));
+    std::vector<std::thread> threads;
+
+    for (auto _ : state) {
+        for (uint32_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back(&RollingArenaFixture::allocateAndFree, this, t);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * threadCount * kAllocations);
+    state.counters["HeapAllocations"] = benchmark::Counter(
+        static_cast<double>(counting.count.load()), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_REGISTER_F(RollingArenaFixture, Contention)
+    ->ArgNames({"Threads", "Source"})
+    ->ArgsProduct({{1, 2, 4, 8},
+                   {static_cast<int64_t>(Source::Heap), static_cast<int64_t>(Source::Arena),
+                    static_cast<int64_t>(Source::ArenaRegions)}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
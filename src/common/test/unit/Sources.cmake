@@ -23,6 +23,7 @@ list(
     "src/test_diagnostics_c.c"
     "src/test_diagnostics_cpp.cpp"
     "src/test_memory.cpp"
+    "src/test_memory_tracker.cpp"
     "src/test_ring_buffer.cpp"
     "src/test_rolling_arena.cpp"
     "src/test_string_format.cpp"
@@ -0,0 +1,147 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include <gtest/gtest.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/common/memory_tracker.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr uint32_t kCategoryCount = 3;
+}
+
+class MemoryTrackerTest : public testing::Test
+{
+public:
+    MemoryTrackerTest()
+    {
+        ldcMemoryTrackerInitialize(&tracker, ldcMemoryAllocatorMalloc(), kCategoryCount, 4096);
+    }
+
+    ~MemoryTrackerTest() override { ldcMemoryTrackerDestroy(&tracker); }
+
+    MemoryTrackerTest(const MemoryTrackerTest&) = delete;
+    MemoryTrackerTest(MemoryTrackerTest&&) = delete;
+    void operator=(const MemoryTrackerTest&) = delete;
+    void operator=(MemoryTrackerTest&&) = delete;
+
+    LdcMemoryTracker tracker = {};
+};
+
+TEST_F(MemoryTrackerTest, Empty)
+{
+    for (uint32_t category = 0; category < kCategoryCount; ++category) {
+        EXPECT_EQ(ldcMemoryTrackerCurrent(&tracker, category), 0);
+        EXPECT_EQ(ldcMemoryTrackerPeak(&tracker, category), 0);
+    }
+    EXPECT_EQ(ldcMemoryTrackerTotal(&tracker), 0);
+    EXPECT_EQ(ldcMemoryTrackerBudget(&tracker), 4096);
+    EXPECT_FALSE(ldcMemoryTrackerOverBudget(&tracker));
+}
+
+TEST_F(MemoryTrackerTest, AllocateFree)
+{
+    LdcMemoryAllocator* allocator0 = ldcMemoryTrackerAllocator(&tracker, 0);
+    LdcMemoryAllocator* allocator2 = ldcMemoryTrackerAllocator(&tracker, 2);
+
+    LdcMemoryAllocation alloc0 = {};
+    LdcMemoryAllocation alloc2 = {};
+    EXPECT_NE(VNAllocateArray(allocator0, &alloc0, uint8_t, 100), nullptr);
+    EXPECT_NE(VNAllocateAlignedArray(allocator2, &alloc2, uint8_t, 64, 1000), nullptr);
+
+    EXPECT_EQ(ldcMemoryTrackerCurrent(&tracker, 0), 100);
+    EXPECT_EQ(ldcMemoryTrackerCurrent(&tracker, 1), 0);
+    EXPECT_EQ(ldcMemoryTrackerCurrent(&tracker, 2), 1000);
+    EXPECT_EQ(ldcMemoryTrackerTotal(&tracker), 1100);
+
+    VNFree(allocator2, &alloc2);
+    EXPECT_EQ(ldcMemoryTrackerCurrent(&tracker, 2), 0);
+    EXPECT_EQ(ldcMemoryTrackerPeak(&tracker, 2), 1000);
+    EXPECT_EQ(ldcMemoryTrackerTotal(&tracker), 100);
+    EXPECT_EQ(ldcMemoryTrackerTotalPeak(&tracker), 1100);
+
+    VNFree(allocator0, &alloc0);
+    EXPECT_EQ(ldcMemoryTrackerTotal(&tracker), 0);
+}
+
+TEST_F(MemoryTrackerTest, Reallocate)
+{
+    LdcMemoryAllocator* allocator = ldcMemoryTrackerAllocator(&tracker, 1);
+
+    LdcMemoryAllocation alloc = {};
+    uint32_t* ptr = VNAllocateArray(allocator, &alloc, uint32_t, 16);
+    ASSERT_NE(ptr, nullptr);
+    for (uint32_t i = 0; i < 16; ++i) {
+        ptr[i] = i;
+    }
+
+    ptr = VNReallocateArray(allocator, &alloc, uint32_t, 64);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(ptr[15], 15);
+    EXPECT_EQ(ldcMemoryTrackerCurrent(&tracker, 1), 64 * sizeof(uint32_t));
+
+    ptr = VNReallocateArray(allocator, &alloc, uint32_t, 8);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(ptr[7], 7);
+    EXPECT_EQ(ldcMemoryTrackerCurrent(&tracker, 1), 8 * sizeof(uint32_t));
+    EXPECT_EQ(ldcMemoryTrackerPeak(&tracker, 1), 64 * sizeof(uint32_t));
+
+    VNFree(allocator, &alloc);
+    EXPECT_EQ(ldcMemoryTrackerCurrent(&tracker, 1), 0);
+}
+
+TEST_F(MemoryTrackerTest, Budget)
+{
+    LdcMemoryAllocator* allocator = ldcMemoryTrackerAllocator(&tracker, 0);
+
+    LdcMemoryAllocation alloc1 = {};
+    LdcMemoryAllocation alloc2 = {};
+    EXPECT_NE(VNAllocateArray(allocator, &alloc1, uint8_t, 4096), nullptr);
+    EXPECT_FALSE(ldcMemoryTrackerOverBudget(&tracker));
+
+    // Going over budget does not fail the allocation
+    EXPECT_NE(VNAllocateArray(allocator, &alloc2, uint8_t, 1), nullptr);
+    EXPECT_TRUE(ldcMemoryTrackerOverBudget(&tracker));
+
+    VNFree(allocator, &alloc2);
+    EXPECT_FALSE(ldcMemoryTrackerOverBudget(&tracker));
+    VNFree(allocator, &alloc1);
+}
+
+TEST_F(MemoryTrackerTest, Threads)
+{
+    constexpr uint32_t kThreads = 4;
+    constexpr uint32_t kIterations = 1000;
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([this, t]() {
+            LdcMemoryAllocator* allocator = ldcMemoryTrackerAllocator(&tracker, t % kCategoryCount);
+            for (uint32_t i = 0; i < kIterations; ++i) {
+                LdcMemoryAllocation alloc = {};
+                VNAllocateArray(allocator, &alloc, uint8_t, 1 + (i % 256));
+                VNFree(allocator, &alloc);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(ldcMemoryTrackerTotal(&tracker), 0);
+    EXPECT_LE(ldcMemoryTrackerTotalPeak(&tracker), kThreads * 256);
+}
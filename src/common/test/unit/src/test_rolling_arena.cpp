@@ -23,6 +23,7 @@
 #include <climits>
 #include <deque>
 #include <random>
+#include <thread>
 #include <vector>
 
 template <uint32_t INITIAL_SLOT_COUNT, uint32_t INITIAL_CAPACITY>
@@ -39,7 +40,7 @@ public:
             ldcRollingArenaInitialize(&arena, runtimeAllocator, kInitialSlotCount, kInitialCapacity);
     }
 
-    ~RollingArena() override {}
+    ~RollingArena() override { ldcRollingArenaDestroy(&arena); }
 
     void checkEmpty() const
     {
@@ -412,6 +413,49 @@ TEST_F(RollingArenaSmall, AllocateAlignedNEON)
 }
 #endif
 
+// Allocations wrapped to the start of the buffer must not run up to, or grow over, the back
+TEST_F(RollingArenaSmall, WrapToBack)
+{
+    LdcMemoryAllocation first = {};
+    LdcMemoryAllocation second = {};
+    LdcMemoryAllocation wrapped = {};
+    LdcMemoryAllocation next = {};
+
+    VNAllocateArray(allocator, &first, uint8_t, 200);
+    uint8_t* secondPtr = VNAllocateArray(allocator, &second, uint8_t, 600);
+    memset(secondPtr, 42, second.size);
+    VNFree(allocator, &first);
+
+    // Would end exactly at the back of the buffer
+    memset(VNAllocateArray(allocator, &wrapped, uint8_t, 200), 1, 200);
+    memset(VNAllocateArray(allocator, &next, uint8_t, 100), 2, 100);
+    EXPECT_EQ(std::count(secondPtr, secondPtr + second.size, 42), 600);
+    VNFree(allocator, &next);
+    VNFree(allocator, &wrapped);
+    VNFree(allocator, &second);
+    checkEmpty();
+}
+
+TEST_F(RollingArenaSmall, ReallocateWrapped)
+{
+    LdcMemoryAllocation first = {};
+    LdcMemoryAllocation second = {};
+    LdcMemoryAllocation wrapped = {};
+
+    VNAllocateArray(allocator, &first, uint8_t, 200);
+    uint8_t* secondPtr = VNAllocateArray(allocator, &second, uint8_t, 600);
+    memset(secondPtr, 42, second.size);
+    VNFree(allocator, &first);
+
+    // Wraps to the start of the buffer, then grows past the space before the back
+    VNAllocateArray(allocator, &wrapped, uint8_t, 100);
+    memset(VNReallocateArray(allocator, &wrapped, uint8_t, 500), 1, 500);
+    EXPECT_EQ(std::count(secondPtr, secondPtr + second.size, 42), 600);
+    VNFree(allocator, &wrapped);
+    VNFree(allocator, &second);
+    checkEmpty();
+}
+
 using RollingArenaLarge = RollingArena<512, 1024 * 1024>;
 
 TEST_F(RollingArenaLarge, RandomAllocations)
@@ -530,3 +574,101 @@ TEST_F(RollingArenaLarge, RandomAllocations)
 
     VNUnused(allocTotal);
 }
+
+TEST_F(RollingArenaLarge, RegionAllocations)
+{
+    const uint32_t kCount = 1000;
+    ASSERT_TRUE(ldcRollingArenaEnableThreadRegions(&arena, 16384));
+
+    std::vector<LdcMemoryAllocation> allocations(kCount);
+    for (uint32_t i = 0; i < kCount; ++i) {
+        uint8_t* ptr = VNAllocateArray(allocator, &allocations[i], uint8_t, random(1000) + 1);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ((uintptr_t)ptr % 64, 0);
+        memset(ptr, static_cast<int>(i), allocations[i].size);
+    }
+
+    // Grow some past the largest region allocation, and check contents survive
+    for (uint32_t i = 0; i < kCount; i += 7) {
+        const size_t size = allocations[i].size;
+        uint8_t* ptr = VNReallocateArray(allocator, &allocations[i], uint8_t, size + 8000);
+        ASSERT_NE(ptr, nullptr);
+        for (size_t j = 0; j < size; ++j) {
+            ASSERT_EQ(ptr[j], static_cast<uint8_t>(i));
+        }
+    }
+
+    std::shuffle(allocations.begin(), allocations.end(), gen);
+    for (LdcMemoryAllocation& allocation : allocations) {
+        VNFree(allocator, &allocation);
+    }
+
+    // The open region still holds its chunk
+    ldcRollingArenaCloseThreadRegions(&arena);
+    checkEmpty();
+}
+
+// Many threads allocating and freeing small blocks, each checking that its oldest block is intact
+// before freeing it. The timing comparison of the two paths is in the common benchmarks.
+//
+static void rollingArenaContention(LdcMemoryAllocatorRollingArena* arena, uint32_t threadCount)
+{
+    constexpr uint32_t kIterations = 20000;
+    constexpr uint32_t kLive = 32;
+
+    std::vector<std::thread> threads;
+    std::vector<std::deque<LdcMemoryAllocation>> remaining(threadCount);
+
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([arena, t, &remaining]() {
+            std::minstd_rand gen(t);
+            std::deque<LdcMemoryAllocation>& live = remaining[t];
+
+            for (uint32_t i = 0; i < kIterations; ++i) {
+                LdcMemoryAllocation allocation = {};
+                const uint32_t size = 16 + gen() % 512;
+                uint8_t* ptr = VNAllocateArray(&arena->allocator, &allocation, uint8_t, size);
+                ptr[0] = ptr[size - 1] = static_cast<uint8_t>(i);
+                live.push_back(allocation);
+
+                if (live.size() > kLive) {
+                    LdcMemoryAllocation& oldest = live.front();
+                    const uint8_t* oldPtr = static_cast<const uint8_t*>(oldest.ptr);
+                    EXPECT_EQ(oldPtr[0], static_cast<uint8_t>(i - kLive));
+                    EXPECT_EQ(oldPtr[oldest.size - 1], static_cast<uint8_t>(i - kLive));
+                    VNFree(&arena->allocator, &oldest);
+                    live.pop_front();
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Free the rest from this thread
+    for (std::deque<LdcMemoryAllocation>& live : remaining) {
+        for (LdcMemoryAllocation& allocation : live) {
+            VNFree(&arena->allocator, &allocation);
+        }
+    }
+}
+
+TEST_F(RollingArenaLarge, Contention)
+{
+    constexpr uint32_t kThreads = 8;
+
+    LdcMemoryAllocatorRollingArena regionArena;
+    ldcRollingArenaInitialize(&regionArena, runtimeAllocator, kInitialSlotCount, kInitialCapacity);
+    ASSERT_TRUE(ldcRollingArenaEnableThreadRegions(&regionArena, 65536));
+
+    rollingArenaContention(&arena, kThreads);
+    rollingArenaContention(&regionArena, kThreads);
+
+    checkEmpty();
+
+    ldcRollingArenaCloseThreadRegions(&regionArena);
+    EXPECT_EQ(regionArena.slotFront, regionArena.slotBack);
+    EXPECT_EQ(regionArena.bufferFront, regionArena.bufferBack);
+    ldcRollingArenaDestroy(&regionArena);
+}
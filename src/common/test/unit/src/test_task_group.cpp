@@ -85,3 +85,59 @@ TEST(TaskGroup, DependencyReserveGrowth)
     ldcTaskGroupDestroy(&group);
     ldcTaskPoolDestroy(&pool);
 }
+
+TEST(TaskGroup, TemplateRecordAndAdd)
+{
+    const uint32_t kNumTasks = 8;
+
+    LdcTaskPool pool;
+    ASSERT_TRUE(ldcTaskPoolInitialize(&pool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(), 2, 8));
+
+    LdcTaskGraphTemplate graph;
+    ldcTaskGraphTemplateInitialize(&graph, ldcMemoryAllocatorMalloc());
+
+    // Record a chain of increments, where each task's data value is its position in the chain
+    LdcTaskGroup recordGroup;
+    ASSERT_TRUE(ldcTaskGroupInitialize(&recordGroup, &pool, 4));
+    const LdcTaskDependency input = ldcTaskDependencyAdd(&recordGroup);
+
+    ldcTaskGroupRecordBegin(&recordGroup, &graph);
+    LdcTaskDependency dep = input;
+    for (uint32_t i = 0; i < kNumTasks; ++i) {
+        IncData data{static_cast<int>(i)};
+        const LdcTaskDependency out = ldcTaskDependencyAdd(&recordGroup);
+        EXPECT_TRUE(ldcTaskGroupAdd(&recordGroup, &dep, 1, out, incTask, NULL, 1, 1, sizeof(data),
+                                    &data, "inc"));
+        dep = out;
+    }
+    const LdcTaskDependency output = dep;
+    EXPECT_TRUE(ldcTaskGroupRecordEnd(&recordGroup));
+
+    ldcTaskDependencyMet(&recordGroup, input, intToPtr(0));
+    EXPECT_EQ(ptrToInt(ldcTaskDependencyWait(&recordGroup, output)), 28);
+
+    ldcTaskGroupWait(&recordGroup);
+    ldcTaskGroupDestroy(&recordGroup);
+
+    // Instantiate into a new group with a header that replaces each task's value
+    LdcTaskGroup group;
+    ASSERT_TRUE(ldcTaskGroupInitialize(&group, &pool, 4));
+    EXPECT_EQ(ldcTaskDependencyAdd(&group), input);
+
+    const IncData header{10};
+    EXPECT_TRUE(ldcTaskGroupAddTemplate(&group, &graph, &header, sizeof(header)));
+    EXPECT_EQ(group.dependenciesCount, kNumTasks + 1);
+
+    ldcTaskDependencyMet(&group, input, intToPtr(1));
+    EXPECT_EQ(ptrToInt(ldcTaskDependencyWait(&group, output)), 1 + 10 * kNumTasks);
+
+    ldcTaskGroupWait(&group);
+    EXPECT_EQ(ldcTaskGroupGetTaskCount(&group, NULL), 0);
+
+    // Group with a different starting set of dependencies cannot use the template
+    EXPECT_FALSE(ldcTaskGroupAddTemplate(&group, &graph, &header, sizeof(header)));
+
+    ldcTaskGroupDestroy(&group);
+    ldcTaskGraphTemplateDestroy(&graph);
+    ldcTaskPoolDestroy(&pool);
+}
@@ -445,6 +445,32 @@ TEST_P(TaskPoolTest, TaskGroupTree)
     ldcTaskGroupDestroy(&group);
 }
 
+TEST_P(TaskPoolTest, TaskGroupDestroyPending)
+{
+    LdcTaskGroup group;
+
+    EXPECT_TRUE(ldcTaskGroupInitialize(&group, &taskPool, 10));
+
+    // One task that runs, and two behind an input that is never met
+    LdcTaskDependency in1 = ldcTaskDependencyAddMet(&group, intToVoidPtr(2));
+    LdcTaskDependency out1 = ldcTaskDependencyAdd(&group);
+    TaskData task1Data = {3};
+    ldcTaskGroupAdd(&group, &in1, 1, out1, groupTask, NULL, 1, 1, sizeof(task1Data), &task1Data, "test1");
+
+    LdcTaskDependency in2 = ldcTaskDependencyAdd(&group);
+    LdcTaskDependency out2 = ldcTaskDependencyAdd(&group);
+    TaskData task2Data = {5};
+    ldcTaskGroupAdd(&group, &in2, 1, out2, groupTask, NULL, 1, 1, sizeof(task2Data), &task2Data, "test2");
+    LdcTaskDependency out3 = ldcTaskDependencyAdd(&group);
+    ldcTaskGroupAdd(&group, &out2, 1, out3, groupTask, NULL, 1, 1, sizeof(task2Data), &task2Data, "test3");
+
+    // Destroying the group waits for the running task, and drops the waiting ones
+    ldcTaskGroupDestroy(&group);
+
+    EXPECT_EQ(taskPool.tasks.size, 0);
+    EXPECT_EQ(taskPool.pendingTaskCount, 0);
+}
+
 INSTANTIATE_TEST_SUITE_P(TaskPool, TaskPoolTest,
                          testing::Values(
                              // clang-format off
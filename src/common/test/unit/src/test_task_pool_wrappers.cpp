@@ -24,6 +24,8 @@
 #include <cstdio>
 #include <mutex>
 #include <set>
+#include <utility>
+#include <vector>
 
 struct TestParam
 {
@@ -45,6 +47,7 @@ public:
     std::atomic<uint32_t> callCount;
     std::set<uint32_t> calledSet;
     std::set<uint32_t> completedSet;
+    std::vector<std::pair<uint32_t, uint32_t>> parts;
     std::mutex mutex;
 
     TaskPoolWrapperTest()
@@ -115,8 +118,8 @@ TEST_P(TaskPoolWrapperTest, Sliced)
     const uint32_t count = GetParam().count;
     SlicedTaskData data = {this, 0xf00dfade, count};
 
-    const bool r =
-        ldcTaskPoolAddSlicedDeferred(&taskPool, NULL, slicedFn, NULL, &data, sizeof(data), count);
+    const bool r = ldcTaskPoolAddSlicedDeferred(&taskPool, NULL, slicedFn, NULL, &data,
+                                                sizeof(data), count, NULL);
     EXPECT_EQ(taskPool.pendingTaskCount, 0);
     EXPECT_TRUE(r);
 
@@ -133,7 +136,7 @@ TEST_P(TaskPoolWrapperTest, SlicedWithCompletion)
     SlicedTaskData data = {this, 0xf00dfade, count};
 
     const bool r = ldcTaskPoolAddSlicedDeferred(&taskPool, NULL, slicedFn, completionFn, &data,
-                                                sizeof(data), count);
+                                                sizeof(data), count, NULL);
 
     EXPECT_EQ(taskPool.pendingTaskCount, 0);
     EXPECT_TRUE(r);
@@ -151,6 +154,50 @@ TEST_P(TaskPoolWrapperTest, SlicedWithCompletion)
     }
 }
 
+static bool slicedPartFn(void* argument, uint32_t offset, uint32_t count)
+{
+    const SlicedTaskData& data = *(SlicedTaskData*)argument;
+    TaskPoolWrapperTest* self = data.self;
+
+    {
+        std::scoped_lock lock(self->mutex);
+        self->parts.emplace_back(offset, count);
+    }
+    return slicedFn(argument, offset, count);
+}
+
+static uint32_t slicedWeightFn(const void* argument, uint32_t iteration)
+{
+    EXPECT_NE(argument, nullptr);
+    // Heavy work at the start of the task
+    return iteration < 16 ? 100 : 1;
+}
+
+TEST_P(TaskPoolWrapperTest, SlicedWithHints)
+{
+    const uint32_t count = GetParam().count;
+    SlicedTaskData data = {this, 0xf00dfade, count};
+    const LdcTaskSliceHints hints = {3, 4, slicedWeightFn};
+
+    const bool r = ldcTaskPoolAddSlicedDeferred(&taskPool, NULL, slicedPartFn, completionFn, &data,
+                                                sizeof(data), count, &hints);
+    EXPECT_EQ(taskPool.pendingTaskCount, 0);
+    EXPECT_TRUE(r);
+
+    // visited whole domain?
+    EXPECT_EQ(calledSet.size(), count);
+    EXPECT_EQ(completedSet.size(), count);
+
+    // Parts are aligned, and no smaller than the grain unless they finish the task
+    for (const auto& [offset, partCount] : parts) {
+        EXPECT_EQ(offset % 4, 0);
+        if (offset + partCount < count) {
+            EXPECT_GE(partCount, 3);
+            EXPECT_EQ(partCount % 4, 0);
+        }
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(TaskPoolWrapper, TaskPoolWrapperTest,
                          testing::Values(
                              // clang-format off
@@ -29,6 +29,7 @@ list(
     "src/dimensions.c"
     "src/entropy.c"
     "src/huffman.c"
+    "src/huffman_cache.c"
     "src/log_utilities.c"
     "src/tile_parser.c"
     "src/transform.c"
@@ -62,6 +63,7 @@ list(
     "include/LCEVC/enhancement/decode.h"
     "include/LCEVC/enhancement/dimensions.h"
     "include/LCEVC/enhancement/hdr_types.h"
+    "include/LCEVC/enhancement/huffman_cache.h"
     "include/LCEVC/enhancement/transform_unit.h")
 
 set(ALL_FILES ${SOURCES} ${HEADERS} ${INTERFACES} "Sources.cmake")
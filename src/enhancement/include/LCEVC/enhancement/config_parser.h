@@ -70,6 +70,26 @@ void ldeConfigReset(LdeFrameConfig* frameConfig);
 bool ldeConfigsParse(const uint8_t* serialized, size_t serializedSize, LdeGlobalConfig* globalConfig,
                      LdeFrameConfig* frameConfig, bool* globalConfigModified);
 
+/*! \brief Parse a serialized frame to config structs without copying the enhancement data.
+ *
+ * Emulation prevention bytes are removed in place, or not at all if the caller has tagged the data
+ * as already unescaped. The resulting chunks point into `serialized`, so the caller must keep it
+ * valid and unmodified until the frame config is released.
+ *
+ * \param[inout]  serialized           Serialised NAL unit to deserialize, modified in place.
+ * \param[in]     serializedSize       Byte size of the serialized data.
+ * \param[in]     unescaped            True if emulation prevention bytes have already been removed
+ *                                     from the NAL unit payload.
+ * \param[inout]  globalConfig         As for ldeConfigsParse
+ * \param[inout]  frameConfig          As for ldeConfigsParse
+ * \param[out]    globalConfigModified Output flag if the input global config was modified
+ *
+ * \return True on success, otherwise false.
+ */
+bool ldeConfigsParseInPlace(uint8_t* serialized, size_t serializedSize, bool unescaped,
+                            LdeGlobalConfig* globalConfig, LdeFrameConfig* frameConfig,
+                            bool* globalConfigModified);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,7 @@ typedef struct LdeConfigPool
 {
     LdcMemoryAllocator* allocator;
     LdcVector globalConfigs;             /**< Active global configs of in-flight frames */
+    LdcVector chunkArrays; /**< Chunk allocations from released frames, for re-use by later frames */
     LdeGlobalConfig* latestGlobalConfig; /**< Most recent global config, the last element in the vector */
     LdeQuantMatrix quantMatrix; /**< State between frames in the LdeFrameConfig, this parameter is used to hold the latest */
     bool ditherEnabled; /**< State between frames in the LdeFrameConfig, holds the last dither enabled state - other dithering params are then parsed */
@@ -55,8 +56,9 @@ void ldeConfigPoolRelease(LdeConfigPool* configPool);
  *         the unprocessed data and returns pointers to a frame config and a global config.
  *         Importantly data must be in timestamp order - this is not checked at this stage, use the
  *         sequencer module for out of order serialized packets. Global configs are internally
- *         re-used until a change is detected. If a duplicate and unreleased timestamp is given,
- *         pre-processed configs will be returned.
+ *         re-used until a change is detected, and a changed global config that is identical to
+ *         one still referenced by an unreleased frame is shared rather than duplicated. If a
+ *         duplicate and unreleased timestamp is given, pre-processed configs will be returned.
  *
  * \param[in]     configPool     Initialized config pool
  * \param[in]     timestamp      Timestamp of new frame
@@ -72,12 +74,32 @@ bool ldeConfigPoolFrameInsert(LdeConfigPool* configPool, uint64_t timestamp,
                               const uint8_t* serialized, size_t serializedSize,
                               LdeGlobalConfig** globalConfig, LdeFrameConfig* frameConfig);
 
+/*! \brief As ldeConfigPoolFrameInsert, but the serialized data is parsed without being copied.
+ *         Emulation prevention bytes are removed in place unless `unescaped` is set. The frame
+ *         config's chunks point into `serialized`, which must outlive the frame config.
+ *
+ * \param[in]     configPool     Initialized config pool
+ * \param[in]     timestamp      Timestamp of new frame
+ * \param[inout]  serialized     Pointer to serialized frame, owned by the caller
+ * \param[in]     serializedSize Size of serialized frame
+ * \param[in]     unescaped      True if emulation prevention bytes have already been removed
+ * \param[out]    globalConfig   Output pointer to global config
+ * \param[out]    frameConfig    Output pointer to frame config
+ *
+ * \return True on success, otherwise false
+ */
+bool ldeConfigPoolFrameInsertInPlace(LdeConfigPool* configPool, uint64_t timestamp,
+                                     uint8_t* serialized, size_t serializedSize, bool unescaped,
+                                     LdeGlobalConfig** globalConfig, LdeFrameConfig* frameConfig);
+
 /*! \brief Release a frame from the pool by its timestamp. Removes the frame config from the pool
- *         and the global config if it is not in use by other unreleased frames
+ *         and the global config if it is not in use by other unreleased frames. The frame's chunk
+ *         array is kept by the pool for re-use by subsequent frames.
  *
  * \param[in]     configPool     Initialized config pool
  * \param[in]     frameConfig    The frame config pointer passed to a previous ldeConfigPoolFrameInsert() call
- * \param[in]     globalConfig   The global config pointer returned by a previous ldeConfigPoolFrameInsert() call
+ * \param[in]     globalConfig   The global config pointer returned by a previous ldeConfigPoolFrameInsert() call,
+ *                               or NULL if the frame was never inserted
  *
  * \return True on success, otherwise false
  */
@@ -18,6 +18,7 @@
 #include <LCEVC/enhancement/cmdbuffer_cpu.h>
 #include <LCEVC/enhancement/cmdbuffer_gpu.h>
 #include <LCEVC/enhancement/config_types.h>
+#include <LCEVC/enhancement/huffman_cache.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -39,13 +40,83 @@ extern "C"
  * \param[out]    cmdBufferCpu      Pointer to an initialized and reset CPU cmdBuffer or nullptr
  * \param[out]    cmdBufferGpu      Pointer to an initialized and reset GPU cmdBuffer or nullptr
  * \param[in]     cmdBufferBuilder  Pointer to an initialized and reset GPU cmdBuffer builder or nullptr
+ * \param[inout]  huffmanCache      Cache of built Huffman decoders, which may be shared between
+ *                                  tiles and frames decoded concurrently, or nullptr
  *
  * \return True on success, otherwise false.
  */
 bool ldeDecodeEnhancement(const LdeGlobalConfig* globalConfig, const LdeFrameConfig* frameConfig,
                           const LdeLOQIndex loq, const uint32_t planeIdx, const uint32_t tileIdx,
                           LdeCmdBufferCpu* cmdBufferCpu, LdeCmdBufferGpu* cmdBufferGpu,
-                          LdeCmdBufferGpuBuilder* cmdBufferBuilder);
+                          LdeCmdBufferGpuBuilder* cmdBufferBuilder, LdeHuffmanCache* huffmanCache);
+
+/*! \brief A decoded coefficient followed by the number of zero coefficients after it. */
+typedef struct LdeCoeffRun
+{
+    int32_t zeros;
+    int16_t value;
+} LdeCoeffRun;
+
+/*! \brief Entropy decoded coefficients of each layer of a single loq-plane-tile, stored as runs so
+ *         that the layers can be decoded independently of each other. */
+typedef struct LdeLayerRuns
+{
+    LdcMemoryAllocator* allocator;
+    LdcMemoryAllocation allocations[RCLayerCountDDS];
+    uint32_t counts[RCLayerCountDDS];
+} LdeLayerRuns;
+
+/*! \brief Initialize an empty set of layer runs.
+ *
+ * \param[in]     allocator         Memory allocator for the run arrays
+ * \param[out]    layerRuns         Layer runs to initialize
+ */
+void ldeLayerRunsInitialize(LdcMemoryAllocator* allocator, LdeLayerRuns* layerRuns);
+
+/*! \brief Release the run arrays of each layer.
+ *
+ * \param[in]     layerRuns         Layer runs to release
+ */
+void ldeLayerRunsFree(LdeLayerRuns* layerRuns);
+
+/*! \brief Entropy decode one layer of a single loq-plane-tile into runs. Each layer has its own
+ *         chunk, so different layers of the same tile may be decoded concurrently into the same
+ *         layer runs. Once all layers are decoded, use ldeDecodeEnhancementFromLayers to produce
+ *         the cmdbuffer.
+ *
+ * \param[in]     globalConfig      Pointer to global config
+ * \param[in]     frameConfig       Pointer to frame config - valid within the global config
+ * \param[in]     loq               LOQ to decode - either LOQ1 or LOQ0
+ * \param[in]     planeIdx          Plane to decode
+ * \param[in]     tileIdx           Tile to decode within the frame if using a tiled stream else 0
+ * \param[in]     layerIdx          Layer to decode, less than the global config's numLayers
+ * \param[inout]  huffmanCache      Cache of built Huffman decoders or nullptr
+ * \param[out]    layerRuns         Initialized layer runs, only the layerIdx entry is written
+ *
+ * \return True on success, otherwise false.
+ */
+bool ldeDecodeLayer(const LdeGlobalConfig* globalConfig, const LdeFrameConfig* frameConfig,
+                    const LdeLOQIndex loq, const uint32_t planeIdx, const uint32_t tileIdx,
+                    const uint32_t layerIdx, LdeHuffmanCache* huffmanCache,
+                    LdeLayerRuns* layerRuns);
+
+/*! \brief As ldeDecodeEnhancement, but taking the residual coefficients from layer runs that have
+ *         already been decoded by ldeDecodeLayer for every layer of the same loq-plane-tile. The
+ *         temporal layer is still decoded here. The output is identical to ldeDecodeEnhancement.
+ *
+ * \param[in]     layerRuns         Decoded layer runs of this loq-plane-tile
+ *
+ * Other parameters are as ldeDecodeEnhancement.
+ *
+ * \return True on success, otherwise false.
+ */
+bool ldeDecodeEnhancementFromLayers(const LdeGlobalConfig* globalConfig,
+                                    const LdeFrameConfig* frameConfig, const LdeLOQIndex loq,
+                                    const uint32_t planeIdx, const uint32_t tileIdx,
+                                    const LdeLayerRuns* layerRuns, LdeCmdBufferCpu* cmdBufferCpu,
+                                    LdeCmdBufferGpu* cmdBufferGpu,
+                                    LdeCmdBufferGpuBuilder* cmdBufferBuilder,
+                                    LdeHuffmanCache* huffmanCache);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,76 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#ifndef VN_LCEVC_ENHANCEMENT_HUFFMAN_CACHE_H
+#define VN_LCEVC_ENHANCEMENT_HUFFMAN_CACHE_H
+
+#include <LCEVC/common/memory.h>
+#include <LCEVC/common/threads.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*! Default number of built decoders held by a Huffman cache */
+#define kHuffmanCacheDefaultCapacity 16
+
+/*! Bounded cache of fully built Huffman decoders, keyed by the code-length headers at the start of
+ *  each chunk. Encoders usually signal the same tables for every tile and frame, so a decoder can
+ *  be used from the cache instead of being rebuilt. Entries are not replaced whilst a decoder is
+ *  using them. The cache may be shared between threads decoding different tiles, and between
+ *  frames. */
+typedef struct LdeHuffmanCache
+{
+    LdcMemoryAllocator* allocator;
+    LdcMemoryAllocation entriesAllocation; /**< `capacity` entries, private to the cache */
+    uint32_t capacity;
+    uint64_t useCounter; /**< Incremented on each hit or insert, for least recently used eviction */
+    uint64_t hits;
+    uint64_t misses;
+    ThreadMutex mutex; /**< Held over lookups, and reference and replacement bookkeeping */
+} LdeHuffmanCache;
+
+/*! \brief Initialize an empty Huffman cache.
+ *
+ * \param[in]     allocator      Memory allocator for the cache entries
+ * \param[out]    cache          Cache to initialize
+ * \param[in]     capacity       Maximum number of built decoders to hold, must be non-zero
+ *
+ * \return True on success, otherwise false.
+ */
+bool ldeHuffmanCacheInitialize(LdcMemoryAllocator* allocator, LdeHuffmanCache* cache,
+                               uint32_t capacity);
+
+/*! \brief Release all memory associated with the cache.
+ *
+ * \param[in]     cache          Initialized cache
+ */
+void ldeHuffmanCacheRelease(LdeHuffmanCache* cache);
+
+/*! \brief Read the number of lookups that found, and did not find, a built decoder.
+ *
+ * \param[in]     cache          Initialized cache
+ * \param[out]    hits           Number of decoders found in the cache, may be NULL
+ * \param[out]    misses         Number of decoders built and inserted into the cache, may be NULL
+ */
+void ldeHuffmanCacheGetStats(LdeHuffmanCache* cache, uint64_t* hits, uint64_t* misses);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VN_LCEVC_ENHANCEMENT_HUFFMAN_CACHE_H
@@ -18,56 +18,6 @@
 
 /*------------------------------------------------------------------------------*/
 
-/*! \brief Helper function to load a new DWORD from the bytestream. */
-static inline bool loadWord(BitStream* stream)
-{
-    const size_t remaining = bytestreamRemaining(&stream->byteStream);
-
-    if (remaining <= 0) {
-        return false;
-    }
-
-    if (remaining >= 4) {
-        /* Enough to read a complete word */
-        if (!bytestreamReadU32(&stream->byteStream, &stream->word)) {
-            return false;
-        }
-
-        stream->nextBit = 0;
-    } else {
-        /* Not enough for a word, read in as much as possible. */
-        stream->word = 0;
-
-        uint8_t byte = 0;
-
-        for (size_t i = 0; i < remaining; ++i) {
-            if (!bytestreamReadU8(&stream->byteStream, &byte)) {
-                return false;
-            }
-
-            stream->word <<= 8;
-            stream->word |= byte;
-        }
-
-        stream->nextBit = (uint8_t)(8 * (4 - remaining));
-        stream->word <<= stream->nextBit;
-    }
-
-    return true;
-}
-
-/*! \brief Determines if the next word needs to be loaded and then loads if needed.  */
-static inline bool checkLoadNextWord(BitStream* stream)
-{
-    if (stream->nextBit == 32 && !loadWord(stream)) {
-        return false;
-    }
-
-    return true;
-}
-
-/*------------------------------------------------------------------------------*/
-
 bool bitstreamInitialize(BitStream* stream, const uint8_t* data, size_t size)
 {
     if (!bytestreamInitialize(&stream->byteStream, data, size)) {
@@ -75,33 +25,31 @@ bool bitstreamInitialize(BitStream* stream, const uint8_t* data, size_t size)
     }
 
     stream->word = 0;
-    stream->nextBit = 0;
+    stream->nextBit = 64;
+    bitstreamRefill(stream);
 
-    return loadWord(stream);
+    return true;
 }
 
 bool bitstreamReadBit(BitStream* stream, uint8_t* out)
 {
     assert(out);
 
-    if (streamComplete(stream) || !checkLoadNextWord(stream)) {
+    if (streamComplete(stream)) {
         return false;
     }
 
-    *out = stream->word >> 31;
-    stream->word <<= 1;
-    stream->nextBit++;
-
+    bitstreamReadBitUnchecked(stream, out);
     return true;
 }
 
 void bitstreamReadBitUnchecked(BitStream* stream, uint8_t* out)
 {
     assert(out && !streamComplete(stream));
-    if (stream->nextBit == 32) {
-        loadWordUnchecked(stream);
+    if (stream->nextBit == 64) {
+        bitstreamRefill(stream);
     }
-    *out = stream->word >> 31;
+    *out = (uint8_t)(stream->word >> 63);
     stream->word <<= 1;
     stream->nextBit++;
 }
@@ -110,31 +58,16 @@ bool bitstreamReadBits(BitStream* stream, uint8_t numBits, int32_t* out)
 {
     assert(out && (numBits <= kMaxBitsAtOnce));
 
-    if (streamComplete(stream) || !checkLoadNextWord(stream)) {
-        return false;
+    if (numBits == 0) {
+        *out = 0;
+        return true;
     }
 
-    /* Load up current word bits. */
-    const uint8_t wordRemaining = 32 - stream->nextBit;
-    *out = (int32_t)(stream->word >> (32 - numBits));
-
-    if (wordRemaining >= numBits) {
-        stream->nextBit += numBits;
-        stream->word <<= numBits;
-    } else {
-        /* Handle outstanding bits to be read in. */
-        const uint8_t readRemaining = numBits - wordRemaining;
-
-        if (!loadWord(stream)) {
-            return false;
-        }
-
-        stream->nextBit += readRemaining;
-        const int32_t trailBits = (int32_t)(stream->word >> (32 - readRemaining));
-        stream->word <<= readRemaining;
-        *out |= trailBits;
+    if (bitstreamGetRemainingBits(stream) < numBits) {
+        return false;
     }
 
+    bitstreamReadBitsUnchecked(stream, numBits, out);
     return true;
 }
 
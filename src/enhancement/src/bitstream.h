@@ -32,13 +32,14 @@ static const uint8_t kMaxBitsAtOnce = 31;
  *
  *  Contains state of a bit accessible stream that can only be read from.
  *
- *  The stream data is expected to be batched into 32-bit words stored in
- *  big-endian ordering. */
+ *  The stream data is read in big-endian ordering into a 64-bit word. The unread bits of the word
+ *  are kept at the top, and the word is topped up with whole bytes from the byte stream whenever
+ *  it has fewer bits than a read needs. */
 typedef struct BitStream
 {
     ByteStream byteStream; /**< Byte stream tracking state of stream data. */
-    uint32_t word;         /**< Current word loaded read from the byte stream. */
-    uint8_t nextBit;       /**< Next bit to read from stream */
+    uint64_t word;         /**< Unread bits from the byte stream, most significant first. */
+    uint8_t nextBit;       /**< Number of bits consumed from the word, 64 when it is empty. */
 } BitStream;
 
 /*------------------------------------------------------------------------------*/
@@ -69,36 +70,35 @@ bool bitstreamReadBits(BitStream* stream, uint8_t numBits, int32_t* out);
 static inline bool streamComplete(const BitStream* stream)
 {
     const bool byteStreamComplete = bytestreamRemaining(&stream->byteStream) == 0;
-    const bool wordComplete = (stream->nextBit == 32);
+    const bool wordComplete = (stream->nextBit == 64);
     return byteStreamComplete && wordComplete;
 }
 
-/*! \brief Helper function to load a new DWORD from the bytestream. */
-static inline void loadWordUnchecked(BitStream* stream)
+/*! \brief Helper function to top up the word with as many whole bytes from the bytestream as fit.
+ *
+ *  While at least 8 bytes remain this is a single unaligned load, shifted in below the unread
+ *  bits, leaving at least 57 bits in the word. Only the last few bytes of the stream are read
+ *  one at a time. The word must have fewer than 64 unread bits. */
+static inline void bitstreamRefill(BitStream* stream)
 {
     const size_t remaining = bytestreamRemaining(&stream->byteStream);
+    const uint8_t* ptr = stream->byteStream.data + stream->byteStream.offset;
 
-    assert(remaining > 0);
+    assert(stream->nextBit > 0);
 
-    if (remaining >= 4) {
-        /* Enough to read a complete word */
-        stream->byteStream.offset +=
-            readU32(stream->byteStream.data + stream->byteStream.offset, &stream->word);
-        stream->nextBit = 0;
+    if (remaining >= 8) {
+        uint64_t next = 0;
+        readU64(ptr, &next);
+        stream->word |= next >> (64 - stream->nextBit);
+        const uint8_t bytes = (uint8_t)(stream->nextBit >> 3);
+        stream->byteStream.offset += bytes;
+        stream->nextBit -= (uint8_t)(bytes << 3);
     } else {
-        /* Not enough for a word, read in as much as possible. */
-        stream->word = 0;
-
-        uint8_t byte = 0;
-        for (size_t i = 0; i < remaining; ++i) {
-            byte = *(stream->byteStream.data + stream->byteStream.offset);
+        for (size_t i = 0; i < remaining && stream->nextBit >= 8; ++i) {
+            stream->nextBit -= 8;
+            stream->word |= (uint64_t)ptr[i] << stream->nextBit;
             stream->byteStream.offset += 1;
-            stream->word <<= 8;
-            stream->word |= byte;
         }
-
-        stream->nextBit = (uint8_t)(8 * (4 - remaining));
-        stream->word <<= stream->nextBit;
     }
 }
 
@@ -106,30 +106,15 @@ static inline void loadWordUnchecked(BitStream* stream)
  *         that numBits is less than the number of remaining bits, and less than kMaxBitsAtOnce. */
 static inline void bitstreamReadBitsUnchecked(BitStream* stream, uint8_t numBits, int32_t* out)
 {
-    assert(out && (numBits <= kMaxBitsAtOnce) && !streamComplete(stream));
+    assert(out && (numBits > 0) && (numBits <= kMaxBitsAtOnce) && !streamComplete(stream));
 
-    if (stream->nextBit == 32) {
-        loadWordUnchecked(stream);
+    if ((uint8_t)(64 - stream->nextBit) < numBits) {
+        bitstreamRefill(stream);
     }
 
-    /* Load up current word bits. */
-    const uint8_t wordRemaining = 32 - stream->nextBit;
-    *out = (int32_t)(stream->word >> (32 - numBits));
-
-    if (wordRemaining >= numBits) {
-        stream->nextBit += numBits;
-        stream->word <<= numBits;
-    } else {
-        /* Handle outstanding bits to be read in. */
-        const uint8_t readRemaining = numBits - wordRemaining;
-
-        loadWordUnchecked(stream);
-
-        stream->nextBit += readRemaining;
-        const int32_t trailBits = (int32_t)(stream->word >> (32 - readRemaining));
-        stream->word <<= readRemaining;
-        *out |= trailBits;
-    }
+    *out = (int32_t)(stream->word >> (64 - numBits));
+    stream->word <<= numBits;
+    stream->nextBit += numBits;
 }
 
 /*! \brief Read a variable length exponential-Golomb encoded 32-bit unsigned integer. Exponential-
@@ -143,7 +128,7 @@ bool bitstreamReadExpGolomb(BitStream* stream, uint32_t* out);
  *  \return number of bits remaining in stream */
 static inline size_t bitstreamGetRemainingBits(const BitStream* stream)
 {
-    const size_t wordBitsRemaining = 32 - stream->nextBit;
+    const size_t wordBitsRemaining = 64 - stream->nextBit;
     const size_t byteBitsRemaining = bytestreamRemaining(&stream->byteStream) * 8;
     return wordBitsRemaining + byteBitsRemaining;
 }
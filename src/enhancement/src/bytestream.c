@@ -171,29 +171,3 @@ const uint8_t* bytestreamCurrent(const ByteStream* stream)
 size_t byteStreamGetSize(const ByteStream* stream) { return stream->size; }
 
 /*------------------------------------------------------------------------------*/
-
-int32_t readU64(const uint8_t* ptr, uint64_t* out)
-{
-    /* clang-format off */
-	*out =    (((uint64_t)ptr[0]) << 56) | (((uint64_t)ptr[1]) << 48)
-			| (((uint64_t)ptr[2]) << 40) | (((uint64_t)ptr[3]) << 32)
-			| (((uint64_t)ptr[4]) << 24) | (((uint64_t)ptr[5]) << 16)
-			| (((uint64_t)ptr[6]) << 8)  |   (uint64_t)ptr[7];
-    /* clang-format on */
-    return 8;
-}
-
-int32_t readU32(const uint8_t* ptr, uint32_t* out)
-{
-    *out = ((uint32_t)ptr[0] << 24) | ((uint32_t)ptr[1] << 16) | ((uint32_t)ptr[2] << 8) |
-           (uint32_t)ptr[3];
-    return 4;
-}
-
-int32_t readU16(const uint8_t* ptr, uint16_t* out)
-{
-    *out = (uint16_t)((ptr[0] << 8) | ptr[1]);
-    return 2;
-}
-
-/*------------------------------------------------------------------------------*/
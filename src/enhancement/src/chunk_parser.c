@@ -377,16 +377,15 @@ bool chunkCheckAlloc(LdeFrameConfig* frameConfig, const LdeGlobalConfig* globalC
         }
     }
 
-    /* Reallocate chunk memory if needed. */
-    if (chunkCount != frameConfig->numChunks || !frameConfig->chunks) {
-        if (frameConfig->chunks) {
-            VNFree(frameConfig->allocator, &frameConfig->chunkAllocation);
-        }
-
+    /* Reallocate chunk memory if needed - an existing allocation that is big enough is re-used. */
+    if (!VNIsAllocated(frameConfig->chunkAllocation) ||
+        VNAllocationSize(frameConfig->chunkAllocation, LdeChunk) < chunkCount) {
         frameConfig->chunks = VNReallocateArray(frameConfig->allocator,
                                                 &frameConfig->chunkAllocation, LdeChunk, chunkCount);
-        frameConfig->numChunks = chunkCount;
+    } else {
+        frameConfig->chunks = VNAllocationPtr(frameConfig->chunkAllocation, LdeChunk);
     }
+    frameConfig->numChunks = chunkCount;
 
     if (!frameConfig->chunks) {
         VNLogError("Memory allocation for chunk data failed");
@@ -146,7 +146,7 @@ void cmdBufferAppendResiduals(LdeCmdBufferGpu* cmdBuffer, LdeCmdBufferGpuBuilder
             tuBlockPosition = tuIndex % CBGKDDBlockSize;
         }
         const uint16_t maskIndex = tuBlockPosition >> 6;
-        cmd->bitmask[maskIndex] |= (1ULL << (blockSize - 1 - (tuBlockPosition % 64)));
+        cmd->bitmask[maskIndex] |= (1ULL << (63 - (tuBlockPosition % 64)));
         if (cmd->bitCount == 0) {
             cmd->bitStart = clz64(cmd->bitmask[maskIndex]);
         }
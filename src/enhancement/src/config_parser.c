@@ -198,6 +198,36 @@ static bool calculateTileCounts(LdeGlobalConfig* globalConfig)
     return true;
 }
 
+/*! \brief The global config fields that the derived tile configuration depends on. */
+typedef struct TileConfigurationInputs
+{
+    LdeChroma chroma;
+    LdeTransformType transform;
+    LdeScalingMode scalingModes[LOQEnhancedCount];
+    uint16_t width;
+    uint16_t height;
+    uint16_t tileWidth;
+    uint16_t tileHeight;
+    uint8_t numPlanes;
+    bool initialized;
+} TileConfigurationInputs;
+
+static void getTileConfigurationInputs(const LdeGlobalConfig* globalConfig,
+                                       TileConfigurationInputs* inputs)
+{
+    VNClear(inputs);
+    inputs->chroma = globalConfig->chroma;
+    inputs->transform = globalConfig->transform;
+    inputs->scalingModes[LOQ0] = globalConfig->scalingModes[LOQ0];
+    inputs->scalingModes[LOQ1] = globalConfig->scalingModes[LOQ1];
+    inputs->width = globalConfig->width;
+    inputs->height = globalConfig->height;
+    inputs->tileWidth = globalConfig->tileWidth[0];
+    inputs->tileHeight = globalConfig->tileHeight[0];
+    inputs->numPlanes = globalConfig->numPlanes;
+    inputs->initialized = globalConfig->initialized;
+}
+
 static bool calculateTileConfiguration(LdeGlobalConfig* globalConfig)
 {
     /* Ensure all tile dimensions are now valid across all planes. */
@@ -395,6 +425,10 @@ static bool parseBlockGlobalConfigTiles(ByteStream* stream, LdeGlobalConfig* glo
  * Occurs once per IDR frame */
 static bool parseBlockGlobalConfig(ByteStream* stream, LdeGlobalConfig* globalConfig)
 {
+    /* Global config blocks usually repeat unchanged, so remember what derived state was based on */
+    TileConfigurationInputs previousInputs;
+    getTileConfigurationInputs(globalConfig, &previousInputs);
+
     if (!globalConfig->bitstreamVersionSet) {
         /* V-Nova config should always arrive before global config. If it has not been sent this
          * frame and a global config is received, then set the version permanently to the current
@@ -593,7 +627,14 @@ static bool parseBlockGlobalConfig(ByteStream* stream, LdeGlobalConfig* globalCo
     }
 
     VNCheckB(postParseInitBlockGlobalConfig(globalConfig));
-    VNCheckB(calculateTileConfiguration(globalConfig));
+
+    /* Tile dimensions and counts only need recalculating if their inputs have changed. */
+    TileConfigurationInputs inputs;
+    getTileConfigurationInputs(globalConfig, &inputs);
+    inputs.initialized = true;
+    if (memcmp(&inputs, &previousInputs, sizeof(TileConfigurationInputs)) != 0) {
+        VNCheckB(calculateTileConfiguration(globalConfig));
+    }
 
     globalConfig->initialized = true;
 
@@ -1285,29 +1326,36 @@ static bool parseBlock(ByteStream* stream, LdeGlobalConfig* globalConfig,
     return true;
 }
 
-bool unencapsulate(const uint8_t* encapsulatedData, size_t encapsulatedSize,
-                   uint8_t* unencapsulatedBuffer, size_t* unencapsulatedSize, bool* isIDR)
+/*! \brief Validate the start code, NAL unit header and RBSP stop-bit of an LCEVC NAL unit.
+ *
+ * \param[in]  data           NAL unit, starting with a 3 or 4 byte start code.
+ * \param[in]  size           Byte size of the NAL unit, including the RBSP stop-bit byte.
+ * \param[out] payloadOffset  Offset of the first payload byte after the NAL unit header.
+ * \param[out] isIDR          Set true if the NAL unit type is IDR.
+ *
+ * \return True on success, otherwise false. */
+static bool parseNALUnitHeader(const uint8_t* data, size_t size, size_t* payloadOffset, bool* isIDR)
 {
-    uint8_t* head = unencapsulatedBuffer;
-    uint8_t zeroes = 0;
-    uint8_t byte = 0;
-    size_t pos = 5; // Remove the first 5 bytes and last byte in while condition
-    int32_t nalStartOffset = 3;
+    size_t nalStartOffset = 3;
+
+    /* Smallest NAL unit is a 3 byte start code, 2 byte header and the stop-bit byte. */
+    if (size < 6) {
+        VNLogError("Malformed NAL unit: too small");
+        return false;
+    }
 
     /* NAL Unit Header checks - MPEG-5 Part 2 LCEVC standard - 7.3.2 (Table-6) & 7.4.2.2 */
-    if (encapsulatedData[encapsulatedSize - 1] != 0x80) {
+    if (data[size - 1] != 0x80) {
         VNLogError("Malformed NAL unit: missing RBSP stop-bit");
         return false;
     }
 
-    if (encapsulatedData[0] != 0 || encapsulatedData[1] != 0 || encapsulatedData[2] != 1) {
-        if (encapsulatedData[0] != 0 || encapsulatedData[1] != 0 || encapsulatedData[2] != 0 ||
-            encapsulatedData[3] != 1) {
+    if (data[0] != 0 || data[1] != 0 || data[2] != 1) {
+        if (data[0] != 0 || data[1] != 0 || data[2] != 0 || data[3] != 1) {
             VNLogError("Malformed prefix: start code [0, 0, 1] or [0, 0, 0, 1] not found\n");
             return false;
         }
         nalStartOffset = 4;
-        pos++;
     }
 
     /*  forbidden_zero_bit   u(1)
@@ -1316,21 +1364,54 @@ bool unencapsulate(const uint8_t* encapsulatedData, size_t encapsulatedSize,
         reserved_flag        u(9) */
 
     /* forbidden bits and reserved flag */
-    if ((encapsulatedData[nalStartOffset] & 0xC1) != 0x41 || encapsulatedData[nalStartOffset + 1] != 0xFF) {
+    if ((data[nalStartOffset] & 0xC1) != 0x41 || data[nalStartOffset + 1] != 0xFF) {
         VNLogError("Malformed NAL unit header: forbidden bits or reserved flags not as expected");
         return false;
     }
 
-    LdeNALType type = (LdeNALType)((encapsulatedData[nalStartOffset] & 0x3E) >> 1);
+    LdeNALType type = (LdeNALType)((data[nalStartOffset] & 0x3E) >> 1);
     if (type != NTNonIDR && type != NTIDR) {
         VNLogError("Unrecognized LCEVC NAL type, it should be IDR or NonIDR");
         return false;
     }
     *isIDR = (type == NTIDR) ? true : false;
+    *payloadOffset = nalStartOffset + 2;
 
-    while (pos < encapsulatedSize - 1) {
-        byte = *(encapsulatedData + pos);
-        pos++;
+    return true;
+}
+
+/*! \brief Remove start code emulation prevention bytes from a NAL unit payload.
+ *
+ *  The output is never longer than the input, so `dst` may be the same as `src` to unescape in
+ *  place. Bytes before the first emulation prevention byte are only copied if `dst` and `src`
+ *  differ, so unescaping in place does not touch a payload that has no escapes.
+ *
+ * \return Byte size of the unescaped payload. */
+static size_t removeEmulationPrevention(const uint8_t* src, size_t size, uint8_t* dst)
+{
+    size_t pos = 0;
+    uint8_t zeroes = 0;
+
+    /* Scan for the first emulation prevention byte - 0x00 0x00 0x03 */
+    for (; pos < size; ++pos) {
+        const uint8_t byte = src[pos];
+
+        if (zeroes == 2 && byte == 3) {
+            break;
+        }
+
+        zeroes = (byte == 0) ? (uint8_t)(zeroes + 1) : 0;
+    }
+
+    if (dst != src) {
+        memcpy(dst, src, pos);
+    }
+
+    uint8_t* head = dst + pos;
+
+    /* Compact the remainder, skipping each emulation prevention byte */
+    while (pos < size) {
+        const uint8_t byte = src[pos++];
 
         if (zeroes == 2 && byte == 3) {
             zeroes = 0;
@@ -1345,7 +1426,37 @@ bool unencapsulate(const uint8_t* encapsulatedData, size_t encapsulatedSize,
 
         *(head++) = byte;
     }
-    *unencapsulatedSize = (size_t)(head - unencapsulatedBuffer);
+
+    return (size_t)(head - dst);
+}
+
+/*! \brief Deserialize the unescaped RBSP of an LCEVC NAL unit into the configs.
+ *
+ *  Chunks in the frame config will point into `rbsp`, so it must remain valid until the frame
+ *  config is released. */
+static bool parseRBSP(const uint8_t* rbsp, size_t rbspSize, bool isIDR, LdeGlobalConfig* globalConfig,
+                      LdeFrameConfig* frameConfig, bool* globalConfigModified)
+{
+    VNLogVerbose("------>>> Begin deserialize");
+
+    ByteStream stream;
+    *globalConfigModified = false;
+    frameConfig->frameConfigSet = false;
+    frameConfig->globalConfigSet = false;
+    frameConfig->nalType = isIDR ? NTIDR : NTNonIDR;
+    frameConfig->loqEnabled[LOQ0] = false;
+    frameConfig->loqEnabled[LOQ1] = false;
+    frameConfig->numChunks = 0;
+
+    if (!bytestreamInitialize(&stream, rbsp, rbspSize)) {
+        return false;
+    }
+
+    while (bytestreamRemaining(&stream) > 0) {
+        if (!parseBlock(&stream, globalConfig, frameConfig, globalConfigModified)) {
+            return false;
+        }
+    }
 
     return true;
 }
@@ -1397,10 +1508,10 @@ void ldeFrameConfigInitialize(LdcMemoryAllocator* allocator, LdeFrameConfig* fra
 
 void ldeConfigsReleaseFrame(LdeFrameConfig* frameConfig)
 {
-    if (frameConfig->chunks) {
+    if (VNIsAllocated(frameConfig->chunkAllocation)) {
         VNFree(frameConfig->allocator, &frameConfig->chunkAllocation);
-        frameConfig->chunks = NULL;
     }
+    frameConfig->chunks = NULL;
     if (VNIsAllocated(frameConfig->unencapsulatedAllocation)) {
         VNFree(frameConfig->allocator, &frameConfig->unencapsulatedAllocation);
     }
@@ -1423,45 +1534,65 @@ bool ldeConfigsParse(const uint8_t* serialized, const size_t serializedSize, Lde
         return false;
     }
 
-    // Unencapsulate - output size will always be the same or smaller
-    size_t unencapsulatedSize = 0;
+    size_t payloadOffset = 0;
     bool idr = false;
     if (VNIsAllocated(frameConfig->unencapsulatedAllocation)) {
         VNFree(frameConfig->allocator, &frameConfig->unencapsulatedAllocation);
     }
+
+    if (!parseNALUnitHeader(serialized, serializedSize, &payloadOffset, &idr)) {
+        VNLogError("Unencapsulation failed during NAL unit parsing");
+        return false;
+    }
+
+    // Unencapsulate - output size will always be the same or smaller. The stop-bit byte is dropped.
+    const size_t payloadSize = serializedSize - payloadOffset - 1;
     uint8_t* unencapsulated = VNAllocateZeroArray(
         frameConfig->allocator, &frameConfig->unencapsulatedAllocation, uint8_t, serializedSize);
+    if (!unencapsulated) {
+        return false;
+    }
 
-    if (!unencapsulate(serialized, serializedSize, unencapsulated, &unencapsulatedSize, &idr)) {
-        VNLogError("Unencapsulation failed during NAL unit parsing");
+    const size_t unencapsulatedSize =
+        removeEmulationPrevention(serialized + payloadOffset, payloadSize, unencapsulated);
+
+    if (!parseRBSP(unencapsulated, unencapsulatedSize, idr, globalConfig, frameConfig,
+                   globalConfigModified)) {
         VNFree(frameConfig->allocator, &frameConfig->unencapsulatedAllocation);
         return false;
     }
 
-    VNLogVerbose("------>>> Begin deserialize");
+    return true;
+}
 
-    ByteStream stream;
-    *globalConfigModified = false;
-    frameConfig->frameConfigSet = false;
-    frameConfig->globalConfigSet = false;
-    frameConfig->nalType = idr ? NTIDR : NTNonIDR;
-    frameConfig->loqEnabled[LOQ0] = false;
-    frameConfig->loqEnabled[LOQ1] = false;
-    frameConfig->numChunks = 0;
+bool ldeConfigsParseInPlace(uint8_t* serialized, size_t serializedSize, bool unescaped,
+                            LdeGlobalConfig* globalConfig, LdeFrameConfig* frameConfig,
+                            bool* globalConfigModified)
+{
+    if (!serialized || !serializedSize) {
+        VNLogError("Serialised NULL or no size");
+        return false;
+    }
 
-    if (!bytestreamInitialize(&stream, unencapsulated, unencapsulatedSize)) {
+    size_t payloadOffset = 0;
+    bool idr = false;
+    if (VNIsAllocated(frameConfig->unencapsulatedAllocation)) {
         VNFree(frameConfig->allocator, &frameConfig->unencapsulatedAllocation);
+    }
+
+    if (!parseNALUnitHeader(serialized, serializedSize, &payloadOffset, &idr)) {
+        VNLogError("Unencapsulation failed during NAL unit parsing");
         return false;
     }
 
-    while (bytestreamRemaining(&stream) > 0) {
-        if (!parseBlock(&stream, globalConfig, frameConfig, globalConfigModified)) {
-            VNFree(frameConfig->allocator, &frameConfig->unencapsulatedAllocation);
-            return false;
-        }
+    uint8_t* payload = serialized + payloadOffset;
+    size_t payloadSize = serializedSize - payloadOffset - 1;
+
+    if (!unescaped) {
+        payloadSize = removeEmulationPrevention(payload, payloadSize, payload);
     }
 
-    return true;
+    return parseRBSP(payload, payloadSize, idr, globalConfig, frameConfig, globalConfigModified);
 }
 
 /*------------------------------------------------------------------------------*/
@@ -19,6 +19,7 @@
 #include <LCEVC/enhancement/config_pool.h>
 
 static const size_t kInitialGlobalPoolSize = 2;
+static const uint32_t kMaxPooledChunkArrays = 8;
 
 /* Wrap a GlobalConfig and it's reference count together
  */
@@ -26,11 +27,27 @@ typedef struct WrappedGlobalConfig
 {
     LdeGlobalConfig globalConfig; //**< The global config
     uint32_t referenceCount;      //**< Number of outstanding references, including 'latest'
+    uint64_t hash;                //**< Hash of the global config contents
 } WrappedGlobalConfig;
 
+// FNV-1a hash of global config contents - padding is zero, as with the memcmp() comparisons
+//
+static uint64_t hashGlobalConfig(const LdeGlobalConfig* globalConfig)
+{
+    const uint8_t* bytes = (const uint8_t*)globalConfig;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < sizeof(LdeGlobalConfig); ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
 // Allocate a new wrapped GlobaConfig
 //
-static WrappedGlobalConfig* allocateGlobalConfig(LdeConfigPool* configPool, const LdeGlobalConfig* initial)
+static WrappedGlobalConfig* allocateGlobalConfig(LdeConfigPool* configPool,
+                                                 const LdeGlobalConfig* initial, uint64_t hash)
 {
     LdcMemoryAllocation allocation = {0};
     VNAllocate(configPool->allocator, &allocation, WrappedGlobalConfig);
@@ -38,9 +55,28 @@ static WrappedGlobalConfig* allocateGlobalConfig(LdeConfigPool* configPool, cons
     WrappedGlobalConfig* wrapped = VNAllocationPtr(allocation, WrappedGlobalConfig);
     memcpy(&wrapped->globalConfig, initial, sizeof(LdeGlobalConfig));
     wrapped->referenceCount = 1;
+    wrapped->hash = hash;
     return wrapped;
 }
 
+// Find an in-use wrapped GlobalConfig with identical contents
+//
+static WrappedGlobalConfig* findGlobalConfig(const LdeConfigPool* configPool,
+                                             const LdeGlobalConfig* globalConfig, uint64_t hash)
+{
+    for (uint32_t i = 0; i < ldcVectorSize(&configPool->globalConfigs); ++i) {
+        const LdcMemoryAllocation* alloc = ldcVectorAt(&configPool->globalConfigs, i);
+        WrappedGlobalConfig* wrapped = VNAllocationPtr(*alloc, WrappedGlobalConfig);
+
+        if (wrapped->hash == hash &&
+            !memcmp(&wrapped->globalConfig, globalConfig, sizeof(LdeGlobalConfig))) {
+            return wrapped;
+        }
+    }
+
+    return NULL;
+}
+
 // Reduce reference count to a wrapped GlobalConfig
 //
 static void releaseGlobalConfig(LdeConfigPool* configPool, WrappedGlobalConfig* wrapped)
@@ -73,6 +109,8 @@ void ldeConfigPoolInitialize(LdcMemoryAllocator* allocator, LdeConfigPool* confi
 
     ldcVectorInitialize(&configPool->globalConfigs, sizeof(LdcMemoryAllocation),
                         (uint32_t)kInitialGlobalPoolSize, allocator);
+    ldcVectorInitialize(&configPool->chunkArrays, sizeof(LdcMemoryAllocation),
+                        kMaxPooledChunkArrays, allocator);
 
     // Start with empty 'latest' global config
     // Explicitly clear whole of structure so that any padding is 0
@@ -82,7 +120,8 @@ void ldeConfigPoolInitialize(LdcMemoryAllocator* allocator, LdeConfigPool* confi
     // Set to default values
     ldeGlobalConfigInitialize(bitstreamVersion, &defaultGlobalConfig);
 
-    WrappedGlobalConfig* latest = allocateGlobalConfig(configPool, &defaultGlobalConfig);
+    WrappedGlobalConfig* latest =
+        allocateGlobalConfig(configPool, &defaultGlobalConfig, hashGlobalConfig(&defaultGlobalConfig));
 
     configPool->latestGlobalConfig = &latest->globalConfig;
     configPool->quantMatrix.set = false;
@@ -96,11 +135,17 @@ void ldeConfigPoolRelease(LdeConfigPool* configPool)
     }
 
     ldcVectorDestroy(&configPool->globalConfigs);
+
+    for (uint32_t i = 0; i < ldcVectorSize(&configPool->chunkArrays); ++i) {
+        VNFree(configPool->allocator, ldcVectorAt(&configPool->chunkArrays, i));
+    }
+
+    ldcVectorDestroy(&configPool->chunkArrays);
 }
 
-bool ldeConfigPoolFrameInsert(LdeConfigPool* configPool, uint64_t timestamp,
-                              const uint8_t* serialized, size_t serializedSize,
-                              LdeGlobalConfig** globalConfigPtr, LdeFrameConfig* frameConfig)
+// Set up a frame config, and a copy of the latest global config, ready for parsing
+//
+static void frameInsertBegin(LdeConfigPool* configPool, LdeGlobalConfig* next, LdeFrameConfig* frameConfig)
 {
     ldeFrameConfigInitialize(configPool->allocator, frameConfig);
 
@@ -110,27 +155,42 @@ bool ldeConfigPoolFrameInsert(LdeConfigPool* configPool, uint64_t timestamp,
     }
     frameConfig->ditherEnabled = configPool->ditherEnabled;
 
+    // Hand over a chunk array from a released frame - it is re-used if big enough for this frame
+    if (!VNIsAllocated(frameConfig->chunkAllocation) && !ldcVectorIsEmpty(&configPool->chunkArrays)) {
+        LdcMemoryAllocation* chunkArray = ldcVectorAtEnd(&configPool->chunkArrays, 0);
+        frameConfig->chunkAllocation = *chunkArray;
+        ldcVectorRemoveReorder(&configPool->chunkArrays, chunkArray);
+    }
+
     // Make a copy of the current global config
     // Copy using memcpy to make sure zero padding is copied over
-    bool globalConfigWritten = false;
-    LdeGlobalConfig next;
-    memcpy(&next, configPool->latestGlobalConfig, sizeof(LdeGlobalConfig));
-
-    if (!ldeConfigsParse(serialized, serializedSize, &next, frameConfig, &globalConfigWritten)) {
-        VNLogError("Could not parse frame 0x%" PRIx64, timestamp);
-        return false;
-    }
+    memcpy(next, configPool->latestGlobalConfig, sizeof(LdeGlobalConfig));
+}
 
+// Update pool state from a parsed frame and hand out a reference to the frame's global config
+//
+static void frameInsertEnd(LdeConfigPool* configPool, const LdeGlobalConfig* next,
+                           bool globalConfigWritten, LdeGlobalConfig** globalConfigPtr,
+                           const LdeFrameConfig* frameConfig)
+{
     // Save stateful params back to the pool
     configPool->quantMatrix = frameConfig->quantMatrix;
     configPool->ditherEnabled = frameConfig->ditherEnabled;
 
     // Has global config changed?
     // Use memcmp to compare - which is why any padding needs to be zero
-    if (globalConfigWritten && memcmp(&next, configPool->latestGlobalConfig, sizeof(LdeGlobalConfig))) {
-        // We have a new config
-
-        WrappedGlobalConfig* newLatest = allocateGlobalConfig(configPool, &next);
+    if (globalConfigWritten && memcmp(next, configPool->latestGlobalConfig, sizeof(LdeGlobalConfig))) {
+        // We have a different config - re-use an identical one still held by in-flight frames,
+        // otherwise make a new one.
+        const uint64_t hash = hashGlobalConfig(next);
+        WrappedGlobalConfig* newLatest = findGlobalConfig(configPool, next, hash);
+
+        if (newLatest) {
+            // Add 'latest' reference
+            newLatest->referenceCount++;
+        } else {
+            newLatest = allocateGlobalConfig(configPool, next, hash);
+        }
 
         // Take away 'latest' reference from old latest
         releaseGlobalConfig(configPool, (WrappedGlobalConfig*)(configPool->latestGlobalConfig));
@@ -143,13 +203,60 @@ bool ldeConfigPoolFrameInsert(LdeConfigPool* configPool, uint64_t timestamp,
     ((WrappedGlobalConfig*)(configPool->latestGlobalConfig))->referenceCount++;
 
     *globalConfigPtr = configPool->latestGlobalConfig;
+}
+
+bool ldeConfigPoolFrameInsert(LdeConfigPool* configPool, uint64_t timestamp,
+                              const uint8_t* serialized, size_t serializedSize,
+                              LdeGlobalConfig** globalConfigPtr, LdeFrameConfig* frameConfig)
+{
+    bool globalConfigWritten = false;
+    LdeGlobalConfig next;
+    frameInsertBegin(configPool, &next, frameConfig);
+
+    if (!ldeConfigsParse(serialized, serializedSize, &next, frameConfig, &globalConfigWritten)) {
+        VNLogError("Could not parse frame 0x%" PRIx64, timestamp);
+        return false;
+    }
+
+    frameInsertEnd(configPool, &next, globalConfigWritten, globalConfigPtr, frameConfig);
+    return true;
+}
+
+bool ldeConfigPoolFrameInsertInPlace(LdeConfigPool* configPool, uint64_t timestamp,
+                                     uint8_t* serialized, size_t serializedSize, bool unescaped,
+                                     LdeGlobalConfig** globalConfigPtr, LdeFrameConfig* frameConfig)
+{
+    bool globalConfigWritten = false;
+    LdeGlobalConfig next;
+    frameInsertBegin(configPool, &next, frameConfig);
+
+    if (!ldeConfigsParseInPlace(serialized, serializedSize, unescaped, &next, frameConfig,
+                                &globalConfigWritten)) {
+        VNLogError("Could not parse frame 0x%" PRIx64, timestamp);
+        return false;
+    }
+
+    frameInsertEnd(configPool, &next, globalConfigWritten, globalConfigPtr, frameConfig);
     return true;
 }
 
 bool ldeConfigPoolFrameRelease(LdeConfigPool* configPool, LdeFrameConfig* frameConfig,
                                LdeGlobalConfig* globalConfig)
 {
-    releaseGlobalConfig(configPool, (WrappedGlobalConfig*)globalConfig);
+    // Keep the chunk array for a later frame, which will usually have the same tile layout
+    if (VNIsAllocated(frameConfig->chunkAllocation) &&
+        ldcVectorSize(&configPool->chunkArrays) < kMaxPooledChunkArrays) {
+        ldcVectorAppend(&configPool->chunkArrays, &frameConfig->chunkAllocation);
+        VNClear(&frameConfig->chunkAllocation);
+        frameConfig->chunks = NULL;
+        frameConfig->numChunks = 0;
+    }
+
+    ldeConfigsReleaseFrame(frameConfig);
+
+    if (globalConfig) {
+        releaseGlobalConfig(configPool, (WrappedGlobalConfig*)globalConfig);
+    }
     return true;
 }
 
@@ -34,9 +34,20 @@
 
 /*------------------------------------------------------------------------------*/
 
+/* Initial number of runs allocated per layer, grown by doubling as needed. */
+#define kLayerRunsInitialCapacity 256
+
+/* Read position in each layer of previously decoded layer runs. */
+typedef struct LayerRunsReader
+{
+    const LdeCoeffRun* next[RCLayerCountDDS];
+    const LdeCoeffRun* end[RCLayerCountDDS];
+} LayerRunsReader;
+
 static inline int32_t entropyDecodeAllLayers(const uint8_t numLayers, const bool decoderExists,
                                              const int32_t tuTotal,
                                              EntropyDecoder residualDecoders[RCLayerCountDDS],
+                                             LayerRunsReader* layerReader,
                                              int32_t zerosOut[RCLayerCountDDS],
                                              int16_t coeffsOut[RCLayerCountDDS], int32_t* minZeroCountOut)
 {
@@ -46,10 +57,20 @@ static inline int32_t entropyDecodeAllLayers(const uint8_t numLayers, const bool
             zerosOut[layer]--;
             coeffsOut[layer] = 0;
         } else if (decoderExists) {
-            const int32_t layerZero = entropyDecode(&residualDecoders[layer], &coeffsOut[layer]);
-            zerosOut[layer] = (layerZero == EntropyNoData) ? (tuTotal - 1) : layerZero;
-            if (zerosOut[layer] < 0) {
-                return zerosOut[layer];
+            if (layerReader) {
+                /* Runs were validated when decoded, running out means they are incomplete. */
+                if (layerReader->next[layer] == layerReader->end[layer]) {
+                    return -1;
+                }
+                coeffsOut[layer] = layerReader->next[layer]->value;
+                zerosOut[layer] = layerReader->next[layer]->zeros;
+                layerReader->next[layer]++;
+            } else {
+                const int32_t layerZero = entropyDecode(&residualDecoders[layer], &coeffsOut[layer]);
+                zerosOut[layer] = (layerZero == EntropyNoData) ? (tuTotal - 1) : layerZero;
+                if (zerosOut[layer] < 0) {
+                    return zerosOut[layer];
+                }
             }
 
             /* set i-th bit if nonzero */
@@ -96,19 +117,45 @@ static inline void deblockResiduals(const LdeDeblock* deblock, int16_t residuals
 
 /*------------------------------------------------------------------------------*/
 
-bool ldeDecodeEnhancement(const LdeGlobalConfig* globalConfig, const LdeFrameConfig* frameConfig,
-                          const LdeLOQIndex loq, const uint32_t planeIdx, const uint32_t tileIdx,
-                          LdeCmdBufferCpu* cmdBufferCpu, LdeCmdBufferGpu* cmdBufferGpu,
-                          LdeCmdBufferGpuBuilder* cmdBufferBuilder)
+static bool validateTile(const LdeGlobalConfig* globalConfig, const LdeLOQIndex loq,
+                         const uint32_t planeIdx, const uint32_t tileIdx)
 {
-    bool res = true;
-
     if (loq > LOQ1 || planeIdx >= RCMaxPlanes || tileIdx >= globalConfig->numTiles[planeIdx][loq]) {
         VNLogError("Invalid LOQ-plane-tile: LOQ%d, plane %d, tile %d", (uint8_t)loq, planeIdx, tileIdx);
         return false;
     }
+    return true;
+}
+
+static bool tileHasData(const LdeGlobalConfig* globalConfig, const LdeFrameConfig* frameConfig,
+                        const LdeLOQIndex loq, const uint32_t planeIdx)
+{
     if (!frameConfig->loqEnabled[loq] || planeIdx > globalConfig->numPlanes) {
         VNLogDebug("Nothing to decode in LOQ%d, plane %d", (uint8_t)loq, planeIdx);
+        return false;
+    }
+    return true;
+}
+
+/* Decode a tile to a cmdbuffer, entropy decoding the residual layers here unless layerRuns is
+ * given, in which case they have already been decoded by ldeDecodeLayer. The entropy decoders are
+ * owned by the caller, so that they can be released however this returns. */
+static bool decodeTileWithDecoders(const LdeGlobalConfig* globalConfig,
+                                   const LdeFrameConfig* frameConfig, const LdeLOQIndex loq,
+                                   const uint32_t planeIdx, const uint32_t tileIdx,
+                                   const LdeLayerRuns* layerRuns, LdeCmdBufferCpu* cmdBufferCpu,
+                                   LdeCmdBufferGpu* cmdBufferGpu,
+                                   LdeCmdBufferGpuBuilder* cmdBufferBuilder,
+                                   LdeHuffmanCache* huffmanCache,
+                                   EntropyDecoder residualDecoders[RCLayerCountDDS],
+                                   EntropyDecoder* temporalDecoder)
+{
+    bool res = true;
+
+    if (!validateTile(globalConfig, loq, planeIdx, tileIdx)) {
+        return false;
+    }
+    if (!tileHasData(globalConfig, frameConfig, loq, planeIdx)) {
         return true;
     }
 
@@ -159,17 +206,23 @@ bool ldeDecodeEnhancement(const LdeGlobalConfig* globalConfig, const LdeFrameCon
     TransformFunction transformFn = transformGetFunction(globalConfig->transform, scaling, false);
 
     /* Setup decoders */
-    EntropyDecoder residualDecoders[RCLayerCountDDS] = {{0}};
-    EntropyDecoder temporalDecoder = {0};
-    if (tileHasEntropyDecode) {
+    LayerRunsReader layerReader = {{0}};
+    if (tileHasEntropyDecode && layerRuns) {
+        for (uint8_t layerIdx = 0; layerIdx < numLayers; ++layerIdx) {
+            layerReader.next[layerIdx] =
+                VNAllocationPtr(layerRuns->allocations[layerIdx], LdeCoeffRun);
+            layerReader.end[layerIdx] = layerReader.next[layerIdx] + layerRuns->counts[layerIdx];
+        }
+    } else if (tileHasEntropyDecode) {
         for (uint8_t layerIdx = 0; layerIdx < numLayers; ++layerIdx) {
             VNCheckB(entropyInitialize(&residualDecoders[layerIdx], &chunks[layerIdx], EDTDefault,
-                                       bitstreamVersion));
+                                       bitstreamVersion, huffmanCache));
         }
     }
 
     if (temporalChunk) {
-        VNCheckB(entropyInitialize(&temporalDecoder, temporalChunk, EDTTemporal, bitstreamVersion));
+        VNCheckB(entropyInitialize(temporalDecoder, temporalChunk, EDTTemporal, bitstreamVersion,
+                                   huffmanCache));
     }
 
     /* Setup TU state */
@@ -185,13 +238,14 @@ bool ldeDecodeEnhancement(const LdeGlobalConfig* globalConfig, const LdeFrameCon
         /* Decode bitstream and track zero runs */
         int32_t minZeroCount = INT_MAX;
         coeffsNonzeroMask = entropyDecodeAllLayers(numLayers, tileHasEntropyDecode, (int32_t)tuState.tuTotal,
-                                                   residualDecoders, zeros, coeffs, &minZeroCount);
+                                                   residualDecoders, layerRuns ? &layerReader : NULL,
+                                                   zeros, coeffs, &minZeroCount);
 
         /* Decode temporal and track temporal run */
         const bool blockStart = ldeTuIsBlockStart(&tuState, tuIndex);
         if (clearBlockQueue == 0 && tileHasTemporalDecode && temporalEnabled) {
             if (temporalRun <= 0) {
-                temporalRun = entropyDecodeTemporal(&temporalDecoder, &temporal);
+                temporalRun = entropyDecodeTemporal(temporalDecoder, &temporal);
                 clearBlockRemainder = false;
 
                 if (temporalRun == EntropyNoData) {
@@ -383,4 +437,147 @@ bool ldeDecodeEnhancement(const LdeGlobalConfig* globalConfig, const LdeFrameCon
     return res;
 }
 
+static bool decodeTile(const LdeGlobalConfig* globalConfig, const LdeFrameConfig* frameConfig,
+                       const LdeLOQIndex loq, const uint32_t planeIdx, const uint32_t tileIdx,
+                       const LdeLayerRuns* layerRuns, LdeCmdBufferCpu* cmdBufferCpu,
+                       LdeCmdBufferGpu* cmdBufferGpu, LdeCmdBufferGpuBuilder* cmdBufferBuilder,
+                       LdeHuffmanCache* huffmanCache)
+{
+    EntropyDecoder residualDecoders[RCLayerCountDDS] = {{0}};
+    EntropyDecoder temporalDecoder = {0};
+
+    const bool res = decodeTileWithDecoders(globalConfig, frameConfig, loq, planeIdx, tileIdx,
+                                            layerRuns, cmdBufferCpu, cmdBufferGpu, cmdBufferBuilder,
+                                            huffmanCache, residualDecoders, &temporalDecoder);
+
+    /* Let the Huffman cache reuse any entries the decoders were using */
+    for (uint8_t layerIdx = 0; layerIdx < RCLayerCountDDS; ++layerIdx) {
+        entropyRelease(&residualDecoders[layerIdx]);
+    }
+    entropyRelease(&temporalDecoder);
+
+    return res;
+}
+
+/*------------------------------------------------------------------------------*/
+
+bool ldeDecodeEnhancement(const LdeGlobalConfig* globalConfig, const LdeFrameConfig* frameConfig,
+                          const LdeLOQIndex loq, const uint32_t planeIdx, const uint32_t tileIdx,
+                          LdeCmdBufferCpu* cmdBufferCpu, LdeCmdBufferGpu* cmdBufferGpu,
+                          LdeCmdBufferGpuBuilder* cmdBufferBuilder, LdeHuffmanCache* huffmanCache)
+{
+    return decodeTile(globalConfig, frameConfig, loq, planeIdx, tileIdx, NULL, cmdBufferCpu,
+                      cmdBufferGpu, cmdBufferBuilder, huffmanCache);
+}
+
+bool ldeDecodeEnhancementFromLayers(const LdeGlobalConfig* globalConfig,
+                                    const LdeFrameConfig* frameConfig, const LdeLOQIndex loq,
+                                    const uint32_t planeIdx, const uint32_t tileIdx,
+                                    const LdeLayerRuns* layerRuns, LdeCmdBufferCpu* cmdBufferCpu,
+                                    LdeCmdBufferGpu* cmdBufferGpu,
+                                    LdeCmdBufferGpuBuilder* cmdBufferBuilder,
+                                    LdeHuffmanCache* huffmanCache)
+{
+    if (!layerRuns) {
+        VNLogError("No layer runs provided to decode from");
+        return false;
+    }
+    return decodeTile(globalConfig, frameConfig, loq, planeIdx, tileIdx, layerRuns, cmdBufferCpu,
+                      cmdBufferGpu, cmdBufferBuilder, huffmanCache);
+}
+
+/*------------------------------------------------------------------------------*/
+
+void ldeLayerRunsInitialize(LdcMemoryAllocator* allocator, LdeLayerRuns* layerRuns)
+{
+    memset(layerRuns, 0, sizeof(LdeLayerRuns));
+    layerRuns->allocator = allocator;
+}
+
+void ldeLayerRunsFree(LdeLayerRuns* layerRuns)
+{
+    for (uint32_t layerIdx = 0; layerIdx < RCLayerCountDDS; ++layerIdx) {
+        if (VNIsAllocated(layerRuns->allocations[layerIdx])) {
+            VNFree(layerRuns->allocator, &layerRuns->allocations[layerIdx]);
+        }
+        layerRuns->counts[layerIdx] = 0;
+    }
+}
+
+bool ldeDecodeLayer(const LdeGlobalConfig* globalConfig, const LdeFrameConfig* frameConfig,
+                    const LdeLOQIndex loq, const uint32_t planeIdx, const uint32_t tileIdx,
+                    const uint32_t layerIdx, LdeHuffmanCache* huffmanCache, LdeLayerRuns* layerRuns)
+{
+    if (!validateTile(globalConfig, loq, planeIdx, tileIdx)) {
+        return false;
+    }
+    if (layerIdx >= globalConfig->numLayers) {
+        VNLogError("Invalid layer %u of %u", layerIdx, globalConfig->numLayers);
+        return false;
+    }
+
+    layerRuns->counts[layerIdx] = 0;
+    if (!tileHasData(globalConfig, frameConfig, loq, planeIdx) || !frameConfig->entropyEnabled) {
+        return true;
+    }
+
+    LdeChunk* chunks = {0};
+    getLayerChunks(globalConfig, frameConfig, planeIdx, loq, tileIdx, &chunks);
+
+    uint16_t width = 0;
+    uint16_t height = 0;
+    ldeTileDimensionsFromConfig(globalConfig, loq, (uint16_t)planeIdx, (uint16_t)tileIdx, &width,
+                                &height);
+    TUState tuState = {0};
+    VNCheckB(ldeTuStateInitialize(&tuState, width, height, 0, 0,
+                                  (globalConfig->transform == TransformDDS) ? 2 : 1));
+    const int32_t tuTotal = (int32_t)tuState.tuTotal;
+
+    EntropyDecoder decoder = {0};
+    VNCheckB(entropyInitialize(&decoder, &chunks[layerIdx], EDTDefault,
+                               globalConfig->bitstreamVersion, huffmanCache));
+
+    LdcMemoryAllocation* allocation = &layerRuns->allocations[layerIdx];
+    LdeCoeffRun* runs = VNAllocationPtr(*allocation, LdeCoeffRun);
+    uint32_t capacity = (uint32_t)VNAllocationSize(*allocation, LdeCoeffRun);
+    uint32_t count = 0;
+    bool res = true;
+
+    /* Decode in the same way as entropyDecodeAllLayers, stopping once the runs cover the tile. */
+    for (int64_t tuCovered = 0; tuCovered < tuTotal;) {
+        int16_t value = 0;
+        int32_t zeros = entropyDecode(&decoder, &value);
+        if (zeros == EntropyNoData) {
+            zeros = tuTotal - 1;
+        }
+        if (zeros < 0) {
+            VNLogError("Failed to decode layer %u: LOQ%d, plane %d, tile %d", layerIdx,
+                       (uint8_t)loq, planeIdx, tileIdx);
+            res = false;
+            break;
+        }
+
+        if (count == capacity) {
+            capacity = (capacity == 0) ? kLayerRunsInitialCapacity : capacity * 2;
+            runs = VNReallocateArray(layerRuns->allocator, allocation, LdeCoeffRun, capacity);
+            if (!runs) {
+                VNLogError("Failed to allocate layer runs, likely out of memory");
+                res = false;
+                break;
+            }
+        }
+        runs[count].zeros = zeros;
+        runs[count].value = value;
+        count++;
+
+        tuCovered += zeros + 1;
+    }
+
+    entropyRelease(&decoder);
+    if (res) {
+        layerRuns->counts[layerIdx] = count;
+    }
+    return res;
+}
+
 /*------------------------------------------------------------------------------*/
@@ -42,8 +42,10 @@ static const uint8_t kNextTemporalContext[HuffTemporalCount][2] = {{HuffTemporal
  *  \param state             Layer decoder state to initialise.
  *  \param chunk             The chunk to decode from.
  *  \param bitstreamVersion  Bitstream version (only present in some streams).
+ *  \param huffmanCache      Cache of built decoders to copy from and insert into, or NULL.
  */
-static bool chunkInitialize(EntropyDecoder* state, const LdeChunk* chunk, const uint8_t bitstreamVersion)
+static bool chunkInitialize(EntropyDecoder* state, const LdeChunk* chunk,
+                            const uint8_t bitstreamVersion, LdeHuffmanCache* huffmanCache)
 {
     state->entropyEnabled = chunk->entropyEnabled;
 
@@ -65,18 +67,42 @@ static bool chunkInitialize(EntropyDecoder* state, const LdeChunk* chunk, const
     /* Load up the stream with huffman tables contained at the beginning of the chunk. */
     VNCheckB(huffmanStreamInitialize(&state->hstream, chunk->data, chunk->size));
 
+    /* Tables are usually the same for every tile and frame, so try to use them from the cache
+     * before building them from the headers. */
+    const HuffmanCacheKind cacheKind = (state->type == EDTDefault) ? HCKTriple : HCKSinglePair;
+    HuffmanCacheKey cacheKey = {0};
+    const void* cached = NULL;
+    if (huffmanCache &&
+        huffmanCacheFetch(huffmanCache, cacheKind, bitstreamVersion, &state->hstream, &cacheKey,
+                          &state->heldCacheEntry, &cached)) {
+        state->heldCache = huffmanCache;
+        state->comboHuffman = cached;
+        state->huffman = cached;
+        return true;
+    }
+
+    const void* built = NULL;
     if (state->type == EDTDefault) {
         /* The default type of entropy decoder (consisting of 3 huffman streams: lsb, msb, and rl)
          * uses a triple-decoder as an optimisation. */
-        VNCheckB(huffmanTripleInitialize(&state->comboHuffman, &state->hstream, bitstreamVersion));
+        VNCheckB(
+            huffmanTripleInitialize(&state->builtComboHuffman, &state->hstream, bitstreamVersion));
+        state->comboHuffman = &state->builtComboHuffman;
+        built = &state->builtComboHuffman;
     } else {
         /* Other entropy decodes just have two huffman streams (or, HuffTemporalCount, which equals
          * HuffSizeCount), so initialize each. */
         for (uint8_t huffType = 0; huffType < HuffTemporalCount; huffType++) {
-            huffmanManualInitializeWithLut(&state->huffman[huffType].manualState,
-                                           &state->huffman[huffType].table, &state->hstream,
+            huffmanManualInitializeWithLut(&state->builtHuffman[huffType].manualState,
+                                           &state->builtHuffman[huffType].table, &state->hstream,
                                            bitstreamVersion);
         }
+        state->huffman = state->builtHuffman;
+        built = state->builtHuffman;
+    }
+
+    if (huffmanCache) {
+        huffmanCacheInsert(huffmanCache, &cacheKey, built);
     }
 
     return true;
@@ -150,7 +176,7 @@ static int32_t getNextSymbolTemporalAndHuffman(EntropyDecoder* state)
 /*------------------------------------------------------------------------------*/
 
 bool entropyInitialize(EntropyDecoder* state, const LdeChunk* chunk, const EntropyDecoderType type,
-                       const uint8_t bitstreamVersion)
+                       const uint8_t bitstreamVersion, LdeHuffmanCache* huffmanCache)
 {
     if (state == NULL || chunk == NULL) {
         VNLogError("Cannot initialize entropy decoder - state or chunk NULL");
@@ -158,6 +184,9 @@ bool entropyInitialize(EntropyDecoder* state, const LdeChunk* chunk, const Entro
     }
 
     /* Shared state. */
+    entropyRelease(state);
+    state->huffman = NULL;
+    state->comboHuffman = NULL;
     state->currHuff = 0;
     state->rawOffset = 0;
     state->rleOnly = false;
@@ -166,11 +195,19 @@ bool entropyInitialize(EntropyDecoder* state, const LdeChunk* chunk, const Entro
     state->type = type;
 
     /* Syntax specific setup. */
-    VNCheckB(chunkInitialize(state, chunk, bitstreamVersion));
+    VNCheckB(chunkInitialize(state, chunk, bitstreamVersion, huffmanCache));
 
     return true;
 }
 
+void entropyRelease(EntropyDecoder* state)
+{
+    if (state->heldCache) {
+        huffmanCacheRelease(state->heldCache, state->heldCacheEntry);
+        state->heldCache = NULL;
+    }
+}
+
 #define VN_ENTROPY_DECODE_DEFINE(symbolGetterFn)                                       \
     static int32_t entropyDecode_##symbolGetterFn(EntropyDecoder* state, int16_t* out) \
     {                                                                                  \
@@ -260,7 +297,7 @@ int32_t entropyDecode(EntropyDecoder* state, int16_t* out)
         return entropyDecode_getNextSymbolRLEOnly(state, out);
     }
 
-    return huffmanTripleDecode(&state->comboHuffman, &state->hstream, out);
+    return huffmanTripleDecode(state->comboHuffman, &state->hstream, out);
 }
 
 int32_t entropyDecodeTemporal(EntropyDecoder* state, TemporalSignal* out)
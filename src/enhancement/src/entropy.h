@@ -49,8 +49,13 @@ typedef struct EntropyDecoder
 {
     uint8_t currHuff;
     uint32_t rawOffset;
-    HuffmanSingleDecoder_t huffman[HuffTemporalCount]; // Note that HuffTemporalCount == HuffSizeCount
-    HuffmanTripleDecodeState comboHuffman;
+    // Decoders in use - either the ones built below, or ones held in the Huffman cache
+    const HuffmanSingleDecoder_t* huffman; // Note that HuffTemporalCount == HuffSizeCount
+    const HuffmanTripleDecodeState* comboHuffman;
+    HuffmanSingleDecoder_t builtHuffman[HuffTemporalCount];
+    HuffmanTripleDecodeState builtComboHuffman;
+    LdeHuffmanCache* heldCache; // Cache holding the decoders in use, or NULL
+    uint32_t heldCacheEntry;
     HuffmanStream hstream;
     bool rleOnly;
     const uint8_t* rleData;
@@ -66,11 +71,19 @@ typedef struct EntropyDecoder
  *  \param chunk              chunk to use for this layer.
  *  \param type               specifies the type of layer decoder to prepare for this chunk.
  *  \param bitstreamVersion   Stream version (streams that lack this are treated as "current"
+ *  \param huffmanCache       Cache of built Huffman decoders shared between chunks, or NULL
  *
  *  \return True on success, otherwise false.
  */
 bool entropyInitialize(EntropyDecoder* state, const LdeChunk* chunk, EntropyDecoderType type,
-                       uint8_t bitstreamVersion);
+                       uint8_t bitstreamVersion, LdeHuffmanCache* huffmanCache);
+
+/*! \brief Release any decoders the entropy decoder holds in the Huffman cache. The decoder may
+ *         be initialized again afterwards.
+ *
+ *  \param state              state of the decoder to release
+ */
+void entropyRelease(EntropyDecoder* state);
 
 /*! \brief Decode the next coefficient from a stream. Coefficients are the things that get
  *         transformed ("Inverse hadamard transformed") to produce residuals.
@@ -276,6 +276,54 @@ static int16_t huffmanManualInitializeCommon(HuffmanManualDecodeState* state, Hu
     return orderIdx;
 }
 
+bool huffmanHeaderSkip(HuffmanStream* stream, uint8_t bitstreamVersion)
+{
+    /* Reads exactly the fields that huffmanManualInitializeCommon reads, without building anything.
+     * Failures are quiet, as the caller falls back to a full initialization which reports them. */
+    uint32_t minCodeLength = 0;
+    uint32_t maxCodeLength = 0;
+    uint32_t bits = 0;
+    if (huffmanStreamReadBits(stream, 5, &minCodeLength) != 0 ||
+        huffmanStreamReadBits(stream, 5, &maxCodeLength) != 0 || maxCodeLength < minCodeLength) {
+        return false;
+    }
+    if (minCodeLength == VN_MAX_CODE_LENGTH && maxCodeLength == VN_MAX_CODE_LENGTH) {
+        return true;
+    }
+    if (minCodeLength == 0 && maxCodeLength == 0) {
+        return huffmanStreamReadBits(stream, 8, &bits) == 0;
+    }
+
+    const int8_t lengthBits = bitWidth((uint8_t)(maxCodeLength - minCodeLength), bitstreamVersion);
+    if (lengthBits < 0 || huffmanStreamReadBits(stream, 1, &bits) != 0) {
+        return false;
+    }
+
+    if (bits) {
+        /* Presence bitmap, with a length for each present symbol */
+        for (int32_t i = 0; i < VN_MAX_NUM_SYMBOLS; ++i) {
+            if (huffmanStreamReadBits(stream, 1, &bits) != 0 ||
+                (bits && huffmanStreamReadBits(stream, (uint8_t)lengthBits, &bits) != 0)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* Symbol count, then a symbol and length for each */
+    uint32_t symbolCount = 0;
+    if (huffmanStreamReadBits(stream, 5, &symbolCount) != 0 || symbolCount == 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < symbolCount; ++i) {
+        if (huffmanStreamReadBits(stream, 8, &bits) != 0 ||
+            huffmanStreamReadBits(stream, (uint8_t)lengthBits, &bits) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /* Declare this so that we can have a tag-team pair of recursive functions. */
 static uint16_t huffmanIterateRls(HuffmanTripleTable* huffmanTableOut, const HuffmanTable* rlTable,
                                   const HuffmanList* rlList, uint16_t parentStartIdx,
@@ -483,8 +531,8 @@ bool huffmanStreamInitialize(HuffmanStream* stream, const uint8_t* data, size_t
         return false;
     }
 
-    stream->wordEndBit = 32;
-    stream->wordStartBit = 32;
+    stream->wordEndBit = 64;
+    stream->wordStartBit = 64;
     stream->bitsRead = 0;
     stream->word = 0;
 
@@ -559,7 +607,7 @@ bool huffmanManualDecode(const HuffmanManualDecodeState* state, HuffmanStream* s
 
             /* Found it! Now advance wordStartBit, so we're no longer looking at those bits. */
             stream->wordStartBit += entry->bits;
-            assert(stream->wordStartBit <= 32);
+            assert(stream->wordStartBit <= 64);
             *symbolOut = entry->symbol;
             return true;
         }
@@ -599,7 +647,7 @@ bool huffmanLutDecode(const HuffmanTable* rlTable, HuffmanStream* stream, uint8_
     uint8_t bits = rlTable->code[lutIdx].bits;
     stream->wordStartBit += bits;
     if (bits != 0) {
-        assert(stream->wordStartBit <= 32);
+        assert(stream->wordStartBit <= 64);
         *symbolOut = rlTable->code[lutIdx].symbol;
         return true;
     }
@@ -640,7 +688,7 @@ int32_t huffmanTripleDecode(const HuffmanTripleDecodeState* state, HuffmanStream
     HuffmanTriple triplet = table->code[lutIdx];
     uint8_t bits = getBits(triplet.contents);
     stream->wordStartBit += bits;
-    assert(stream->wordStartBit <= 32);
+    assert(stream->wordStartBit <= 64);
 
     /* Quickly dismiss the fast case: */
     if (!isIncomplete(triplet.contents)) {
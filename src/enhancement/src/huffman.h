@@ -17,6 +17,8 @@
 
 #include "bitstream.h"
 
+#include <LCEVC/enhancement/huffman_cache.h>
+
 /* These must add up to VN_BIG_TABLE_MAX_SIZE*/
 #define VN_BIG_TABLE_LEADING_ZEROES_BITS 4
 #define VN_BIG_TABLE_MAX_CODE_SIZE 8
@@ -68,7 +70,7 @@ static inline bool nextSymbolIsRL(uint8_t symbol) { return (symbol & 0x80); }
 typedef struct HuffmanStream
 {
     ByteStream byteStream;
-    uint32_t word;
+    uint64_t word;
     uint8_t wordStartBit;
     uint8_t wordEndBit;
     uint64_t bitsRead;
@@ -154,6 +156,15 @@ typedef struct HuffmanTripleDecodeState
     HuffmanManualDecodeState manualStates[HuffCount]; /**< Individual decoders, as a double-fallback */
 } HuffmanTripleDecodeState;
 
+/*! \brief Read past one code-length header without building a decoder from it. Used to find the
+ *         extent of the headers at the start of a chunk, to key the Huffman cache.
+ *
+ *  \param stream            Huffman stream positioned at the start of a header
+ *  \param bitstreamVersion  The bitstream version number to decode with
+ *
+ *  \return True if a complete and valid header was read, otherwise false. */
+bool huffmanHeaderSkip(HuffmanStream* stream, uint8_t bitstreamVersion);
+
 /*! \brief Initialize a triple huffman decoder
  *
  *  \param state   Triple-decoder to initialize
@@ -186,23 +197,23 @@ bool huffmanStreamInitialize(HuffmanStream* stream, const uint8_t* data, size_t
 /*! \brief Get number of remaining bits on the HuffmanStream_t */
 static inline size_t huffmanStreamGetRemainingBits(const HuffmanStream* stream)
 {
-    const size_t wordBitsRemaining = 32 - stream->wordEndBit;
+    const size_t wordBitsRemaining = 64 - stream->wordEndBit;
     const size_t byteBitsRemaining = bytestreamRemaining(&stream->byteStream) * 8;
     return wordBitsRemaining + byteBitsRemaining;
 }
 
-/*! \brief Extract bits from the middle of a number.
+/*! \brief Extract at most 32 bits from the middle of a word.
  *
  *  \param startBit The first bit that you want, inclusive
  *  \param endBit   The last bit that you want, exclusive
  *
  *  \return         The bits in the specified interval, right-aligned. For example,
- *                  extract(0xf0f1f2f3, 8, 20) returns 0x00000f1f
+ *                  extract(0xf0f1f2f3f4f5f6f7, 8, 20) returns 0x00000f1f
  */
-static inline uint32_t extractBits(uint32_t data, uint8_t startBit, uint8_t endBit)
+static inline uint32_t extractBits(uint64_t data, uint8_t startBit, uint8_t endBit)
 {
-    const uint32_t mask = (1 << (endBit - startBit)) - 1;
-    return (data >> (32 - endBit)) & mask;
+    const uint64_t mask = ((uint64_t)1 << (endBit - startBit)) - 1;
+    return (uint32_t)((data >> (64 - endBit)) & mask);
 }
 
 /*! \brief Advance the Huffman stream BY a certain number of bits. Can be used directly, if you
@@ -215,7 +226,7 @@ static inline uint32_t extractBits(uint32_t data, uint8_t startBit, uint8_t endB
  * knowing whether they're already in word, or need to come off of byteStream. */
 static inline void huffmanStreamAdvanceByNBits(HuffmanStream* stream, uint8_t bits)
 {
-    /* Can only read, at most, 25 bits (if word is 32 bits). If we try to read more, we risk
+    /* Can only read, at most, 57 bits (as word is 64 bits). If we try to read more, we risk
      * pushing wordStartBit below zero, because we read 8 bits at a time. */
     assert(bits <= (8 * (sizeof(stream->word)) - 7));
 
@@ -223,18 +234,32 @@ static inline void huffmanStreamAdvanceByNBits(HuffmanStream* stream, uint8_t bi
     stream->bitsRead += bits;
 
     if (stream->wordEndBit > (8 * sizeof(stream->word))) {
-        /* If wordEndBit is past the end, then shuffle data in from the right to the left, 8 bits at
-         * a time, until wordStartBit is as far left as possible. This helps us access the
-         * byteStream as rarely as possible. */
-        while (stream->wordStartBit > 7) {
-            stream->word <<= 8;
-            if (stream->byteStream.offset < stream->byteStream.size) {
-                stream->word |= *(stream->byteStream.data + stream->byteStream.offset);
-                stream->byteStream.offset++;
+        /* If wordEndBit is past the end, then shuffle data in from the right to the left, a whole
+         * number of bytes at once, until wordStartBit is as far left as possible. This helps us
+         * access the byteStream as rarely as possible. */
+        const uint8_t shift = (uint8_t)(stream->wordStartBit & ~7);
+        const size_t offset = stream->byteStream.offset;
+        assert(shift > 0);
+
+        if (offset + sizeof(stream->word) <= stream->byteStream.size) {
+            /* Away from the end of the stream, a single unaligned load covers every byte that can
+             * be shifted in. The shift is split in two, as it may be the whole word. */
+            uint64_t next = 0;
+            readU64(stream->byteStream.data + offset, &next);
+            stream->word = ((stream->word << 1) << (shift - 1)) | (next >> (64 - shift));
+            stream->byteStream.offset += shift >> 3;
+        } else {
+            /* Near the end, read byte by byte, shifting in zeros past the end of the data. */
+            for (uint8_t i = 0; i < shift; i += 8) {
+                stream->word <<= 8;
+                if (stream->byteStream.offset < stream->byteStream.size) {
+                    stream->word |= *(stream->byteStream.data + stream->byteStream.offset);
+                    stream->byteStream.offset++;
+                }
             }
-            stream->wordStartBit -= 8;
-            stream->wordEndBit -= 8;
         }
+        stream->wordStartBit -= shift;
+        stream->wordEndBit -= shift;
     }
 }
 
@@ -332,6 +357,58 @@ bool huffmanManualDecode(const HuffmanManualDecodeState* state, HuffmanStream* s
  *  \return True if this decoder is a single-symbol decoder, otherwise false */
 bool huffmanGetSingleSymbol(const HuffmanManualDecodeState* state, uint8_t* symbolOut);
 
+/*- Huffman cache -------------------------------------------------------------------------------*/
+
+/*! \brief The shape of decoder built from a set of headers - a triple-decoder from 3 headers (LSB,
+ *         MSB and RL), or a pair of single-decoders from 2 headers (temporal or sizes). */
+typedef enum HuffmanCacheKind
+{
+    HCKTriple = 0,
+    HCKSinglePair,
+    HCKCount
+} HuffmanCacheKind;
+
+/*! \brief The headers at the start of a chunk, as located by huffmanCacheFetch. */
+typedef struct HuffmanCacheKey
+{
+    const uint8_t* data; /**< Start of the headers in the chunk */
+    uint32_t bits;       /**< Length of the headers, or 0 if they cannot be cached */
+    uint64_t hash;
+    HuffmanCacheKind kind;
+    uint8_t bitstreamVersion;
+} HuffmanCacheKey;
+
+/*! \brief Look for a decoder built from the headers at the start of a stream.
+ *
+ *  \param cache            Cache to search
+ *  \param kind             Shape of decoder wanted
+ *  \param bitstreamVersion Bitstream version the headers are decoded with
+ *  \param stream           Freshly initialized stream over the chunk. Advanced past the headers on
+ *                          a hit, otherwise left unchanged.
+ *  \param key              Filled in for passing to huffmanCacheInsert after a miss
+ *  \param entry            Set on a hit, for passing to huffmanCacheRelease
+ *  \param decoder          Set on a hit to the cached HuffmanTripleDecodeState, or
+ *                          HuffmanSingleDecoder_t[2], which stays valid until released
+ *
+ *  \return True if a decoder was found in the cache, otherwise false. */
+bool huffmanCacheFetch(LdeHuffmanCache* cache, HuffmanCacheKind kind, uint8_t bitstreamVersion,
+                       HuffmanStream* stream, HuffmanCacheKey* key, uint32_t* entry,
+                       const void** decoder);
+
+/*! \brief Release a decoder found by huffmanCacheFetch, so that its entry can be replaced.
+ *
+ *  \param cache   Cache the decoder was found in
+ *  \param entry   Entry from the successful huffmanCacheFetch */
+void huffmanCacheRelease(LdeHuffmanCache* cache, uint32_t entry);
+
+/*! \brief Insert a copy of a decoder built after a miss, replacing the least recently used entry
+ *         that is not in use if full.
+ *
+ *  \param cache   Cache to insert into
+ *  \param key     Key from the failed huffmanCacheFetch
+ *  \param decoder Newly built decoder, of the kind given in the key */
+void huffmanCacheInsert(LdeHuffmanCache* cache, const HuffmanCacheKey* key, const void* decoder);
+
 /*------------------------------------------------------------------------------*/
 
 #endif // VN_LCEVC_ENHANCEMENT_HUFFMAN_H
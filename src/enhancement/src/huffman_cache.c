@@ -0,0 +1,266 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include "huffman.h"
+
+#include <assert.h>
+#include <LCEVC/common/diagnostics.h>
+#include <LCEVC/common/log.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/common/printf_macros.h>
+#include <LCEVC/common/threads.h>
+#include <LCEVC/enhancement/huffman_cache.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------------*/
+
+/* Largest possible headers for a triple-decoder: each of the 3 has 11 bits of lengths and flags,
+ * then a presence bitmap of 256 symbols with up to 6 bits of length each. */
+#define VN_HUFFMAN_CACHE_MAX_KEY_BYTES ((3 * (11 + VN_MAX_NUM_SYMBOLS * 7) + 7) / 8)
+
+typedef union HuffmanCacheDecoder
+{
+    HuffmanTripleDecodeState triple;
+    HuffmanSingleDecoder_t singlePair[2];
+} HuffmanCacheDecoder;
+
+typedef struct HuffmanCacheEntry
+{
+    uint64_t hash;
+    uint64_t lastUse;  /**< 0 for an entry that is unused, or still being written */
+    uint32_t refCount; /**< Decoders using the entry, which may not be replaced until released */
+    uint32_t bits;
+    HuffmanCacheKind kind;
+    uint8_t bitstreamVersion;
+    uint8_t key[VN_HUFFMAN_CACHE_MAX_KEY_BYTES]; /**< Header bits, with any trailing bits zeroed */
+    HuffmanCacheDecoder decoder;
+} HuffmanCacheEntry;
+
+static const uint32_t kHeaderCount[HCKCount] = {HuffCount, 2};
+static const size_t kDecoderSize[HCKCount] = {sizeof(HuffmanTripleDecodeState),
+                                              2 * sizeof(HuffmanSingleDecoder_t)};
+
+/*------------------------------------------------------------------------------*/
+
+/* Last byte of the headers, with any bits following them zeroed */
+static inline uint8_t keyLastByte(const uint8_t* data, uint32_t bits)
+{
+    const uint32_t trailingBits = (8 - (bits & 7)) & 7;
+    return (uint8_t)(data[(bits - 1) >> 3] & (0xFF << trailingBits));
+}
+
+/* FNV-1a hash of the header bits, as for the global configs in the config pool */
+static uint64_t hashKey(const uint8_t* data, uint32_t bits, HuffmanCacheKind kind,
+                        uint8_t bitstreamVersion)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const uint32_t wholeBytes = (bits - 1) >> 3;
+
+    for (uint32_t i = 0; i < wholeBytes; ++i) {
+        hash = (hash ^ data[i]) * 0x100000001b3ULL;
+    }
+    hash = (hash ^ keyLastByte(data, bits)) * 0x100000001b3ULL;
+    hash = (hash ^ (uint64_t)kind) * 0x100000001b3ULL;
+    hash = (hash ^ bitstreamVersion) * 0x100000001b3ULL;
+
+    return hash;
+}
+
+static bool keyMatches(const HuffmanCacheEntry* entry, const HuffmanCacheKey* key)
+{
+    if (entry->lastUse == 0 || entry->hash != key->hash || entry->bits != key->bits ||
+        entry->kind != key->kind || entry->bitstreamVersion != key->bitstreamVersion) {
+        return false;
+    }
+
+    const uint32_t wholeBytes = (key->bits - 1) >> 3;
+    return memcmp(entry->key, key->data, wholeBytes) == 0 &&
+           entry->key[wholeBytes] == keyLastByte(key->data, key->bits);
+}
+
+static void reportStats(const LdeHuffmanCache* cache)
+{
+    VNMetricUInt32("huffmanCacheHits", cache->hits);
+    VNMetricUInt32("huffmanCacheMisses", cache->misses);
+}
+
+/*------------------------------------------------------------------------------*/
+
+bool ldeHuffmanCacheInitialize(LdcMemoryAllocator* allocator, LdeHuffmanCache* cache,
+                               uint32_t capacity)
+{
+    memset(cache, 0, sizeof(LdeHuffmanCache));
+
+    if (capacity == 0) {
+        VNLogError("Huffman cache capacity must be non-zero");
+        return false;
+    }
+    if (!VNAllocateZeroArray(allocator, &cache->entriesAllocation, HuffmanCacheEntry, capacity)) {
+        VNLogError("Unable to allocate Huffman cache entries");
+        return false;
+    }
+
+    cache->allocator = allocator;
+    cache->capacity = capacity;
+    threadMutexInitialize(&cache->mutex);
+    return true;
+}
+
+void ldeHuffmanCacheRelease(LdeHuffmanCache* cache)
+{
+    if (!cache->allocator) {
+        return;
+    }
+
+    VNLogDebug("Huffman cache released after %" PRIu64 " hits and %" PRIu64 " misses", cache->hits,
+               cache->misses);
+    threadMutexDestroy(&cache->mutex);
+    VNFree(cache->allocator, &cache->entriesAllocation);
+    cache->allocator = NULL;
+}
+
+void ldeHuffmanCacheGetStats(LdeHuffmanCache* cache, uint64_t* hits, uint64_t* misses)
+{
+    threadMutexLock(&cache->mutex);
+    if (hits) {
+        *hits = cache->hits;
+    }
+    if (misses) {
+        *misses = cache->misses;
+    }
+    threadMutexUnlock(&cache->mutex);
+}
+
+/*------------------------------------------------------------------------------*/
+
+bool huffmanCacheFetch(LdeHuffmanCache* cache, HuffmanCacheKind kind, uint8_t bitstreamVersion,
+                       HuffmanStream* stream, HuffmanCacheKey* key, uint32_t* entry,
+                       const void** decoder)
+{
+    assert(stream->bitsRead == 0);
+
+    key->bits = 0;
+    if (cache->capacity == 0) {
+        return false;
+    }
+
+    key->data = stream->byteStream.data;
+    key->kind = kind;
+    key->bitstreamVersion = bitstreamVersion;
+
+    /* Find the extent of the headers on a copy of the stream, so a miss leaves it untouched for
+     * the full initialization. Anything that does not read cleanly is left to that too. */
+    HuffmanStream headerStream = *stream;
+    for (uint32_t header = 0; header < kHeaderCount[kind]; ++header) {
+        if (!huffmanHeaderSkip(&headerStream, bitstreamVersion)) {
+            return false;
+        }
+    }
+    if (headerStream.bitsRead == 0 || headerStream.bitsRead > VN_HUFFMAN_CACHE_MAX_KEY_BYTES * 8) {
+        return false;
+    }
+    key->bits = (uint32_t)headerStream.bitsRead;
+    key->hash = hashKey(key->data, key->bits, kind, bitstreamVersion);
+
+    HuffmanCacheEntry* entries = VNAllocationPtr(cache->entriesAllocation, HuffmanCacheEntry);
+    bool found = false;
+
+    /* Entries are not changed whilst referenced, so the decoder is used in place. */
+    threadMutexLock(&cache->mutex);
+    for (uint32_t idx = 0; idx < cache->capacity; ++idx) {
+        if (keyMatches(&entries[idx], key)) {
+            entries[idx].refCount++;
+            entries[idx].lastUse = ++cache->useCounter;
+            *entry = idx;
+            *decoder = &entries[idx].decoder;
+            found = true;
+            break;
+        }
+    }
+    if (found) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+    }
+    reportStats(cache);
+    threadMutexUnlock(&cache->mutex);
+
+    if (found) {
+        *stream = headerStream;
+    }
+    return found;
+}
+
+void huffmanCacheRelease(LdeHuffmanCache* cache, uint32_t entry)
+{
+    HuffmanCacheEntry* entries = VNAllocationPtr(cache->entriesAllocation, HuffmanCacheEntry);
+
+    threadMutexLock(&cache->mutex);
+    assert(entry < cache->capacity && entries[entry].refCount > 0);
+    entries[entry].refCount--;
+    threadMutexUnlock(&cache->mutex);
+}
+
+void huffmanCacheInsert(LdeHuffmanCache* cache, const HuffmanCacheKey* key, const void* decoder)
+{
+    if (key->bits == 0 || cache->capacity == 0) {
+        return;
+    }
+
+    HuffmanCacheEntry* entries = VNAllocationPtr(cache->entriesAllocation, HuffmanCacheEntry);
+    const uint32_t wholeBytes = (key->bits - 1) >> 3;
+
+    /* Another tile may have built the same decoder since the lookup - otherwise replace the least
+     * recently used entry that is not in use, which will be an empty one while the cache is
+     * filling. If every entry is in use, the decoder is not cached. */
+    HuffmanCacheEntry* victim = NULL;
+
+    threadMutexLock(&cache->mutex);
+    for (uint32_t idx = 0; idx < cache->capacity; ++idx) {
+        if (keyMatches(&entries[idx], key)) {
+            victim = NULL;
+            break;
+        }
+        if (entries[idx].refCount == 0 && (!victim || entries[idx].lastUse < victim->lastUse)) {
+            victim = &entries[idx];
+        }
+    }
+    if (victim) {
+        /* Reserve the entry - it cannot be matched or replaced until it is written. */
+        victim->lastUse = 0;
+        victim->refCount = 1;
+    }
+    threadMutexUnlock(&cache->mutex);
+
+    if (!victim) {
+        return;
+    }
+
+    victim->hash = key->hash;
+    victim->bits = key->bits;
+    victim->kind = key->kind;
+    victim->bitstreamVersion = key->bitstreamVersion;
+    memcpy(victim->key, key->data, wholeBytes);
+    victim->key[wholeBytes] = keyLastByte(key->data, key->bits);
+    memcpy(&victim->decoder, decoder, kDecoderSize[key->kind]);
+
+    threadMutexLock(&cache->mutex);
+    victim->lastUse = ++cache->useCounter;
+    victim->refCount = 0;
+    threadMutexUnlock(&cache->mutex);
+}
+
+/*------------------------------------------------------------------------------*/
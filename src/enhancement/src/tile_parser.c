@@ -91,7 +91,7 @@ bool tiledSizeDecoderInitialize(LdcMemoryAllocator* allocator, TiledSizeDecoder*
     chunk.size = bytestreamRemaining(stream);
 
     EntropyDecoder layerDecoder = {0};
-    VNCheckB(entropyInitialize(&layerDecoder, &chunk, decoderType, bitstreamVersion));
+    VNCheckB(entropyInitialize(&layerDecoder, &chunk, decoderType, bitstreamVersion, NULL));
 
     VNLogVerbose("Tiled size decoder initialize");
 
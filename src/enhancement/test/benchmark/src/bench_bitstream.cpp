@@ -0,0 +1,148 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Throughput of the bit readers that the config parser and entropy decoder sit on. Each benchmark
+// reads a 64KiB random buffer with a fixed random sequence of read widths, and reports the rate
+// at which bits are consumed.
+//
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+extern "C"
+{
+#include "bitstream.h"
+#include "huffman.h"
+}
+
+namespace {
+
+constexpr size_t kDataSize = 64 * 1024;
+
+// Random data, and a sequence of read widths in [1, maxWidth] that fits within it
+class BitReaderFixture : public benchmark::Fixture
+{
+public:
+    void setUpWidths(uint8_t maxWidth)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<uint32_t> byteDist(0, 255);
+        data.resize(kDataSize);
+        for (uint8_t& byte : data) {
+            byte = static_cast<uint8_t>(byteDist(rng));
+        }
+
+        std::uniform_int_distribution<uint32_t> widthDist(1, maxWidth);
+        widths.clear();
+        totalBits = 0;
+        while (totalBits + maxWidth <= kDataSize * 8) {
+            widths.push_back(static_cast<uint8_t>(widthDist(rng)));
+            totalBits += widths.back();
+        }
+    }
+
+    void setBitsProcessed(benchmark::State& state) const
+    {
+        state.counters["bits"] =
+            benchmark::Counter(static_cast<double>(totalBits * state.iterations()),
+                               benchmark::Counter::kIsRate);
+    }
+
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> widths;
+    uint64_t totalBits = 0;
+};
+
+} // namespace
+
+// BitStream, as used by the config parser - checked reads of up to 24 bits
+BENCHMARK_DEFINE_F(BitReaderFixture, BitStreamReadBits)(benchmark::State& state)
+{
+    setUpWidths(24);
+    for (auto _ : state) {
+        BitStream stream;
+        bitstreamInitialize(&stream, data.data(), data.size());
+        int32_t sum = 0;
+        for (const uint8_t width : widths) {
+            int32_t value = 0;
+            bitstreamReadBits(&stream, width, &value);
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setBitsProcessed(state);
+}
+
+// BitStream unchecked reads of up to 24 bits
+BENCHMARK_DEFINE_F(BitReaderFixture, BitStreamReadBitsUnchecked)(benchmark::State& state)
+{
+    setUpWidths(24);
+    for (auto _ : state) {
+        BitStream stream;
+        bitstreamInitialize(&stream, data.data(), data.size());
+        int32_t sum = 0;
+        for (const uint8_t width : widths) {
+            int32_t value = 0;
+            bitstreamReadBitsUnchecked(&stream, width, &value);
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setBitsProcessed(state);
+}
+
+// HuffmanStream as used by the small look-up table decoders - peek VN_SMALL_TABLE_MAX_SIZE bits,
+// then consume up to that many
+BENCHMARK_DEFINE_F(BitReaderFixture, HuffmanStreamLut)(benchmark::State& state)
+{
+    setUpWidths(VN_SMALL_TABLE_MAX_SIZE);
+    for (auto _ : state) {
+        HuffmanStream stream;
+        huffmanStreamInitialize(&stream, data.data(), data.size());
+        uint32_t sum = 0;
+        for (const uint8_t width : widths) {
+            sum += huffmanStreamAdvanceToNthBit(&stream, VN_SMALL_TABLE_MAX_SIZE);
+            stream.wordStartBit += width;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setBitsProcessed(state);
+}
+
+// HuffmanStream as used by the triple decoder - top up to VN_BIG_TABLE_CODE_SIZE_TO_READ bits,
+// then consume up to that many
+BENCHMARK_DEFINE_F(BitReaderFixture, HuffmanStreamTriple)(benchmark::State& state)
+{
+    setUpWidths(VN_BIG_TABLE_CODE_SIZE_TO_READ);
+    for (auto _ : state) {
+        HuffmanStream stream;
+        huffmanStreamInitialize(&stream, data.data(), data.size());
+        uint32_t sum = 0;
+        for (const uint8_t width : widths) {
+            huffmanStreamAdvanceByNBits(&stream, VN_BIG_TABLE_CODE_SIZE_TO_READ -
+                                                     (stream.wordEndBit - stream.wordStartBit));
+            sum += extractBits(stream.word, stream.wordStartBit, stream.wordEndBit);
+            stream.wordStartBit += width;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setBitsProcessed(state);
+}
+
+BENCHMARK_REGISTER_F(BitReaderFixture, BitStreamReadBits);
+BENCHMARK_REGISTER_F(BitReaderFixture, BitStreamReadBitsUnchecked);
+BENCHMARK_REGISTER_F(BitReaderFixture, HuffmanStreamLut);
+BENCHMARK_REGISTER_F(BitReaderFixture, HuffmanStreamTriple);
@@ -80,12 +80,14 @@ int main(int argc, char** argv)
                     ldeCmdBufferCpuReset(&cmdBufferCpu, transformSize);
                     ldeCmdBufferGpuReset(&cmdBufferGpu, &cmdBufferGpuBuilder, transformSize);
                     if (!ldeDecodeEnhancement(&globalConfig, &frameConfig, static_cast<LdeLOQIndex>(loqIdx),
-                                              planeIdx, tileIdx, &cmdBufferCpu, nullptr, nullptr)) {
+                                              planeIdx, tileIdx, &cmdBufferCpu, nullptr, nullptr,
+                                              nullptr)) {
                         return EXIT_FAILURE;
                     }
                     if (!ldeDecodeEnhancement(&globalConfig, &frameConfig,
                                               static_cast<LdeLOQIndex>(loqIdx), planeIdx, tileIdx,
-                                              nullptr, &cmdBufferGpu, &cmdBufferGpuBuilder)) {
+                                              nullptr, &cmdBufferGpu, &cmdBufferGpuBuilder,
+                                              nullptr)) {
                         return EXIT_FAILURE;
                     }
                     fmt::print("Frame {} LOQ{} plane {} tile {} has {} CPU commands, {} GPU "
@@ -14,9 +14,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 extern "C"
 {
 #include "bitstream.h"
+#include "huffman.h"
 }
 
 // -----------------------------------------------------------------------------
@@ -99,4 +104,120 @@ TEST(BitStream, ReadBitDeath)
 #endif
 }
 
-// -----------------------------------------------------------------------------
\ No newline at end of file
+// -----------------------------------------------------------------------------
+
+namespace {
+
+// Straightforward MSB-first reader, returning zeros past the end of the data
+class ReferenceBitReader
+{
+public:
+    explicit ReferenceBitReader(const std::vector<uint8_t>& data)
+        : m_data(data)
+    {}
+
+    uint32_t peek(uint8_t numBits) const
+    {
+        uint32_t value = 0;
+        for (size_t bit = m_position; bit < m_position + numBits; ++bit) {
+            const uint32_t byte = (bit / 8 < m_data.size()) ? m_data[bit / 8] : 0;
+            value = (value << 1) | ((byte >> (7 - (bit % 8))) & 1);
+        }
+        return value;
+    }
+
+    uint32_t read(uint8_t numBits)
+    {
+        const uint32_t value = peek(numBits);
+        m_position += numBits;
+        return value;
+    }
+
+    size_t remaining() const { return m_data.size() * 8 - m_position; }
+
+private:
+    const std::vector<uint8_t>& m_data;
+    size_t m_position = 0;
+};
+
+std::vector<uint8_t> randomData(std::mt19937& rng, size_t size)
+{
+    std::uniform_int_distribution<uint32_t> byteDist(0, 255);
+    std::vector<uint8_t> data(size);
+    for (uint8_t& byte : data) {
+        byte = static_cast<uint8_t>(byteDist(rng));
+    }
+    return data;
+}
+
+} // namespace
+
+// Reads of random widths, crossing word boundaries and the partial word at the end of streams
+// whose sizes are not a multiple of the word size.
+TEST(BitStream, ReadBitsMatchesReference)
+{
+    std::mt19937 rng(42);
+    for (size_t size = 1; size < 40; ++size) {
+        const std::vector<uint8_t> data = randomData(rng, size);
+        ReferenceBitReader reference(data);
+        BitStream stream = {};
+        ASSERT_TRUE(bitstreamInitialize(&stream, data.data(), data.size()));
+
+        std::uniform_int_distribution<uint32_t> widthDist(0, kMaxBitsAtOnce);
+        while (reference.remaining() > 0) {
+            const auto numBits = static_cast<uint8_t>(widthDist(rng));
+            if (numBits == 0) {
+                uint8_t bit = 0;
+                ASSERT_TRUE(bitstreamReadBit(&stream, &bit));
+                EXPECT_EQ(bit, reference.read(1));
+            } else if (numBits <= reference.remaining()) {
+                int32_t value = 0;
+                ASSERT_TRUE(bitstreamReadBits(&stream, numBits, &value));
+                EXPECT_EQ(static_cast<uint32_t>(value), reference.read(numBits));
+            } else {
+                // Too few bits left, which must fail without consuming anything
+                int32_t value = 0;
+                EXPECT_FALSE(bitstreamReadBits(&stream, numBits, &value));
+            }
+            EXPECT_EQ(bitstreamGetRemainingBits(&stream), reference.remaining());
+        }
+
+        uint8_t bit = 0;
+        EXPECT_FALSE(bitstreamReadBit(&stream, &bit));
+        EXPECT_EQ(bitstreamGetConsumedBytes(&stream), size);
+    }
+}
+
+// The two ways the entropy decoder fills its window: topping up to a fixed number of bits for the
+// look-up tables, and growing the window one bit at a time for the sorted-list fallback.
+TEST(HuffmanStream, AdvanceMatchesReference)
+{
+    std::mt19937 rng(42);
+    for (size_t size = 1; size < 64; ++size) {
+        const std::vector<uint8_t> data = randomData(rng, size);
+        ReferenceBitReader reference(data);
+        HuffmanStream stream = {};
+        ASSERT_TRUE(huffmanStreamInitialize(&stream, data.data(), data.size()));
+
+        std::uniform_int_distribution<uint32_t> widthDist(1, VN_BIG_TABLE_CODE_SIZE_TO_READ);
+        while (reference.remaining() > 0) {
+            const auto window = static_cast<uint8_t>(widthDist(rng));
+            if (window % 2) {
+                EXPECT_EQ(huffmanStreamAdvanceToNthBit(&stream, window), reference.peek(window));
+            } else {
+                for (uint8_t bits = 1; bits <= window; ++bits) {
+                    EXPECT_EQ(huffmanStreamAdvanceToNthBit(&stream, bits), reference.peek(bits));
+                }
+            }
+
+            const auto consumed = static_cast<uint8_t>(std::uniform_int_distribution<uint32_t>(
+                1, std::min<size_t>(window, reference.remaining()))(rng));
+            stream.wordStartBit += consumed;
+            reference.read(consumed);
+        }
+
+        EXPECT_EQ(stream.bitsRead - (stream.wordEndBit - stream.wordStartBit), size * 8);
+    }
+}
+
+// -----------------------------------------------------------------------------
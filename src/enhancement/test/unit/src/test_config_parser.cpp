@@ -191,3 +191,100 @@ TEST_F(ConfigParserTest, checkHDRParams)
 
     ldeConfigsReleaseFrame(&frameConfig);
 }
+
+static void expectSameChunks(const LdeFrameConfig& expected, const LdeFrameConfig& actual)
+{
+    ASSERT_EQ(expected.numChunks, actual.numChunks);
+    for (uint32_t i = 0; i < expected.numChunks; ++i) {
+        EXPECT_EQ(expected.chunks[i].rleOnly, actual.chunks[i].rleOnly);
+        EXPECT_EQ(expected.chunks[i].entropyEnabled, actual.chunks[i].entropyEnabled);
+        ASSERT_EQ(expected.chunks[i].size, actual.chunks[i].size);
+        if (expected.chunks[i].size) {
+            EXPECT_EQ(memcmp(expected.chunks[i].data, actual.chunks[i].data, expected.chunks[i].size), 0);
+        }
+    }
+}
+
+TEST_F(ConfigParserTest, parseInPlace)
+{
+    openAsset("decode_temp_on.bin");
+    const auto frame = getFrame();
+    bool globalConfigModified = false;
+    EXPECT_TRUE(ldeConfigsParse(frame.data(), frame.size(), &globalConfig, &frameConfig,
+                                &globalConfigModified));
+
+    LdeGlobalConfig inPlaceGlobalConfig = {};
+    LdeFrameConfig inPlaceFrameConfig = {};
+    ldeGlobalConfigInitialize(BitstreamVersionUnspecified, &inPlaceGlobalConfig);
+    ldeFrameConfigInitialize(allocator, &inPlaceFrameConfig);
+
+    auto inPlace = frame;
+    EXPECT_TRUE(ldeConfigsParseInPlace(inPlace.data(), inPlace.size(), false, &inPlaceGlobalConfig,
+                                       &inPlaceFrameConfig, &globalConfigModified));
+    EXPECT_TRUE(globalConfigModified);
+    EXPECT_FALSE(VNIsAllocated(inPlaceFrameConfig.unencapsulatedAllocation));
+    EXPECT_EQ(memcmp(&globalConfig, &inPlaceGlobalConfig, sizeof(LdeGlobalConfig)), 0);
+    EXPECT_EQ(frameConfig.nalType, inPlaceFrameConfig.nalType);
+    expectSameChunks(frameConfig, inPlaceFrameConfig);
+
+    // Chunks should point into the caller's buffer
+    for (uint32_t i = 0; i < inPlaceFrameConfig.numChunks; ++i) {
+        if (inPlaceFrameConfig.chunks[i].size) {
+            EXPECT_GE(inPlaceFrameConfig.chunks[i].data, inPlace.data());
+            EXPECT_LE(inPlaceFrameConfig.chunks[i].data + inPlaceFrameConfig.chunks[i].size,
+                      inPlace.data() + inPlace.size());
+        }
+    }
+
+    ldeConfigsReleaseFrame(&inPlaceFrameConfig);
+    ldeConfigsReleaseFrame(&frameConfig);
+}
+
+TEST_F(ConfigParserTest, parseUnescaped)
+{
+    openAsset("decode_temp_on.bin");
+    const auto frame = getFrame();
+    bool globalConfigModified = false;
+    EXPECT_TRUE(ldeConfigsParse(frame.data(), frame.size(), &globalConfig, &frameConfig,
+                                &globalConfigModified));
+
+    // Strip emulation prevention bytes after the 4 byte start code and 2 byte NAL unit header
+    const size_t headerSize = (frame[2] == 1) ? 5 : 6;
+    std::vector<uint8_t> unescaped(frame.begin(), frame.begin() + headerSize);
+    uint32_t zeroes = 0;
+    for (size_t i = headerSize; i < frame.size() - 1; ++i) {
+        if (zeroes == 2 && frame[i] == 3) {
+            zeroes = 0;
+            continue;
+        }
+        zeroes = (frame[i] == 0) ? zeroes + 1 : 0;
+        unescaped.push_back(frame[i]);
+    }
+    unescaped.push_back(frame.back());
+
+    LdeGlobalConfig unescapedGlobalConfig = {};
+    LdeFrameConfig unescapedFrameConfig = {};
+    ldeGlobalConfigInitialize(BitstreamVersionUnspecified, &unescapedGlobalConfig);
+    ldeFrameConfigInitialize(allocator, &unescapedFrameConfig);
+
+    const auto original = unescaped;
+    EXPECT_TRUE(ldeConfigsParseInPlace(unescaped.data(), unescaped.size(), true,
+                                       &unescapedGlobalConfig, &unescapedFrameConfig,
+                                       &globalConfigModified));
+    EXPECT_EQ(unescaped, original);
+    EXPECT_EQ(memcmp(&globalConfig, &unescapedGlobalConfig, sizeof(LdeGlobalConfig)), 0);
+    expectSameChunks(frameConfig, unescapedFrameConfig);
+
+    ldeConfigsReleaseFrame(&unescapedFrameConfig);
+    ldeConfigsReleaseFrame(&frameConfig);
+}
+
+TEST_F(ConfigParserTest, parseMalformedNALUnit)
+{
+    std::vector<uint8_t> truncated = {0, 0, 1, 0x5d};
+    bool globalConfigModified = false;
+    EXPECT_FALSE(ldeConfigsParse(truncated.data(), truncated.size(), &globalConfig, &frameConfig,
+                                 &globalConfigModified));
+    EXPECT_FALSE(ldeConfigsParseInPlace(truncated.data(), truncated.size(), false, &globalConfig,
+                                        &frameConfig, &globalConfigModified));
+}
@@ -19,6 +19,7 @@
 #include <LCEVC/enhancement/config_pool.h>
 #include <LCEVC/utility/bin_reader.h>
 
+#include <algorithm>
 #include <filesystem>
 
 namespace filesystem = std::filesystem;
@@ -168,3 +169,31 @@ TEST_F(ConfigPoolTest, allFramesRelease)
 
     EXPECT_LE(ldcVectorSize(&configPool.globalConfigs), 1);
 }
+
+TEST_F(ConfigPoolTest, chunkArrayReuse)
+{
+    const void* previousChunks = nullptr;
+    uint32_t previousNumChunks = 0;
+    auto frame = getFrame();
+    uint64_t timestamp = 0;
+
+    while (!frame.empty()) {
+        LdeGlobalConfig* globalConfigPtr = nullptr;
+        LdeFrameConfig frameConfig = {};
+
+        EXPECT_TRUE(ldeConfigPoolFrameInsert(&configPool, timestamp, frame.data(), frame.size(),
+                                             &globalConfigPtr, &frameConfig));
+
+        // The chunk array released by the last frame is re-used if it is big enough
+        if (previousChunks && frameConfig.numChunks <= previousNumChunks) {
+            EXPECT_EQ(VNAllocationPtr(frameConfig.chunkAllocation, void), previousChunks);
+        }
+        previousChunks = VNAllocationPtr(frameConfig.chunkAllocation, void);
+        previousNumChunks = std::max(previousNumChunks, frameConfig.numChunks);
+
+        EXPECT_TRUE(ldeConfigPoolFrameRelease(&configPool, &frameConfig, globalConfigPtr));
+        EXPECT_EQ(ldcVectorSize(&configPool.chunkArrays), 1);
+        timestamp++;
+        frame = getFrame();
+    }
+}
@@ -19,6 +19,7 @@
 #include <LCEVC/enhancement/cmdbuffer_gpu.h>
 #include <LCEVC/enhancement/config_parser.h>
 #include <LCEVC/enhancement/decode.h>
+#include <LCEVC/enhancement/huffman_cache.h>
 #include <LCEVC/utility/bin_reader.h>
 #include <LCEVC/utility/md5.h>
 
@@ -81,6 +82,18 @@ public:
         return hash.hexDigest();
     }
 
+    // Decode every layer of a tile separately, as the CPU pipeline does in parallel
+    bool decodeLayers(LdeLOQIndex loq)
+    {
+        for (uint32_t layer = 0; layer < globalConfig.numLayers; ++layer) {
+            if (!ldeDecodeLayer(&globalConfig, &frameConfig, loq, 0, 0, layer, nullptr,
+                                &layerRuns)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     LdcMemoryAllocator* allocator{};
     LdcMemoryAllocation chunkAllocation = {0};
     LdeGlobalConfig globalConfig = {0};
@@ -89,6 +102,7 @@ public:
     LdeCmdBufferCpu cmdBufferCpu = {};
     LdeCmdBufferGpu cmdBufferGpu = {};
     LdeCmdBufferGpuBuilder cmdBufferGpuBuilder = {};
+    LdeLayerRuns layerRuns = {};
 
     MD5 hash;
     std::unique_ptr<BinReader> m_binReader;
@@ -116,20 +130,20 @@ TEST_F(DecodeTemporalOn, DecodeToCpuCmdBuffer)
     EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
 
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ1, 0, 0, &cmdBufferCpu,
-                                     nullptr, nullptr));
+                                     nullptr, nullptr, nullptr));
     EXPECT_EQ(cmdBufferCpu.count, 19);
     EXPECT_EQ(hashCpuBuffer(), "c0367ce3a91ed34af5040e43d598d8c2");
 
     EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, &cmdBufferCpu,
-                                     nullptr, nullptr));
+                                     nullptr, nullptr, nullptr));
     EXPECT_EQ(cmdBufferCpu.count, 344);
     EXPECT_EQ(hashCpuBuffer(), "6b5b6fdfa8d147d7e286b9b336d278eb");
 
     EXPECT_EQ(getFrame(), true);
     EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, &cmdBufferCpu,
-                                     nullptr, nullptr));
+                                     nullptr, nullptr, nullptr));
     EXPECT_EQ(cmdBufferCpu.count, 461);
     EXPECT_EQ(hashCpuBuffer(), "e7f1da13d3b99a8a470cd395e7e9c9ff");
 
@@ -142,7 +156,7 @@ TEST_F(DecodeTemporalOn, DecodeToGpuCmdBuffer)
     EXPECT_EQ(globalConfig.numLayers, 4);
     EXPECT_TRUE(ldeCmdBufferGpuReset(&cmdBufferGpu, &cmdBufferGpuBuilder, globalConfig.numLayers));
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ1, 0, 0, nullptr,
-                                     &cmdBufferGpu, &cmdBufferGpuBuilder));
+                                     &cmdBufferGpu, &cmdBufferGpuBuilder, nullptr));
     EXPECT_EQ(cmdBufferGpu.commandCount, 10);
     EXPECT_EQ(cmdBufferGpuBuilder.residualCapacity, 76);
     EXPECT_EQ(cmdBufferGpu.residualCount, 76);
@@ -150,7 +164,7 @@ TEST_F(DecodeTemporalOn, DecodeToGpuCmdBuffer)
 
     EXPECT_TRUE(ldeCmdBufferGpuReset(&cmdBufferGpu, &cmdBufferGpuBuilder, globalConfig.numLayers));
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, nullptr,
-                                     &cmdBufferGpu, &cmdBufferGpuBuilder));
+                                     &cmdBufferGpu, &cmdBufferGpuBuilder, nullptr));
     EXPECT_EQ(cmdBufferGpu.commandCount, 16);
     EXPECT_EQ(cmdBufferGpuBuilder.residualCapacity, 1376);
     EXPECT_EQ(cmdBufferGpu.residualCount, 1376);
@@ -159,7 +173,7 @@ TEST_F(DecodeTemporalOn, DecodeToGpuCmdBuffer)
     EXPECT_TRUE(getFrame());
     EXPECT_TRUE(ldeCmdBufferGpuReset(&cmdBufferGpu, &cmdBufferGpuBuilder, globalConfig.numLayers));
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, nullptr,
-                                     &cmdBufferGpu, &cmdBufferGpuBuilder));
+                                     &cmdBufferGpu, &cmdBufferGpuBuilder, nullptr));
     EXPECT_EQ(cmdBufferGpu.commandCount, 18);
     EXPECT_EQ(cmdBufferGpuBuilder.residualCapacity, 1812);
     EXPECT_EQ(cmdBufferGpu.residualCount, 1812);
@@ -174,7 +188,7 @@ TEST_F(DecodeTemporalOff, DecodeToCpuCmdBuffer)
     EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
 
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ1, 0, 0, &cmdBufferCpu,
-                                     nullptr, nullptr));
+                                     nullptr, nullptr, nullptr));
     EXPECT_EQ(cmdBufferCpu.count, 110);
     EXPECT_EQ(hashCpuBuffer(), "2c3e03aca3071a7fc1602aa0183d8e5d");
 }
@@ -185,7 +199,7 @@ TEST_F(DecodeTemporalOff, DecodeToGpuCmdBuffer)
     EXPECT_EQ(globalConfig.numLayers, 4);
     EXPECT_TRUE(ldeCmdBufferGpuReset(&cmdBufferGpu, &cmdBufferGpuBuilder, globalConfig.numLayers));
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ1, 0, 0, nullptr,
-                                     &cmdBufferGpu, &cmdBufferGpuBuilder));
+                                     &cmdBufferGpu, &cmdBufferGpuBuilder, nullptr));
     EXPECT_EQ(cmdBufferGpu.commandCount, 9);
     EXPECT_EQ(cmdBufferGpuBuilder.residualCapacity, 440);
     EXPECT_EQ(cmdBufferGpu.residualCount, 440);
@@ -193,7 +207,7 @@ TEST_F(DecodeTemporalOff, DecodeToGpuCmdBuffer)
 
     EXPECT_TRUE(ldeCmdBufferGpuReset(&cmdBufferGpu, &cmdBufferGpuBuilder, globalConfig.numLayers));
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, nullptr,
-                                     &cmdBufferGpu, &cmdBufferGpuBuilder));
+                                     &cmdBufferGpu, &cmdBufferGpuBuilder, nullptr));
     EXPECT_EQ(cmdBufferGpu.commandCount, 14);
     EXPECT_EQ(cmdBufferGpuBuilder.residualCapacity, 804);
     EXPECT_EQ(cmdBufferGpuBuilder.residualSetCount, 0);
@@ -204,7 +218,7 @@ TEST_F(DecodeTemporalOff, DecodeToGpuCmdBuffer)
     EXPECT_TRUE(getFrame());
     EXPECT_TRUE(ldeCmdBufferGpuReset(&cmdBufferGpu, &cmdBufferGpuBuilder, globalConfig.numLayers));
     EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, nullptr,
-                                     &cmdBufferGpu, &cmdBufferGpuBuilder));
+                                     &cmdBufferGpu, &cmdBufferGpuBuilder, nullptr));
     EXPECT_EQ(cmdBufferGpu.commandCount, 14);
     EXPECT_EQ(cmdBufferGpuBuilder.residualCapacity, 804);
     EXPECT_EQ(cmdBufferGpu.residualCount, 776);
@@ -213,13 +227,118 @@ TEST_F(DecodeTemporalOff, DecodeToGpuCmdBuffer)
     ldeCmdBufferGpuFree(&cmdBufferGpu, &cmdBufferGpuBuilder);
 }
 
+TEST_F(DecodeTemporalOn, DecodeWithHuffmanCache)
+{
+    LdeHuffmanCache huffmanCache = {};
+    ASSERT_TRUE(ldeHuffmanCacheInitialize(allocator, &huffmanCache, 4));
+    EXPECT_EQ(ldeCmdBufferCpuInitialize(allocator, &cmdBufferCpu, 0), true);
+
+    // Output must match the uncached decode
+    EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
+    EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ1, 0, 0, &cmdBufferCpu,
+                                     nullptr, nullptr, &huffmanCache));
+    EXPECT_EQ(hashCpuBuffer(), "c0367ce3a91ed34af5040e43d598d8c2");
+
+    EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
+    EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, &cmdBufferCpu,
+                                     nullptr, nullptr, &huffmanCache));
+    EXPECT_EQ(hashCpuBuffer(), "6b5b6fdfa8d147d7e286b9b336d278eb");
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    ldeHuffmanCacheGetStats(&huffmanCache, &hits, &misses);
+
+    // Decoding the same tile again takes every decoder from the cache
+    const uint64_t firstMisses = misses;
+    EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
+    EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, &cmdBufferCpu,
+                                     nullptr, nullptr, &huffmanCache));
+    EXPECT_EQ(hashCpuBuffer(), "6b5b6fdfa8d147d7e286b9b336d278eb");
+    ldeHuffmanCacheGetStats(&huffmanCache, &hits, &misses);
+    EXPECT_EQ(misses, firstMisses);
+
+    EXPECT_EQ(getFrame(), true);
+    EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
+    EXPECT_TRUE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, &cmdBufferCpu,
+                                     nullptr, nullptr, &huffmanCache));
+    EXPECT_EQ(hashCpuBuffer(), "e7f1da13d3b99a8a470cd395e7e9c9ff");
+
+    ldeCmdBufferCpuFree(&cmdBufferCpu);
+    ldeHuffmanCacheRelease(&huffmanCache);
+}
+
+TEST_F(DecodeTemporalOn, DecodeFromLayersToCpuCmdBuffer)
+{
+    ldeLayerRunsInitialize(allocator, &layerRuns);
+    EXPECT_EQ(ldeCmdBufferCpuInitialize(allocator, &cmdBufferCpu, 0), true);
+
+    // Output must match decoding all layers together
+    EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
+    EXPECT_TRUE(decodeLayers(LOQ1));
+    EXPECT_TRUE(ldeDecodeEnhancementFromLayers(&globalConfig, &frameConfig, LOQ1, 0, 0, &layerRuns,
+                                               &cmdBufferCpu, nullptr, nullptr, nullptr));
+    EXPECT_EQ(cmdBufferCpu.count, 19);
+    EXPECT_EQ(hashCpuBuffer(), "c0367ce3a91ed34af5040e43d598d8c2");
+
+    EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
+    EXPECT_TRUE(decodeLayers(LOQ0));
+    EXPECT_TRUE(ldeDecodeEnhancementFromLayers(&globalConfig, &frameConfig, LOQ0, 0, 0, &layerRuns,
+                                               &cmdBufferCpu, nullptr, nullptr, nullptr));
+    EXPECT_EQ(cmdBufferCpu.count, 344);
+    EXPECT_EQ(hashCpuBuffer(), "6b5b6fdfa8d147d7e286b9b336d278eb");
+
+    // Runs are reused between frames
+    EXPECT_EQ(getFrame(), true);
+    EXPECT_EQ(ldeCmdBufferCpuReset(&cmdBufferCpu, globalConfig.numLayers), true);
+    EXPECT_TRUE(decodeLayers(LOQ0));
+    EXPECT_TRUE(ldeDecodeEnhancementFromLayers(&globalConfig, &frameConfig, LOQ0, 0, 0, &layerRuns,
+                                               &cmdBufferCpu, nullptr, nullptr, nullptr));
+    EXPECT_EQ(cmdBufferCpu.count, 461);
+    EXPECT_EQ(hashCpuBuffer(), "e7f1da13d3b99a8a470cd395e7e9c9ff");
+
+    ldeCmdBufferCpuFree(&cmdBufferCpu);
+    ldeLayerRunsFree(&layerRuns);
+}
+
+TEST_F(DecodeTemporalOff, DecodeFromLayersToGpuCmdBuffer)
+{
+    ldeLayerRunsInitialize(allocator, &layerRuns);
+    EXPECT_TRUE(ldeCmdBufferGpuInitialize(allocator, &cmdBufferGpu, &cmdBufferGpuBuilder));
+
+    EXPECT_TRUE(ldeCmdBufferGpuReset(&cmdBufferGpu, &cmdBufferGpuBuilder, globalConfig.numLayers));
+    EXPECT_TRUE(decodeLayers(LOQ1));
+    EXPECT_TRUE(ldeDecodeEnhancementFromLayers(&globalConfig, &frameConfig, LOQ1, 0, 0, &layerRuns,
+                                               nullptr, &cmdBufferGpu, &cmdBufferGpuBuilder,
+                                               nullptr));
+    EXPECT_EQ(cmdBufferGpu.commandCount, 9);
+    EXPECT_EQ(hashGpuBuffer(), "6756dfa75d9d89120fa6f22e0d2be6c3");
+
+    EXPECT_TRUE(ldeCmdBufferGpuReset(&cmdBufferGpu, &cmdBufferGpuBuilder, globalConfig.numLayers));
+    EXPECT_TRUE(decodeLayers(LOQ0));
+    EXPECT_TRUE(ldeDecodeEnhancementFromLayers(&globalConfig, &frameConfig, LOQ0, 0, 0, &layerRuns,
+                                               nullptr, &cmdBufferGpu, &cmdBufferGpuBuilder,
+                                               nullptr));
+    EXPECT_EQ(cmdBufferGpu.commandCount, 14);
+    EXPECT_EQ(hashGpuBuffer(), "45914d5584eca6510c622c352393836c");
+
+    ldeCmdBufferGpuFree(&cmdBufferGpu, &cmdBufferGpuBuilder);
+    ldeLayerRunsFree(&layerRuns);
+}
+
 TEST_F(DecodeTemporalOn, InvalidInputs)
 {
     EXPECT_FALSE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ2, 0, 0, &cmdBufferCpu,
-                                      nullptr, nullptr));
+                                      nullptr, nullptr, nullptr));
     EXPECT_FALSE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 4, 0, &cmdBufferCpu,
-                                      nullptr, nullptr));
+                                      nullptr, nullptr, nullptr));
     EXPECT_FALSE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 1, &cmdBufferCpu,
+                                      nullptr, nullptr, nullptr));
+    EXPECT_FALSE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, nullptr, nullptr,
                                       nullptr, nullptr));
-    EXPECT_FALSE(ldeDecodeEnhancement(&globalConfig, &frameConfig, LOQ0, 0, 0, nullptr, nullptr, nullptr));
-}
\ No newline at end of file
+
+    ldeLayerRunsInitialize(allocator, &layerRuns);
+    EXPECT_FALSE(ldeDecodeLayer(&globalConfig, &frameConfig, LOQ0, 0, 0, globalConfig.numLayers,
+                                nullptr, &layerRuns));
+    EXPECT_FALSE(ldeDecodeEnhancementFromLayers(&globalConfig, &frameConfig, LOQ0, 0, 0, nullptr,
+                                                &cmdBufferCpu, nullptr, nullptr, nullptr));
+}
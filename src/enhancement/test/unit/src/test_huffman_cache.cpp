@@ -0,0 +1,282 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include <gtest/gtest.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/enhancement/bitstream_types.h>
+#include <LCEVC/enhancement/huffman_cache.h>
+
+#include <cstring>
+#include <vector>
+
+extern "C"
+{
+#include "entropy.h"
+}
+
+namespace {
+
+constexpr uint8_t kVersion = BitstreamVersionCurrent;
+
+// Big-endian bit writer for building chunks with known code-length headers
+class BitWriter
+{
+public:
+    void write(uint32_t value, uint8_t numBits)
+    {
+        for (int32_t bit = numBits - 1; bit >= 0; --bit) {
+            if ((m_bitCount & 7) == 0) {
+                m_data.push_back(0);
+            }
+            m_data.back() |= static_cast<uint8_t>(((value >> bit) & 1) << (7 - (m_bitCount & 7)));
+            m_bitCount++;
+        }
+    }
+
+    LdeChunk chunk() const
+    {
+        LdeChunk res = {};
+        res.entropyEnabled = true;
+        res.data = m_data.data();
+        res.size = static_cast<uint32_t>(m_data.size());
+        return res;
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+    uint32_t m_bitCount = 0;
+};
+
+// Header listing 3 symbols, with a 1 bit code for the first and 2 bit codes for the others
+void writeListHeader(BitWriter& writer, uint8_t symbol0, uint8_t symbol1, uint8_t symbol2)
+{
+    writer.write(1, 5); // min length
+    writer.write(2, 5); // max length
+    writer.write(0, 1); // symbol count follows, rather than a presence bitmap
+    writer.write(3, 5);
+    writer.write(symbol0, 8);
+    writer.write(0, 1);
+    writer.write(symbol1, 8);
+    writer.write(1, 1);
+    writer.write(symbol2, 8);
+    writer.write(1, 1);
+}
+
+// Header for an alphabet of one symbol, which takes no bits to code
+void writeSingleSymbolHeader(BitWriter& writer, uint8_t symbol)
+{
+    writer.write(0, 5);
+    writer.write(0, 5);
+    writer.write(symbol, 8);
+}
+
+void writeCodedData(BitWriter& writer)
+{
+    for (uint32_t i = 0; i < 32; ++i) {
+        writer.write(0x5A, 8);
+    }
+}
+
+// LSB symbols that are not followed by an MSB or a run length
+BitWriter residualChunk(uint8_t lsbSymbol)
+{
+    BitWriter writer;
+    writeListHeader(writer, lsbSymbol, 0x42, 0x3E);
+    writeSingleSymbolHeader(writer, 0x00);
+    writeSingleSymbolHeader(writer, 0x00);
+    writeCodedData(writer);
+    return writer;
+}
+
+BitWriter temporalChunk()
+{
+    BitWriter writer;
+    writeListHeader(writer, 0x01, 0x85, 0x7F);
+    writeListHeader(writer, 0x81, 0x02, 0x40);
+    writeCodedData(writer);
+    return writer;
+}
+
+// Initialize a cleared decoder from a chunk, releasing whatever it held before
+bool initialize(EntropyDecoder& decoder, const LdeChunk& chunk, EntropyDecoderType type,
+                LdeHuffmanCache* cache)
+{
+    entropyRelease(&decoder);
+    memset(&decoder, 0, sizeof(decoder));
+    return entropyInitialize(&decoder, &chunk, type, kVersion, cache);
+}
+
+// Same stream position and same tables, wherever the tables are held
+bool operator==(const EntropyDecoder& a, const EntropyDecoder& b)
+{
+    if (a.type != b.type || memcmp(&a.hstream, &b.hstream, sizeof(HuffmanStream)) != 0) {
+        return false;
+    }
+    if (a.type == EDTDefault) {
+        return memcmp(a.comboHuffman, b.comboHuffman, sizeof(HuffmanTripleDecodeState)) == 0;
+    }
+    return memcmp(a.huffman, b.huffman, sizeof(HuffmanSingleDecoder_t) * HuffTemporalCount) == 0;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+class HuffmanCacheTest : public testing::Test
+{
+public:
+    void SetUp() override { allocator = ldcMemoryAllocatorMalloc(); }
+    void TearDown() override
+    {
+        entropyRelease(&built);
+        entropyRelease(&cached);
+        ldeHuffmanCacheRelease(&cache);
+    }
+
+    void expectStats(uint64_t expectedHits, uint64_t expectedMisses)
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        ldeHuffmanCacheGetStats(&cache, &hits, &misses);
+        EXPECT_EQ(hits, expectedHits);
+        EXPECT_EQ(misses, expectedMisses);
+    }
+
+    LdcMemoryAllocator* allocator = nullptr;
+    LdeHuffmanCache cache = {};
+    EntropyDecoder built = {};
+    EntropyDecoder cached = {};
+};
+
+TEST_F(HuffmanCacheTest, InvalidCapacity)
+{
+    EXPECT_FALSE(ldeHuffmanCacheInitialize(allocator, &cache, 0));
+}
+
+TEST_F(HuffmanCacheTest, TripleDecoderMatchesBuild)
+{
+    ASSERT_TRUE(ldeHuffmanCacheInitialize(allocator, &cache, 4));
+    const BitWriter writer = residualChunk(0x40);
+    const LdeChunk chunk = writer.chunk();
+
+    ASSERT_TRUE(initialize(built, chunk, EDTDefault, nullptr));
+
+    // Miss builds and inserts, hit uses the entry - both leave the stream after the headers
+    ASSERT_TRUE(initialize(cached, chunk, EDTDefault, &cache));
+    EXPECT_TRUE(cached == built);
+    expectStats(0, 1);
+
+    ASSERT_TRUE(initialize(cached, chunk, EDTDefault, &cache));
+    EXPECT_TRUE(cached == built);
+    expectStats(1, 1);
+
+    for (uint32_t i = 0; i < 64; ++i) {
+        int16_t builtCoeff = 0;
+        int16_t cachedCoeff = 0;
+        EXPECT_EQ(entropyDecode(&built, &builtCoeff), entropyDecode(&cached, &cachedCoeff));
+        EXPECT_EQ(builtCoeff, cachedCoeff);
+    }
+}
+
+TEST_F(HuffmanCacheTest, SinglePairDecoderMatchesBuild)
+{
+    ASSERT_TRUE(ldeHuffmanCacheInitialize(allocator, &cache, 4));
+    const BitWriter writer = temporalChunk();
+    const LdeChunk chunk = writer.chunk();
+
+    ASSERT_TRUE(initialize(built, chunk, EDTTemporal, nullptr));
+    ASSERT_TRUE(initialize(cached, chunk, EDTTemporal, &cache));
+    ASSERT_TRUE(initialize(cached, chunk, EDTTemporal, &cache));
+    EXPECT_TRUE(cached == built);
+    expectStats(1, 1);
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        TemporalSignal builtSignal = TSInter;
+        TemporalSignal cachedSignal = TSInter;
+        EXPECT_EQ(entropyDecodeTemporal(&built, &builtSignal),
+                  entropyDecodeTemporal(&cached, &cachedSignal));
+        EXPECT_EQ(builtSignal, cachedSignal);
+    }
+}
+
+TEST_F(HuffmanCacheTest, DifferentHeadersAreSeparate)
+{
+    ASSERT_TRUE(ldeHuffmanCacheInitialize(allocator, &cache, 4));
+    const BitWriter writerA = residualChunk(0x40);
+    const BitWriter writerB = residualChunk(0x44);
+    const LdeChunk chunkA = writerA.chunk();
+    const LdeChunk chunkB = writerB.chunk();
+
+    ASSERT_TRUE(initialize(cached, chunkA, EDTDefault, &cache));
+    ASSERT_TRUE(initialize(cached, chunkB, EDTDefault, &cache));
+    expectStats(0, 2);
+
+    ASSERT_TRUE(initialize(built, chunkB, EDTDefault, nullptr));
+    ASSERT_TRUE(initialize(cached, chunkB, EDTDefault, &cache));
+    EXPECT_TRUE(cached == built);
+    expectStats(1, 2);
+
+    // Temporal and size decoders are built in the same way from the same headers, so share entries
+    const BitWriter writerT = temporalChunk();
+    const LdeChunk chunkT = writerT.chunk();
+    ASSERT_TRUE(initialize(cached, chunkT, EDTTemporal, &cache));
+    ASSERT_TRUE(initialize(cached, chunkT, EDTSizeUnsigned, &cache));
+    expectStats(2, 3);
+}
+
+TEST_F(HuffmanCacheTest, EvictsLeastRecentlyUsed)
+{
+    ASSERT_TRUE(ldeHuffmanCacheInitialize(allocator, &cache, 2));
+    const BitWriter writerA = residualChunk(0x40);
+    const BitWriter writerB = residualChunk(0x44);
+    const BitWriter writerC = residualChunk(0x48);
+
+    ASSERT_TRUE(initialize(cached, writerA.chunk(), EDTDefault, &cache));
+    ASSERT_TRUE(initialize(cached, writerB.chunk(), EDTDefault, &cache));
+    ASSERT_TRUE(initialize(cached, writerA.chunk(), EDTDefault, &cache));
+    expectStats(1, 2);
+
+    // B is the least recently used, so C replaces it
+    ASSERT_TRUE(initialize(cached, writerC.chunk(), EDTDefault, &cache));
+    ASSERT_TRUE(initialize(cached, writerA.chunk(), EDTDefault, &cache));
+    expectStats(2, 3);
+    ASSERT_TRUE(initialize(cached, writerB.chunk(), EDTDefault, &cache));
+    expectStats(2, 4);
+}
+
+TEST_F(HuffmanCacheTest, ReferencedEntriesAreNotReplaced)
+{
+    ASSERT_TRUE(ldeHuffmanCacheInitialize(allocator, &cache, 1));
+    const BitWriter writerA = residualChunk(0x40);
+    const BitWriter writerB = residualChunk(0x44);
+    const LdeChunk chunkA = writerA.chunk();
+    const LdeChunk chunkB = writerB.chunk();
+
+    ASSERT_TRUE(initialize(cached, chunkA, EDTDefault, &cache));
+    ASSERT_TRUE(initialize(cached, chunkA, EDTDefault, &cache));
+    expectStats(1, 1);
+
+    // A is in use, so B is built but not cached, and A is left intact
+    ASSERT_TRUE(initialize(built, chunkB, EDTDefault, &cache));
+    ASSERT_TRUE(initialize(built, chunkB, EDTDefault, &cache));
+    expectStats(1, 3);
+    ASSERT_TRUE(initialize(built, chunkA, EDTDefault, nullptr));
+    EXPECT_TRUE(cached == built);
+
+    // Once released, A can be replaced
+    entropyRelease(&cached);
+    ASSERT_TRUE(initialize(built, chunkB, EDTDefault, &cache));
+    ASSERT_TRUE(initialize(built, chunkB, EDTDefault, &cache));
+    expectStats(2, 4);
+}
@@ -11,6 +11,7 @@
 # licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
 # ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
 # THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE.
+import json
 import os.path
 import re
 
@@ -33,6 +34,10 @@ class Test(CoreTest):
 
         if test['cli'].get('--base'):
             test['cli']['--read-bin-linearly'] = 'FLAG'
+        benchmark_file = None
+        if test['cli'].get('--benchmark'):
+            benchmark_file = os.path.abspath(os.path.join(test_dir, 'benchmark.json'))
+            test['cli']['--benchmark-output'] = benchmark_file
         process = super().test(test, test_dir)
         output = process.stdout.decode('utf-8')
 
@@ -57,6 +62,16 @@ class Test(CoreTest):
         frame_time_match = re.search(frame_time_pattern, output)
         frame_time_ms = float(frame_time_match.group(1)) if frame_time_match else None
         self.record_result('frame_time', frame_time_ms)
+
+        # Benchmark mode reports more detail as JSON
+        if benchmark_file and os.path.exists(benchmark_file):
+            with open(benchmark_file, 'r') as json_file:
+                benchmark = json.load(json_file)
+            self.record_result('fps', benchmark['fps'])
+            for percentile in ('p50', 'p90', 'p99'):
+                self.record_result(f'latency_{percentile}', benchmark['latency_ms'][percentile])
+            self.record_result('cpu_time_per_frame', benchmark['cpu_ms_per_frame'])
+            self.record_result('benchmark_peak_rss', benchmark['peak_rss_kib'])
         if config.get('PLATFORM') in ADB_PLATFORMS:
             frequency = self.get_current_frequency()
             self.record_result('post_test_frequency', frequency)
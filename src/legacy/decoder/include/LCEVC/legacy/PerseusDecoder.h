@@ -470,6 +470,14 @@ extern "C"
     /* \brief Function pointer type for log callback messages. */
     typedef void (*perseus_decoder_log_callback)(void* userData, perseus_decoder_log_type type, const char* msg, size_t msgLength);
 
+    /* \brief Function pointer type for one job of a batch run by a job executor. Returns 0 on success. */
+    typedef int (*perseus_job_function)(void* context, uint32_t index);
+
+    /* \brief Function pointer type for an external job executor. The executor must call `job` once
+     *        for each index in [0, count), possibly concurrently, and only return once all of those
+     *        calls have finished. Returns 0 if every job returned 0. */
+    typedef int (*perseus_job_executor)(void* userData, perseus_job_function job, void* context, uint32_t count);
+
 /*!
  * \brief Perseus decoder configuration
  */
@@ -498,6 +506,8 @@ extern "C"
         perseus_decoder_log_callback log_callback;        /**< Optional pointer to receive codec generated log messages */
         void*                        log_userdata;        /**< Pointer to user data that will be pass into the first argument of `log_callback` */
         uint8_t                      use_parallel_decode; /**< If non-zero then `decode_base` and `decode_high` will perform decoding in parallel. */
+        perseus_job_executor         job_executor;        /**< Optional executor to run parallel work on, rather than worker threads created by the decoder. Work is split into `num_worker_threads` jobs. */
+        void*                        job_executor_userdata; /**< Pointer to user data that will be passed into the first argument of `job_executor` */
     } perseus_decoder_config;
 
 #define LOGO_OVERLAY_POSITION_X_DEFAULT 50
@@ -298,7 +298,12 @@ VN_DEC_CORE_API int VN_CALLCONV perseus_decoder_open(perseus_decoder* pp,
     uint32_t threadCount =
         (cfg->num_worker_threads == -1) ? threadingGetNumCores() : cfg->num_worker_threads;
 
-    VN_CHECK(threadingInitialise(memory, log, &ctx->threadManager, threadCount));
+    if (cfg->job_executor) {
+        VN_CHECK(threadingInitialiseWithExecutor(memory, log, &ctx->threadManager, threadCount,
+                                                 cfg->job_executor, cfg->job_executor_userdata));
+    } else {
+        VN_CHECK(threadingInitialise(memory, log, &ctx->threadManager, threadCount));
+    }
     if (ctx->dumpSurfaces) {
         VN_CHECK(surfaceDumpCacheInitialise(memory, log, &ctx->surfaceDumpCache));
     }
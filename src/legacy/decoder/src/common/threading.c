@@ -282,6 +282,8 @@ int32_t threadingInitialise(Memory_t memory, Logger_t log, ThreadManager_t* mgr,
     mgr->memory = memory;
     mgr->log = log;
     mgr->numThreads = numThreads;
+    mgr->executor = NULL;
+    mgr->executorUserData = NULL;
 
     for (int32_t i = 0; i < (int32_t)numThreads; i++) {
         Thread_t* thrd = &mgr->threads[i];
@@ -294,6 +296,13 @@ int32_t threadingInitialise(Memory_t memory, Logger_t log, ThreadManager_t* mgr,
 
 void threadingRelease(ThreadManager_t* mgr)
 {
+    /* Jobs were handed to an external executor, there are no threads to stop. */
+    if (mgr->executor) {
+        mgr->executor = NULL;
+        mgr->numThreads = 0;
+        return;
+    }
+
     for (uint32_t i = 0; i < mgr->numThreads; i++) {
         Thread_t* thread = &mgr->threads[i];
         ThreadPlatform_t* plat = &thread->platform;
@@ -466,6 +475,64 @@ uint32_t threadingGetNumThreads(ThreadManager_t* mgr) { return 1; }
 
 #endif
 
+/*------------------------------------------------------------------------------*/
+
+typedef struct ExecutorJobs
+{
+    JobFunction_t function;
+    uint8_t* jobs;
+    uint32_t jobByteSize;
+} ExecutorJobs_t;
+
+typedef struct ExecutorSlicedJobs
+{
+    SlicedJobFunction_t function;
+    const void* executeContext;
+    size_t totalSize;
+    size_t perSliceCount;
+    size_t last;
+} ExecutorSlicedJobs_t;
+
+static int32_t executorJob(void* context, uint32_t index)
+{
+    const ExecutorJobs_t* jobs = (const ExecutorJobs_t*)context;
+    return jobs->function((void*)(jobs->jobs + (size_t)index * jobs->jobByteSize));
+}
+
+/* Rebuild the same slice as the thread backend would give to the job at `index`, so that
+ * functions indexing per-slice state see no difference between the backends. */
+static int32_t executorSlicedJob(void* context, uint32_t index)
+{
+    const ExecutorSlicedJobs_t* sliced = (const ExecutorSlicedJobs_t*)context;
+    const JobIndex_t jobIndex = {.current = index, .last = sliced->last};
+    SliceOffset_t offset = {.offset = index * sliced->perSliceCount,
+                            .count = sliced->perSliceCount};
+
+    if (index == sliced->last) {
+        offset.count = sliced->totalSize - offset.offset;
+    }
+
+    return sliced->function(sliced->executeContext, jobIndex, offset);
+}
+
+int32_t threadingInitialiseWithExecutor(Memory_t memory, Logger_t log, ThreadManager_t* mgr,
+                                        uint32_t numThreads, JobExecutor_t executor,
+                                        void* executorUserData)
+{
+    if (mgr == NULL || executor == NULL) {
+        return -1;
+    }
+
+    mgr->memory = memory;
+    mgr->log = log;
+    mgr->threads = NULL;
+    mgr->numThreads = (numThreads > 0) ? numThreads : 1;
+    mgr->executor = executor;
+    mgr->executorUserData = executorUserData;
+
+    return 0;
+}
+
 bool threadingExecuteJobs(ThreadManager_t* mgr, JobFunction_t function, void* jobs,
                           uint32_t jobCount, uint32_t jobByteSize)
 {
@@ -473,6 +540,16 @@ bool threadingExecuteJobs(ThreadManager_t* mgr, JobFunction_t function, void* jo
         return (function(jobs) == 0);
     }
 
+    if (mgr->executor) {
+        if (jobCount == 0) {
+            return true;
+        }
+
+        ExecutorJobs_t executorJobs = {
+            .function = function, .jobs = (uint8_t*)jobs, .jobByteSize = jobByteSize};
+        return (mgr->executor(mgr->executorUserData, executorJob, &executorJobs, jobCount) == 0);
+    }
+
     uint32_t threadIdx = 0;
     uint8_t* jobData = (uint8_t*)jobs;
     uint32_t jobOffset = 0;
@@ -524,28 +601,39 @@ bool threadingExecuteSlicedJobsWithPostRun(ThreadManager_t* mgr, SlicedJobFuncti
 
     JobIndex_t index = {.current = 0, .last = totalJobCount - 1};
     SliceOffset_t offset = {.offset = 0, .count = perSliceCount};
-    uint32_t threadIdx = 0;
     bool res = true;
 
-    /* Schedule up to thread-counts worth of work. */
-    size_t jobCount = totalJobCount;
-    for (; (jobCount > 1) && (threadIdx < mgr->numThreads); threadIdx += 1) {
-        threadingSubmitSlicedJob(mgr, threadIdx, function, executeContext, index, offset);
+    if (mgr->executor) {
+        ExecutorSlicedJobs_t executorJobs = {.function = function,
+                                             .executeContext = executeContext,
+                                             .totalSize = totalSize,
+                                             .perSliceCount = perSliceCount,
+                                             .last = totalJobCount - 1};
+        res &= (mgr->executor(mgr->executorUserData, executorSlicedJob, &executorJobs,
+                              (uint32_t)totalJobCount) == 0);
+    } else {
+        uint32_t threadIdx = 0;
 
-        index.current += 1;
-        offset.offset += perSliceCount;
-        jobCount -= 1;
-    }
+        /* Schedule up to thread-counts worth of work. */
+        size_t jobCount = totalJobCount;
+        for (; (jobCount > 1) && (threadIdx < mgr->numThreads); threadIdx += 1) {
+            threadingSubmitSlicedJob(mgr, threadIdx, function, executeContext, index, offset);
 
-    /* Run a single remainder on calling thread. */
-    if (jobCount) {
-        offset.count = totalSize - offset.offset;
-        res &= (function(executeContext, index, offset) == 0);
-    }
+            index.current += 1;
+            offset.offset += perSliceCount;
+            jobCount -= 1;
+        }
+
+        /* Run a single remainder on calling thread. */
+        if (jobCount) {
+            offset.count = totalSize - offset.offset;
+            res &= (function(executeContext, index, offset) == 0);
+        }
 
-    /* Wait for busy threads to finish. */
-    for (uint32_t i = 0; i < threadIdx; i += 1) {
-        res &= threadingWaitJob(mgr, i);
+        /* Wait for busy threads to finish. */
+        for (uint32_t i = 0; i < threadIdx; i += 1) {
+            res &= threadingWaitJob(mgr, i);
+        }
     }
 
     /* Post run function call */
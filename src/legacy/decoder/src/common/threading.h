@@ -21,12 +21,23 @@ typedef struct Logger* Logger_t;
 typedef struct Memory* Memory_t;
 typedef struct Thread Thread_t;
 
+/*! \brief A single job of a batch given to a job executor, returns 0 on success. */
+typedef int32_t (*ExecutorJobFunction_t)(void* context, uint32_t index);
+
+/*! \brief An external executor that runs `job` for each index in [0, count), possibly
+ *         concurrently, and returns once they have all finished. Returns 0 if every job
+ *         returned 0. */
+typedef int32_t (*JobExecutor_t)(void* userData, ExecutorJobFunction_t job, void* context,
+                                 uint32_t count);
+
 typedef struct ThreadManager
 {
     Memory_t memory;
     Logger_t log;
     Thread_t* threads;
     uint32_t numThreads;
+    JobExecutor_t executor;
+    void* executorUserData;
 } ThreadManager_t;
 
 typedef struct JobIndex
@@ -58,6 +69,17 @@ static inline bool isLastSlice(JobIndex_t index) { return index.current == index
  *  \returns 0 on success */
 int32_t threadingInitialise(Memory_t memory, Logger_t log, ThreadManager_t* mgr, uint32_t numThreads);
 
+/*! \brief init the thread engine to run jobs on an external executor, no threads are started.
+ *
+ *  \param numThreads        The number of jobs that sliced work is split into
+ *  \param executor          The executor that jobs are handed to
+ *  \param executorUserData  Passed as the first argument of `executor`
+ *
+ *  \returns 0 on success */
+int32_t threadingInitialiseWithExecutor(Memory_t memory, Logger_t log, ThreadManager_t* mgr,
+                                        uint32_t numThreads, JobExecutor_t executor,
+                                        void* executorUserData);
+
 /*! \brief Release the threading engine. */
 void threadingRelease(ThreadManager_t* mgr);
 
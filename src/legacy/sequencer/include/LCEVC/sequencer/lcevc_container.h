@@ -82,7 +82,8 @@ uint64_t stampedBufferGetInsertTime(const StampedBuffer* stBuf);
  */
 bool stampedBufferGetIDR(const StampedBuffer* stBuf);
 
-/*! Releases memory of a StampedBuffer - ensure this is called once a buffer has been used
+/*! Releases a StampedBuffer back to its container, which re-uses it and its copied data for later
+ *  insertions - ensure this is called once a buffer has been used
  *
  * @param[in]  stBuf                StampedBuffer to release
  */
@@ -93,7 +94,8 @@ void stampedBufferRelease(StampedBuffer** stBuf);
 /*! Create a new LCEVCContainer
  *
  * @param[in]  allocator            Memory allocator instance
- * @param[in]  allocation           Memory allocation to store stamped buffers within the container
+ * @param[in]  allocation           Memory allocation for the container's index of stamped buffers,
+ *                                  which must remain valid until the container is destroyed
  * @param[in]  capacity             The maximum StampedBuffers in the container before errors
  *                                  during insertion. Maps to API config item loq_unprocessed_cap.
  * @return                          Pointer to a new LCEVCContainer
@@ -101,7 +103,8 @@ void stampedBufferRelease(StampedBuffer** stBuf);
 LCEVCContainer* lcevcContainerCreate(LdcMemoryAllocator* allocator, LdcMemoryAllocation* allocation,
                                      size_t capacity);
 
-/*! Destroy the LCEVCContainer and release memory of all un-extracted data.
+/*! Destroy the LCEVCContainer and release memory of all un-extracted data. The memory of any
+ *  extracted StampedBuffers that have not been released yet is freed when the last one is.
  *
  * @param[in]  container            Container to destroy.
  */
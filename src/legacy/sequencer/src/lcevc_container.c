@@ -22,6 +22,13 @@
 
 // - StampedBuffer and StampedBufferList ----------------------------------------------------------
 
+// StampedBuffers are allocated in slabs of this many, and are recycled through a free list, along
+// with their copied data, rather than being freed when released.
+#define kStampedBufferSlabSize 32
+
+// Initial number of StampedBuffers that the heap has room for before growing
+#define kStampedBufferHeapInitialSize 16
+
 typedef struct StampedBuffer
 {
     bool wasCopied;
@@ -31,18 +38,42 @@ typedef struct StampedBuffer
     uint64_t inputTime;
     bool idr;
 
-    // This struct is also a linked-list node, but these two pointers are inaccessible by clients.
-    struct StampedBuffer* previous;
-    struct StampedBuffer* next;
+    // These members are inaccessible by clients.
+    struct StampedBufferList* list;     // List that the buffer came from, and is recycled to
+    LdcMemoryAllocation dataAllocation; // Copied data, kept for re-use when the buffer is recycled
+    size_t heapIndex;                   // Position in the list's heap, while in the list
+    struct StampedBuffer* nextFree;     // Next buffer in the free list, while free
 } StampedBuffer;
 
+typedef struct StampedBufferSlab
+{
+    LdcMemoryAllocation allocation;
+    struct StampedBufferSlab* next;
+    StampedBuffer buffers[kStampedBufferSlabSize];
+} StampedBufferSlab;
+
+/// The held StampedBuffers are kept in a binary min-heap on timestamp, so that inserting and
+/// extracting the next in order are O(log n). An open-addressed hash table from timestamp to buffer
+/// finds duplicates and any given timestamp in O(1). Both grow as needed, up to the capacity.
 typedef struct StampedBufferList
 {
     LdcMemoryAllocator* allocator;
-    LdcMemoryAllocation* allocation;
-    StampedBuffer* head;
+    LdcMemoryAllocation* heapAllocation; // StampedBuffer*[heapSize]
+    LdcMemoryAllocation tableAllocation; // StampedBuffer*[tableMask + 1]
+    StampedBuffer** heap;
+    StampedBuffer** table;
+    size_t heapSize;
+    size_t tableMask;
     size_t size;
     size_t capacity;
+
+    // Slab allocated StampedBuffers. Buffers in use are those held in the list, or extracted and
+    // not yet released. If the container is destroyed while any are still in use, the slabs are
+    // freed, along with the container, when the last one is released.
+    StampedBufferSlab* slabs;
+    StampedBuffer* freeBuffers;
+    size_t buffersInUse;
+    LCEVCContainer* destroyedContainer;
 } StampedBufferList;
 
 // Internal types for unencapsulation
@@ -95,16 +126,28 @@ bool stampedBufferGetIDR(const StampedBuffer* stBuf)
     return stBuf->idr;
 }
 
+static void stampedBufferListFree(StampedBufferList* list);
+
 void stampedBufferRelease(StampedBuffer** stBuf)
 {
-    if (stBuf == NULL) {
+    if (stBuf == NULL || *stBuf == NULL) {
         return;
     }
-    if (*stBuf != NULL && (*stBuf)->wasCopied) {
-        free((void*)(*stBuf)->buffer);
-    }
-    free(*stBuf);
+    StampedBuffer* entry = *stBuf;
+    StampedBufferList* list = entry->list;
+
+    entry->buffer = NULL;
+    entry->bufferSize = 0;
+    entry->nextFree = list->freeBuffers;
+    list->freeBuffers = entry;
+    list->buffersInUse--;
     *stBuf = NULL;
+
+    if (list->destroyedContainer != NULL && list->buffersInUse == 0) {
+        LCEVCContainer* container = list->destroyedContainer;
+        stampedBufferListFree(list);
+        free(container);
+    }
 }
 
 bool lcevcContainerUnencapsulate(const uint8_t* encapsulatedData, size_t encapsulatedSize,
@@ -173,22 +216,50 @@ bool lcevcContainerUnencapsulate(const uint8_t* encapsulatedData, size_t encapsu
 }
 
 // Internal functions
-static StampedBuffer* stampedBufferNodeAlloc(LdcMemoryAllocator* allocator,
-                                             LdcMemoryAllocation* allocation, const uint8_t* data,
+static StampedBuffer* stampedBufferNodeAlloc(StampedBufferList* list, const uint8_t* data,
                                              size_t bufferSize, uint64_t timestamp, uint64_t inputTime,
                                              bool copy, bool unencapsulate, bool idr)
 {
-    StampedBuffer* newNode = calloc(1, sizeof(StampedBuffer));
+    if (list->freeBuffers == NULL) {
+        LdcMemoryAllocation allocation = {0};
+        StampedBufferSlab* slab = VNAllocateZero(list->allocator, &allocation, StampedBufferSlab);
+        if (slab == NULL) {
+            VNLogError("Failed to allocate stamped buffers");
+            return NULL;
+        }
+        slab->allocation = allocation;
+        slab->next = list->slabs;
+        list->slabs = slab;
+        for (size_t idx = kStampedBufferSlabSize; idx > 0; idx--) {
+            StampedBuffer* entry = &slab->buffers[idx - 1];
+            entry->list = list;
+            entry->nextFree = list->freeBuffers;
+            list->freeBuffers = entry;
+        }
+    }
+
+    StampedBuffer* newNode = list->freeBuffers;
 
     const uint8_t* newEntryData = (copy ? NULL : data);
     size_t unencapsulatedSize = 0;
     if (copy && bufferSize > 0) {
-        uint8_t* tempData = VNAllocateArray(allocator, allocation, uint8_t, bufferSize);
+        // Re-use the data of a recycled buffer if it is big enough - unencapsulated data is never
+        // bigger than the encapsulated data.
+        uint8_t* tempData = VNAllocationPtr(newNode->dataAllocation, uint8_t);
+        if (newNode->dataAllocation.size < bufferSize) {
+            if (VNIsAllocated(newNode->dataAllocation)) {
+                VNFree(list->allocator, &newNode->dataAllocation);
+            }
+            tempData =
+                VNAllocateArray(list->allocator, &newNode->dataAllocation, uint8_t, bufferSize);
+            if (tempData == NULL) {
+                VNLogError("Failed to allocate %zu bytes of LCEVC data", bufferSize);
+                return NULL;
+            }
+        }
         if (unencapsulate) {
             if (!lcevcContainerUnencapsulate(data, bufferSize, tempData, &unencapsulatedSize, &idr)) {
                 VNLogError("Failed to lcevcContainerUnencapsulate LCEVC data from NAL unit");
-                VNFree(allocator, allocation);
-                free(newNode);
                 return NULL;
             }
         } else {
@@ -196,75 +267,226 @@ static StampedBuffer* stampedBufferNodeAlloc(LdcMemoryAllocator* allocator,
         }
         newEntryData = tempData;
     }
+
+    list->freeBuffers = newNode->nextFree;
+    list->buffersInUse++;
+    newNode->nextFree = NULL;
     newNode->wasCopied = copy;
     newNode->buffer = newEntryData;
     newNode->bufferSize = copy && unencapsulate ? unencapsulatedSize : bufferSize;
     newNode->idr = idr;
     newNode->inputTime = inputTime;
     newNode->timestamp = timestamp;
-    newNode->next = NULL;
-    newNode->previous = NULL;
     return newNode;
 }
 
-static bool stampedBufferListInsert(StampedBufferList* list, StampedBuffer* entry)
+static void stampedBufferListFree(StampedBufferList* list)
 {
-    if ((list == NULL) || (entry == NULL) || (list->size >= list->capacity)) {
-        return false;
+    StampedBufferSlab* slab = list->slabs;
+    while (slab != NULL) {
+        StampedBufferSlab* next = slab->next;
+        for (size_t idx = 0; idx < kStampedBufferSlabSize; idx++) {
+            if (VNIsAllocated(slab->buffers[idx].dataAllocation)) {
+                VNFree(list->allocator, &slab->buffers[idx].dataAllocation);
+            }
+        }
+        // The allocation record is inside the block being freed
+        LdcMemoryAllocation allocation = slab->allocation;
+        VNFree(list->allocator, &allocation);
+        slab = next;
     }
+    list->slabs = NULL;
+    list->freeBuffers = NULL;
 
-    if (list->head == NULL) {
-        list->head = entry;
-        list->size++;
-        return true;
+    if (list->heapAllocation != NULL && VNIsAllocated(*list->heapAllocation)) {
+        VNFree(list->allocator, list->heapAllocation);
     }
+    if (VNIsAllocated(list->tableAllocation)) {
+        VNFree(list->allocator, &list->tableAllocation);
+    }
+    list->heap = NULL;
+    list->table = NULL;
+    list->heapSize = 0;
+    list->tableMask = 0;
+}
 
-    const uint64_t timestamp = entry->timestamp;
+// - StampedBufferList heap and table -------------------------------------------------------------
 
-    StampedBuffer* curPtr = list->head;
-    size_t index = 0;
-    while (index < list->capacity && curPtr != NULL) {
-        const uint64_t curTH = curPtr->timestamp;
+static inline size_t stampedBufferTableSlot(const StampedBufferList* list, uint64_t timestamp)
+{
+    // Timestamps are often multiples of a frame duration, so mix all the bits into the low ones
+    uint64_t hash = timestamp;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (size_t)hash & list->tableMask;
+}
 
-        // Reject duplicate timestamps first
-        if (timestamp == curTH) {
-            VN_SEQ_WARNING("Attempting to insert buffer with duplicate timestamp %" PRIu64 "\n", timestamp);
-            return false;
+static StampedBuffer* stampedBufferTableFind(const StampedBufferList* list, uint64_t timestamp)
+{
+    if (list->table == NULL) {
+        return NULL;
+    }
+    for (size_t slot = stampedBufferTableSlot(list, timestamp); list->table[slot] != NULL;
+         slot = (slot + 1) & list->tableMask) {
+        if (list->table[slot]->timestamp == timestamp) {
+            return list->table[slot];
         }
+    }
+    return NULL;
+}
 
-        if (timestamp < curTH) {
-            entry->next = curPtr;
-            entry->previous = curPtr->previous;
-            if (entry->previous) {
-                entry->previous->next = entry;
-            } else {
-                list->head = entry;
-            }
-            curPtr->previous = entry;
+static void stampedBufferTableAdd(StampedBufferList* list, StampedBuffer* entry)
+{
+    size_t slot = stampedBufferTableSlot(list, entry->timestamp);
+    while (list->table[slot] != NULL) {
+        slot = (slot + 1) & list->tableMask;
+    }
+    list->table[slot] = entry;
+}
 
-            list->size++;
-            return true;
+static void stampedBufferTableRemove(StampedBufferList* list, const StampedBuffer* entry)
+{
+    size_t slot = stampedBufferTableSlot(list, entry->timestamp);
+    while (list->table[slot] != entry) {
+        slot = (slot + 1) & list->tableMask;
+    }
+
+    // Shift back any following entries that would no longer be found past the gap
+    size_t next = slot;
+    for (;;) {
+        list->table[slot] = NULL;
+        for (;;) {
+            next = (next + 1) & list->tableMask;
+            if (list->table[next] == NULL) {
+                return;
+            }
+            const size_t home = stampedBufferTableSlot(list, list->table[next]->timestamp);
+            // Move the entry unless its home slot lies cyclically in (slot, next]
+            if ((slot <= next) ? (slot >= home || home > next) : (slot >= home && home > next)) {
+                break;
+            }
         }
+        list->table[slot] = list->table[next];
+        slot = next;
+    }
+}
 
-        if (curPtr->next == NULL) {
-            entry->previous = curPtr;
-            curPtr->next = entry;
+static inline void stampedBufferHeapSet(StampedBufferList* list, size_t index, StampedBuffer* entry)
+{
+    list->heap[index] = entry;
+    entry->heapIndex = index;
+}
 
-            list->size++;
-            return true;
+static void stampedBufferHeapSiftUp(StampedBufferList* list, size_t index)
+{
+    StampedBuffer* entry = list->heap[index];
+    while (index > 0) {
+        const size_t parent = (index - 1) / 2;
+        if (list->heap[parent]->timestamp <= entry->timestamp) {
+            break;
+        }
+        stampedBufferHeapSet(list, index, list->heap[parent]);
+        index = parent;
+    }
+    stampedBufferHeapSet(list, index, entry);
+}
+
+static void stampedBufferHeapSiftDown(StampedBufferList* list, size_t index)
+{
+    StampedBuffer* entry = list->heap[index];
+    for (;;) {
+        size_t child = 2 * index + 1;
+        if (child >= list->size) {
+            break;
+        }
+        if (child + 1 < list->size &&
+            list->heap[child + 1]->timestamp < list->heap[child]->timestamp) {
+            child++;
+        }
+        if (entry->timestamp <= list->heap[child]->timestamp) {
+            break;
         }
+        stampedBufferHeapSet(list, index, list->heap[child]);
+        index = child;
+    }
+    stampedBufferHeapSet(list, index, entry);
+}
+
+// Make room for at least one more entry in the heap and table
+static bool stampedBufferListGrow(StampedBufferList* list)
+{
+    if (list->size < list->heapSize) {
+        return true;
+    }
+
+    size_t heapSize = (list->heapSize == 0) ? kStampedBufferHeapInitialSize : list->heapSize * 2;
+    if (heapSize > list->capacity) {
+        heapSize = list->capacity;
+    }
+    StampedBuffer** heap =
+        (list->heapSize == 0)
+            ? VNAllocateArray(list->allocator, list->heapAllocation, StampedBuffer*, heapSize)
+            : VNReallocateArray(list->allocator, list->heapAllocation, StampedBuffer*, heapSize);
+    if (heap == NULL) {
+        VNLogError("Failed to grow LCEVC container to %zu entries", heapSize);
+        return false;
+    }
+    list->heap = heap;
+    list->heapSize = heapSize;
 
-        curPtr = curPtr->next;
-        index++;
+    // Keep the table at most half full
+    size_t tableSize = kStampedBufferHeapInitialSize;
+    while (tableSize < heapSize * 2) {
+        tableSize *= 2;
+    }
+    if (tableSize == list->tableMask + 1 && list->table != NULL) {
+        return true;
+    }
+    if (VNIsAllocated(list->tableAllocation)) {
+        VNFree(list->allocator, &list->tableAllocation);
+    }
+    list->table =
+        VNAllocateZeroArray(list->allocator, &list->tableAllocation, StampedBuffer*, tableSize);
+    if (list->table == NULL) {
+        VNLogError("Failed to grow LCEVC container to %zu entries", heapSize);
+        list->tableMask = 0;
+        return false;
+    }
+    list->tableMask = tableSize - 1;
+    for (size_t idx = 0; idx < list->size; idx++) {
+        stampedBufferTableAdd(list, list->heap[idx]);
     }
+    return true;
+}
 
-    // This shouldn't be possible, because we checked the list size at the top of this function.
-    // Somehow the size of the list has gotten out of sync, so repair it.
-    VN_SEQ_ERROR(
-        "Size out of sync! Claims to be %zu, but we're already full and capacity is %zu.\n",
-        list->size, list->capacity);
-    list->size = list->capacity;
-    return false;
+static inline const StampedBuffer* stampedBufferListFront(const StampedBufferList* list)
+{
+    return (list->size > 0) ? list->heap[0] : NULL;
+}
+
+static bool stampedBufferListInsert(StampedBufferList* list, StampedBuffer* entry)
+{
+    if ((list == NULL) || (entry == NULL) || (list->size >= list->capacity)) {
+        return false;
+    }
+
+    // Reject duplicate timestamps first
+    if (stampedBufferTableFind(list, entry->timestamp) != NULL) {
+        VN_SEQ_WARNING("Attempting to insert buffer with duplicate timestamp %" PRIu64 "\n",
+                       entry->timestamp);
+        return false;
+    }
+
+    if (!stampedBufferListGrow(list)) {
+        return false;
+    }
+
+    stampedBufferTableAdd(list, entry);
+    stampedBufferHeapSet(list, list->size, entry);
+    list->size++;
+    stampedBufferHeapSiftUp(list, list->size - 1);
+    return true;
 }
 
 static bool stampedBufferAlloc(StampedBufferList* list, const uint8_t* data, size_t bufferSize,
@@ -276,8 +498,8 @@ static bool stampedBufferAlloc(StampedBufferList* list, const uint8_t* data, siz
         return false;
     }
 
-    StampedBuffer* newEntry = stampedBufferNodeAlloc(list->allocator, list->allocation, data, bufferSize,
-                                                     timestamp, inputTime, copy, unencapsulate, isIdr);
+    StampedBuffer* newEntry = stampedBufferNodeAlloc(list, data, bufferSize, timestamp, inputTime,
+                                                     copy, unencapsulate, isIdr);
     if (!stampedBufferListInsert(list, newEntry)) {
         stampedBufferRelease(&newEntry);
         return false;
@@ -292,91 +514,70 @@ static const StampedBuffer* stampedBufferQuery(const StampedBufferList* list, ui
     if (list == NULL) {
         return NULL;
     }
-    const StampedBuffer* cur = list->head;
     *isAtHeadOut = false;
 
-    while (cur) {
-        if (cur->timestamp == timestamp) {
-            *isAtHeadOut = (cur == list->head);
-            return cur;
-        }
-
-        cur = cur->next;
+    const StampedBuffer* found = stampedBufferTableFind(list, timestamp);
+    if (found != NULL) {
+        *isAtHeadOut = (found->heapIndex == 0);
     }
-
-    return NULL;
+    return found;
 }
 
 static StampedBuffer* stampedBufferExtract(StampedBufferList* list, uint64_t timestamp, bool* isAtHeadOut)
 {
-    if (list == NULL || list->head == NULL) {
+    if (list == NULL || list->size == 0) {
         return NULL;
     }
     *isAtHeadOut = false;
 
-    StampedBuffer* cur = list->head;
-    while (cur) {
-        if (cur->timestamp == timestamp) {
-            // Found the right entry
-            *isAtHeadOut = (cur == list->head);
-
-            if (cur->next) {
-                cur->next->previous = cur->previous;
-            }
-
-            if (cur->previous) {
-                if (cur == list->head) {
-                    VN_SEQ_ERROR("Entry has a previous buffer, but is the head of our list. Head "
-                                 "will be reset.\n");
-                    list->head = cur->next;
-                } else {
-                    cur->previous->next = cur->next;
-                }
-            } else {
-                list->head = cur->next;
-            }
+    StampedBuffer* found = stampedBufferTableFind(list, timestamp);
+    if (found == NULL) {
+        return NULL;
+    }
+    *isAtHeadOut = (found->heapIndex == 0);
 
-            list->size--;
-            return cur;
+    stampedBufferTableRemove(list, found);
+    const size_t index = found->heapIndex;
+    list->size--;
+    if (index != list->size) {
+        // Fill the gap with the last entry, and move that up or down to its place
+        stampedBufferHeapSet(list, index, list->heap[list->size]);
+        if (index > 0 && list->heap[index]->timestamp < list->heap[(index - 1) / 2]->timestamp) {
+            stampedBufferHeapSiftUp(list, index);
+        } else {
+            stampedBufferHeapSiftDown(list, index);
         }
-
-        cur = cur->next;
     }
-
-    return NULL;
+    return found;
 }
 
 static StampedBuffer* stampedBufferPopFront(StampedBufferList* list)
 {
-    if (list == NULL || list->head == NULL) {
+    if (list == NULL || list->size == 0) {
         return NULL;
     }
     bool dummyHeadOut = false;
-    return stampedBufferExtract(list, list->head->timestamp, &dummyHeadOut);
+    return stampedBufferExtract(list, list->heap[0]->timestamp, &dummyHeadOut);
 }
 
 static void stampedBufferListRelease(StampedBufferList* list)
 {
-    StampedBuffer* cur = (list ? list->head : NULL);
-    if (cur == NULL) {
+    if (list == NULL || list->size == 0) {
         return;
     }
 
-    StampedBuffer* next = NULL;
-    while (cur) {
-        next = cur->next;
+    for (size_t idx = 0; idx < list->size; idx++) {
+        StampedBuffer* cur = list->heap[idx];
         stampedBufferRelease(&cur);
-        cur = next;
     }
-
+    memset(list->table, 0, (list->tableMask + 1) * sizeof(StampedBuffer*));
     list->size = 0;
-    list->head = NULL;
 }
 
 // - LCEVCContainer -------------------------------------------------------------------------------
 
 /// This struct uses the TimestampPredictor struct to keep track of valid timestamps, and uses
-/// list to hold them (list is a sorted doubly-linked list of `StampedBuffer`s)
+/// list to hold them (list is a heap of `StampedBuffer`s ordered by timestamp)
 /// NOTE: this is not threadsafe. Instead, the calling code should be threadsafe.
 typedef struct LCEVCContainer
 {
@@ -389,11 +590,12 @@ LCEVCContainer* lcevcContainerCreate(LdcMemoryAllocator* allocator, LdcMemoryAll
                                      size_t capacity)
 {
     LCEVCContainer* newContainer = calloc(1, sizeof(LCEVCContainer));
+    if (newContainer == NULL) {
+        return NULL;
+    }
     newContainer->predictor = timestampPredictorCreate();
     newContainer->list.allocator = allocator;
-    newContainer->list.allocation = allocation;
-    newContainer->list.head = NULL;
-    newContainer->list.size = 0;
+    newContainer->list.heapAllocation = allocation;
     newContainer->list.capacity = capacity;
 
     newContainer->processedFirst = false;
@@ -403,7 +605,21 @@ LCEVCContainer* lcevcContainerCreate(LdcMemoryAllocator* allocator, LdcMemoryAll
 void lcevcContainerDestroy(LCEVCContainer* container)
 {
     timestampPredictorDestroy(container->predictor);
+    container->predictor = NULL;
     stampedBufferListRelease(&(container->list));
+
+    // Buffers that the client still holds are released into the slabs, so keep them until then.
+    // The heap allocation belongs to the client, so is freed now.
+    if (container->list.buffersInUse > 0) {
+        if (VNIsAllocated(*container->list.heapAllocation)) {
+            VNFree(container->list.allocator, container->list.heapAllocation);
+        }
+        container->list.heapAllocation = NULL;
+        container->list.heap = NULL;
+        container->list.destroyedContainer = container;
+        return;
+    }
+    stampedBufferListFree(&(container->list));
     free(container);
 }
 
@@ -416,8 +632,9 @@ void lcevcContainerSetMaxNumReorderFrames(LCEVCContainer* container, uint32_t ma
     timestampPredictorSetMaxNumReorderFrames(container->predictor, maxNumReorderFrames);
     // As the predictor will be reset now we should give it a hint if we have any time handles
     // As the list is ordered we can use the head of the list to do the hinting
-    if (container->list.head != NULL) {
-        timestampPredictorHint(container->predictor, container->list.head->timestamp);
+    const StampedBuffer* head = stampedBufferListFront(&container->list);
+    if (head != NULL) {
+        timestampPredictorHint(container->predictor, head->timestamp);
     }
 }
 
@@ -428,8 +645,9 @@ bool lcevcContainerInsert(LCEVCContainer* container, const uint8_t* data, uint32
     bool ret = stampedBufferAlloc(&container->list, data, size, timestamp, inputTime, true,
                                   unencapsulate, false);
     // Hint with the list head as that will be the smallest PTS
-    if (container->list.head != NULL) {
-        timestampPredictorHint(container->predictor, container->list.head->timestamp);
+    const StampedBuffer* head = stampedBufferListFront(&container->list);
+    if (head != NULL) {
+        timestampPredictorHint(container->predictor, head->timestamp);
     }
     timestampPredictorFeed(container->predictor, timestamp);
     return ret;
@@ -441,8 +659,9 @@ bool lcevcContainerInsertNoCopy(LCEVCContainer* container, const uint8_t* data,
     // This will allocate the buffer itself, and fail if duplicate.
     bool ret = stampedBufferAlloc(&container->list, data, size, timestamp, inputTime, false, false, isIdr);
     // Hint with the list head as that will be the smallest PTS
-    if (container->list.head != NULL) {
-        timestampPredictorHint(container->predictor, container->list.head->timestamp);
+    const StampedBuffer* head = stampedBufferListFront(&container->list);
+    if (head != NULL) {
+        timestampPredictorHint(container->predictor, head->timestamp);
     }
     timestampPredictorFeed(container->predictor, timestamp);
     return ret;
@@ -520,7 +739,7 @@ StampedBuffer* lcevcContainerExtractNextInOrder(LCEVCContainer* container, bool
         return NULL;
     }
 
-    const uint64_t headTimestamp = container->list.head->timestamp;
+    const uint64_t headTimestamp = container->list.heap[0]->timestamp;
     // Moving to here allows the top of the list to always hint even if it's not next
     timestampPredictorHint(container->predictor, headTimestamp);
     if (!force && !timestampPredictorIsNext(container->predictor, headTimestamp)) {
@@ -25,6 +25,7 @@ set(SOURCE_ROOT
     "src/unit_rng.h"
     "src/unit_rng.cpp"
     "src/unit_sharpen.cpp"
+    "src/unit_threading.cpp"
     "src/unit_transform.cpp"
     "src/unit_utility.h"
     "src/unit_utility.cpp")
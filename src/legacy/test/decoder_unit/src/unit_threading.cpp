@@ -0,0 +1,158 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+extern "C"
+{
+#include "common/threading.h"
+}
+
+#include "unit_fixture.h"
+
+#include <array>
+#include <thread>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+constexpr uint32_t kSliceCount = 4;
+constexpr size_t kTotalSize = 1003;
+
+struct SliceRecord
+{
+    size_t last = 0;
+    size_t offset = 0;
+    size_t count = 0;
+    uint32_t calls = 0;
+};
+
+using SliceRecords = std::array<SliceRecord, kSliceCount>;
+
+int32_t recordSlice(const void* executeContext, JobIndex_t index, SliceOffset_t offset)
+{
+    // Each slice writes only its own record
+    SliceRecord& record = (*const_cast<SliceRecords*>(static_cast<const SliceRecords*>(
+        executeContext)))[index.current];
+    record.last = index.last;
+    record.offset = offset.offset;
+    record.count = offset.count;
+    record.calls++;
+    return 0;
+}
+
+int32_t failSecondJob(void* data) { return (*static_cast<int32_t*>(data) == 1) ? -1 : 0; }
+
+int32_t markJob(void* data)
+{
+    *static_cast<int32_t*>(data) += 1;
+    return 0;
+}
+
+// Runs every job on its own thread
+int32_t threadPerJobExecutor(void* userData, ExecutorJobFunction_t job, void* context,
+                             uint32_t count)
+{
+    *static_cast<uint32_t*>(userData) += 1;
+
+    std::vector<int32_t> results(count, 0);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < count; ++i) {
+        threads.emplace_back([&results, job, context, i]() { results[i] = job(context, i); });
+    }
+    int32_t res = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        threads[i].join();
+        res |= results[i];
+    }
+    return res;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+class ThreadingTest : public Fixture
+{
+protected:
+    void initializeThreads() { threadingInitialise(memory(), log(), &threadManager, kSliceCount); }
+    void initializeExecutor()
+    {
+        threadingInitialiseWithExecutor(memory(), log(), &threadManager, kSliceCount,
+                                        threadPerJobExecutor, &executorCalls);
+    }
+    void TearDown() override
+    {
+        threadingRelease(&threadManager);
+        Fixture::TearDown();
+    }
+
+    Memory_t memory() { return memoryWrapper.get(); }
+    Logger_t log() { return logWrapper.get(); }
+
+    ThreadManager_t threadManager = {};
+    uint32_t executorCalls = 0;
+};
+
+TEST_F(ThreadingTest, ExecutorSlicesMatchThreads)
+{
+    SliceRecords threaded{};
+    initializeThreads();
+    EXPECT_TRUE(threadingExecuteSlicedJobs(&threadManager, recordSlice, &threaded, kTotalSize));
+    threadingRelease(&threadManager);
+
+    SliceRecords executed{};
+    initializeExecutor();
+    EXPECT_EQ(threadingGetNumThreads(&threadManager), kSliceCount);
+    EXPECT_TRUE(threadingExecuteSlicedJobs(&threadManager, recordSlice, &executed, kTotalSize));
+    EXPECT_EQ(executorCalls, 1U);
+
+    for (uint32_t i = 0; i < kSliceCount; ++i) {
+        EXPECT_EQ(executed[i].calls, 1U);
+        EXPECT_EQ(executed[i].calls, threaded[i].calls);
+        EXPECT_EQ(executed[i].last, threaded[i].last);
+        EXPECT_EQ(executed[i].offset, threaded[i].offset);
+        EXPECT_EQ(executed[i].count, threaded[i].count);
+    }
+}
+
+TEST_F(ThreadingTest, ExecutorPostRunFollowsJobs)
+{
+    SliceRecords executed{};
+    initializeExecutor();
+    EXPECT_TRUE(threadingExecuteSlicedJobsWithPostRun(&threadManager, recordSlice, recordSlice,
+                                                      &executed, kTotalSize));
+    for (uint32_t i = 0; i < kSliceCount; ++i) {
+        EXPECT_EQ(executed[i].calls, 2U);
+    }
+}
+
+TEST_F(ThreadingTest, ExecutorRunsEveryJob)
+{
+    std::array<int32_t, 7> jobs{};
+    initializeExecutor();
+    EXPECT_TRUE(threadingExecuteJobs(&threadManager, markJob, jobs.data(),
+                                     static_cast<uint32_t>(jobs.size()), sizeof(int32_t)));
+    for (const int32_t job : jobs) {
+        EXPECT_EQ(job, 1);
+    }
+}
+
+TEST_F(ThreadingTest, ExecutorReportsFailedJob)
+{
+    std::array<int32_t, 3> jobs{0, 1, 2};
+    initializeExecutor();
+    EXPECT_FALSE(threadingExecuteJobs(&threadManager, failSecondJob, jobs.data(),
+                                      static_cast<uint32_t>(jobs.size()), sizeof(int32_t)));
+}
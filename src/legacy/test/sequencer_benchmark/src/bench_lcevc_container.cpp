@@ -0,0 +1,112 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Insert enhancement data for a run of frames whose timestamps arrive in decode order within a
+// given reorder depth, and extract it in presentation order - as the legacy LcevcProcessor does.
+//
+#include <benchmark/benchmark.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/sequencer/lcevc_container.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+namespace {
+
+constexpr uint64_t kFrameDuration = 40;
+constexpr uint32_t kDataSize = 2048;
+
+// Timestamps in presentation order, shuffled within windows of the reorder depth
+std::vector<uint64_t> decodeOrderTimestamps(size_t count, size_t depth)
+{
+    std::vector<uint64_t> timestamps(count);
+    for (size_t i = 0; i < count; i++) {
+        timestamps[i] = 1000 + i * kFrameDuration;
+    }
+    std::mt19937 rng(1234);
+    for (size_t start = 0; start < count; start += depth) {
+        std::shuffle(timestamps.begin() + static_cast<ptrdiff_t>(start),
+                     timestamps.begin() + static_cast<ptrdiff_t>(std::min(start + depth, count)),
+                     rng);
+    }
+    return timestamps;
+}
+
+} // namespace
+
+// Argument: reorder depth. Each iteration fills the container to the depth, then drains it.
+void LcevcContainerInsertExtract(benchmark::State& state)
+{
+    const size_t depth = static_cast<size_t>(state.range(0));
+    const std::vector<uint64_t> timestamps = decodeOrderTimestamps(depth, depth);
+    const std::vector<uint8_t> data(kDataSize, 0x55);
+
+    LdcMemoryAllocator* allocator = ldcMemoryAllocatorMalloc();
+    LdcMemoryAllocation allocation = {};
+    LCEVCContainer* container = lcevcContainerCreate(allocator, &allocation, depth);
+
+    for (auto _ : state) {
+        for (const uint64_t timestamp : timestamps) {
+            lcevcContainerInsert(container, data.data(), kDataSize, timestamp, false, 0);
+        }
+        uint64_t timestamp = 0;
+        size_t queueSize = 0;
+        while (StampedBuffer* buffer =
+                   lcevcContainerExtractNextInOrder(container, true, &timestamp, &queueSize)) {
+            benchmark::DoNotOptimize(stampedBufferGetBuffer(buffer));
+            stampedBufferRelease(&buffer);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(depth));
+
+    lcevcContainerDestroy(container);
+}
+
+// Argument: reorder depth. Steady state of a decoder, with the container kept full to the depth
+// while each new frame is inserted and the next in order is extracted.
+void LcevcContainerSteadyState(benchmark::State& state)
+{
+    const size_t depth = static_cast<size_t>(state.range(0));
+    const size_t count = depth * 16;
+    const std::vector<uint64_t> timestamps = decodeOrderTimestamps(count, depth);
+    const std::vector<uint8_t> data(kDataSize, 0x55);
+
+    LdcMemoryAllocator* allocator = ldcMemoryAllocatorMalloc();
+    LdcMemoryAllocation allocation = {};
+    LCEVCContainer* container = lcevcContainerCreate(allocator, &allocation, depth + 1);
+
+    for (auto _ : state) {
+        for (const uint64_t timestamp : timestamps) {
+            lcevcContainerInsert(container, data.data(), kDataSize, timestamp, false, 0);
+            if (lcevcContainerSize(container) > depth) {
+                uint64_t extracted = 0;
+                size_t queueSize = 0;
+                StampedBuffer* buffer =
+                    lcevcContainerExtractNextInOrder(container, true, &extracted, &queueSize);
+                benchmark::DoNotOptimize(stampedBufferGetBuffer(buffer));
+                stampedBufferRelease(&buffer);
+            }
+        }
+        lcevcContainerClear(container);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+
+    lcevcContainerDestroy(container);
+}
+
+BENCHMARK(LcevcContainerInsertExtract)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK(LcevcContainerSteadyState)->RangeMultiplier(4)->Range(16, 4096);
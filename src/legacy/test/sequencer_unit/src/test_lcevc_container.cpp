@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <random>
 #include <unordered_set>
 
 using MilliSecond = std::chrono::duration<int64_t, std::milli>;
@@ -928,3 +929,80 @@ TEST_F(LCEVCContainerTestFixture, clearRemovesAll)
         EXPECT_FALSE(lcevcContainerExists(m_lcevcContainer, th, &dummyIsAtHead));
     }
 }
+
+TEST(SequencerTestLCEVCContainer, extractIsSortedAtLargeReorderDepth)
+{
+    constexpr size_t kDepth = 4096;
+    LdcMemoryAllocator* allocator = ldcMemoryAllocatorMalloc();
+    LdcMemoryAllocation allocation = {0};
+    LCEVCContainer* lcevcContainer = lcevcContainerCreate(allocator, &allocation, kDepth);
+    ASSERT_NE(lcevcContainer, nullptr);
+
+    // Shuffled timestamps, some of which are flushed before extraction
+    std::vector<uint64_t> timestamps(kDepth);
+    for (size_t i = 0; i < kDepth; i++) {
+        timestamps[i] = 1000 + i * 40;
+    }
+    std::shuffle(timestamps.begin(), timestamps.end(), std::mt19937(42));
+    for (size_t i = 0; i < kDepth; i++) {
+        const uint8_t* data = kRandData[i % kLenRandLengths];
+        EXPECT_TRUE(lcevcContainerInsert(lcevcContainer, data,
+                                         static_cast<uint32_t>(kRandLengths[i % kLenRandLengths]),
+                                         timestamps[i], false, 0));
+    }
+    EXPECT_FALSE(lcevcContainerInsert(lcevcContainer, kRandData1, 1, timestamps[0], false, 0));
+    for (size_t i = 0; i < kDepth; i += 3) {
+        EXPECT_TRUE(lcevcContainerFlush(lcevcContainer, timestamps[i]));
+    }
+
+    std::vector<uint64_t> expected;
+    for (size_t i = 0; i < kDepth; i++) {
+        if (i % 3 != 0) {
+            expected.push_back(timestamps[i]);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(lcevcContainerSize(lcevcContainer), expected.size());
+
+    for (uint64_t th : expected) {
+        bool isAtHead = false;
+        EXPECT_TRUE(lcevcContainerExists(lcevcContainer, th, &isAtHead));
+        EXPECT_TRUE(isAtHead);
+
+        uint64_t extractedTh = 0;
+        size_t queueSize = 0;
+        StampedBuffer* buffer =
+            lcevcContainerExtractNextInOrder(lcevcContainer, true, &extractedTh, &queueSize);
+        ASSERT_NE(buffer, nullptr);
+        EXPECT_EQ(extractedTh, th);
+        EXPECT_EQ(stampedBufferGetTimestamp(buffer), th);
+        stampedBufferRelease(&buffer);
+    }
+    EXPECT_EQ(lcevcContainerSize(lcevcContainer), 0);
+
+    lcevcContainerDestroy(lcevcContainer);
+}
+
+TEST(SequencerTestLCEVCContainer, extractedBufferOutlivesContainer)
+{
+    LdcMemoryAllocator* allocator = ldcMemoryAllocatorMalloc();
+    LdcMemoryAllocation allocation = {0};
+    LCEVCContainer* lcevcContainer =
+        lcevcContainerCreate(allocator, &allocation, kContainerDefaultCapacity);
+    ASSERT_NE(lcevcContainer, nullptr);
+
+    ASSERT_TRUE(lcevcContainerInsert(lcevcContainer, kRandData2,
+                                     static_cast<uint32_t>(kRandLengths[1]), 100, false, 0));
+    ASSERT_TRUE(lcevcContainerInsert(lcevcContainer, kRandData3,
+                                     static_cast<uint32_t>(kRandLengths[2]), 200, false, 0));
+    bool isNext = false;
+    StampedBuffer* buffer = lcevcContainerExtract(lcevcContainer, 100, &isNext);
+    ASSERT_NE(buffer, nullptr);
+
+    lcevcContainerDestroy(lcevcContainer);
+
+    ASSERT_EQ(stampedBufferGetBufSize(buffer), kRandLengths[1]);
+    EXPECT_TRUE(
+        std::equal(kRandData2, kRandData2 + kRandLengths[1], stampedBufferGetBuffer(buffer)));
+    stampedBufferRelease(&buffer);
+}
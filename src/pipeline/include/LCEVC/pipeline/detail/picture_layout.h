@@ -158,6 +158,12 @@ static inline LdpColorSpace ldpPictureLayoutColorSpace(const LdpPictureLayout* l
     return layout->layoutInfo->colorSpace;
 }
 
+static inline bool ldpPictureLayoutIsSemiPlanar(const LdpPictureLayout* layout)
+{
+    return layout->layoutInfo->colorSpace == LdpColorSpaceYUV &&
+           layout->layoutInfo->colorComponents == 3 && layout->layoutInfo->interleave[1] == 2;
+}
+
 static inline bool ldpPictureLayoutAreRowsContiguous(const LdpPictureLayout* layout, uint32_t plane)
 {
     assert(plane < ldpPictureLayoutPlanes(layout));
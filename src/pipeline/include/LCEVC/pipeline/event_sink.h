@@ -60,6 +60,12 @@ public:
                           const LdpDecodeInformation* decodeInfo = nullptr,
                           const uint8_t* data = nullptr, uint32_t dataSize = 0) = 0;
 
+    // Direct completion - if enabled, a pipeline that supports it hands each finished output
+    // picture to completePicture() in timestamp order, on the worker thread that finished it,
+    // rather than returning it from receiveOutputPicture(). completePicture() must not block.
+    virtual bool isCompletionEnabled() const = 0;
+    virtual void completePicture(LdpPicture* picture, const LdpDecodeInformation* decodeInfo) = 0;
+
     // Return a pointer to a common event sink that does nothing
     static EventSink* nullSink();
 
@@ -19,6 +19,7 @@
 #include <LCEVC/enhancement/cmdbuffer_cpu.h>
 #include <LCEVC/enhancement/cmdbuffer_gpu.h>
 #include <LCEVC/enhancement/config_types.h>
+#include <LCEVC/enhancement/decode.h>
 #include <LCEVC/pipeline/picture.h>
 #include <stdint.h>
 
@@ -47,6 +48,9 @@ typedef struct LdpEnhancementTile
     LdeCmdBufferCpu buffer;
     LdeCmdBufferGpu bufferGpu;
     LdeCmdBufferGpuBuilder bufferGpuBuilder;
+
+    // Entropy decoded layers, between decoding layers in parallel and generating the command buffer
+    LdeLayerRuns layerRuns;
 } LdpEnhancementTile;
 
 // Frame
@@ -155,6 +155,9 @@ static inline LdpColorSpace ldpPictureLayoutColorSpace(const LdpPictureLayout* l
 // Return the extension to use for raw output files of this format
 static inline const char* ldpPictureLayoutSuffix(const LdpPictureLayout* layout);
 
+// Return true if the layout is YUV with both chroma components interleaved in one plane, eg: NV12
+static inline bool ldpPictureLayoutIsSemiPlanar(const LdpPictureLayout* layout);
+
 // Return true if there are no gaps between rows of pixels
 static inline bool ldpPictureLayoutAreRowsContiguous(const LdpPictureLayout* layout, uint32_t plane);
 
@@ -19,6 +19,7 @@
 #include <LCEVC/common/configure.hpp>
 #include <LCEVC/common/return_code.h>
 #include <LCEVC/common/shared_library.h>
+#include <LCEVC/common/task_pool.h>
 #include <LCEVC/pipeline/buffer.h>
 #include <LCEVC/pipeline/event_sink.h>
 #include <LCEVC/pipeline/picture.h>
@@ -61,6 +62,11 @@ public:
 
     virtual std::unique_ptr<Pipeline> finish(EventSink* eventSink) const = 0;
 
+    // Run the pipeline's parallel work on a task pool owned by the caller, that may be shared with
+    // other pipelines, and must outlive the pipeline. Pipelines that cannot use one return false,
+    // and keep their own threads.
+    virtual bool setTaskPool(LdcTaskPool* /*taskPool*/) { return false; }
+
     VNNoCopyNoMove(PipelineBuilder);
 
 private:
@@ -102,6 +108,12 @@ public:
 
     virtual void freePicture(LdpPicture* picture) = 0;
 
+    // Memory accounting - pipelines that do not track their allocations return NotSupported
+    virtual LdcReturnCode getMemoryUsage(LdpMemoryUsage& /*usageOut*/)
+    {
+        return LdcReturnCodeNotSupported;
+    }
+
     VNNoCopyNoMove(Pipeline);
 
 private:
@@ -88,6 +88,10 @@ typedef enum LdpColorFormat
 
     LdpColorFormatNV12_8 = 2001,
     LdpColorFormatNV21_8 = 2002,
+    LdpColorFormatNV16_8 = 2003,
+    LdpColorFormatP010_LE = 2004,
+    LdpColorFormatP016_LE = 2005,
+    LdpColorFormatP210_LE = 2006,
 
     LdpColorFormatRGB_8 = 3001,
     LdpColorFormatBGR_8 = 3002,
@@ -206,6 +210,15 @@ typedef enum LdpFixedPoint
 
 typedef struct LdpAccelBuffer LdpAccelBuffer;
 
+// Matches LCEVC_Degradation
+typedef enum LdpDegradation
+{
+    LdpDegradationNone = 0,
+    LdpDegradationSkipLOQ0 = 1,
+    LdpDegradationSkipTemporal = 2,
+    LdpDegradationScaledPassthrough = 4,
+} LdpDegradation;
+
 // Matches LCEVC_DecodeInformation
 typedef struct LdpDecodeInformation
 {
@@ -218,10 +231,36 @@ typedef struct LdpDecodeInformation
     uint32_t baseWidth;
     uint32_t baseHeight;
     uint8_t baseBitdepth;
+    uint8_t degradation;
 
     void* userData;
 } LdpDecodeInformation;
 
+// Matches LCEVC_MemoryCategory
+typedef enum LdpMemoryCategory
+{
+    LdpMemoryCategoryFrames = 0,
+    LdpMemoryCategoryTemporal = 1,
+    LdpMemoryCategoryIntermediate = 2,
+    LdpMemoryCategoryCmdBuffers = 3,
+    LdpMemoryCategoryTasks = 4,
+    LdpMemoryCategoryOther = 5,
+
+    LdpMemoryCategoryCount,
+    LdpMemoryCategoryForceInt32 = 0x7ffffff,
+} LdpMemoryCategory;
+
+// Matches LCEVC_MemoryUsage
+typedef struct LdpMemoryUsage
+{
+    uint64_t current[LdpMemoryCategoryCount];
+    uint64_t peak[LdpMemoryCategoryCount];
+    uint64_t total;
+    uint64_t totalPeak;
+    uint64_t budget;
+    bool degraded;
+} LdpMemoryUsage;
+
 // Stores sample_aspect_ratio_num and sample_aspect_ratio_den
 typedef struct LdpAspectRatio
 {
@@ -32,6 +32,14 @@ public:
     {
         // Never genaretes any events
     }
+
+    bool isCompletionEnabled() const override { return false; }
+
+    void completePicture(struct LdpPicture* picture,
+                         const LdpDecodeInformation* decodeInfo) override
+    {
+        // Never enabled
+    }
 };
 
 EventSink* EventSink::nullSink()
@@ -57,6 +57,10 @@
                                                                                                                                                                                       \
         {LdpColorFormatNV12_8,         LdpColorSpaceYUV,       3, 1, 1, {0, 1},    {0, 1},    {0, 0},    {1, 2, 2},    {0, 0, 1},    BITS(8),  LdpFP##prefix##8,  ".nv12"},           \
         {LdpColorFormatNV21_8,         LdpColorSpaceYUV,       3, 1, 1, {0, 1},    {0, 1},    {0, 0},    {1, 2, 2},    {0, 1, 0},    BITS(8),  LdpFP##prefix##8,  ".nv21"},           \
+        {LdpColorFormatNV16_8,         LdpColorSpaceYUV,       3, 1, 0, {0, 1},    {0, 0},    {0, 0},    {1, 2, 2},    {0, 0, 1},    BITS(8),  LdpFP##prefix##8,  ".nv16"},           \
+        {LdpColorFormatP010_LE,        LdpColorSpaceYUV,       3, 1, 1, {0, 1},    {0, 1},    {0, 0},    {1, 2, 2},    {0, 0, 2},    BITS(16), LdpFP##prefix##10, ".p010"},           \
+        {LdpColorFormatP016_LE,        LdpColorSpaceYUV,       3, 1, 1, {0, 1},    {0, 1},    {0, 0},    {1, 2, 2},    {0, 0, 2},    BITS(16), LdpFP##prefix##14, ".p016"},           \
+        {LdpColorFormatP210_LE,        LdpColorSpaceYUV,       3, 1, 0, {0, 1},    {0, 0},    {0, 0},    {1, 2, 2},    {0, 0, 2},    BITS(16), LdpFP##prefix##10, ".p210"},           \
                                                                                                                                                                                       \
         {LdpColorFormatRGB_8,          LdpColorSpaceRGB,       3, 0, 0, {0},       {0},       {0},       {3, 3, 3},    {0, 1, 2},    BITS(8),  LdpFP##prefix##8,  ".rgb"},            \
         {LdpColorFormatBGR_8,          LdpColorSpaceRGB,       3, 0, 0, {0},       {0},       {0},       {3, 3, 3},    {2, 1, 0},    BITS(8),  LdpFP##prefix##8,  ".bgr"},            \
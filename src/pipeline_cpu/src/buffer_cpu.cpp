@@ -30,14 +30,15 @@ BufferCPU::BufferCPU(PipelineCPU& pipeline, uint32_t size)
 {
     // Allocate the bytes
     if (size > 0) {
-        VNAllocateAlignedArray(m_pipeline.allocator(), &m_allocation, uint8_t, kBufferRowAlignment, size);
+        VNAllocateAlignedArray(m_pipeline.allocator(LdpMemoryCategoryFrames), &m_allocation,
+                               uint8_t, kBufferRowAlignment, size);
     }
 }
 
 BufferCPU::~BufferCPU()
 {
     if (VNIsAllocated(m_allocation)) {
-        VNFree(m_pipeline.allocator(), &m_allocation);
+        VNFree(m_pipeline.allocator(LdpMemoryCategoryFrames), &m_allocation);
     }
 }
 
@@ -91,7 +92,8 @@ uint32_t BufferCPU::size() const
 
 bool BufferCPU::resize(uint32_t size)
 {
-    const uint8_t* ptr = VNReallocateArray(m_pipeline.allocator(), &m_allocation, uint8_t, size);
+    const uint8_t* ptr = VNReallocateArray(m_pipeline.allocator(LdpMemoryCategoryFrames),
+                                           &m_allocation, uint8_t, size);
     return ptr != nullptr;
 }
 
@@ -21,6 +21,7 @@
 #include <LCEVC/common/memory.h>
 #include <LCEVC/common/platform.h>
 #include <LCEVC/common/return_code.h>
+#include <LCEVC/common/threads.h>
 #include <LCEVC/enhancement/bitstream_types.h>
 #include <LCEVC/enhancement/cmdbuffer_cpu.h>
 #include <LCEVC/enhancement/config_parser.h>
@@ -59,7 +60,7 @@ FrameCPU::FrameCPU(PipelineCPU* pipeline, uint64_t timestamp)
 //
 bool FrameCPU::initialize()
 {
-    if (!initializeCommandBuffers() || !initializeIntermediateBuffers())
+    if (!initializeCommandBuffers())
         return false;
 
     // Figure out dithering strength either from the frame or local config override
@@ -72,7 +73,11 @@ bool FrameCPU::initialize()
         }
     }
 
-    return ldppDitherFrameInitialise(&m_frameDither, m_pipeline->globalDitherBuffer(), timestamp, strength);
+    if (!ldppDitherFrameInitialise(&m_frameDither, m_pipeline->globalDither(), timestamp, strength))
+        return false;
+
+    // After dithering, which decides the intermediate format
+    return initializeIntermediateBuffers();
 }
 
 // Generate task graph
@@ -115,9 +120,11 @@ void FrameCPU::release(bool wait)
 
     ldcTaskGroupDestroy(&m_taskGroup);
 
-    VNFree(m_pipeline->allocator(), &m_enhancementData);
+    // Release config first - chunks point into the enhancement data
+    ldeConfigPoolFrameRelease(m_pipeline->configPool(), &config, globalConfig);
+    globalConfig = nullptr;
 
-    ldeConfigsReleaseFrame(&config);
+    VNFree(m_pipeline->frameAllocator(LdpMemoryCategoryFrames), &m_enhancementData);
 
     releaseCommandBuffers();
     releaseIntermediateBuffers();
@@ -150,7 +157,9 @@ bool FrameCPU::initializeCommandBuffers()
         return true;
     }
 
-    enhancementTiles = VNAllocateArray(m_pipeline->allocator(), &m_enhancementTilesAllocation,
+    LdcMemoryAllocator* const cmdBufferAllocator{
+        m_pipeline->frameAllocator(LdpMemoryCategoryCmdBuffers)};
+    enhancementTiles = VNAllocateArray(cmdBufferAllocator, &m_enhancementTilesAllocation,
                                        LdpEnhancementTile, enhancementTileCount);
     if (!enhancementTiles) {
         return false;
@@ -181,12 +190,24 @@ bool FrameCPU::initializeCommandBuffers()
                                        &et->tileX, &et->tileY);
                 et->planeWidth = planeWidth;
                 et->planeHeight = planeHeight;
-
-                if (!ldeCmdBufferCpuInitialize(m_pipeline->allocator(), &et->buffer, 0)) {
-                    return false;
-                }
-                if (!ldeCmdBufferCpuReset(&et->buffer, globalConfig->numLayers)) {
-                    return false;
+                ldeLayerRunsInitialize(cmdBufferAllocator, &et->layerRuns);
+
+                if (m_pipeline->configuration().bitmaskCmdBuffers) {
+                    if (!ldeCmdBufferGpuInitialize(cmdBufferAllocator, &et->bufferGpu,
+                                                   &et->bufferGpuBuilder)) {
+                        return false;
+                    }
+                    if (!ldeCmdBufferGpuReset(&et->bufferGpu, &et->bufferGpuBuilder,
+                                              globalConfig->numLayers)) {
+                        return false;
+                    }
+                } else {
+                    if (!ldeCmdBufferCpuInitialize(cmdBufferAllocator, &et->buffer, 0)) {
+                        return false;
+                    }
+                    if (!ldeCmdBufferCpuReset(&et->buffer, globalConfig->numLayers)) {
+                        return false;
+                    }
                 }
                 et++;
             }
@@ -201,9 +222,38 @@ void FrameCPU::releaseCommandBuffers()
 {
     // Release comamnd buffers
     for (uint32_t i = 0; i < enhancementTileCount; ++i) {
-        ldeCmdBufferCpuFree(&enhancementTiles[i].buffer);
+        if (m_pipeline->configuration().bitmaskCmdBuffers) {
+            ldeCmdBufferGpuFree(&enhancementTiles[i].bufferGpu,
+                                &enhancementTiles[i].bufferGpuBuilder);
+        } else {
+            ldeCmdBufferCpuFree(&enhancementTiles[i].buffer);
+        }
+        ldeLayerRunsFree(&enhancementTiles[i].layerRuns);
     }
-    VNFree(m_pipeline->allocator(), &m_enhancementTilesAllocation);
+    VNFree(m_pipeline->frameAllocator(LdpMemoryCategoryCmdBuffers), &m_enhancementTilesAllocation);
+}
+
+// Can the intermediate buffers be U8 without changing the output?
+//
+// Adding residuals or the temporal buffer to a U8 plane rounds and clamps each sample exactly as
+// the final conversion of an S16 plane would, so a single add is lossless. Interpolating upscales
+// and dithering round after each pass and clamp any overshoot, and LOQ1 residuals would be clamped
+// before the LOQ0 stages add to them, so frames with any of those stay at full precision.
+//
+bool FrameCPU::reducedPrecisionExact() const
+{
+    if (!globalConfig->initialized || globalConfig->baseDepth != Depth8 ||
+        globalConfig->enhancedDepth != Depth8) {
+        return false;
+    }
+
+    const bool upscaled = globalConfig->scalingModes[LOQ0] != Scale0D ||
+                          globalConfig->scalingModes[LOQ1] != Scale0D;
+    if (upscaled && (globalConfig->upscale != USNearest || m_frameDither.strength != 0)) {
+        return false;
+    }
+
+    return !config.loqEnabled[LOQ1];
 }
 
 // Set up intermediate buffers
@@ -214,6 +264,8 @@ bool FrameCPU::initializeIntermediateBuffers()
 {
     const LdpColorFormat format = getBaseColorFormat();
 
+    m_reducedPrecision = m_pipeline->configuration().reducedPrecision && reducedPrecisionExact();
+
     // Allocate buffers starting at LOQ0, down to LOQ2 - As we go down, if there is no scaling
     // between layers, then the buffer will be shared with lower LOQ.
     for (int8_t loq = LOQ0; loq <= LOQ2; loq++) {
@@ -226,8 +278,17 @@ bool FrameCPU::initializeIntermediateBuffers()
             height = static_cast<uint16_t>(baseHeight);
         }
 
-        ldpInternalPictureLayoutInitialize(&m_intermediateLayout[loq], format, width, height,
-                                           kBufferRowAlignment);
+        if (m_reducedPrecision) {
+            ldpPictureLayoutInitialize(&m_intermediateLayout[loq], format, width, height,
+                                       kBufferRowAlignment);
+        } else {
+            ldpInternalPictureLayoutInitialize(&m_intermediateLayout[loq], format, width, height,
+                                               kBufferRowAlignment);
+        }
+        if (loq == LOQ0) {
+            ldpInternalPictureLayoutInitialize(&m_temporalLayout, format, width, height,
+                                               kBufferRowAlignment);
+        }
 
         const uint8_t numPlanes = std::min(ldpPictureLayoutPlanes(&m_intermediateLayout[loq]),
                                            static_cast<uint8_t>(RCMaxPlanes));
@@ -236,7 +297,7 @@ bool FrameCPU::initializeIntermediateBuffers()
             if (needsIntermediateBuffer(static_cast<LdeLOQIndex>(loq), plane)) {
                 // Create internal buffer for this LoQ/plane
                 const uint32_t loqSize = ldpPictureLayoutPlaneSize(&m_intermediateLayout[loq], plane);
-                if (!VNAllocateAlignedArray(m_pipeline->allocator(),
+                if (!VNAllocateAlignedArray(m_pipeline->allocator(LdpMemoryCategoryIntermediate),
                                             &m_intermediateBufferAllocation[plane][loq], uint8_t,
                                             kBufferRowAlignment, loqSize)) {
                     return false;
@@ -269,7 +330,8 @@ void FrameCPU::releaseIntermediateBuffers()
     for (uint8_t plane = 0; plane < RCMaxPlanes; plane++) {
         for (int8_t loq = LOQ0; loq <= LOQ2; loq++) {
             if (VNIsAllocated(m_intermediateBufferAllocation[plane][loq])) {
-                VNFree(m_pipeline->allocator(), &m_intermediateBufferAllocation[plane][loq]);
+                VNFree(m_pipeline->allocator(LdpMemoryCategoryIntermediate),
+                       &m_intermediateBufferAllocation[plane][loq]);
             }
         }
     }
@@ -309,6 +371,9 @@ LdcReturnCode FrameCPU::setBase(LdpPicture* picture, uint64_t deadline, void* ba
     baseFormat = ldpPictureLayoutFormat(&basePicture->layout);
 
     m_deadline = deadline;
+    if (m_pipeline->configuration().deadlinePolicy) {
+        m_baseTime = threadTimeMicroseconds(0);
+    }
 
     // Set base and mark dependency as met
     ldcTaskDependencyMet(&m_taskGroup, m_depBasePicture, basePicture);
@@ -364,13 +429,33 @@ bool FrameCPU::isEnhanced(LdeLOQIndex loq, uint32_t plane) const
 // Figure output colour format from frame configuration
 LdpColorFormat FrameCPU::getOutputColorFormat() const
 {
-    if (baseFormat == LdpColorFormatNV12_8 || baseFormat == LdpColorFormatNV21_8) {
+    // Semi-planar bases get a semi-planar output of the enhanced depth
+    if (baseFormat == LdpColorFormatNV21_8) {
         if (globalConfig->enhancedDepth != Depth8) {
-            VNLogError("Cannot enhance to > 8bit when using an NV12/21 base");
+            VNLogError("Cannot enhance to > 8bit when using an NV21 base");
             return LdpColorFormatUnknown;
         }
         return baseFormat;
     }
+    if (baseFormat == LdpColorFormatNV12_8 || baseFormat == LdpColorFormatP010_LE ||
+        baseFormat == LdpColorFormatP016_LE) {
+        switch (globalConfig->enhancedDepth) {
+            case Depth8: return LdpColorFormatNV12_8;
+            case Depth10: return LdpColorFormatP010_LE;
+            case Depth12:
+            case Depth14: return LdpColorFormatP016_LE;
+            default: return LdpColorFormatUnknown;
+        }
+    }
+    if (baseFormat == LdpColorFormatNV16_8 || baseFormat == LdpColorFormatP210_LE) {
+        switch (globalConfig->enhancedDepth) {
+            case Depth8: return LdpColorFormatNV16_8;
+            case Depth10: return LdpColorFormatP210_LE;
+            default:
+                VNLogError("Cannot enhance to > 10bit when using an NV16/P210 base");
+                return LdpColorFormatUnknown;
+        }
+    }
 
     switch (globalConfig->chroma) {
         case CTMonochrome:
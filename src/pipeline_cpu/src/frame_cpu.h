@@ -59,6 +59,7 @@ public:
     bool initializeCommandBuffers();
     void releaseCommandBuffers();
 
+    bool reducedPrecisionExact() const;
     bool initializeIntermediateBuffers();
     void releaseIntermediateBuffers();
 
@@ -70,6 +71,13 @@ public:
         return VNAllocationPtr(m_enhancementTilesAllocation, LdpEnhancementTile) + tileIdx;
     }
 
+    // Find the tile index of a command buffer
+    uint32_t enhancementTileIndex(const LdpEnhancementTile* tile) const
+    {
+        return static_cast<uint32_t>(
+            tile - VNAllocationPtr(m_enhancementTilesAllocation, LdpEnhancementTile));
+    }
+
     // Attach a base picture to the frame (and mark dependency as met)
     LdcReturnCode setBase(LdpPicture* picture, uint64_t deadline, void* userData);
 
@@ -92,6 +100,12 @@ public:
     // Construct picture description for output
     LdpPictureDesc getOutputPictureDesc() const;
 
+    // Accumulate time spent by one of this frame's tasks on a decode stage
+    void addStageTime(DecodeStage stage, uint64_t microseconds)
+    {
+        m_stageTime[stage] += microseconds;
+    }
+
     uint8_t numEnhancedPlanes() const { return globalConfig->numPlanes; }
     uint8_t numImagePlanes() const;
 
@@ -133,6 +147,12 @@ private:
     LdcMemoryAllocation m_intermediateBufferAllocation[RCMaxPlanes][LOQMaxCount] = {};
     LdpPictureLayout m_intermediateLayout[LOQMaxCount] = {};
 
+    // True if the intermediate buffers use the reduced precision U8 format rather than S16
+    bool m_reducedPrecision{false};
+
+    // Layout of the temporal buffers - S16 even when the intermediate buffers are reduced
+    LdpPictureLayout m_temporalLayout{};
+
     // Pointers to buffer to use for each LOQ - may share buffers between LoQs depending on scaling modes
     uint8_t* m_intermediateBufferPtr[RCMaxPlanes][LOQMaxCount] = {};
 
@@ -147,6 +167,14 @@ private:
     // Temporal buffer(s) assigned to this frame (once dependency is met)
     TemporalBuffer* m_temporalBuffer[RCMaxPlanes] = {};
 
+    // True if a copy of this frame's temporal state has already been handed on to the next frame,
+    // so the buffer goes back to the pool when released
+    bool m_temporalForwarded[RCMaxPlanes] = {};
+
+    // True while this frame is waiting for any free temporal buffer to start a new chain of
+    // temporal state (GOP parallel decode). Protected by the pipeline's m_interTaskMutex.
+    bool m_temporalNewChain[RCMaxPlanes] = {};
+
     // Dithering info for this frame
     LdppDitherFrame m_frameDither{};
 
@@ -160,9 +188,23 @@ private:
     // True if this frame should be copied to output with no processing (but optionally scaled)
     bool m_passthrough{false};
 
+    // True once the output picture has been handed to the event sink's completion callback - the
+    // frame is then released by the next API call. Protected by the pipeline's m_interTaskMutex.
+    bool m_completed{false};
+
     // Deadline for this frame in microseconds relative to threadTimeMicroseconds()
     uint64_t m_deadline{UINT64_MAX};
 
+    // Times that the base arrived and that tasks were generated, from threadTimeMicroseconds()
+    uint64_t m_baseTime{0};
+    uint64_t m_startTime{0};
+
+    // How decoding of this frame was reduced to meet its deadline - LdpDegradation flags
+    uint8_t m_degradation{LdpDegradationNone};
+
+    // Time spent by this frame's tasks on each decode stage, in microseconds
+    std::atomic<uint64_t> m_stageTime[DecodeStageCount] = {};
+
     // Final decodeInfo to sent back to API
     LdpDecodeInformation m_decodeInfo;
 };
@@ -155,7 +155,8 @@ bool PictureCPU::lock(LdpAccess access, PictureLock*& lockOut)
     }
 
     // Allocate lock object, and in-place construct
-    PictureLock* pictureLock = VNAllocate(m_pipeline.allocator(), &m_lockAllocation, PictureLock);
+    PictureLock* pictureLock =
+        VNAllocate(m_pipeline.allocator(LdpMemoryCategoryFrames), &m_lockAllocation, PictureLock);
     lockOut = new (pictureLock) PictureLock(this, access); // NOLINT(cppcoreguidelines-owning-memory)
 
     return true;
@@ -173,7 +174,7 @@ bool PictureCPU::unlock(const PictureLock* lock)
 
     // Release the lock object
     if (VNIsAllocated(m_lockAllocation)) {
-        VNFree(m_pipeline.allocator(), &m_lockAllocation);
+        VNFree(m_pipeline.allocator(LdpMemoryCategoryFrames), &m_lockAllocation);
     }
 
     return true;
@@ -28,19 +28,30 @@ using namespace common;
 //
 static const ConfigMemberMap<PipelineConfigCPU> kConfigMemberMap = {
     {"allow_dithering", makeBinding(&PipelineConfigCPU::ditherEnabled)},
+    {"bitmask_cmdbuffers", makeBinding(&PipelineConfigCPU::bitmaskCmdBuffers)},
+    {"deadline_policy", makeBinding(&PipelineConfigCPU::deadlinePolicy)},
     {"default_max_reorder", makeBinding(&PipelineConfigCPU::defaultMaxReorder)},
     {"dither_seed", makeBinding(&PipelineConfigCPU::setDitherSeed)},
     {"dither_strength", makeBinding(&PipelineConfigCPU::ditherOverrideStrength)},
     {"enhancement_delay", makeBinding(&PipelineConfigCPU::enhancementDelay)},
+    {"enhancement_unescaped", makeBinding(&PipelineConfigCPU::enhancementUnescaped)},
     {"force_bitstream_version", makeBinding(&PipelineConfigCPU::forceBitstreamVersion)},
     {"force_scalar", makeBinding(&PipelineConfigCPU::forceScalar)},
+    {"gop_parallel_decode", makeBinding(&PipelineConfigCPU::gopParallelDecode)},
     {"highlight_residuals", makeBinding(&PipelineConfigCPU::highlightResiduals)},
+    {"huffman_cache_size", makeBinding(&PipelineConfigCPU::huffmanCacheSize)},
     {"log_tasks", makeBinding(&PipelineConfigCPU::showTasks)},
     {"max_latency", makeBinding(&PipelineConfigCPU::maxLatency)},
+    {"memory_budget_mb", makeBinding(&PipelineConfigCPU::memoryBudgetMB)},
+    {"memory_usage", makeBinding(&PipelineConfigCPU::memoryUsage)},
     {"min_latency", makeBinding(&PipelineConfigCPU::minLatency)},
     {"temporal_buffers", makeBinding(&PipelineConfigCPU::numTemporalBuffers)},
+    {"temporal_forward", makeBinding(&PipelineConfigCPU::temporalForward)},
+    {"parallel_layer_decode", makeBinding(&PipelineConfigCPU::parallelLayerDecode)},
     {"passthrough_mode", makeBinding(&PipelineConfigCPU::setPassthroughMode)},
+    {"reduced_precision", makeBinding(&PipelineConfigCPU::reducedPrecision)},
     {"s_filter_strength", makeBinding(&PipelineConfigCPU::sharpeningOverrideStrength)},
+    {"task_graph_templates", makeBinding(&PipelineConfigCPU::taskGraphTemplates)},
     {"threads", makeBinding(&PipelineConfigCPU::numThreads)},
 };
 
@@ -61,6 +72,12 @@ std::unique_ptr<pipeline::Pipeline> PipelineBuilderCPU::finish(pipeline::EventSi
     return pipeline;
 }
 
+bool PipelineBuilderCPU::setTaskPool(LdcTaskPool* taskPool)
+{
+    m_taskPool = taskPool;
+    return true;
+}
+
 // Forward configuration to default config mapping mechanism.
 //
 bool PipelineBuilderCPU::configure(std::string_view name, bool val)
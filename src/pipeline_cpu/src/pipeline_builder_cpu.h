@@ -43,9 +43,11 @@ public:
 
     // PipelineBuilder
     std::unique_ptr<pipeline::Pipeline> finish(pipeline::EventSink* eventSink) const override;
+    bool setTaskPool(LdcTaskPool* taskPool) override;
 
     LdcMemoryAllocator* allocator() const { return m_allocator; }
     const PipelineConfigCPU& configuration() const { return m_configuration; }
+    LdcTaskPool* taskPool() const { return m_taskPool; }
 
     VNNoCopyNoMove(PipelineBuilderCPU);
 
@@ -54,6 +56,9 @@ private:
 
     LdcMemoryAllocator* m_allocator = nullptr;
 
+    // An externally owned task pool, or null for the pipeline to start its own
+    LdcTaskPool* m_taskPool = nullptr;
+
     PipelineConfigCPU m_configuration;
 
     common::ConfigurableMembers<PipelineConfigCPU> m_configurableMembers;
@@ -39,16 +39,27 @@ struct PipelineConfigCPU
     // Memory arena defaults
     uint32_t initialArenaCount = 1024;
     uint32_t initialArenaSize = 65536;
+    // Size of each thread's lock-free region within an arena, or 0 to always take the arena lock
+    uint32_t arenaRegionSize = 16384;
 
     // Maximum number of frames to buffer
     uint32_t maxLatency = 32;
 
+    // Memory budget in MiB, or 0 for none - over budget, latency is reduced and frames passed through
+    uint32_t memoryBudgetMB = 0;
+
+    // Account memory by category for getMemoryUsage() even without a budget
+    bool memoryUsage = false;
+
     // Minimum frames that can be held for batching
     uint32_t minLatency = 0;
 
     // Number of threads - thread pool plus main thread - defaults is filled in from number of platform cores plus 1
     uint32_t numThreads = 1;
 
+    // Number of built Huffman decoders to cache between tiles and frames, or 0 to always build them
+    uint32_t huffmanCacheSize = 16;
+
     // Initial Number of slots reserved in task pool
     uint32_t numReservedTasks = 32;
 
@@ -58,15 +69,37 @@ struct PipelineConfigCPU
     // Number of frames late that enhancement can arrive late (non-standard)
     uint32_t enhancementDelay = 0;
 
+    // Enhancement data has already had emulation prevention bytes removed
+    bool enhancementUnescaped = false;
+
     // Force scalar pixel operations
     bool forceScalar = false;
 
     // Show residuals for debugging
     bool highlightResiduals = false;
 
+    // Generate and apply block bitmask (GPU format) command buffers
+    bool bitmaskCmdBuffers = false;
+
+    // Use U8 rather than S16 intermediate planes for 8-bit frames, where the output is unchanged
+    bool reducedPrecision = false;
+
+    // Entropy decode the layers of each enhancement tile in parallel, then merge them to commands
+    bool parallelLayerDecode = false;
+
     // Number of temporal buffers per channel
     uint32_t numTemporalBuffers = 1;
 
+    // Copy temporal state into a spare temporal buffer for the next frame as soon as it is ready
+    bool temporalForward = false;
+
+    // Start frames at a temporal refresh or IDR on any free temporal buffer, rather than the
+    // previous frame's, so that the segments between refresh points decode concurrently (offline)
+    bool gopParallelDecode = false;
+
+    // Reduce the enhancement of frames predicted to miss their deadline, from measured decode costs
+    bool deadlinePolicy = false;
+
     // How passthrough is handled by pipeline
     PassthroughMode passthroughMode = PassthroughMode::Scale;
 
@@ -84,6 +117,9 @@ struct PipelineConfigCPU
     // Describe generated frame tasks in log
     bool showTasks = false;
 
+    // Reuse recorded task graphs for frames with the same configuration
+    bool taskGraphTemplates = false;
+
     // 'set' methods to adapt config types to internal values
     //
     bool setDitherSeed(const int32_t& val)
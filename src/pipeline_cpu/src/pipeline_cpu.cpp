@@ -24,6 +24,7 @@
 #include <LCEVC/common/limit.h>
 #include <LCEVC/common/log.h>
 #include <LCEVC/common/memory.h>
+#include <LCEVC/common/memory_tracker.h>
 #include <LCEVC/common/return_code.h>
 #include <LCEVC/common/task_pool.h>
 #include <LCEVC/common/threads.h>
@@ -35,6 +36,7 @@
 #include <LCEVC/pixel_processing/blit.h>
 #include <LCEVC/pixel_processing/upscale.h>
 //
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -86,6 +88,55 @@ namespace {
         return compareTimestamps(ets, ts);
     }
 
+    // Number of bytes in the block map of a temporal buffer
+    inline size_t temporalBlockMapSize(const TemporalBufferDesc& desc)
+    {
+        return static_cast<size_t>((desc.width + BSTemporal - 1) >> BSTemporalShift) *
+               ((desc.height + BSTemporal - 1) >> BSTemporalShift);
+    }
+
+    // Categories with a rolling arena for blocks that live no longer than their frame
+    constexpr LdpMemoryCategory kFrameArenaCategories[] = {
+        LdpMemoryCategoryFrames, LdpMemoryCategoryIntermediate, LdpMemoryCategoryCmdBuffers,
+        LdpMemoryCategoryTasks};
+
+    // Weight of each new measurement in the averaged decode costs
+    constexpr float kDecodeCostWeight = 0.125f;
+
+    inline float averageDecodeCost(float average, float measurement)
+    {
+        return (average > 0.0f) ? average + (measurement - average) * kDecodeCostWeight
+                                : measurement;
+    }
+
+    // Adds the time a task spends to a decode stage of its frame, when the deadline policy is on
+    class StageTimer
+    {
+    public:
+        StageTimer(const PipelineCPU* pipeline, FrameCPU* frame, DecodeStage stage)
+            : m_frame(pipeline->configuration().deadlinePolicy ? frame : nullptr)
+            , m_stage(stage)
+            , m_start(m_frame ? threadTimeMicroseconds(0) : 0)
+        {}
+        ~StageTimer()
+        {
+            if (m_frame) {
+                m_frame->addStageTime(m_stage, threadTimeMicroseconds(0) - m_start);
+            }
+        }
+        VNNoCopyNoMove(StageTimer);
+
+    private:
+        FrameCPU* m_frame;
+        DecodeStage m_stage;
+        uint64_t m_start;
+    };
+
+    inline DecodeStage tileStage(const LdpEnhancementTile* enhancementTile)
+    {
+        return (enhancementTile->loq == LOQ0) ? DecodeStageLOQ0 : DecodeStageLOQ1;
+    }
+
 } // namespace
 
 // PipelineCPU
@@ -93,13 +144,14 @@ namespace {
 PipelineCPU::PipelineCPU(const PipelineBuilderCPU& builder, pipeline::EventSink* eventSink)
     : m_configuration(builder.configuration())
     , m_eventSink(eventSink ? eventSink : pipeline::EventSink::nullSink())
-    , m_allocator(builder.allocator())
+    , m_allocator(initializeMemoryTracker(builder.allocator()))
     , m_buffers(builder.configuration().maxLatency, builder.allocator())
     , m_pictures(builder.configuration().maxLatency, builder.allocator())
     , m_frames(builder.configuration().maxLatency, builder.allocator())
     , m_reorderIndex(builder.configuration().maxLatency, builder.allocator())
     , m_processingIndex(builder.configuration().maxLatency, builder.allocator())
     , m_maxReorder(m_configuration.defaultMaxReorder)
+    , m_latencyLimit(m_configuration.maxLatency)
     , m_temporalBuffers(builder.configuration().numTemporalBuffers * RCMaxPlanes, builder.allocator())
     , m_basePicturePending(nextPowerOfTwoU32(builder.configuration().maxLatency + 1), builder.allocator())
     , m_basePictureOutBuffer(nextPowerOfTwoU32(builder.configuration().maxLatency + 1), builder.allocator())
@@ -107,11 +159,17 @@ PipelineCPU::PipelineCPU(const PipelineBuilderCPU& builder, pipeline::EventSink*
                                      builder.allocator())
 {
     // Set up dithering
-    ldppDitherGlobalInitialize(m_allocator, &m_dither, m_configuration.ditherSeed);
-
-    // Set up an allocator for per frame data
-    ldcRollingArenaInitialize(&m_rollingArena, m_allocator, m_configuration.initialArenaCount,
-                              m_configuration.initialArenaSize);
+    ldppDitherGlobalInitialize(&m_dither, m_configuration.ditherSeed);
+
+    // Set up allocators for per frame data
+    for (const LdpMemoryCategory category : kFrameArenaCategories) {
+        LdcMemoryAllocatorRollingArena* arena = &m_rollingArenas[category];
+        ldcRollingArenaInitialize(arena, allocator(category), m_configuration.initialArenaCount,
+                                  m_configuration.initialArenaSize);
+        if (m_configuration.arenaRegionSize > 0) {
+            ldcRollingArenaEnableThreadRegions(arena, m_configuration.arenaRegionSize);
+        }
+    }
 
     // Configuration pool
     LdeBitstreamVersion bitstreamVersion = BitstreamVersionUnspecified;
@@ -121,17 +179,34 @@ PipelineCPU::PipelineCPU(const PipelineBuilderCPU& builder, pipeline::EventSink*
     }
     ldeConfigPoolInitialize(m_allocator, &m_configPool, bitstreamVersion);
 
-    // Start task pool - pool threads is 1 less than configured threads
-    VNCheck(m_configuration.numThreads >= 1);
-    ldcTaskPoolInitialize(&m_taskPool, m_allocator, m_allocator, m_configuration.numThreads - 1,
-                          m_configuration.numReservedTasks);
+    // Huffman decoders are cached across frames, unless disabled
+    if (m_configuration.huffmanCacheSize > 0) {
+        ldeHuffmanCacheInitialize(allocator(LdpMemoryCategoryCmdBuffers), &m_huffmanCache,
+                                  m_configuration.huffmanCacheSize);
+    }
+
+    // Use the builder's task pool if it has one, otherwise start a private pool - pool threads is
+    // 1 less than configured threads
+    LdcMemoryAllocator* const taskAllocator{allocator(LdpMemoryCategoryTasks)};
+    m_taskPool = builder.taskPool();
+    if (!m_taskPool) {
+        VNCheck(m_configuration.numThreads >= 1);
+        ldcTaskPoolInitialize(&m_privateTaskPool, taskAllocator,
+                              frameAllocator(LdpMemoryCategoryTasks),
+                              m_configuration.numThreads - 1, m_configuration.numReservedTasks);
+        m_taskPool = &m_privateTaskPool;
+    }
+
+    for (TaskGraphTemplate& tgt : m_taskGraphTemplates) {
+        ldcTaskGraphTemplateInitialize(&tgt.graph, taskAllocator);
+    }
 
     // Fill in empty temporal buffer anchors
     TemporalBuffer buf{};
     buf.desc.timestamp = kInvalidTimestamp;
     buf.timestampLimit = kInvalidTimestamp;
     for (uint32_t i = 0; i < m_configuration.numTemporalBuffers * RCMaxPlanes; ++i) {
-        buf.desc.plane = i;
+        buf.desc.plane = i % RCMaxPlanes;
         m_temporalBuffers.append(buf);
     }
 
@@ -147,7 +222,14 @@ PipelineCPU::~PipelineCPU()
         PictureCPU* picture{VNAllocationPtr(m_pictures[i], PictureCPU)};
         // Call destructor directly, as we are doing in-place construct/destruct
         picture->~PictureCPU();
-        VNFree(m_allocator, &m_pictures[i]);
+        VNFree(allocator(LdpMemoryCategoryFrames), &m_pictures[i]);
+    }
+
+    // Release buffers still bound to pictures that were not freed
+    for (uint32_t i = 0; i < m_buffers.size(); ++i) {
+        BufferCPU* buffer{VNAllocationPtr(m_buffers[i], BufferCPU)};
+        buffer->~BufferCPU();
+        VNFree(allocator(LdpMemoryCategoryFrames), &m_buffers[i]);
     }
 
     // Release frames
@@ -156,25 +238,38 @@ PipelineCPU::~PipelineCPU()
         frame->release(false);
         // Call destructor directly, as we are doing in-place construct/destruct
         frame->~FrameCPU();
-        VNFree(m_allocator, &m_frames[i]);
+        VNFree(allocator(LdpMemoryCategoryFrames), &m_frames[i]);
     }
 
     // Release any temporal buffers
     for (uint32_t i = 0; i < m_temporalBuffers.size(); ++i) {
         TemporalBuffer* tb = m_temporalBuffers.at(i);
         if (VNIsAllocated(tb->allocation)) {
-            VNFree(m_allocator, &tb->allocation);
+            VNFree(allocator(LdpMemoryCategoryTemporal), &tb->allocation);
+        }
+        if (VNIsAllocated(tb->blockMapAllocation)) {
+            VNFree(allocator(LdpMemoryCategoryTemporal), &tb->blockMapAllocation);
         }
     }
-    // Release dither
-    ldppDitherGlobalRelease(&m_dither);
 
     ldeConfigPoolRelease(&m_configPool);
+    ldeHuffmanCacheRelease(&m_huffmanCache);
+
+    for (TaskGraphTemplate& tgt : m_taskGraphTemplates) {
+        ldcTaskGraphTemplateDestroy(&tgt.graph);
+    }
 
-    ldcRollingArenaDestroy(&m_rollingArena);
+    // Close down task pool, unless it is external
+    if (m_taskPool == &m_privateTaskPool) {
+        ldcTaskPoolDestroy(&m_privateTaskPool);
+    }
+
+    // Everything allocated from the arenas has now been released
+    for (const LdpMemoryCategory category : kFrameArenaCategories) {
+        ldcRollingArenaDestroy(&m_rollingArenas[category]);
+    }
 
-    // Close down task pool
-    ldcTaskPoolDestroy(&m_taskPool);
+    ldcMemoryTrackerDestroy(&m_memoryTracker);
 
     m_eventSink->generate(pipeline::EventExit);
 }
@@ -193,7 +288,9 @@ LdcReturnCode PipelineCPU::sendEnhancementData(uint64_t timestamp, const uint8_t
         return LdcReturnCodeInvalidParam;
     }
 
-    if (frameLatency() >= m_configuration.maxLatency) {
+    updateMemoryBudget();
+
+    if (frameLatency() >= m_latencyLimit) {
         VNLogDebug("sendEnhancementData: %" PRIx64 " AGAIN", timestamp);
         return LdcReturnCodeAgain;
     }
@@ -204,8 +301,13 @@ LdcReturnCode PipelineCPU::sendEnhancementData(uint64_t timestamp, const uint8_t
         return LdcReturnCodeError;
     }
 
+    if (!m_overBudget && m_latencyLimit < m_configuration.maxLatency) {
+        m_latencyLimit++;
+    }
+
     LdcMemoryAllocation enhancementDataAllocation{};
-    uint8_t* const enhancement{VNAllocateArray(m_allocator, &enhancementDataAllocation, uint8_t, byteSize)};
+    uint8_t* const enhancement{VNAllocateArray(frameAllocator(LdpMemoryCategoryFrames),
+                                               &enhancementDataAllocation, uint8_t, byteSize)};
     memcpy(enhancement, data, byteSize);
     frame->m_enhancementData = enhancementDataAllocation;
     frame->m_state = FrameStateReorder;
@@ -309,6 +411,12 @@ LdcReturnCode PipelineCPU::sendOutputPicture(LdpPicture* outputPicture)
 
 LdpPicture* PipelineCPU::receiveOutputPicture(LdpDecodeInformation& decodeInfoOut)
 {
+    // Pictures go straight to the completion callback instead
+    if (m_eventSink->isCompletionEnabled()) {
+        releaseCompletedFrames();
+        return nullptr;
+    }
+
     FrameCPU* frame{};
 
     // Pull any done frame from start (lowest timestamp) of 'processing' frame index.
@@ -336,7 +444,7 @@ LdpPicture* PipelineCPU::receiveOutputPicture(LdpDecodeInformation& decodeInfoOu
             }
             VNLogWarning("receiveOutputPicture wait timed out");
 #ifdef VN_SDK_LOG_ENABLE_DEBUG
-            ldcTaskPoolDump(&m_taskPool, nullptr);
+            ldcTaskPoolDump(m_taskPool, nullptr);
 #endif
         } else {
             break;
@@ -476,6 +584,7 @@ LdcReturnCode PipelineCPU::synchronize(bool dropPending)
         ldcTaskGroupWait(&frame->m_taskGroup);
     }
 
+    releaseCompletedFrames();
     return LdcReturnCodeSuccess;
 }
 
@@ -485,7 +594,8 @@ BufferCPU* PipelineCPU::allocateBuffer(uint32_t requiredSize)
 {
     // Allocate buffer structure
     LdcMemoryAllocation allocation;
-    BufferCPU* const buffer{VNAllocateZero(m_allocator, &allocation, BufferCPU)};
+    BufferCPU* const buffer{
+        VNAllocateZero(allocator(LdpMemoryCategoryFrames), &allocation, BufferCPU)};
     if (!buffer) {
         return nullptr;
     }
@@ -513,7 +623,7 @@ void PipelineCPU::releaseBuffer(BufferCPU* buffer)
     buffer->~BufferCPU();
 
     // Release memory
-    VNFree(m_allocator, pAlloc);
+    VNFree(allocator(LdpMemoryCategoryFrames), pAlloc);
 
     m_buffers.removeReorder(pAlloc);
 }
@@ -526,7 +636,8 @@ PictureCPU* PipelineCPU::allocatePicture()
 {
     // Allocate picture
     LdcMemoryAllocation pictureAllocation;
-    PictureCPU* picture{VNAllocateZero(m_allocator, &pictureAllocation, PictureCPU)};
+    PictureCPU* picture{
+        VNAllocateZero(allocator(LdpMemoryCategoryFrames), &pictureAllocation, PictureCPU)};
     if (!picture) {
         return nullptr;
     }
@@ -554,7 +665,7 @@ void PipelineCPU::releasePicture(PictureCPU* picture)
     picture->~PictureCPU();
 
     // Release memory
-    VNFree(m_allocator, pAlloc);
+    VNFree(allocator(LdpMemoryCategoryFrames), pAlloc);
 
     m_pictures.removeReorder(pAlloc);
 }
@@ -602,7 +713,8 @@ FrameCPU* PipelineCPU::allocateFrame(uint64_t timestamp)
 
     // Allocate frame with in place construction
     LdcMemoryAllocation frameAllocation = {};
-    FrameCPU* const frame{VNAllocateZero(m_allocator, &frameAllocation, FrameCPU)};
+    FrameCPU* const frame{
+        VNAllocateZero(allocator(LdpMemoryCategoryFrames), &frameAllocation, FrameCPU)};
     if (!frame) {
         return nullptr;
     }
@@ -646,17 +758,264 @@ void PipelineCPU::freeFrame(FrameCPU* frame)
     frame->~FrameCPU();
 
     // Release memory
-    VNFree(m_allocator, frameAlloc);
+    VNFree(allocator(LdpMemoryCategoryFrames), frameAlloc);
 
     m_frames.removeReorder(frameAlloc);
 }
 
+// Completion callback
+//
+// Frames can finish out of order, so a frame's picture is only completed once all earlier frames
+// have been. The next frame to complete is picked under m_interTaskMutex, but the callback is made
+// without it, so worker threads never wait on client code. Only one thread delivers at a time: it
+// keeps going until no frame is ready, picking up frames that finished whilst it was in the
+// callback, and any other thread that finds m_completionDelivering set returns straight away. The
+// frames stay in the processing index until an API call frees them, as a frame cannot be freed
+// from within its own task group.
+//
+FrameCPU* PipelineCPU::nextFrameToComplete()
+{
+    for (uint32_t idx = 0; idx < m_processingIndex.size(); ++idx) {
+        FrameCPU* const candidate{m_processingIndex[idx]};
+        if (candidate->m_state != FrameStateDone) {
+            break;
+        }
+        if (!candidate->m_completed) {
+            return candidate;
+        }
+    }
+    return nullptr;
+}
+
+void PipelineCPU::completeDoneFrames()
+{
+    FrameCPU* frame{};
+    {
+        common::ScopedLock lock(m_interTaskMutex);
+        if (m_completionDelivering) {
+            // The delivering thread will find any frame this thread finished
+            return;
+        }
+        frame = nextFrameToComplete();
+        if (!frame) {
+            return;
+        }
+        m_completionDelivering = true;
+    }
+
+    while (frame) {
+        VNLogDebug("completePicture: %" PRIx64 " %p", frame->timestamp,
+                   (void*)frame->outputPicture);
+        VNTraceInstant("completePicture", frame->timestamp, (void*)frame->outputPicture);
+
+        // The frame cannot be released until it is marked completed
+        m_eventSink->completePicture(frame->outputPicture, &frame->m_decodeInfo);
+
+        common::ScopedLock lock(m_interTaskMutex);
+        frame->m_completed = true;
+        frame = nextFrameToComplete();
+        if (!frame) {
+            m_completionDelivering = false;
+        }
+    }
+}
+
+void PipelineCPU::releaseCompletedFrames()
+{
+    while (true) {
+        FrameCPU* frame{};
+        {
+            common::ScopedLock lock(m_interTaskMutex);
+            if (m_processingIndex.isEmpty() || !m_processingIndex[0]->m_completed) {
+                break;
+            }
+            frame = m_processingIndex[0];
+            m_processingIndex.removeIndex(0);
+        }
+
+        freeFrame(frame);
+    }
+}
+
 // Number of outstanding frames
 uint32_t PipelineCPU::frameLatency() const
 {
     return m_reorderIndex.size() + m_processingIndex.size();
 }
 
+//// Memory budget
+//
+// The tracker never fails an allocation for going over budget. Instead, on going over, the limit
+// on frames in flight is halved, and new frames are passed through without enhancement until usage
+// is back under budget. The limit then grows back by one for each accepted frame.
+//
+// Without a budget, allocations only go through the tracker if usage accounting was asked for.
+//
+LdcMemoryAllocator* PipelineCPU::initializeMemoryTracker(LdcMemoryAllocator* parentAllocator)
+{
+    ldcMemoryTrackerInitialize(&m_memoryTracker, parentAllocator, LdpMemoryCategoryCount,
+                               static_cast<size_t>(m_configuration.memoryBudgetMB) << 20);
+    if (!memoryTracked()) {
+        return parentAllocator;
+    }
+    return ldcMemoryTrackerAllocator(&m_memoryTracker, LdpMemoryCategoryOther);
+}
+
+void PipelineCPU::updateMemoryBudget()
+{
+    if (ldcMemoryTrackerBudget(&m_memoryTracker) == 0) {
+        return;
+    }
+
+    const bool overBudget{ldcMemoryTrackerOverBudget(&m_memoryTracker)};
+
+    if (overBudget != m_overBudget) {
+        if (overBudget) {
+            m_latencyLimit = std::max(std::min(m_latencyLimit, frameLatency()) / 2, 1U);
+            VNLogWarning("Memory budget exceeded: %" PRIu64 " of %" PRIu64
+                         " bytes - limiting latency to %u frames",
+                         static_cast<uint64_t>(ldcMemoryTrackerTotal(&m_memoryTracker)),
+                         static_cast<uint64_t>(ldcMemoryTrackerBudget(&m_memoryTracker)),
+                         m_latencyLimit);
+        } else {
+            VNLogInfo("Memory back under budget: %" PRIu64 " bytes",
+                      static_cast<uint64_t>(ldcMemoryTrackerTotal(&m_memoryTracker)));
+        }
+        m_overBudget = overBudget;
+    }
+}
+
+//// Degradation
+//
+// A frame can go without some of its enhancement:
+//
+// - Skip LOQ0 residuals - and the temporal buffer, which cannot be updated without them
+// - Scaled passthrough - the base is only upscaled
+//
+// Frames started while memory is over budget skip all enhancement work, so they take on no
+// residual or temporal buffers. Their configuration is still parsed, so that global configuration
+// changes and temporal signalling are not lost.
+//
+// With the deadline policy, the CPU time of each decode stage is measured per frame, along with
+// the ratio of each frame's elapsed decode time to that CPU time, which accounts for threading and
+// load. When a frame starts, its decode time is predicted for each level of degradation, and the
+// least degraded level that would meet the frame's deadline is chosen.
+//
+// Once a frame goes without the temporal buffer, the buffer no longer matches the stream, so the
+// following frames also skip LOQ0 until the next temporal refresh or IDR clears the buffer.
+//
+uint8_t PipelineCPU::deadlineDegradation(const FrameCPU* frame)
+{
+    float stageCost[DecodeStageCount] = {};
+    float latencyRatio{0.0f};
+    {
+        common::ScopedLock lock(m_interTaskMutex);
+        std::copy_n(m_stageCost, DecodeStageCount, stageCost);
+        latencyRatio = m_latencyRatio;
+    }
+
+    if (frame->m_deadline == UINT64_MAX || latencyRatio <= 0.0f) {
+        return LdpDegradationNone;
+    }
+
+    const uint64_t now{threadTimeMicroseconds(0)};
+    const float remaining{frame->m_deadline > now ? static_cast<float>(frame->m_deadline - now)
+                                                  : 0.0f};
+    const float scaled{latencyRatio * stageCost[DecodeStageBase]};
+    const float withoutLOQ0{scaled + latencyRatio * stageCost[DecodeStageLOQ1]};
+    const float full{withoutLOQ0 + latencyRatio * stageCost[DecodeStageLOQ0]};
+
+    if (full <= remaining) {
+        return LdpDegradationNone;
+    }
+    if (withoutLOQ0 > remaining && m_configuration.passthroughMode != PassthroughMode::Disable) {
+        return LdpDegradationSkipLOQ0 | LdpDegradationScaledPassthrough;
+    }
+    return LdpDegradationSkipLOQ0;
+}
+
+void PipelineCPU::applyDegradation(FrameCPU* frame)
+{
+    if (frame->config.nalType == NTIDR || frame->config.temporalRefresh) {
+        m_temporalDegraded = false;
+    }
+
+    uint8_t degradation{LdpDegradationNone};
+
+    if (m_overBudget && m_configuration.passthroughMode != PassthroughMode::Disable) {
+        // Over memory budget - do not take on buffers for enhancement
+        degradation = LdpDegradationSkipLOQ0 | LdpDegradationScaledPassthrough;
+    } else if (m_configuration.deadlinePolicy) {
+        degradation = deadlineDegradation(frame);
+    }
+
+    if (frame->globalConfig->temporalEnabled) {
+        if (m_temporalDegraded) {
+            degradation |= LdpDegradationSkipLOQ0;
+        }
+        if (degradation & LdpDegradationSkipLOQ0) {
+            degradation |= LdpDegradationSkipTemporal;
+            m_temporalDegraded = true;
+        }
+    }
+
+    if (degradation != LdpDegradationNone) {
+        VNLogDebug("applyDegradation: %" PRIx64 " degradation:%x", frame->timestamp, degradation);
+    }
+
+    if (degradation & LdpDegradationSkipLOQ0) {
+        frame->config.loqEnabled[LOQ0] = false;
+    }
+    if (degradation & LdpDegradationScaledPassthrough) {
+        frame->config.loqEnabled[LOQ1] = false;
+    }
+    frame->m_degradation = degradation;
+}
+
+void PipelineCPU::updateDecodeCosts(const FrameCPU* frame)
+{
+    if (frame->m_skip || frame->m_startTime == 0) {
+        return;
+    }
+
+    float total{0.0f};
+    for (uint32_t stage = 0; stage < DecodeStageCount; ++stage) {
+        const auto stageTime{static_cast<float>(frame->m_stageTime[stage].load())};
+        // Stages that did not run keep their previous cost
+        if (stageTime > 0.0f) {
+            m_stageCost[stage] = averageDecodeCost(m_stageCost[stage], stageTime);
+            total += stageTime;
+        }
+    }
+    if (total == 0.0f) {
+        // Unscaled passthrough - nothing measured
+        return;
+    }
+
+    const uint64_t start{std::max(frame->m_startTime, frame->m_baseTime)};
+    const uint64_t now{threadTimeMicroseconds(0)};
+    const float latency{now > start ? static_cast<float>(now - start) : 0.0f};
+    m_latencyRatio = averageDecodeCost(m_latencyRatio, latency / total);
+}
+
+LdcReturnCode PipelineCPU::getMemoryUsage(LdpMemoryUsage& usageOut)
+{
+    if (!memoryTracked()) {
+        return LdcReturnCodeNotSupported;
+    }
+
+    for (uint32_t category = 0; category < LdpMemoryCategoryCount; ++category) {
+        usageOut.current[category] = ldcMemoryTrackerCurrent(&m_memoryTracker, category);
+        usageOut.peak[category] = ldcMemoryTrackerPeak(&m_memoryTracker, category);
+    }
+    usageOut.total = ldcMemoryTrackerTotal(&m_memoryTracker);
+    usageOut.totalPeak = ldcMemoryTrackerTotalPeak(&m_memoryTracker);
+    usageOut.budget = ldcMemoryTrackerBudget(&m_memoryTracker);
+    usageOut.degraded = m_overBudget || m_latencyLimit < m_configuration.maxLatency;
+
+    return LdcReturnCodeSuccess;
+}
+
 //// Frame start
 //
 // Get the next frame, if any, in timestamp order - taking into account reorder and flushing.
@@ -686,6 +1045,8 @@ FrameCPU* PipelineCPU::getNextReordered()
 //
 void PipelineCPU::startReadyFrames()
 {
+    releaseCompletedFrames();
+
     // Pull ready frames from reorder table
     while (FrameCPU* frame = getNextReordered()) {
         const uint64_t timestamp{frame->timestamp};
@@ -699,18 +1060,23 @@ void PipelineCPU::startReadyFrames()
         }
 
         if (!frame->m_passthrough) {
-            // Parse the LCEVC configuration into distinct per-frame data
+            // Parse the LCEVC configuration into distinct per-frame data. The frame owns its copy
+            // of the enhancement data until release, so it is unescaped and parsed in place.
             // Switch to pass-through if configuration parse failed.
-            goodConfig = ldeConfigPoolFrameInsert(&m_configPool, timestamp,
-                                                  VNAllocationPtr(frame->m_enhancementData, uint8_t),
-                                                  VNAllocationSize(frame->m_enhancementData, uint8_t),
-                                                  &frame->globalConfig, &frame->config);
+            goodConfig = ldeConfigPoolFrameInsertInPlace(
+                &m_configPool, timestamp, VNAllocationPtr(frame->m_enhancementData, uint8_t),
+                VNAllocationSize(frame->m_enhancementData, uint8_t),
+                m_configuration.enhancementUnescaped, &frame->globalConfig, &frame->config);
 
             if (!goodConfig) {
                 frame->m_passthrough = true;
             }
         }
 
+        if (!frame->m_passthrough) {
+            applyDegradation(frame);
+        }
+
         if (frame->m_passthrough) {
             // Set up enough frame configuration to support pass-through
             ldeConfigPoolFramePassthrough(&m_configPool, &frame->globalConfig, &frame->config);
@@ -738,11 +1104,16 @@ void PipelineCPU::startReadyFrames()
             m_processingIndex.append(frame);
         }
 
+        if (m_configuration.deadlinePolicy) {
+            frame->m_startTime = threadTimeMicroseconds(0);
+        }
+
         frame->generateTasks(m_lastGoodTimestamp);
 
-        // Remember timestamps for next time
+        // Remember timestamps for next time - a frame without the temporal buffer does not
+        // pass one on
         m_previousTimestamp = timestamp;
-        if (goodConfig) {
+        if (goodConfig && !(frame->m_degradation & LdpDegradationSkipTemporal)) {
             m_lastGoodTimestamp = timestamp;
         }
     }
@@ -822,15 +1193,28 @@ LdcTaskDependency PipelineCPU::requireTemporalBuffer(FrameCPU* frame, uint64_t t
 {
     LdcTaskDependency dep{ldcTaskDependencyAdd(&frame->m_taskGroup)};
 
+    requestTemporalBuffer(frame, timestamp, plane, dep);
+
+    return dep;
+}
+
+// As requireTemporalBuffer(), but using an existing dependency in the frame's task group
+//
+void PipelineCPU::requestTemporalBuffer(FrameCPU* frame, uint64_t timestamp, uint32_t plane,
+                                        LdcTaskDependency dep)
+{
     uint32_t width = frame->globalConfig->width;
     uint32_t height = frame->globalConfig->height;
     width >>= ldpColorFormatPlaneWidthShift(frame->baseFormat, plane);
     height >>= ldpColorFormatPlaneHeightShift(frame->baseFormat, plane);
 
     // Fill in requirements
-    frame->m_temporalBufferDesc[plane].timestamp = timestamp;
     frame->m_temporalBufferDesc[plane].clear =
         frame->config.nalType == NTIDR || frame->config.temporalRefresh;
+    frame->m_temporalBufferDesc[plane].timestamp =
+        (m_configuration.gopParallelDecode && frame->m_temporalBufferDesc[plane].clear)
+            ? kInvalidTimestamp
+            : timestamp;
     frame->m_temporalBufferDesc[plane].width = width;
     frame->m_temporalBufferDesc[plane].height = height;
     frame->m_temporalBufferDesc[plane].plane = plane;
@@ -844,8 +1228,6 @@ LdcTaskDependency PipelineCPU::requireTemporalBuffer(FrameCPU* frame, uint64_t t
     if (TemporalBuffer* temporalBuffer = matchTemporalBuffer(frame, plane)) {
         ldcTaskDependencyMet(&frame->m_taskGroup, dep, temporalBuffer);
     }
-
-    return dep;
 }
 
 TemporalBuffer* PipelineCPU::matchTemporalBuffer(FrameCPU* frame, uint32_t plane)
@@ -853,6 +1235,10 @@ TemporalBuffer* PipelineCPU::matchTemporalBuffer(FrameCPU* frame, uint32_t plane
     TemporalBuffer* foundTemporalBuffer{};
     const uint64_t timestamp = frame->m_temporalBufferDesc[plane].timestamp;
 
+    // With GOP parallel decode, a refresh does not wait for the prior frame's buffer
+    const bool newChain{m_configuration.gopParallelDecode &&
+                        frame->m_temporalBufferDesc[plane].clear};
+
     {
         common::ScopedLock lock(m_interTaskMutex);
 
@@ -876,6 +1262,13 @@ TemporalBuffer* PipelineCPU::matchTemporalBuffer(FrameCPU* frame, uint32_t plane
                 foundTemporalBuffer = tb;
                 break;
             }
+
+            if (newChain && tb->desc.plane == plane) {
+                // Every frame before this one has been started, so nothing else can want the
+                // state left in this buffer
+                foundTemporalBuffer = tb;
+                break;
+            }
         }
 
         // Got one - mark it as in use
@@ -892,6 +1285,9 @@ TemporalBuffer* PipelineCPU::matchTemporalBuffer(FrameCPU* frame, uint32_t plane
                     }
                 }
             }
+        } else if (newChain) {
+            // Wait for the next buffer that is returned, or left at the end of a chain
+            frame->m_temporalNewChain[plane] = true;
         }
     }
 
@@ -931,22 +1327,12 @@ void PipelineCPU::releaseTemporalBuffer(FrameCPU* frame, uint32_t plane)
         frame->m_temporalBuffer[plane] = nullptr;
         tb->frame = nullptr;
 
-        tb->desc.timestamp = frame->timestamp;
-
-        // Do any of the pending frames want this buffer?
-        for (uint32_t idx = 0; idx < m_processingIndex.size(); ++idx) {
-            FrameCPU* nextFrame{m_processingIndex[idx]};
-            if (tb->desc.timestamp == nextFrame->m_temporalBufferDesc[plane].timestamp &&
-                tb->desc.plane == nextFrame->m_temporalBufferDesc[plane].plane) {
-                // Matches this frame
-                foundNextFrame = nextFrame;
-                break;
-            }
-        }
-
-        if (foundNextFrame) {
-            foundNextFrame->m_temporalBuffer[plane] = tb;
-            tb->frame = foundNextFrame;
+        if (frame->m_temporalForwarded[plane]) {
+            // Next frame already has a copy - return this buffer to the pool
+            tb->desc.timestamp = kInvalidTimestamp;
+            foundNextFrame = startTemporalChain(tb, plane);
+        } else {
+            foundNextFrame = passOnTemporalBuffer(tb, frame->timestamp, plane);
         }
     }
 
@@ -959,12 +1345,112 @@ void PipelineCPU::releaseTemporalBuffer(FrameCPU* frame, uint32_t plane)
     }
 }
 
+// Find an unused temporal buffer for a plane, and mark it as in use by the given frame
+//
+TemporalBuffer* PipelineCPU::reserveSpareTemporalBuffer(FrameCPU* frame, uint32_t plane)
+{
+    common::ScopedLock lock(m_interTaskMutex);
+
+    for (uint32_t i = 0; i < m_temporalBuffers.size(); ++i) {
+        TemporalBuffer* tb{m_temporalBuffers.at(i)};
+        if (!tb->frame && tb->desc.plane == plane && tb->desc.timestamp == kInvalidTimestamp) {
+            tb->frame = frame;
+            return tb;
+        }
+    }
+
+    return nullptr;
+}
+
+// A frame has copied its temporal state into a spare buffer before it has finished with its own -
+// hand the copy on now, rather than when the frame releases its buffer
+//
+void PipelineCPU::forwardTemporalBuffer(FrameCPU* frame, TemporalBuffer* copy, uint32_t plane)
+{
+    VNLogDebug("forwardTemporalBuffer: %" PRIx64 " plane: %" PRIu32, frame->timestamp, plane);
+
+    FrameCPU* foundNextFrame{nullptr};
+
+    {
+        common::ScopedLock lock(m_interTaskMutex);
+
+        copy->frame = nullptr;
+        frame->m_temporalForwarded[plane] = true;
+
+        foundNextFrame = passOnTemporalBuffer(copy, frame->timestamp, plane);
+    }
+
+    if (foundNextFrame) {
+        VNLogDebug("  CPU::forwardTemporalBuffer found: plane=%" PRIu32 " frame=%" PRIx64
+                   " prev=%" PRIx64,
+                   plane, foundNextFrame->timestamp, frame->timestamp);
+        updateTemporalBufferDesc(copy, foundNextFrame->m_temporalBufferDesc[plane]);
+        ldcTaskDependencyMet(&foundNextFrame->m_taskGroup,
+                             foundNextFrame->m_depTemporalBuffer[plane], copy);
+    }
+}
+
+// Mark a temporal buffer as holding the state up to `timestamp`, and attach it to any pending
+// frame that is waiting for that state.
+//
+FrameCPU* PipelineCPU::passOnTemporalBuffer(TemporalBuffer* tb, uint64_t timestamp, uint32_t plane)
+{
+    tb->desc.timestamp = timestamp;
+
+    // Do any of the pending frames want this buffer?
+    for (uint32_t idx = 0; idx < m_processingIndex.size(); ++idx) {
+        FrameCPU* nextFrame{m_processingIndex[idx]};
+        if (tb->desc.timestamp == nextFrame->m_temporalBufferDesc[plane].timestamp &&
+            tb->desc.plane == nextFrame->m_temporalBufferDesc[plane].plane) {
+            // Matches this frame
+            nextFrame->m_temporalBuffer[plane] = tb;
+            tb->frame = nextFrame;
+            return nextFrame;
+        }
+    }
+
+    return startTemporalChain(tb, plane);
+}
+
+// Hand an unwanted temporal buffer to the earliest frame that is waiting to start a new chain.
+//
+// A buffer holding the state of a frame before the waiting frame is at the end of its chain - all
+// the frames that could continue from it have been started. A later frame's state may still be
+// wanted by a frame that has not been started yet.
+//
+FrameCPU* PipelineCPU::startTemporalChain(TemporalBuffer* tb, uint32_t plane)
+{
+    if (!m_configuration.gopParallelDecode) {
+        return nullptr;
+    }
+
+    for (uint32_t idx = 0; idx < m_processingIndex.size(); ++idx) {
+        FrameCPU* nextFrame{m_processingIndex[idx]};
+        if (!nextFrame->m_temporalNewChain[plane] ||
+            tb->desc.plane != nextFrame->m_temporalBufferDesc[plane].plane) {
+            continue;
+        }
+        if (tb->desc.timestamp != kInvalidTimestamp &&
+            compareTimestamps(tb->desc.timestamp, nextFrame->timestamp) >= 0) {
+            continue;
+        }
+
+        nextFrame->m_temporalNewChain[plane] = false;
+        nextFrame->m_temporalBuffer[plane] = tb;
+        tb->frame = nextFrame;
+        return nextFrame;
+    }
+
+    return nullptr;
+}
+
 // Make a temporal buffer match the given description
 void PipelineCPU::updateTemporalBufferDesc(TemporalBuffer* buffer, const TemporalBufferDesc& desc) const
 {
     const size_t paddedWidth = alignU32(desc.width, kBufferRowAlignment);
     const size_t byteStride{paddedWidth * sizeof(uint16_t)};
     const size_t bufferSize{byteStride * static_cast<size_t>(desc.height)};
+    const size_t blockMapSize{temporalBlockMapSize(desc)};
 
     if (!VNIsAllocated(buffer->allocation) || buffer->desc.width != desc.width ||
         buffer->desc.height != desc.height) {
@@ -974,12 +1460,24 @@ void PipelineCPU::updateTemporalBufferDesc(TemporalBuffer* buffer, const Tempora
             VNLogWarning("Temporal buffer does not match: %08d Got %dx%d, Wanted %dx%d", desc.timestamp,
                          buffer->desc.width, buffer->desc.height, desc.width, desc.height);
         }
-        buffer->planeDesc.firstSample = VNAllocateAlignedZeroArray(
-            allocator(), &buffer->allocation, uint8_t, kBufferRowAlignment, bufferSize);
+        if (VNIsAllocated(buffer->allocation)) {
+            VNFree(allocator(LdpMemoryCategoryTemporal), &buffer->allocation);
+        }
+        buffer->planeDesc.firstSample =
+            VNAllocateAlignedZeroArray(allocator(LdpMemoryCategoryTemporal), &buffer->allocation,
+                                       uint8_t, kBufferRowAlignment, bufferSize);
         buffer->planeDesc.rowByteStride = static_cast<uint32_t>(byteStride);
         memset(buffer->planeDesc.firstSample, 0, bufferSize);
+
+        if (VNIsAllocated(buffer->blockMapAllocation)) {
+            VNFree(allocator(LdpMemoryCategoryTemporal), &buffer->blockMapAllocation);
+        }
+        buffer->blockMap = VNAllocateZeroArray(allocator(LdpMemoryCategoryTemporal),
+                                               &buffer->blockMapAllocation, uint8_t, blockMapSize);
+        buffer->blocksAcross = (desc.width + BSTemporal - 1) >> BSTemporalShift;
     } else if (desc.clear) {
         memset(buffer->planeDesc.firstSample, 0, bufferSize);
+        memset(buffer->blockMap, 0, blockMapSize);
     }
 
     // Update description
@@ -987,6 +1485,17 @@ void PipelineCPU::updateTemporalBufferDesc(TemporalBuffer* buffer, const Tempora
     buffer->desc.clear = false;
 }
 
+//// Task data
+//
+// Every task's data starts with the pipeline and frame that it works on. This header is replaced
+// when a recorded task graph is reused for another frame.
+//
+struct TaskDataHeader
+{
+    PipelineCPU* pipeline;
+    FrameCPU* frame;
+};
+
 //// ConvertToInternal
 //
 // Copy incoming picture plane to internal fixed point surface format
@@ -1011,13 +1520,15 @@ void* PipelineCPU::taskConvertToInternal(LdcTask* task, const LdcTaskPart* /*par
     const TaskConvertToInternalData& data{VNTaskData(task, TaskConvertToInternalData)};
     PipelineCPU* const pipeline{data.pipeline};
     FrameCPU* const frame{data.frame};
+    const StageTimer stageTimer{pipeline, frame, DecodeStageBase};
 
     if (frame->m_skip) {
         return nullptr;
     }
 
-    bool isNV12 = frame->basePicture->layout.layoutInfo->format == LdpColorFormatNV12_8;
-    uint32_t srcPlaneIndex = (isNV12 && data.planeIndex == 2) ? 1 : data.planeIndex;
+    // Both chroma planes are read from the interleaved plane of a semi-planar base
+    const bool isSemiPlanar = ldpPictureLayoutIsSemiPlanar(&frame->basePicture->layout);
+    const uint32_t srcPlaneIndex = (isSemiPlanar && data.planeIndex == 2) ? 1 : data.planeIndex;
     LdpPicturePlaneDesc srcPlane;
     frame->getBasePlaneDesc(srcPlaneIndex, srcPlane);
 
@@ -1029,7 +1540,7 @@ void* PipelineCPU::taskConvertToInternal(LdcTask* task, const LdcTaskPart* /*par
     VNLogDebug("taskConvertToInternal timestamp:%" PRIx64 " plane:%d enhanced:%d",
                data.frame->timestamp, data.planeIndex);
 
-    if (!ldppPlaneBlit(&pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+    if (!ldppPlaneBlit(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
                        data.planeIndex, &frame->basePicture->layout,
                        &frame->m_intermediateLayout[LOQ2], &srcPlane, &dstPlane, BMCopy)) {
         VNLogError("ldppPlaneBlit In failed");
@@ -1072,23 +1583,48 @@ void* PipelineCPU::taskConvertFromInternal(LdcTask* task, const LdcTaskPart* /*p
     const TaskConvertFromInternalData& data{VNTaskData(task, TaskConvertFromInternalData)};
     PipelineCPU* const pipeline{data.pipeline};
     FrameCPU* const frame{data.frame};
+    const StageTimer stageTimer{pipeline, frame, DecodeStageBase};
 
     if (frame->m_skip) {
         return nullptr;
     }
 
+    // Both chroma planes are written to the interleaved plane of a semi-planar output at once, by
+    // the task for plane 1
+    if (ldpPictureLayoutIsSemiPlanar(&frame->outputPicture->layout) && data.planeIndex > 0) {
+        if (data.planeIndex == 2) {
+            return nullptr;
+        }
+
+        LdpPicturePlaneDesc srcPlanes[2];
+        frame->getIntermediatePlaneDesc(1, LOQ0, srcPlanes[0]);
+        frame->getIntermediatePlaneDesc(2, LOQ0, srcPlanes[1]);
+
+        LdpPicturePlaneDesc dstPlane;
+        frame->getOutputPlaneDesc(1, dstPlane);
+
+        VNLogDebug("taskConvertFromInternal timestamp:%" PRIx64 " planes:1,2",
+                   data.frame->timestamp);
+
+        if (!ldppPlaneBlitInterleave(pipeline->m_taskPool, task,
+                                     pipeline->m_configuration.forceScalar,
+                                     &frame->m_intermediateLayout[LOQ0],
+                                     &frame->outputPicture->layout, srcPlanes, &dstPlane)) {
+            VNLogError("ldppPlaneBlitInterleave out failed");
+        }
+        return nullptr;
+    }
+
     LdpPicturePlaneDesc srcPlane;
     frame->getIntermediatePlaneDesc(data.planeIndex, LOQ0, srcPlane);
 
-    bool isNV12 = frame->outputPicture->layout.layoutInfo->format == LdpColorFormatNV12_8;
-    uint32_t dstPlaneIndex = (isNV12 && data.planeIndex == 2) ? 1 : data.planeIndex;
     LdpPicturePlaneDesc dstPlane;
-    frame->getOutputPlaneDesc(dstPlaneIndex, dstPlane);
+    frame->getOutputPlaneDesc(data.planeIndex, dstPlane);
 
     VNLogDebug("taskConvertFromInternal timestamp:%" PRIx64 " plane:%d", data.frame->timestamp,
                data.planeIndex);
 
-    if (!ldppPlaneBlit(&pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+    if (!ldppPlaneBlit(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
                        data.planeIndex, &frame->m_intermediateLayout[LOQ0],
                        &frame->outputPicture->layout, &srcPlane, &dstPlane, BMCopy)) {
         VNLogError("ldppPlaneBlit out failed");
@@ -1097,15 +1633,22 @@ void* PipelineCPU::taskConvertFromInternal(LdcTask* task, const LdcTaskPart* /*p
     return nullptr;
 }
 
+// 'otherChroma' is the other chroma plane for chroma planes, or kTaskDependencyInvalid. The output
+// picture format may not be known yet, so both chroma conversions wait for both chroma planes in
+// case the output turns out to be semi-planar.
+//
 LdcTaskDependency PipelineCPU::addTaskConvertFromInternal(FrameCPU* frame, uint32_t planeIndex,
                                                           uint32_t baseDepth, uint32_t enhancementDepth,
-                                                          LdcTaskDependency dst, LdcTaskDependency src)
+                                                          LdcTaskDependency dst,
+                                                          LdcTaskDependency src,
+                                                          LdcTaskDependency otherChroma)
 {
     const TaskConvertFromInternalData data{this, frame, planeIndex, baseDepth, enhancementDepth};
-    const LdcTaskDependency inputs[] = {dst, src};
+    const LdcTaskDependency inputs[] = {dst, src, otherChroma};
+    const uint32_t numInputs = (otherChroma != kTaskDependencyInvalid) ? 3 : 2;
     const LdcTaskDependency output = ldcTaskDependencyAdd(&frame->m_taskGroup);
 
-    ldcTaskGroupAdd(&frame->m_taskGroup, inputs, VNArraySize(inputs), output, taskConvertFromInternal,
+    ldcTaskGroupAdd(&frame->m_taskGroup, inputs, numInputs, output, taskConvertFromInternal,
                     nullptr, 1, 1, sizeof(data), &data, "ConvertFromInternal");
 
     return output;
@@ -1133,6 +1676,7 @@ void* PipelineCPU::taskUpsample(LdcTask* task, const LdcTaskPart* /*part*/)
     const TaskUpsampleData& data{VNTaskData(task, TaskUpsampleData)};
     PipelineCPU* const pipeline{data.pipeline};
     FrameCPU* const frame{data.frame};
+    const StageTimer stageTimer{pipeline, frame, DecodeStageBase};
 
     if (frame->m_skip) {
         return nullptr;
@@ -1158,8 +1702,8 @@ void* PipelineCPU::taskUpsample(LdcTask* task, const LdcTaskPart* /*part*/)
     VNLogDebug("taskUpsample timestamp:%" PRIx64 " loq:%d plane:%d", frame->timestamp,
                (uint32_t)data.fromLoq, data.plane);
 
-    if (!ldppUpscale(pipeline->allocator(), &pipeline->m_taskPool, task,
-                     &frame->globalConfig->kernel, &upscaleArgs)) {
+    if (!ldppUpscale(pipeline->frameAllocator(LdpMemoryCategoryIntermediate), pipeline->m_taskPool,
+                     task, &frame->globalConfig->kernel, &upscaleArgs)) {
         VNLogError("Upsample failed");
     }
 
@@ -1190,7 +1734,7 @@ struct TaskGenerateCmdBufferData
 {
     PipelineCPU* pipeline;
     FrameCPU* frame;
-    LdpEnhancementTile* enhancementTile;
+    uint32_t enhancementTileIdx;
 };
 
 void* PipelineCPU::taskGenerateCmdBuffer(LdcTask* task, const LdcTaskPart* /*part*/)
@@ -1199,15 +1743,47 @@ void* PipelineCPU::taskGenerateCmdBuffer(LdcTask* task, const LdcTaskPart* /*par
     assert(task->dataSize == sizeof(TaskGenerateCmdBufferData));
 
     const TaskGenerateCmdBufferData& data{VNTaskData(task, TaskGenerateCmdBufferData)};
+    PipelineCPU* const pipeline{data.pipeline};
     FrameCPU* const frame{data.frame};
+    LdpEnhancementTile* const enhancementTile{
+        frame->getEnhancementTile(data.enhancementTileIdx)};
+    const StageTimer stageTimer{pipeline, frame, tileStage(enhancementTile)};
 
     VNLogDebug("taskGenerateCmdBuffer timestamp:%" PRIx64 " tile:%d loq:%d plane:%d",
-               data.frame->timestamp, data.enhancementTile->tile,
-               (uint32_t)data.enhancementTile->loq, data.enhancementTile->plane);
-
-    if (!ldeDecodeEnhancement(frame->globalConfig, &frame->config, data.enhancementTile->loq,
-                              data.enhancementTile->plane, data.enhancementTile->tile,
-                              &data.enhancementTile->buffer, nullptr, nullptr)) {
+               data.frame->timestamp, enhancementTile->tile,
+               (uint32_t)enhancementTile->loq, enhancementTile->plane);
+
+    LdeHuffmanCache* const huffmanCache{
+        pipeline->m_huffmanCache.capacity > 0 ? &pipeline->m_huffmanCache : nullptr};
+
+    // Layers may have been decoded in parallel beforehand by taskDecodeLayers
+    const LdeLayerRuns* const layerRuns{
+        pipeline->m_configuration.parallelLayerDecode ? &enhancementTile->layerRuns : nullptr};
+
+    LdeCmdBufferCpu* cmdBufferCpu{nullptr};
+    LdeCmdBufferGpu* cmdBufferGpu{nullptr};
+    LdeCmdBufferGpuBuilder* cmdBufferBuilder{nullptr};
+    if (pipeline->m_configuration.bitmaskCmdBuffers) {
+        cmdBufferGpu = &enhancementTile->bufferGpu;
+        cmdBufferBuilder = &enhancementTile->bufferGpuBuilder;
+    } else {
+        cmdBufferCpu = &enhancementTile->buffer;
+    }
+
+    bool decoded = false;
+    if (layerRuns) {
+        decoded = ldeDecodeEnhancementFromLayers(
+            frame->globalConfig, &frame->config, enhancementTile->loq, enhancementTile->plane,
+            enhancementTile->tile, layerRuns, cmdBufferCpu, cmdBufferGpu, cmdBufferBuilder,
+            huffmanCache);
+        // The runs are only needed until the command buffer exists
+        ldeLayerRunsFree(&enhancementTile->layerRuns);
+    } else {
+        decoded = ldeDecodeEnhancement(frame->globalConfig, &frame->config, enhancementTile->loq,
+                                       enhancementTile->plane, enhancementTile->tile, cmdBufferCpu,
+                                       cmdBufferGpu, cmdBufferBuilder, huffmanCache);
+    }
+    if (!decoded) {
         VNLogError("ldeDecodeEnhancement failed");
     }
 
@@ -1216,15 +1792,85 @@ void* PipelineCPU::taskGenerateCmdBuffer(LdcTask* task, const LdcTaskPart* /*par
 
 LdcTaskDependency PipelineCPU::addTaskGenerateCmdBuffer(FrameCPU* frame, LdpEnhancementTile* enhancementTile)
 {
-    const TaskGenerateCmdBufferData data{this, frame, enhancementTile};
+    const TaskGenerateCmdBufferData data{this, frame,
+                                         frame->enhancementTileIndex(enhancementTile)};
     const LdcTaskDependency outputDep{ldcTaskDependencyAdd(&frame->m_taskGroup)};
 
-    ldcTaskGroupAdd(&frame->m_taskGroup, nullptr, 0, outputDep, taskGenerateCmdBuffer, nullptr, 1,
-                    1, sizeof(data), &data, "GenerateCmdBuffer");
+    if (m_configuration.parallelLayerDecode) {
+        const LdcTaskDependency inputs[] = {addTaskDecodeLayers(frame, enhancementTile)};
+        ldcTaskGroupAdd(&frame->m_taskGroup, inputs, VNArraySize(inputs), outputDep,
+                        taskGenerateCmdBuffer, nullptr, 1, 1, sizeof(data), &data,
+                        "GenerateCmdBuffer");
+    } else {
+        ldcTaskGroupAdd(&frame->m_taskGroup, nullptr, 0, outputDep, taskGenerateCmdBuffer, nullptr,
+                        1, 1, sizeof(data), &data, "GenerateCmdBuffer");
+    }
 
     return outputDep;
 }
 
+//// DecodeLayers
+//
+// Entropy decode each layer of an enhancement tile into runs, one layer per task part, ready for
+// GenerateCmdBuffer to merge into a command buffer.
+//
+struct TaskDecodeLayersData
+{
+    PipelineCPU* pipeline;
+    FrameCPU* frame;
+    uint32_t enhancementTileIdx;
+};
+
+void* PipelineCPU::taskDecodeLayers(LdcTask* task, const LdcTaskPart* part)
+{
+    VNTraceScoped();
+    assert(task->dataSize == sizeof(TaskDecodeLayersData));
+
+    const TaskDecodeLayersData& data{VNTaskData(task, TaskDecodeLayersData)};
+    PipelineCPU* const pipeline{data.pipeline};
+    FrameCPU* const frame{data.frame};
+    LdpEnhancementTile* const enhancementTile{frame->getEnhancementTile(data.enhancementTileIdx)};
+    const StageTimer stageTimer{pipeline, frame, tileStage(enhancementTile)};
+
+    LdeHuffmanCache* const huffmanCache{
+        pipeline->m_huffmanCache.capacity > 0 ? &pipeline->m_huffmanCache : nullptr};
+
+    for (uint32_t layer = part->start; layer < part->start + part->count; ++layer) {
+        if (!ldeDecodeLayer(frame->globalConfig, &frame->config, enhancementTile->loq,
+                            enhancementTile->plane, enhancementTile->tile, layer, huffmanCache,
+                            &enhancementTile->layerRuns)) {
+            VNLogError("ldeDecodeLayer failed");
+        }
+    }
+
+    return nullptr;
+}
+
+LdcTaskDependency PipelineCPU::addTaskDecodeLayers(FrameCPU* frame, LdpEnhancementTile* enhancementTile)
+{
+    const TaskDecodeLayersData data{this, frame, frame->enhancementTileIndex(enhancementTile)};
+    const LdcTaskDependency outputDep{ldcTaskDependencyAdd(&frame->m_taskGroup)};
+
+    ldcTaskGroupAdd(&frame->m_taskGroup, nullptr, 0, outputDep, taskDecodeLayers, nullptr,
+                    frame->globalConfig->numLayers, 1, sizeof(data), &data, "DecodeLayers");
+
+    return outputDep;
+}
+
+// Apply an enhancement tile's command buffer in whichever format the pipeline generates
+//
+bool PipelineCPU::applyCmdBuffer(LdpEnhancementTile* enhancementTile, LdpFixedPoint fixedPoint,
+                                 const LdpPicturePlaneDesc* plane, bool tuRasterOrder)
+{
+    if (m_configuration.bitmaskCmdBuffers) {
+        return ldppApplyCmdBufferBitmask(m_taskPool, NULL, enhancementTile, fixedPoint, plane,
+                                         tuRasterOrder, m_configuration.forceScalar,
+                                         m_configuration.highlightResiduals);
+    }
+    return ldppApplyCmdBuffer(m_taskPool, NULL, enhancementTile, fixedPoint, plane, tuRasterOrder,
+                              m_configuration.forceScalar, m_configuration.highlightResiduals);
+}
+
 //// ApplyCmdBufferDirect
 //
 // Apply a generated CPU command buffer to directly to output plane. (No Temporal)
@@ -1235,7 +1881,7 @@ struct TaskApplyCmdBufferDirectData
 {
     PipelineCPU* pipeline;
     FrameCPU* frame;
-    LdpEnhancementTile* enhancementTile;
+    uint32_t enhancementTileIdx;
 };
 
 void* PipelineCPU::taskApplyCmdBufferDirect(LdcTask* task, const LdcTaskPart* /*part*/)
@@ -1246,24 +1892,28 @@ void* PipelineCPU::taskApplyCmdBufferDirect(LdcTask* task, const LdcTaskPart* /*
     const TaskApplyCmdBufferDirectData& data{VNTaskData(task, TaskApplyCmdBufferDirectData)};
     PipelineCPU* const pipeline{data.pipeline};
     FrameCPU* const frame{data.frame};
+    LdpEnhancementTile* const enhancementTile{
+        frame->getEnhancementTile(data.enhancementTileIdx)};
+    const StageTimer stageTimer{pipeline, frame, tileStage(enhancementTile)};
 
     if (frame->m_skip) {
         return nullptr;
     }
 
     VNLogDebug("taskApplyCmdBufferDirect timestamp:%" PRIx64 " loq:%d plane:%d", data.frame->timestamp,
-               (uint32_t)data.enhancementTile->loq, data.enhancementTile->plane);
+               (uint32_t)enhancementTile->loq, enhancementTile->plane);
 
     LdpPicturePlaneDesc ppDesc{};
 
-    frame->getIntermediatePlaneDesc(data.enhancementTile->plane, data.enhancementTile->loq, ppDesc);
+    frame->getIntermediatePlaneDesc(enhancementTile->plane, enhancementTile->loq, ppDesc);
 
     const bool tuRasterOrder =
         !frame->globalConfig->temporalEnabled && frame->globalConfig->tileDimensions == TDTNone;
 
-    if (!ldppApplyCmdBuffer(&pipeline->m_taskPool, NULL, data.enhancementTile, LdpFPS14, &ppDesc,
-                            tuRasterOrder, pipeline->m_configuration.forceScalar,
-                            pipeline->m_configuration.highlightResiduals)) {
+    const LdpFixedPoint fixedPoint =
+        frame->m_intermediateLayout[enhancementTile->loq].layoutInfo->fixedPoint;
+
+    if (!pipeline->applyCmdBuffer(enhancementTile, fixedPoint, &ppDesc, tuRasterOrder)) {
         VNLogError("taskApplyCmdBufferDirect failed");
     }
 
@@ -1275,7 +1925,8 @@ LdcTaskDependency PipelineCPU::addTaskApplyCmdBufferDirect(FrameCPU* frame,
                                                            LdcTaskDependency imageBuffer,
                                                            LdcTaskDependency cmdBuffer)
 {
-    const TaskApplyCmdBufferDirectData data{this, frame, enhancementTile};
+    const TaskApplyCmdBufferDirectData data{this, frame,
+                                            frame->enhancementTileIndex(enhancementTile)};
 
     const LdcTaskDependency inputs[] = {imageBuffer, cmdBuffer};
     const LdcTaskDependency output{ldcTaskDependencyAdd(&frame->m_taskGroup)};
@@ -1294,7 +1945,7 @@ struct TaskApplyCmdBufferTemporalData
 {
     PipelineCPU* pipeline;
     FrameCPU* frame;
-    LdpEnhancementTile* enhancementTile;
+    uint32_t enhancementTileIdx;
 };
 
 void* PipelineCPU::taskApplyCmdBufferTemporal(LdcTask* task, const LdcTaskPart* /*part*/)
@@ -1305,16 +1956,25 @@ void* PipelineCPU::taskApplyCmdBufferTemporal(LdcTask* task, const LdcTaskPart*
     const TaskApplyCmdBufferTemporalData& data{VNTaskData(task, TaskApplyCmdBufferTemporalData)};
     PipelineCPU* const pipeline{data.pipeline};
     FrameCPU* const frame{data.frame};
+    LdpEnhancementTile* const enhancementTile{
+        frame->getEnhancementTile(data.enhancementTileIdx)};
+    const StageTimer stageTimer{pipeline, frame, DecodeStageLOQ0};
 
     VNLogDebug("taskApplyCmdBufferTemporal timestamp:%" PRIx64 " tile:%d loq:%d plane:%d",
-               data.frame->timestamp, data.enhancementTile->tile,
-               (uint32_t)data.enhancementTile->loq, data.enhancementTile->plane);
+               data.frame->timestamp, enhancementTile->tile,
+               (uint32_t)enhancementTile->loq, enhancementTile->plane);
+
+    TemporalBuffer* const temporalBuffer{frame->m_temporalBuffer[enhancementTile->plane]};
+    LdpPicturePlaneDesc ppDesc{temporalBuffer->planeDesc};
 
-    LdpPicturePlaneDesc ppDesc{frame->m_temporalBuffer[data.enhancementTile->plane]->planeDesc};
+    // Note the blocks that now may hold residuals, so that adding the temporal buffer to the
+    // picture can skip the rest
+    if (!ldppCmdBufferMarkBlocks(enhancementTile, pipeline->m_configuration.bitmaskCmdBuffers,
+                                 temporalBuffer->blockMap, temporalBuffer->blocksAcross)) {
+        VNLogError("ldppCmdBufferMarkBlocks failed");
+    }
 
-    if (!ldppApplyCmdBuffer(&pipeline->m_taskPool, NULL, data.enhancementTile, LdpFPS14, &ppDesc,
-                            false, pipeline->m_configuration.forceScalar,
-                            pipeline->m_configuration.highlightResiduals)) {
+    if (!pipeline->applyCmdBuffer(enhancementTile, LdpFPS14, &ppDesc, false)) {
         VNLogError("ldppApplyCmdBufferTemporal failed");
     }
     return nullptr;
@@ -1325,7 +1985,8 @@ LdcTaskDependency PipelineCPU::addTaskApplyCmdBufferTemporal(FrameCPU* frame,
                                                              LdcTaskDependency temporalBuffer,
                                                              LdcTaskDependency cmdBuffer)
 {
-    const TaskApplyCmdBufferTemporalData data{this, frame, enhancementTile};
+    const TaskApplyCmdBufferTemporalData data{this, frame,
+                                              frame->enhancementTileIndex(enhancementTile)};
 
     const LdcTaskDependency inputs[] = {temporalBuffer, cmdBuffer};
     const LdcTaskDependency output{ldcTaskDependencyAdd(&frame->m_taskGroup)};
@@ -1355,9 +2016,10 @@ void* PipelineCPU::taskApplyAddTemporal(LdcTask* task, const LdcTaskPart* /*part
     const TaskApplyAddTemporalData& data{VNTaskData(task, TaskApplyAddTemporalData)};
     PipelineCPU* const pipeline{data.pipeline};
     FrameCPU* const frame{data.frame};
+    const StageTimer stageTimer{pipeline, frame, DecodeStageLOQ0};
 
     if (frame->m_skip || frame->m_passthrough) {
-        pipeline->releaseTemporalBuffer(frame, data.planeIndex);
+        // Temporal buffer is released by the following TemporalRelease task
         return nullptr;
     }
 
@@ -1366,10 +2028,14 @@ void* PipelineCPU::taskApplyAddTemporal(LdcTask* task, const LdcTaskPart* /*part
     LdpPicturePlaneDesc dstPlane{};
     frame->getIntermediatePlaneDesc(data.planeIndex, LOQ0, dstPlane);
 
-    if (!ldppPlaneBlit(&pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar, data.planeIndex,
-                       &frame->m_intermediateLayout[LOQ0], &frame->m_intermediateLayout[LOQ0],
-                       &frame->m_temporalBuffer[data.planeIndex]->planeDesc, &dstPlane, BMAdd)) {
-        VNLogError("ldppPlaneBlit out failed");
+    // Only blocks that have had residuals since the buffer was last cleared need adding
+    const TemporalBuffer* const temporalBuffer{frame->m_temporalBuffer[data.planeIndex]};
+    if (!ldppPlaneBlitBlocks(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+                             data.planeIndex, &frame->m_temporalLayout,
+                             &frame->m_intermediateLayout[LOQ0], &temporalBuffer->planeDesc,
+                             &dstPlane, BMAdd, temporalBuffer->blockMap,
+                             temporalBuffer->blocksAcross)) {
+        VNLogError("ldppPlaneBlitBlocks out failed");
     }
 
     return nullptr;
@@ -1427,7 +2093,7 @@ void* PipelineCPU::taskPassthrough(LdcTask* task, const LdcTaskPart* /*part*/)
 
     VNLogDebug("taskPassthrough timestamp:%" PRIx64 " plane:%d", data.frame->timestamp, data.planeIndex);
 
-    if (!ldppPlaneBlit(&pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+    if (!ldppPlaneBlit(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
                        data.planeIndex, &frame->basePicture->layout, &frame->outputPicture->layout,
                        &srcPlane, &dstPlane, BMCopy)) {
         VNLogError("ldppPlaneBlit In failed");
@@ -1554,20 +2220,34 @@ void* PipelineCPU::taskOutputDone(LdcTask* task, const LdcTaskPart* /*part*/)
         // Build the decode info for the frame
         frame->m_decodeInfo.timestamp = frame->timestamp;
         frame->m_decodeInfo.hasBase = true;
-        frame->m_decodeInfo.hasEnhancement =
-            frame->config.loqEnabled[LOQ1] || frame->config.loqEnabled[LOQ0];
+        frame->m_decodeInfo.hasEnhancement = frame->config.loqEnabled[LOQ1] ||
+                                             frame->config.loqEnabled[LOQ0] ||
+                                             frame->m_degradation != LdpDegradationNone;
         frame->m_decodeInfo.skipped = frame->m_skip;
         frame->m_decodeInfo.enhanced = frame->config.loqEnabled[LOQ1] || frame->config.loqEnabled[LOQ0];
         frame->m_decodeInfo.baseWidth = frame->baseWidth;
         frame->m_decodeInfo.baseHeight = frame->baseHeight;
         frame->m_decodeInfo.baseBitdepth = frame->baseBitdepth;
+        frame->m_decodeInfo.degradation = frame->m_degradation;
         frame->m_decodeInfo.userData = frame->userData;
 
+        if (pipeline->m_configuration.deadlinePolicy) {
+            pipeline->updateDecodeCosts(frame);
+        }
+
         pipeline->m_interTaskFrameDone.signal();
 
         pipeline->m_eventSink->generate(pipeline::EventOutputPictureDone, frame->outputPicture,
                                         &frame->m_decodeInfo);
-        pipeline->m_eventSink->generate(pipeline::EventCanReceive);
+
+        if (!pipeline->m_eventSink->isCompletionEnabled()) {
+            pipeline->m_eventSink->generate(pipeline::EventCanReceive);
+        }
+    }
+
+    // Deliver directly on this thread, outside of the inter-task lock
+    if (pipeline->m_eventSink->isCompletionEnabled()) {
+        pipeline->completeDoneFrames();
     }
 
     return nullptr;
@@ -1581,6 +2261,77 @@ void PipelineCPU::addTaskOutputDone(FrameCPU* frame, const LdcTaskDependency* in
                     taskOutputDone, nullptr, 1, 1, sizeof(data), &data, "OutputDone");
 }
 
+//// TemporalForward
+//
+// Once this frame's residuals have been applied to its temporal buffer, copy the buffer to a spare
+// one and hand that to the next frame. The next frame's temporal residuals then no longer wait
+// for this frame's LoQ1 and upsampling to finish, only for the copy.
+//
+struct TaskTemporalForwardData
+{
+    PipelineCPU* pipeline;
+    FrameCPU* frame;
+    uint32_t planeIndex;
+};
+
+void* PipelineCPU::taskTemporalForward(LdcTask* task, const LdcTaskPart* /*part*/)
+{
+    VNTraceScoped();
+    assert(task->dataSize == sizeof(TaskTemporalForwardData));
+
+    const TaskTemporalForwardData& data{VNTaskData(task, TaskTemporalForwardData)};
+    PipelineCPU* const pipeline{data.pipeline};
+    FrameCPU* const frame{data.frame};
+    const StageTimer stageTimer{pipeline, frame, DecodeStageLOQ0};
+    const uint32_t planeIndex{data.planeIndex};
+
+    TemporalBuffer* const temporalBuffer{frame->m_temporalBuffer[planeIndex]};
+    if (!temporalBuffer) {
+        return nullptr;
+    }
+
+    TemporalBuffer* const copy{pipeline->reserveSpareTemporalBuffer(frame, planeIndex)};
+    if (!copy) {
+        // All buffers in use - the next frame picks up this buffer on release instead
+        return nullptr;
+    }
+
+    VNLogDebug("taskTemporalForward timestamp:%" PRIx64 " plane:%d", frame->timestamp, planeIndex);
+
+    TemporalBufferDesc desc{temporalBuffer->desc};
+    desc.timestamp = kInvalidTimestamp;
+    desc.clear = false;
+    pipeline->updateTemporalBufferDesc(copy, desc);
+    memcpy(copy->blockMap, temporalBuffer->blockMap, temporalBlockMapSize(desc));
+
+    if (!ldppPlaneBlit(pipeline->m_taskPool, task, pipeline->m_configuration.forceScalar,
+                       planeIndex, &frame->m_temporalLayout, &frame->m_temporalLayout,
+                       &temporalBuffer->planeDesc, &copy->planeDesc, BMCopy)) {
+        VNLogError("ldppPlaneBlit temporal failed");
+        common::ScopedLock lock(pipeline->m_interTaskMutex);
+        copy->frame = nullptr;
+        return nullptr;
+    }
+
+    pipeline->forwardTemporalBuffer(frame, copy, planeIndex);
+
+    return nullptr;
+}
+
+LdcTaskDependency PipelineCPU::addTaskTemporalForward(FrameCPU* frame, uint32_t planeIndex,
+                                                      LdcTaskDependency temporalDep)
+{
+    const TaskTemporalForwardData data{this, frame, planeIndex};
+
+    const LdcTaskDependency inputs[] = {temporalDep};
+    const LdcTaskDependency output{ldcTaskDependencyAdd(&frame->m_taskGroup)};
+
+    ldcTaskGroupAdd(&frame->m_taskGroup, inputs, VNArraySize(inputs), output, taskTemporalForward,
+                    nullptr, 1, 1, sizeof(data), &data, "TemporalForward");
+
+    return output;
+}
+
 //// TemporalRelease
 //
 // Wait for a bunch of input dependencies to be met, then:
@@ -1611,21 +2362,123 @@ void* PipelineCPU::taskTemporalRelease(LdcTask* task, const LdcTaskPart* /*part*
     return nullptr;
 }
 
-void PipelineCPU::addTaskTemporalRelease(FrameCPU* frame, const LdcTaskDependency* deps, uint32_t planeIndex)
+void PipelineCPU::addTaskTemporalRelease(FrameCPU* frame, const LdcTaskDependency* inputDeps,
+                                         uint32_t inputDepsCount, uint32_t planeIndex)
 {
     const TaskTemporalReleaseData data{this, frame, planeIndex};
-    const LdcTaskDependency inputs[] = {deps[planeIndex]};
 
-    ldcTaskGroupAdd(&frame->m_taskGroup, inputs, VNArraySize(inputs), kTaskDependencyInvalid,
+    ldcTaskGroupAdd(&frame->m_taskGroup, inputDeps, inputDepsCount, kTaskDependencyInvalid,
                     taskTemporalRelease, nullptr, 1, 1, sizeof(data), &data, "TemporalRelease");
 }
 
+// Every task data structure must start with the same members as TaskDataHeader
+static_assert(offsetof(TaskConvertToInternalData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskConvertFromInternalData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskUpsampleData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskGenerateCmdBufferData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskDecodeLayersData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskApplyCmdBufferDirectData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskApplyCmdBufferTemporalData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskApplyAddTemporalData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskPassthroughData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskWaitForManyData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskBaseDoneData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskOutputDoneData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskTemporalForwardData, frame) == offsetof(TaskDataHeader, frame));
+static_assert(offsetof(TaskTemporalReleaseData, frame) == offsetof(TaskDataHeader, frame));
+
+// Gather the parts of a frame's configuration that decide the shape of its task graph
+//
+TaskGraphKey PipelineCPU::makeTaskGraphKey(const FrameCPU* frame)
+{
+    const LdeFrameConfig& frameConfig{frame->config};
+    const LdeGlobalConfig& globalConfig{*frame->globalConfig};
+
+    // Cleared so that keys can be compared bytewise
+    TaskGraphKey key;
+    memset(&key, 0, sizeof(key));
+
+    key.numImagePlanes = frame->numImagePlanes();
+    key.numPlanes = globalConfig.numPlanes;
+    key.baseDepth = globalConfig.baseDepth;
+    key.enhancedDepth = globalConfig.enhancedDepth;
+    key.temporalEnabled = globalConfig.temporalEnabled;
+    key.frameConfigSet = frameConfig.frameConfigSet;
+    key.passthrough = frame->m_passthrough;
+    key.skipTemporal = (frame->m_degradation & LdpDegradationSkipTemporal) != 0;
+    key.numLayers = globalConfig.numLayers;
+    for (uint32_t loq = 0; loq < LOQEnhancedCount; ++loq) {
+        key.scalingModes[loq] = globalConfig.scalingModes[loq];
+        key.loqEnabled[loq] = frameConfig.loqEnabled[loq];
+        for (uint32_t plane = 0; plane < RCMaxPlanes; ++plane) {
+            key.numTiles[plane][loq] = globalConfig.numTiles[plane][loq];
+        }
+    }
+
+    return key;
+}
+
 // Fill out a task group given a frame configuration
 //
+// Consecutive frames mostly have the same shape of task graph, so recently generated graphs are
+// recorded, and added to later frames with the same configuration in one step.
+//
 void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTimestamp)
 {
     VNTraceScoped();
 
+    if (frame->config.sharpenType != STDisabled && frame->config.sharpenStrength != 0.0f) {
+        VNLogWarning("S-Filter is configured in stream, but not supported by decoder.");
+    }
+
+    if (!m_configuration.taskGraphTemplates) {
+        addTasksEnhancement(frame, previousTimestamp);
+        return;
+    }
+
+    const TaskGraphKey key{makeTaskGraphKey(frame)};
+
+    // Is there a matching recorded graph?
+    uint32_t templateIdx = m_nextTaskGraphTemplate;
+    for (uint32_t idx = 0; idx < kMaxTaskGraphTemplates; ++idx) {
+        const TaskGraphTemplate& tgt{m_taskGraphTemplates[idx]};
+        if (tgt.valid && memcmp(&tgt.key, &key, sizeof(key)) == 0) {
+            templateIdx = idx;
+            break;
+        }
+    }
+
+    TaskGraphTemplate& tgt{m_taskGraphTemplates[templateIdx]};
+
+    if (tgt.valid && memcmp(&tgt.key, &key, sizeof(key)) == 0) {
+        const TaskDataHeader header{this, frame};
+        if (ldcTaskGroupAddTemplate(&frame->m_taskGroup, &tgt.graph, &header, sizeof(header))) {
+            // Connect up temporal buffers, as generating the graph would have done
+            for (uint32_t plane = 0; plane < RCMaxPlanes; ++plane) {
+                if (tgt.depTemporalBuffer[plane] != kTaskDependencyInvalid) {
+                    requestTemporalBuffer(frame, previousTimestamp, plane,
+                                          tgt.depTemporalBuffer[plane]);
+                }
+            }
+            return;
+        }
+    } else {
+        // Replace the oldest recorded graph
+        m_nextTaskGraphTemplate = (m_nextTaskGraphTemplate + 1) % kMaxTaskGraphTemplates;
+    }
+
+    // Generate the graph, recording it for later frames
+    ldcTaskGroupRecordBegin(&frame->m_taskGroup, &tgt.graph);
+    addTasksEnhancement(frame, previousTimestamp);
+    tgt.valid = ldcTaskGroupRecordEnd(&frame->m_taskGroup);
+    tgt.key = key;
+    memcpy(tgt.depTemporalBuffer, frame->m_depTemporalBuffer, sizeof(tgt.depTemporalBuffer));
+}
+
+// Add all the tasks for an enhanced frame to its task group
+//
+void PipelineCPU::addTasksEnhancement(FrameCPU* frame, uint64_t previousTimestamp)
+{
     // Convenience values for readability
     const LdeFrameConfig& frameConfig{frame->config};
     const LdeGlobalConfig& globalConfig{*frame->globalConfig};
@@ -1633,10 +2486,6 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
 
     uint32_t enhancementTileIdx = 0;
 
-    if (frame->config.sharpenType != STDisabled && frame->config.sharpenStrength != 0.0f) {
-        VNLogWarning("S-Filter is configured in stream, but not supported by decoder.");
-    }
-
     //// LoQ 1
     //
     LdcTaskDependency basePlanes[kLdpPictureMaxNumPlanes] = {};
@@ -1646,6 +2495,9 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
         basePlanes[plane] = frame->m_depBasePicture;
     }
 
+    // Tasks that read from the base picture
+    LdcTaskDependency baseReaders[kLdpPictureMaxNumPlanes] = {};
+
     // Upsample and residuals
     for (uint8_t plane = 0; plane < numImagePlanes; ++plane) {
         const bool isEnhanced = frame->isEnhanced(LOQ1, plane);
@@ -1657,6 +2509,7 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
         // Convert between base and enhancement bit depth
         basePlane = addTaskConvertToInternal(frame, plane, globalConfig.baseDepth,
                                              globalConfig.enhancedDepth, basePlanes[plane]);
+        baseReaders[plane] = basePlane;
 
         //// Base + Residuals
         //
@@ -1717,7 +2570,8 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
 
         LdcTaskDependency recon{upsampledPlanes[plane]};
 
-        if (globalConfig.temporalEnabled && !frame->m_passthrough) {
+        if (globalConfig.temporalEnabled && !frame->m_passthrough &&
+            !(frame->m_degradation & LdpDegradationSkipTemporal)) {
             LdcTaskDependency temporal{kTaskDependencyInvalid};
 
             if (plane < globalConfig.numPlanes) {
@@ -1755,8 +2609,19 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
 
             // Always add temporal buffer, even if no enhancement this frame
             if (plane < globalConfig.numPlanes) {
+                LdcTaskDependency releaseInputs[2] = {};
+                uint32_t releaseInputsCount = 0;
+
+                // If enabled, and there are spare temporal buffers, hand a copy of the temporal
+                // state on to the next frame as soon as this frame's residuals are in
+                if (m_configuration.temporalForward && m_configuration.numTemporalBuffers > 1) {
+                    releaseInputs[releaseInputsCount++] =
+                        addTaskTemporalForward(frame, plane, temporal);
+                }
+
                 reconstructedPlanes[plane] = addTaskApplyAddTemporal(frame, plane, temporal, recon);
-                addTaskTemporalRelease(frame, reconstructedPlanes, plane);
+                releaseInputs[releaseInputsCount++] = reconstructedPlanes[plane];
+                addTaskTemporalRelease(frame, releaseInputs, releaseInputsCount, plane);
             } else {
                 reconstructedPlanes[plane] = recon;
             }
@@ -1797,20 +2662,21 @@ void PipelineCPU::generateTasksEnhancement(FrameCPU* frame, uint64_t previousTim
 
     // Convert any enhanced planes back to output
     for (uint8_t plane = 0; plane < numImagePlanes; ++plane) {
-        outputPlanes[plane] =
-            addTaskConvertFromInternal(frame, plane, globalConfig.baseDepth, globalConfig.enhancedDepth,
-                                       frame->m_depOutputPicture, reconstructedPlanes[plane]);
+        const LdcTaskDependency otherChroma{
+            (plane > 0) ? reconstructedPlanes[3 - plane] : kTaskDependencyInvalid};
+        outputPlanes[plane] = addTaskConvertFromInternal(
+            frame, plane, globalConfig.baseDepth, globalConfig.enhancedDepth,
+            frame->m_depOutputPicture, reconstructedPlanes[plane], otherChroma);
     }
 
     // Send output when all planes are ready
     addTaskOutputDone(frame, outputPlanes, numImagePlanes);
 
     // Send base when all tasks that use it have completed
-    LdcTaskDependency deps[kLdpPictureMaxNumPlanes] = {};
-    uint32_t depsCount = 0;
-    ldcTaskGroupFindOutputSetFromInput(&frame->m_taskGroup, frame->m_depBasePicture, deps,
-                                       kLdpPictureMaxNumPlanes, &depsCount);
-    addTaskBaseDone(frame, deps, depsCount);
+    //
+    // NB: The readers are tracked directly rather than searching the group, as a reader that has
+    // already finished is no longer in the group, and would be missing from a recorded graph.
+    addTaskBaseDone(frame, baseReaders, numImagePlanes);
 }
 
 // Fill out a task group for a simple unscaled passthrough configuration
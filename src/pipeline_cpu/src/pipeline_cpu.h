@@ -22,17 +22,21 @@
 #include <LCEVC/common/threads.h>
 //
 #include <LCEVC/common/class_utils.hpp>
+#include <LCEVC/common/memory_tracker.h>
 #include <LCEVC/common/ring_buffer.hpp>
 #include <LCEVC/common/rolling_arena.h>
 #include <LCEVC/common/task_pool.h>
 #include <LCEVC/common/threads.hpp>
 #include <LCEVC/common/vector.hpp>
 #include <LCEVC/enhancement/config_pool.h>
+#include <LCEVC/enhancement/huffman_cache.h>
 #include <LCEVC/pipeline/event_sink.h>
 #include <LCEVC/pipeline/frame.h>
 #include <LCEVC/pipeline/pipeline.h>
 #include <LCEVC/pixel_processing/dither.h>
 
+#include <cassert>
+
 namespace lcevc_dec::pipeline_cpu {
 
 class BufferCPU;
@@ -65,6 +69,50 @@ struct TemporalBuffer
     LdpPicturePlaneDesc planeDesc;
     // Buffer allocation
     LdcMemoryAllocation allocation;
+
+    // One byte per 32x32 block, non-zero if the block may hold non-zero residuals
+    uint8_t* blockMap;
+    uint32_t blocksAcross;
+    LdcMemoryAllocation blockMapAllocation;
+};
+
+// The parts of a frame's configuration that decide the shape of its task graph
+//
+struct TaskGraphKey
+{
+    uint8_t numImagePlanes;
+    uint8_t numPlanes;
+    LdeBitDepth baseDepth;
+    LdeBitDepth enhancedDepth;
+    LdeScalingMode scalingModes[LOQEnhancedCount];
+    uint32_t numTiles[RCMaxPlanes][LOQEnhancedCount];
+    bool temporalEnabled;
+    bool frameConfigSet;
+    bool loqEnabled[LOQEnhancedCount];
+    bool passthrough;
+    bool skipTemporal;
+    uint8_t numLayers;
+};
+
+// Parts of a frame's decode whose costs are measured separately for the deadline policy
+//
+enum DecodeStage
+{
+    DecodeStageBase, // Conversion and upscaling - still needed for scaled passthrough
+    DecodeStageLOQ1,
+    DecodeStageLOQ0, // Including the temporal buffer
+    DecodeStageCount
+};
+
+// A task graph recorded from one frame, that can be added to other frames with the same key
+//
+struct TaskGraphTemplate
+{
+    bool valid;
+    TaskGraphKey key;
+    // Temporal buffer dependencies, connected per frame after adding the graph
+    LdcTaskDependency depTemporalBuffer[RCMaxPlanes];
+    LdcTaskGraphTemplate graph;
 };
 
 // A base picture reference and other arguments from sendBase()
@@ -109,11 +157,31 @@ public:
 
     void freePicture(LdpPicture* picture) override;
 
+    // Memory accounting
+    LdcReturnCode getMemoryUsage(LdpMemoryUsage& usageOut) override;
+
     // Accessors for use by frames
     const PipelineConfigCPU& configuration() const { return m_configuration; }
     LdcMemoryAllocator* allocator() const { return m_allocator; }
-    LdcTaskPool* taskPool() { return &m_taskPool; }
-    LdppDitherGlobal* globalDitherBuffer() { return &m_dither; }
+    LdcMemoryAllocator* allocator(LdpMemoryCategory category) const
+    {
+        return memoryTracked() ? ldcMemoryTrackerAllocator(&m_memoryTracker, category)
+                               : m_allocator;
+    }
+    // True if allocations go through the memory tracker
+    bool memoryTracked() const
+    {
+        return m_configuration.memoryBudgetMB > 0 || m_configuration.memoryUsage;
+    }
+    // Allocator for blocks that are released by the end of their frame - see kFrameArenaCategories
+    LdcMemoryAllocator* frameAllocator(LdpMemoryCategory category)
+    {
+        assert(m_rollingArenas[category].allocator.functions);
+        return &m_rollingArenas[category].allocator;
+    }
+    LdcTaskPool* taskPool() { return m_taskPool; }
+    LdeConfigPool* configPool() { return &m_configPool; }
+    LdppDitherGlobal* globalDither() { return &m_dither; }
 
     // Buffer allocation
     BufferCPU* allocateBuffer(uint32_t requiredSize);
@@ -131,6 +199,12 @@ public:
     // Mark the frame as having finished with it's temporal buffer
     void releaseTemporalBuffer(FrameCPU* frame, uint32_t plane);
 
+    // Claim an unused temporal buffer for `frame` to copy its temporal state into
+    TemporalBuffer* reserveSpareTemporalBuffer(FrameCPU* frame, uint32_t plane);
+
+    // Hand a copy of a frame's finished temporal state on to the next frame, ahead of release
+    void forwardTemporalBuffer(FrameCPU* frame, TemporalBuffer* copy, uint32_t plane);
+
     // Create task group for this frame
     void generateTasksEnhancement(FrameCPU* frame, uint64_t previousTimestamp);
 
@@ -164,25 +238,69 @@ private:
     // Move frames from reorder table to generated tasks
     void startReadyFrames();
 
+    // Hand done frames to the completion callback in timestamp order - m_interTaskMutex is not held
+    void completeDoneFrames();
+
+    // First done frame that has not been completed, if all frames before it have been
+    // - m_interTaskMutex must be held
+    FrameCPU* nextFrameToComplete();
+
+    // Free frames whose output pictures have been completed
+    void releaseCompletedFrames();
+
     // Assign incoming output pictures to Frames
     void connectOutputPictures();
 
     // Number of outstanding frames
     uint32_t frameLatency() const;
 
+    // Set up accounting of allocations, returning the allocator for uncategorized data
+    LdcMemoryAllocator* initializeMemoryTracker(LdcMemoryAllocator* parentAllocator);
+
+    // Check memory use against the budget, and adjust the latency limit to suit
+    void updateMemoryBudget();
+
+    // The degradation needed for a frame to meet its deadline
+    uint8_t deadlineDegradation(const FrameCPU* frame);
+
+    // Reduce the decoding of a frame that is over the memory budget or predicted to miss its
+    // deadline, or that follows such a frame without a temporal refresh
+    void applyDegradation(FrameCPU* frame);
+
+    // Update the measured decode costs from a finished frame - m_interTaskMutex must be held
+    void updateDecodeCosts(const FrameCPU* frame);
+
     // Move any frames before `timestamp` into processing queue
     void startProcessing(uint64_t timestamp);
 
     // Try to match a frame to current temporal buffer(s)
     TemporalBuffer* matchTemporalBuffer(FrameCPU* frame, uint32_t plane);
 
+    // Fill in temporal requirements for an existing dependency, and try to match a buffer
+    void requestTemporalBuffer(FrameCPU* frame, uint64_t timestamp, uint32_t plane,
+                               LdcTaskDependency dep);
+
+    // Task graph generation for enhanced frames, and the key for reusing recorded graphs
+    static TaskGraphKey makeTaskGraphKey(const FrameCPU* frame);
+    void addTasksEnhancement(FrameCPU* frame, uint64_t previousTimestamp);
+
+    // Stamp a temporal buffer and find any pending frame that wants it
+    // - m_interTaskMutex must be held
+    FrameCPU* passOnTemporalBuffer(TemporalBuffer* tb, uint64_t timestamp, uint32_t plane);
+
+    // Find a frame waiting to start a new temporal chain that can take an unwanted buffer
+    // - m_interTaskMutex must be held
+    FrameCPU* startTemporalChain(TemporalBuffer* tb, uint32_t plane);
+
     // Create new tasks
     LdcTaskDependency addTaskGenerateCmdBuffer(FrameCPU* frame, LdpEnhancementTile* enhancementTile);
+    LdcTaskDependency addTaskDecodeLayers(FrameCPU* frame, LdpEnhancementTile* enhancementTile);
     LdcTaskDependency addTaskConvertToInternal(FrameCPU* frame, uint32_t planeIndex, uint32_t baseDepth,
                                                uint32_t enhancementDepth, LdcTaskDependency input);
     LdcTaskDependency addTaskConvertFromInternal(FrameCPU* frame, uint32_t planeIndex,
                                                  uint32_t baseDepth, uint32_t enhancementDepth,
-                                                 LdcTaskDependency dst, LdcTaskDependency src);
+                                                 LdcTaskDependency dst, LdcTaskDependency src,
+                                                 LdcTaskDependency otherChroma);
     LdcTaskDependency addTaskUpsample(FrameCPU* frame, LdeLOQIndex loq, uint32_t plane,
                                       LdcTaskDependency input);
 
@@ -203,11 +321,19 @@ private:
     LdcTaskDependency addTaskPassthrough(FrameCPU* frame, uint32_t planeIndex,
                                          LdcTaskDependency destDep, LdcTaskDependency srcDep);
 
-    void addTaskTemporalRelease(FrameCPU* frame, const LdcTaskDependency* deps, uint32_t planeIndex);
+    LdcTaskDependency addTaskTemporalForward(FrameCPU* frame, uint32_t planeIndex,
+                                             LdcTaskDependency temporalDep);
+    void addTaskTemporalRelease(FrameCPU* frame, const LdcTaskDependency* inputDeps,
+                                uint32_t inputDepsCount, uint32_t planeIndex);
+    // Apply a tile's command buffer in the configured format
+    bool applyCmdBuffer(LdpEnhancementTile* enhancementTile, LdpFixedPoint fixedPoint,
+                        const LdpPicturePlaneDesc* plane, bool tuRasterOrder);
+
     // // Task bodies
     static void* taskConvertToInternal(LdcTask* task, const LdcTaskPart* part);
     static void* taskConvertFromInternal(LdcTask* task, const LdcTaskPart* part);
     static void* taskGenerateCmdBuffer(LdcTask* task, const LdcTaskPart* part);
+    static void* taskDecodeLayers(LdcTask* task, const LdcTaskPart* part);
     static void* taskUpsample(LdcTask* task, const LdcTaskPart* part);
     static void* taskApplyCmdBufferDirect(LdcTask* task, const LdcTaskPart* part);
     static void* taskApplyCmdBufferTemporal(LdcTask* task, const LdcTaskPart* part);
@@ -216,6 +342,7 @@ private:
     static void* taskOutputDone(LdcTask* task, const LdcTaskPart* part);
     static void* taskBaseDone(LdcTask* task, const LdcTaskPart* part);
     static void* taskPassthrough(LdcTask* task, const LdcTaskPart* part);
+    static void* taskTemporalForward(LdcTask* task, const LdcTaskPart* part);
     static void* taskTemporalRelease(LdcTask* task, const LdcTaskPart* part);
 
     // Configuration from builder
@@ -224,17 +351,25 @@ private:
     // Interface to event mechanism
     pipeline::EventSink* m_eventSink = nullptr;
 
-    // The system allocator to use
+    // Accounts allocations by category, on top of the system allocator - internally synchronized.
+    // Only used when there is a budget, or usage accounting is asked for.
+    mutable LdcMemoryTracker m_memoryTracker = {};
+
+    // The allocator to use for data that does not fall into a tracked category
     LdcMemoryAllocator* m_allocator = nullptr;
 
-    // A rolling memory allocator for per-frame blocks
-    LdcMemoryAllocatorRollingArena m_rollingArena = {};
+    // Rolling memory allocators for per-frame blocks, on top of each category's tracked allocator
+    LdcMemoryAllocatorRollingArena m_rollingArenas[LdpMemoryCategoryCount] = {};
 
     // Enhancement configuration pool
     LdeConfigPool m_configPool = {};
 
-    // Task pool
-    LdcTaskPool m_taskPool = {};
+    // Built Huffman decoders shared by command buffer generation tasks - internally synchronized
+    LdeHuffmanCache m_huffmanCache = {};
+
+    // Task pool - either the builder's external pool, or m_privateTaskPool
+    LdcTaskPool* m_taskPool = nullptr;
+    LdcTaskPool m_privateTaskPool = {};
 
     // Vector of Buffer allocations
     lcevc_dec::common::Vector<LdcMemoryAllocation> m_buffers;
@@ -257,11 +392,33 @@ private:
     // Limit for frame reordering - can be dynamically updated as enhancement data comes in
     uint32_t m_maxReorder = 0;
 
+    // Limit for frames in flight - maxLatency, unless cut back whilst over the memory budget
+    uint32_t m_latencyLimit = 0;
+
+    // Memory use was over budget at the last check - new frames skip enhancement
+    bool m_overBudget = false;
+
+    // Average CPU time of each decode stage of a frame, in microseconds - m_interTaskMutex
+    float m_stageCost[DecodeStageCount] = {};
+
+    // Average ratio of a frame's elapsed decode time to the CPU time of its stages, or 0 until a
+    // frame has been measured - m_interTaskMutex
+    float m_latencyRatio = 0.0f;
+
+    // A frame has been decoded without the temporal buffer, so later frames must also go without
+    // until the next temporal refresh
+    bool m_temporalDegraded = false;
+
     // Vector of temporal buffers
     // A small pool of  (1 or more) temporal buffers is allocated on startup, then passed along
     // between frames.
     lcevc_dec::common::Vector<TemporalBuffer> m_temporalBuffers;
 
+    // Recently recorded task graphs, reused by frames with the same configuration
+    static constexpr uint32_t kMaxTaskGraphTemplates = 4;
+    TaskGraphTemplate m_taskGraphTemplates[kMaxTaskGraphTemplates] = {};
+    uint32_t m_nextTaskGraphTemplate = 0;
+
     // The prior frame during initial in-order config parsing - used to negotiate temporal buffers
     uint64_t m_previousTimestamp = kInvalidTimestamp;
 
@@ -288,6 +445,10 @@ private:
 
     // Signalled when frames are done, whilst holding m_interTaskMutex
     common::CondVar m_interTaskFrameDone;
+
+    // Set whilst a thread is making completion callbacks, so pictures are delivered in order by
+    // one thread at a time - m_interTaskMutex
+    bool m_completionDelivering = false;
 };
 
 } // namespace lcevc_dec::pipeline_cpu
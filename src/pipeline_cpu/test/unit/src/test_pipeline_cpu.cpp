@@ -12,17 +12,36 @@
  * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
  * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
 
+#include <find_assets_dir.h>
 #include <LCEVC/common/acceleration.h>
 #include <LCEVC/common/diagnostics.h>
+#include <LCEVC/extract/extract.h>
+#include <LCEVC/pipeline/picture.h>
 #include <LCEVC/pipeline/pipeline.h>
 #include <LCEVC/pipeline/types.h>
 #include <LCEVC/pipeline_cpu/create_pipeline.h>
+#include <pipeline_config_cpu.h>
 //
 #include <gtest/gtest.h>
 //
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
+namespace filesystem = std::filesystem;
 using namespace lcevc_dec::pipeline;
+using lcevc_dec::pipeline_cpu::PassthroughMode;
+
+const static filesystem::path kTestAssets{
+    lcevc_dec::utility::findAssetsDir("src/utility/test/assets")};
 
 TEST(PipelineCPU, Create)
 {
@@ -61,3 +80,783 @@ TEST_F(PipelineCPUFixture, AllocatePicturesManaged)
     auto picture = mPipeline->allocPictureManaged(pictureDesc);
     ASSERT_TRUE(picture);
 }
+
+TEST(PipelineCPU, MemoryUsage)
+{
+    auto pipelineBuilder =
+        CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(), (void*)ldcAccelerationGet());
+    ASSERT_TRUE(pipelineBuilder);
+    ASSERT_TRUE(pipelineBuilder->configure("memory_budget_mb", 1));
+
+    auto pipeline = pipelineBuilder->finish(EventSink::nullSink());
+    ASSERT_TRUE(pipeline);
+
+    LdpMemoryUsage usage{};
+    ASSERT_EQ(pipeline->getMemoryUsage(usage), LdcReturnCodeSuccess);
+    EXPECT_EQ(usage.budget, 1U << 20);
+    EXPECT_FALSE(usage.degraded);
+    EXPECT_GT(usage.current[LdpMemoryCategoryTasks], 0U);
+    const uint64_t framesBefore = usage.current[LdpMemoryCategoryFrames];
+
+    // A picture and its buffer are accounted as frame memory until freed
+    const LdpPictureDesc pictureDesc{1920, 1080, LdpColorFormatI420_8};
+    LdpPicture* picture = pipeline->allocPictureManaged(pictureDesc);
+    ASSERT_TRUE(picture);
+
+    ASSERT_EQ(pipeline->getMemoryUsage(usage), LdcReturnCodeSuccess);
+    EXPECT_GT(usage.current[LdpMemoryCategoryFrames], framesBefore);
+    uint64_t total = 0;
+    for (uint32_t category = 0; category < LdpMemoryCategoryCount; ++category) {
+        total += usage.current[category];
+        EXPECT_GE(usage.peak[category], usage.current[category]);
+    }
+    EXPECT_EQ(usage.total, total);
+
+    pipeline->freePicture(picture);
+    ASSERT_EQ(pipeline->getMemoryUsage(usage), LdcReturnCodeSuccess);
+    EXPECT_EQ(usage.current[LdpMemoryCategoryFrames], framesBefore);
+}
+
+TEST(PipelineCPU, MemoryUsageWithoutBudget)
+{
+    // Usage is accounted without a budget only when asked for
+    for (const bool memoryUsage : {false, true}) {
+        auto pipelineBuilder = CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(),
+                                                                (void*)ldcAccelerationGet());
+        ASSERT_TRUE(pipelineBuilder);
+        ASSERT_TRUE(pipelineBuilder->configure("memory_usage", memoryUsage));
+
+        auto pipeline = pipelineBuilder->finish(EventSink::nullSink());
+        ASSERT_TRUE(pipeline);
+
+        LdpMemoryUsage usage{};
+        if (!memoryUsage) {
+            EXPECT_EQ(pipeline->getMemoryUsage(usage), LdcReturnCodeNotSupported);
+            continue;
+        }
+        ASSERT_EQ(pipeline->getMemoryUsage(usage), LdcReturnCodeSuccess);
+        EXPECT_EQ(usage.budget, 0U);
+        EXPECT_FALSE(usage.degraded);
+        EXPECT_GT(usage.current[LdpMemoryCategoryTasks], 0U);
+    }
+}
+
+// An event sink that takes output pictures through the completion callback
+class CompletionSink : public EventSink
+{
+public:
+    void enableEvents(const std::vector<int32_t>& /*enabledEvents*/) override {}
+    bool isEventEnabled(uint8_t /*eventType*/) const override { return false; }
+    void generate(uint8_t eventType, LdpPicture* /*picture*/,
+                  const LdpDecodeInformation* /*decodeInfo*/, const uint8_t* /*data*/,
+                  uint32_t /*dataSize*/) override
+    {
+        if (eventType == EventOutputPictureDone) {
+            std::scoped_lock lock(mutex);
+            ++done;
+            condVar.notify_all();
+        }
+    }
+
+    bool isCompletionEnabled() const override { return true; }
+    void completePicture(LdpPicture* picture, const LdpDecodeInformation* decodeInfo) override
+    {
+        std::unique_lock lock(mutex);
+        completed.emplace_back(picture, decodeInfo->timestamp);
+
+        // Optionally hold the first callback until the test releases it
+        if (holdFirst && completed.size() == 1) {
+            holding = true;
+            condVar.notify_all();
+            releasedInTime =
+                condVar.wait_for(lock, std::chrono::seconds(5), [this] { return released; });
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable condVar;
+    std::vector<std::pair<LdpPicture*, uint64_t>> completed;
+    uint64_t done{0};
+
+    bool holdFirst{false};
+    bool holding{false};
+    bool released{false};
+    bool releasedInTime{false};
+};
+
+TEST(PipelineCPU, CompletionCallback)
+{
+    auto pipelineBuilder =
+        CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(), (void*)ldcAccelerationGet());
+    ASSERT_TRUE(pipelineBuilder);
+
+    CompletionSink sink;
+    auto pipeline = pipelineBuilder->finish(&sink);
+    ASSERT_TRUE(pipeline);
+
+    // Base only frames pass through to the output pictures
+    constexpr uint64_t kFrames = 4;
+    const LdpPictureDesc pictureDesc{64, 32, LdpColorFormatI420_8};
+    std::vector<LdpPicture*> outputPictures;
+    for (uint64_t timestamp = 1; timestamp <= kFrames; ++timestamp) {
+        LdpPicture* basePicture = pipeline->allocPictureManaged(pictureDesc);
+        ASSERT_EQ(pipeline->sendBasePicture(timestamp, basePicture, 1000000, nullptr),
+                  LdcReturnCodeSuccess);
+        outputPictures.push_back(pipeline->allocPictureManaged(pictureDesc));
+        ASSERT_EQ(pipeline->sendOutputPicture(outputPictures.back()), LdcReturnCodeSuccess);
+    }
+
+    pipeline->flush(kFrames);
+    pipeline->synchronize(false);
+
+    // Nothing is left to receive - all pictures went to the sink, in timestamp order
+    LdpDecodeInformation decodeInfo{};
+    EXPECT_EQ(pipeline->receiveOutputPicture(decodeInfo), nullptr);
+
+    {
+        const std::scoped_lock lock(sink.mutex);
+        ASSERT_EQ(sink.completed.size(), kFrames);
+        for (uint64_t idx = 0; idx < kFrames; ++idx) {
+            EXPECT_EQ(sink.completed[idx].first, outputPictures[idx]);
+            EXPECT_EQ(sink.completed[idx].second, idx + 1);
+        }
+    }
+
+    for (LdpPicture* picture : outputPictures) {
+        pipeline->freePicture(picture);
+    }
+    while (LdpPicture* basePicture = pipeline->receiveFinishedBasePicture()) {
+        pipeline->freePicture(basePicture);
+    }
+}
+
+TEST(PipelineCPU, CompletionCallbackUnlocked)
+{
+    auto pipelineBuilder =
+        CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(), (void*)ldcAccelerationGet());
+    ASSERT_TRUE(pipelineBuilder);
+    ASSERT_TRUE(pipelineBuilder->configure("threads", 4));
+
+    CompletionSink sink;
+    sink.holdFirst = true;
+    auto pipeline = pipelineBuilder->finish(&sink);
+    ASSERT_TRUE(pipeline);
+
+    // More frames than worker threads, so no worker may wait for the held callback
+    constexpr uint64_t kFrames = 8;
+    const LdpPictureDesc pictureDesc{64, 32, LdpColorFormatI420_8};
+    std::vector<LdpPicture*> outputPictures;
+    for (uint64_t timestamp = 1; timestamp <= kFrames; ++timestamp) {
+        LdpPicture* basePicture = pipeline->allocPictureManaged(pictureDesc);
+        ASSERT_EQ(pipeline->sendBasePicture(timestamp, basePicture, 1000000, nullptr),
+                  LdcReturnCodeSuccess);
+        outputPictures.push_back(pipeline->allocPictureManaged(pictureDesc));
+        ASSERT_EQ(pipeline->sendOutputPicture(outputPictures.back()), LdcReturnCodeSuccess);
+    }
+
+    // Wait for the first callback to be made
+    {
+        std::unique_lock lock(sink.mutex);
+        ASSERT_TRUE(sink.condVar.wait_for(lock, std::chrono::seconds(5),
+                                          [&sink] { return sink.holding; }));
+    }
+
+    // The pipeline can still be called whilst a callback is in progress
+    LdpDecodeInformation decodeInfo{};
+    EXPECT_EQ(pipeline->receiveOutputPicture(decodeInfo), nullptr);
+
+    // Other frames still finish, and none of them is delivered ahead of the held one
+    {
+        std::unique_lock lock(sink.mutex);
+        EXPECT_TRUE(sink.condVar.wait_for(lock, std::chrono::seconds(5),
+                                          [&sink] { return sink.done == kFrames; }));
+        EXPECT_EQ(sink.completed.size(), 1);
+    }
+
+    {
+        const std::scoped_lock lock(sink.mutex);
+        sink.released = true;
+        sink.condVar.notify_all();
+    }
+
+    pipeline->flush(kFrames);
+    pipeline->synchronize(false);
+
+    // Later frames wait for the held callback, so order is kept
+    {
+        const std::scoped_lock lock(sink.mutex);
+        EXPECT_TRUE(sink.releasedInTime);
+        ASSERT_EQ(sink.completed.size(), kFrames);
+        for (uint64_t idx = 0; idx < kFrames; ++idx) {
+            EXPECT_EQ(sink.completed[idx].first, outputPictures[idx]);
+            EXPECT_EQ(sink.completed[idx].second, idx + 1);
+        }
+    }
+
+    EXPECT_EQ(pipeline->receiveOutputPicture(decodeInfo), nullptr);
+    for (LdpPicture* picture : outputPictures) {
+        pipeline->freePicture(picture);
+    }
+    while (LdpPicture* basePicture = pipeline->receiveFinishedBasePicture()) {
+        pipeline->freePicture(basePicture);
+    }
+}
+
+// Decoding real enhancement data
+//
+// The H.265 test stream has a temporal refresh on its first frame only, and residuals build up in
+// the temporal buffer after it. A stream with several refreshes is made by repeating GOPs of
+// different lengths from the start of the stream, over a synthetic base.
+
+// The stream is 176x144, with 1D scaling from the base
+constexpr uint32_t kBaseWidth = 88;
+constexpr uint32_t kBaseHeight = 144;
+constexpr uint32_t kOutputWidth = 176;
+constexpr uint32_t kOutputHeight = 144;
+
+constexpr uint32_t kGopLengths[] = {7, 12, 5, 16, 9, 11};
+constexpr size_t kWindowSize = 16;
+constexpr int32_t kTemporalBuffers = 3;
+
+constexpr uint8_t kNalTypeAccessUnitDelimiter = 35;
+constexpr uint32_t kMaxEnhancementSize = 65536;
+
+// Extract the enhancement data of each access unit in an Annex B H.265 stream
+std::vector<std::vector<uint8_t>> readEnhancementH265(const filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<uint8_t> stream{std::istreambuf_iterator<char>(file),
+                                      std::istreambuf_iterator<char>()};
+
+    // Access units start at each delimiter, including any leading zero of the start code
+    std::vector<size_t> accessUnits;
+    for (size_t pos = 0; pos + 3 < stream.size(); ++pos) {
+        if (stream[pos] == 0 && stream[pos + 1] == 0 && stream[pos + 2] == 1 &&
+            ((stream[pos + 3] >> 1) & 0x3f) == kNalTypeAccessUnitDelimiter) {
+            accessUnits.push_back((pos > 0 && stream[pos - 1] == 0) ? pos - 1 : pos);
+        }
+    }
+    accessUnits.push_back(stream.size());
+
+    std::vector<std::vector<uint8_t>> enhancement;
+    for (size_t idx = 0; idx + 1 < accessUnits.size(); ++idx) {
+        std::vector<uint8_t> data(kMaxEnhancementSize);
+        uint32_t size = 0;
+        const size_t accessUnitSize{accessUnits[idx + 1] - accessUnits[idx]};
+        if (LCEVC_extractEnhancementFromNAL(stream.data() + accessUnits[idx],
+                                            static_cast<uint32_t>(accessUnitSize),
+                                            LCEVC_NALFormat_AnnexB, LCEVC_CodecType_H265,
+                                            data.data(), kMaxEnhancementSize, &size) == 1) {
+            data.resize(size);
+            enhancement.push_back(std::move(data));
+        }
+    }
+    return enhancement;
+}
+
+// Fill the planes of an I420 picture with a pattern that changes with each frame
+void fillPicture(LdpPicture* picture, uint32_t width, uint32_t height, uint64_t frame)
+{
+    LdpPictureLock* lock{};
+    ASSERT_TRUE(ldpPictureLock(picture, LdpAccessWrite, &lock));
+    for (uint32_t plane = 0; plane < 3; ++plane) {
+        LdpPicturePlaneDesc planeDesc{};
+        ASSERT_TRUE(ldpPictureLockGetPlaneDesc(lock, plane, &planeDesc));
+        const uint32_t planeWidth = plane ? width / 2 : width;
+        const uint32_t planeHeight = plane ? height / 2 : height;
+        for (uint32_t y = 0; y < planeHeight; ++y) {
+            uint8_t* row = planeDesc.firstSample + static_cast<size_t>(y) * planeDesc.rowByteStride;
+            for (uint32_t x = 0; x < planeWidth; ++x) {
+                row[x] = static_cast<uint8_t>(x * 7 + y * 3 + plane * 50 + frame * 13);
+            }
+        }
+    }
+    ldpPictureUnlock(picture, lock);
+}
+
+// Copy out the planes of an I420 picture
+std::vector<uint8_t> readPicture(LdpPicture* picture, uint32_t width, uint32_t height)
+{
+    std::vector<uint8_t> samples;
+    LdpPictureLock* lock{};
+    if (!ldpPictureLock(picture, LdpAccessRead, &lock)) {
+        return samples;
+    }
+    for (uint32_t plane = 0; plane < 3; ++plane) {
+        LdpPicturePlaneDesc planeDesc{};
+        ldpPictureLockGetPlaneDesc(lock, plane, &planeDesc);
+        const uint32_t planeWidth = plane ? width / 2 : width;
+        const uint32_t planeHeight = plane ? height / 2 : height;
+        for (uint32_t y = 0; y < planeHeight; ++y) {
+            const uint8_t* row =
+                planeDesc.firstSample + static_cast<size_t>(y) * planeDesc.rowByteStride;
+            samples.insert(samples.end(), row, row + planeWidth);
+        }
+    }
+    ldpPictureUnlock(picture, lock);
+    return samples;
+}
+
+struct DecodedFrame
+{
+    uint64_t timestamp;
+    bool enhanced;
+    uint8_t degradation;
+    std::vector<uint8_t> samples;
+};
+
+// Wait for the next output picture, and keep a copy of it
+bool receiveFrame(Pipeline& pipeline, std::vector<DecodedFrame>& decoded)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    LdpDecodeInformation decodeInfo{};
+    LdpPicture* picture{};
+    while (!(picture = pipeline.receiveOutputPicture(decodeInfo))) {
+        if (std::chrono::steady_clock::now() > timeout) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+
+    decoded.push_back({decodeInfo.timestamp, decodeInfo.enhanced, decodeInfo.degradation,
+                       readPicture(picture, kOutputWidth, kOutputHeight)});
+    pipeline.freePicture(picture);
+
+    while (LdpPicture* basePicture = pipeline.receiveFinishedBasePicture()) {
+        pipeline.freePicture(basePicture);
+    }
+    return true;
+}
+
+// Index into the enhancement of each frame of a sequence of GOPs
+template <size_t N>
+std::vector<uint32_t> gopFrames(const uint32_t (&gopLengths)[N])
+{
+    std::vector<uint32_t> frames;
+    for (const uint32_t gopLength : gopLengths) {
+        for (uint32_t idx = 0; idx < gopLength; ++idx) {
+            frames.push_back(idx);
+        }
+    }
+    return frames;
+}
+
+// Send the GOPs a window of frames at a time, and collect the output pictures in order.
+//
+// Within a window, the bases are sent last frame first. Sending a base starts every earlier frame,
+// so each GOP is still waiting for its bases when the refresh at the start of the next GOP begins.
+void decodeGops(Pipeline& pipeline, const std::vector<std::vector<uint8_t>>& enhancement,
+                uint64_t firstTimestamp, std::vector<DecodedFrame>& decoded)
+{
+    const LdpPictureDesc baseDesc{kBaseWidth, kBaseHeight, LdpColorFormatI420_8};
+    const LdpPictureDesc outputDesc{kOutputWidth, kOutputHeight, LdpColorFormatI420_8};
+
+    const std::vector<uint32_t> frames{gopFrames(kGopLengths)};
+
+    for (size_t windowStart = 0; windowStart < frames.size(); windowStart += kWindowSize) {
+        const size_t windowEnd = std::min(windowStart + kWindowSize, frames.size());
+
+        for (size_t frame = windowStart; frame < windowEnd; ++frame) {
+            const std::vector<uint8_t>& data{enhancement[frames[frame]]};
+            ASSERT_EQ(pipeline.sendEnhancementData(firstTimestamp + frame, data.data(),
+                                                   static_cast<uint32_t>(data.size())),
+                      LdcReturnCodeSuccess);
+        }
+
+        for (size_t frame = windowEnd; frame-- > windowStart;) {
+            LdpPicture* basePicture = pipeline.allocPictureManaged(baseDesc);
+            ASSERT_TRUE(basePicture);
+            fillPicture(basePicture, kBaseWidth, kBaseHeight, frame);
+            ASSERT_EQ(
+                pipeline.sendBasePicture(firstTimestamp + frame, basePicture, 1000000, nullptr),
+                LdcReturnCodeSuccess);
+        }
+
+        for (size_t frame = windowStart; frame < windowEnd; ++frame) {
+            ASSERT_EQ(pipeline.sendOutputPicture(pipeline.allocPictureManaged(outputDesc)),
+                      LdcReturnCodeSuccess);
+        }
+        for (size_t frame = windowStart; frame < windowEnd; ++frame) {
+            ASSERT_TRUE(receiveFrame(pipeline, decoded));
+        }
+    }
+}
+
+// Decode the GOPs twice in one pipeline, noting the memory in use after each pass
+struct GopDecode
+{
+    std::vector<DecodedFrame> decoded[2];
+    uint64_t framesMemory[2];
+    uint64_t temporalMemory[2];
+};
+
+void decodeGopsTwice(bool gopParallelDecode, const std::vector<std::vector<uint8_t>>& enhancement,
+                     GopDecode& result)
+{
+    auto pipelineBuilder =
+        CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(), (void*)ldcAccelerationGet());
+    ASSERT_TRUE(pipelineBuilder);
+    ASSERT_TRUE(pipelineBuilder->configure("threads", 4));
+    ASSERT_TRUE(pipelineBuilder->configure("temporal_buffers", kTemporalBuffers));
+    ASSERT_TRUE(pipelineBuilder->configure("gop_parallel_decode", gopParallelDecode));
+    ASSERT_TRUE(pipelineBuilder->configure("memory_usage", true));
+    // Dither noise depends on the timestamp, and the two passes use different timestamps
+    ASSERT_TRUE(pipelineBuilder->configure("allow_dithering", false));
+
+    auto pipeline = pipelineBuilder->finish(EventSink::nullSink());
+    ASSERT_TRUE(pipeline);
+
+    uint64_t firstTimestamp = 1;
+    for (uint32_t pass = 0; pass < 2; ++pass) {
+        ASSERT_NO_FATAL_FAILURE(
+            decodeGops(*pipeline, enhancement, firstTimestamp, result.decoded[pass]));
+        firstTimestamp += result.decoded[pass].size();
+
+        LdpMemoryUsage usage{};
+        ASSERT_EQ(pipeline->getMemoryUsage(usage), LdcReturnCodeSuccess);
+        result.framesMemory[pass] = usage.current[LdpMemoryCategoryFrames];
+        result.temporalMemory[pass] = usage.current[LdpMemoryCategoryTemporal];
+    }
+}
+
+TEST(PipelineCPU, GopParallelDecode)
+{
+    const std::vector<std::vector<uint8_t>> enhancement{
+        readEnhancementH265(kTestAssets / "test_176x144_lcevc_h265.h265")};
+    ASSERT_GE(enhancement.size(),
+              *std::max_element(std::begin(kGopLengths), std::end(kGopLengths)));
+
+    GopDecode sequential;
+    ASSERT_NO_FATAL_FAILURE(decodeGopsTwice(false, enhancement, sequential));
+    GopDecode parallel;
+    ASSERT_NO_FATAL_FAILURE(decodeGopsTwice(true, enhancement, parallel));
+
+    uint32_t frameCount = 0;
+    for (const uint32_t gopLength : kGopLengths) {
+        frameCount += gopLength;
+    }
+
+    for (uint32_t pass = 0; pass < 2; ++pass) {
+        ASSERT_EQ(sequential.decoded[pass].size(), frameCount);
+        ASSERT_EQ(parallel.decoded[pass].size(), frameCount);
+
+        // Same pictures in the same order
+        for (uint32_t idx = 0; idx < frameCount; ++idx) {
+            const DecodedFrame& expected{sequential.decoded[pass][idx]};
+            const DecodedFrame& actual{parallel.decoded[pass][idx]};
+            EXPECT_EQ(expected.timestamp, pass * frameCount + idx + 1);
+            EXPECT_EQ(actual.timestamp, expected.timestamp);
+            EXPECT_EQ(actual.enhanced, expected.enhanced);
+            EXPECT_EQ(actual.samples, expected.samples) << "pass " << pass << " frame " << idx;
+
+            // The second pass decodes the same pictures with the buffers left by the first
+            EXPECT_EQ(actual.samples, parallel.decoded[0][idx].samples) << "frame " << idx;
+        }
+    }
+
+    // The stream has residuals, so the temporal buffers were used
+    EXPECT_GT(std::count_if(parallel.decoded[0].begin(), parallel.decoded[0].end(),
+                            [](const DecodedFrame& frame) { return frame.enhanced; }),
+              0);
+
+    // Nothing is kept from one pass to the next, and the temporal buffers stay within the
+    // configured pool that the sequential decode allocates
+    EXPECT_EQ(parallel.framesMemory[1], parallel.framesMemory[0]);
+    EXPECT_EQ(parallel.temporalMemory[1], parallel.temporalMemory[0]);
+    EXPECT_GT(parallel.temporalMemory[0], 0U);
+    EXPECT_LE(parallel.temporalMemory[0], sequential.temporalMemory[0]);
+}
+
+// Decode the GOPs once in a new pipeline, with one boolean option set
+void decodeGopsWithOption(const char* name, bool value,
+                          const std::vector<std::vector<uint8_t>>& enhancement,
+                          std::vector<DecodedFrame>& decoded)
+{
+    auto pipelineBuilder =
+        CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(), (void*)ldcAccelerationGet());
+    ASSERT_TRUE(pipelineBuilder);
+    ASSERT_TRUE(pipelineBuilder->configure("threads", 4));
+    // Spare temporal buffers, for options that use them
+    ASSERT_TRUE(pipelineBuilder->configure("temporal_buffers", kTemporalBuffers));
+    ASSERT_TRUE(pipelineBuilder->configure("allow_dithering", false));
+    ASSERT_TRUE(pipelineBuilder->configure(name, value));
+
+    auto pipeline = pipelineBuilder->finish(EventSink::nullSink());
+    ASSERT_TRUE(pipeline);
+
+    ASSERT_NO_FATAL_FAILURE(decodeGops(*pipeline, enhancement, 1, decoded));
+}
+
+// Decode the GOPs with an option off and on, and check that the output is the same
+void expectOptionUnchangedOutput(const char* name)
+{
+    const std::vector<std::vector<uint8_t>> enhancement{
+        readEnhancementH265(kTestAssets / "test_176x144_lcevc_h265.h265")};
+    ASSERT_GE(enhancement.size(),
+              *std::max_element(std::begin(kGopLengths), std::end(kGopLengths)));
+
+    std::vector<DecodedFrame> off;
+    ASSERT_NO_FATAL_FAILURE(decodeGopsWithOption(name, false, enhancement, off));
+    std::vector<DecodedFrame> on;
+    ASSERT_NO_FATAL_FAILURE(decodeGopsWithOption(name, true, enhancement, on));
+
+    ASSERT_EQ(on.size(), off.size());
+    for (size_t idx = 0; idx < off.size(); ++idx) {
+        EXPECT_EQ(on[idx].timestamp, off[idx].timestamp);
+        EXPECT_EQ(on[idx].enhanced, off[idx].enhanced);
+        EXPECT_EQ(on[idx].samples, off[idx].samples) << name << " frame " << idx;
+    }
+}
+
+// The stream upscales with an interpolating kernel, which would round and clamp in 8-bit
+// intermediate planes, so reduced precision has to keep them at full precision
+TEST(PipelineCPU, ReducedPrecision) { expectOptionUnchangedOutput("reduced_precision"); }
+
+// Each frame's temporal residuals start from the copy handed on by the previous frame
+TEST(PipelineCPU, TemporalForward) { expectOptionUnchangedOutput("temporal_forward"); }
+
+// Two GOPs, with a deadline that cannot be met part way through the first
+constexpr uint32_t kDeadlineGopLengths[] = {10, 10};
+constexpr uint32_t kMissedDeadlineFrame = 4;
+
+// Send a frame and its pictures, and wait for it to be decoded - without enhancement data, the
+// base is passed through
+void decodeFrame(Pipeline& pipeline, const std::vector<uint8_t>& data, uint64_t frame,
+                 uint32_t timeout, std::vector<DecodedFrame>& decoded)
+{
+    const LdpPictureDesc baseDesc{kBaseWidth, kBaseHeight, LdpColorFormatI420_8};
+    const LdpPictureDesc outputDesc{kOutputWidth, kOutputHeight, LdpColorFormatI420_8};
+
+    if (!data.empty()) {
+        ASSERT_EQ(
+            pipeline.sendEnhancementData(frame, data.data(), static_cast<uint32_t>(data.size())),
+            LdcReturnCodeSuccess);
+    }
+    ASSERT_EQ(pipeline.sendOutputPicture(pipeline.allocPictureManaged(outputDesc)),
+              LdcReturnCodeSuccess);
+
+    LdpPicture* basePicture = pipeline.allocPictureManaged(baseDesc);
+    ASSERT_TRUE(basePicture);
+    fillPicture(basePicture, kBaseWidth, kBaseHeight, frame);
+    ASSERT_EQ(pipeline.sendBasePicture(frame, basePicture, timeout, nullptr),
+              LdcReturnCodeSuccess);
+
+    ASSERT_TRUE(receiveFrame(pipeline, decoded));
+}
+
+// Decode the GOPs a frame at a time, with the given decode timeout for each frame
+void decodeWithTimeouts(bool deadlinePolicy, const std::vector<std::vector<uint8_t>>& enhancement,
+                        const std::vector<uint32_t>& timeouts, std::vector<DecodedFrame>& decoded)
+{
+    auto pipelineBuilder =
+        CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(), (void*)ldcAccelerationGet());
+    ASSERT_TRUE(pipelineBuilder);
+    ASSERT_TRUE(pipelineBuilder->configure("deadline_policy", deadlinePolicy));
+    // Only skip LOQ0, so that the degradation does not depend on how long the base stage takes
+    ASSERT_TRUE(pipelineBuilder->configure(
+        "passthrough_mode", static_cast<int32_t>(PassthroughMode::Disable)));
+    ASSERT_TRUE(pipelineBuilder->configure("allow_dithering", false));
+
+    auto pipeline = pipelineBuilder->finish(EventSink::nullSink());
+    ASSERT_TRUE(pipeline);
+
+    const std::vector<uint32_t> frames{gopFrames(kDeadlineGopLengths)};
+    ASSERT_EQ(timeouts.size(), frames.size());
+
+    for (size_t frame = 0; frame < frames.size(); ++frame) {
+        ASSERT_NO_FATAL_FAILURE(
+            decodeFrame(*pipeline, enhancement[frames[frame]], frame, timeouts[frame], decoded));
+    }
+}
+
+TEST(PipelineCPU, DeadlineDegradation)
+{
+    const std::vector<std::vector<uint8_t>> enhancement{
+        readEnhancementH265(kTestAssets / "test_176x144_lcevc_h265.h265")};
+    ASSERT_GE(enhancement.size(), kDeadlineGopLengths[0]);
+
+    const uint32_t frameCount{kDeadlineGopLengths[0] + kDeadlineGopLengths[1]};
+    const std::vector<uint32_t> noDeadline(frameCount, UINT32_MAX);
+    std::vector<uint32_t> missedDeadline{noDeadline};
+    missedDeadline[kMissedDeadlineFrame] = 1;
+
+    std::vector<DecodedFrame> reference;
+    ASSERT_NO_FATAL_FAILURE(decodeWithTimeouts(false, enhancement, noDeadline, reference));
+    std::vector<DecodedFrame> undegraded;
+    ASSERT_NO_FATAL_FAILURE(decodeWithTimeouts(true, enhancement, noDeadline, undegraded));
+    std::vector<DecodedFrame> degraded;
+    ASSERT_NO_FATAL_FAILURE(decodeWithTimeouts(true, enhancement, missedDeadline, degraded));
+
+    ASSERT_EQ(reference.size(), frameCount);
+    ASSERT_EQ(undegraded.size(), frameCount);
+    ASSERT_EQ(degraded.size(), frameCount);
+
+    // Without deadlines, the policy changes nothing
+    for (uint32_t idx = 0; idx < frameCount; ++idx) {
+        EXPECT_EQ(undegraded[idx].timestamp, reference[idx].timestamp);
+        EXPECT_EQ(undegraded[idx].degradation, LdpDegradationNone) << "frame " << idx;
+        EXPECT_EQ(undegraded[idx].samples, reference[idx].samples) << "frame " << idx;
+    }
+
+    // The frame that cannot meet its deadline skips LOQ0 and the temporal buffer, and so does
+    // the rest of its GOP. The refresh that starts the next GOP restores the full decode.
+    for (uint32_t idx = 0; idx < frameCount; ++idx) {
+        const bool skipped{idx >= kMissedDeadlineFrame && idx < kDeadlineGopLengths[0]};
+        EXPECT_EQ(degraded[idx].timestamp, reference[idx].timestamp);
+        if (skipped) {
+            EXPECT_EQ(degraded[idx].degradation,
+                      LdpDegradationSkipLOQ0 | LdpDegradationSkipTemporal)
+                << "frame " << idx;
+            EXPECT_FALSE(degraded[idx].enhanced) << "frame " << idx;
+        } else {
+            EXPECT_EQ(degraded[idx].degradation, LdpDegradationNone) << "frame " << idx;
+            EXPECT_EQ(degraded[idx].enhanced, reference[idx].enhanced) << "frame " << idx;
+            EXPECT_EQ(degraded[idx].samples, reference[idx].samples) << "frame " << idx;
+        }
+    }
+}
+
+// Memory use goes over budget part way through the first GOP, and comes back before its end
+constexpr uint32_t kOverBudgetFrame = 3;
+constexpr uint32_t kUnderBudgetFrame = 6;
+
+TEST(PipelineCPU, MemoryBudgetDegradation)
+{
+    const std::vector<std::vector<uint8_t>> enhancement{
+        readEnhancementH265(kTestAssets / "test_176x144_lcevc_h265.h265")};
+    ASSERT_GE(enhancement.size(), kDeadlineGopLengths[0]);
+
+    const uint32_t frameCount{kDeadlineGopLengths[0] + kDeadlineGopLengths[1]};
+    std::vector<DecodedFrame> reference;
+    ASSERT_NO_FATAL_FAILURE(decodeWithTimeouts(
+        false, enhancement, std::vector<uint32_t>(frameCount, UINT32_MAX), reference));
+    ASSERT_EQ(reference.size(), frameCount);
+
+    auto pipelineBuilder =
+        CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(), (void*)ldcAccelerationGet());
+    ASSERT_TRUE(pipelineBuilder);
+    ASSERT_TRUE(pipelineBuilder->configure("memory_budget_mb", 8));
+    ASSERT_TRUE(pipelineBuilder->configure("allow_dithering", false));
+    auto pipeline = pipelineBuilder->finish(EventSink::nullSink());
+    ASSERT_TRUE(pipeline);
+
+    // A picture bigger than the whole budget holds memory over it
+    const LdpPictureDesc largeDesc{3840, 2160, LdpColorFormatI420_8};
+    LdpPicture* largePicture{};
+
+    const std::vector<uint32_t> frames{gopFrames(kDeadlineGopLengths)};
+    std::vector<DecodedFrame> decoded;
+    for (uint32_t frame = 0; frame < frameCount; ++frame) {
+        if (frame == kOverBudgetFrame) {
+            largePicture = pipeline->allocPictureManaged(largeDesc);
+            ASSERT_TRUE(largePicture);
+        } else if (frame == kUnderBudgetFrame) {
+            pipeline->freePicture(largePicture);
+        }
+        ASSERT_NO_FATAL_FAILURE(
+            decodeFrame(*pipeline, enhancement[frames[frame]], frame, UINT32_MAX, decoded));
+    }
+    ASSERT_EQ(decoded.size(), frameCount);
+
+    // Frames over budget are only upscaled. Once back under budget, the rest of the GOP still
+    // goes without the temporal buffer, and the refresh that starts the next GOP restores the full
+    // decode.
+    for (uint32_t idx = 0; idx < frameCount; ++idx) {
+        EXPECT_EQ(decoded[idx].timestamp, reference[idx].timestamp);
+        if (idx >= kOverBudgetFrame && idx < kUnderBudgetFrame) {
+            EXPECT_EQ(decoded[idx].degradation,
+                      LdpDegradationSkipLOQ0 | LdpDegradationSkipTemporal |
+                          LdpDegradationScaledPassthrough)
+                << "frame " << idx;
+        } else if (idx >= kUnderBudgetFrame && idx < kDeadlineGopLengths[0]) {
+            EXPECT_EQ(decoded[idx].degradation,
+                      LdpDegradationSkipLOQ0 | LdpDegradationSkipTemporal)
+                << "frame " << idx;
+        } else {
+            EXPECT_EQ(decoded[idx].degradation, LdpDegradationNone) << "frame " << idx;
+            EXPECT_EQ(decoded[idx].samples, reference[idx].samples) << "frame " << idx;
+        }
+    }
+}
+
+// Task graph templates
+//
+// Frames with each kind of task graph are mixed through the GOPs, so that recorded graphs are
+// matched against frames that differ in each field of the key that the stream can vary.
+
+// Frames decoded from the base alone, one mid GOP and one starting a GOP
+constexpr uint32_t kBaseOnlyFrames[] = {3, 19};
+// Frames over the memory budget, which also skip the temporal buffer until the next refresh
+constexpr uint32_t kOverBudgetFrames[] = {26, 30};
+
+void decodeGopsVaried(bool taskGraphTemplates, const std::vector<std::vector<uint8_t>>& enhancement,
+                      std::vector<DecodedFrame>& decoded)
+{
+    auto pipelineBuilder =
+        CREATE_PIPELINE_CPU_BUILDER_NAME(ldcDiagnosticsStateGet(), (void*)ldcAccelerationGet());
+    ASSERT_TRUE(pipelineBuilder);
+    ASSERT_TRUE(pipelineBuilder->configure("task_graph_templates", taskGraphTemplates));
+    ASSERT_TRUE(pipelineBuilder->configure("memory_budget_mb", 8));
+    ASSERT_TRUE(pipelineBuilder->configure("allow_dithering", false));
+    auto pipeline = pipelineBuilder->finish(EventSink::nullSink());
+    ASSERT_TRUE(pipeline);
+
+    const LdpPictureDesc largeDesc{3840, 2160, LdpColorFormatI420_8};
+    LdpPicture* largePicture{};
+
+    const std::vector<uint32_t> frames{gopFrames(kGopLengths)};
+    const std::vector<uint8_t> baseOnly;
+    for (uint32_t frame = 0; frame < frames.size(); ++frame) {
+        if (frame == kOverBudgetFrames[0]) {
+            largePicture = pipeline->allocPictureManaged(largeDesc);
+            ASSERT_TRUE(largePicture);
+        } else if (frame == kOverBudgetFrames[1]) {
+            pipeline->freePicture(largePicture);
+        }
+        const bool isBaseOnly = std::find(std::begin(kBaseOnlyFrames), std::end(kBaseOnlyFrames),
+                                          frame) != std::end(kBaseOnlyFrames);
+        ASSERT_NO_FATAL_FAILURE(decodeFrame(*pipeline,
+                                            isBaseOnly ? baseOnly : enhancement[frames[frame]],
+                                            frame, UINT32_MAX, decoded));
+    }
+}
+
+TEST(PipelineCPU, TaskGraphTemplates)
+{
+    const std::vector<std::vector<uint8_t>> enhancement{
+        readEnhancementH265(kTestAssets / "test_176x144_lcevc_h265.h265")};
+    ASSERT_GE(enhancement.size(),
+              *std::max_element(std::begin(kGopLengths), std::end(kGopLengths)));
+
+    std::vector<DecodedFrame> generated;
+    ASSERT_NO_FATAL_FAILURE(decodeGopsVaried(false, enhancement, generated));
+    std::vector<DecodedFrame> recorded;
+    ASSERT_NO_FATAL_FAILURE(decodeGopsVaried(true, enhancement, recorded));
+
+    ASSERT_EQ(recorded.size(), generated.size());
+    for (size_t idx = 0; idx < generated.size(); ++idx) {
+        EXPECT_EQ(recorded[idx].timestamp, generated[idx].timestamp);
+        EXPECT_EQ(recorded[idx].enhanced, generated[idx].enhanced) << "frame " << idx;
+        EXPECT_EQ(recorded[idx].degradation, generated[idx].degradation) << "frame " << idx;
+        EXPECT_EQ(recorded[idx].samples, generated[idx].samples) << "frame " << idx;
+    }
+
+    // Each kind of graph was decoded: with and without residuals from the stream, passed through,
+    // and degraded with and without the temporal buffer
+    EXPECT_GT(std::count_if(generated.begin(), generated.end(),
+                            [](const DecodedFrame& frame) { return frame.enhanced; }),
+              0);
+    EXPECT_GT(std::count_if(generated.begin(), generated.end(),
+                            [](const DecodedFrame& frame) {
+                                return !frame.enhanced && frame.degradation == LdpDegradationNone;
+                            }),
+              std::size(kBaseOnlyFrames));
+    for (const uint32_t frame : kBaseOnlyFrames) {
+        EXPECT_FALSE(generated[frame].enhanced) << "frame " << frame;
+    }
+    EXPECT_EQ(generated[kOverBudgetFrames[0]].degradation,
+              LdpDegradationSkipLOQ0 | LdpDegradationSkipTemporal |
+                  LdpDegradationScaledPassthrough);
+    EXPECT_EQ(generated[kOverBudgetFrames[1]].degradation,
+              LdpDegradationSkipLOQ0 | LdpDegradationSkipTemporal);
+}
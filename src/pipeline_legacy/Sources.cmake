@@ -23,7 +23,8 @@ list(
     "src/lcevc_processor.cpp"
     "src/picture_copy.cpp"
     "src/picture.cpp"
-    "src/picture_lock.cpp")
+    "src/picture_lock.cpp"
+    "src/task_pool_executor.cpp")
 
 list(
     APPEND
@@ -38,7 +39,8 @@ list(
     "src/lcevc_processor.h"
     "src/picture_copy.h"
     "src/picture.h"
-    "src/picture_lock.h")
+    "src/picture_lock.h"
+    "src/task_pool_executor.h")
 
 list(APPEND INTERFACES "include/LCEVC/pipeline_legacy/create_pipeline.h")
 
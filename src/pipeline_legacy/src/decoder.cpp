@@ -37,8 +37,10 @@ namespace lcevc_dec::decoder {
 
 // - Decoder --------------------------------------------------------------------------------------
 
-Decoder::Decoder(const DecoderConfig& config, pipeline::EventSink* eventSink)
-    : m_lcevcProcessor(m_coreDecoder, m_bufferManager)
+Decoder::Decoder(const DecoderConfig& config, pipeline::EventSink* eventSink,
+                 LdcTaskPool* taskPool)
+    : m_sharedTaskPool(taskPool)
+    , m_lcevcProcessor(m_coreDecoder, m_bufferManager)
     , m_config(config)
     , m_eventSink(eventSink)
 {}
@@ -88,7 +90,15 @@ bool Decoder::initializeCoreDecoder()
 {
     perseus_decoder_config coreCfg = {};
     m_config.initialiseCoreConfig(coreCfg);
+    // A shared pool is always used when there is one
+    if (m_sharedTaskPool || m_config.getUseTaskPool()) {
+        if (!m_coreTaskPool.initialize(m_sharedTaskPool, m_config.getCoreDecoderNumThreads())) {
+            return false;
+        }
+        m_coreTaskPool.setCoreConfig(coreCfg);
+    }
     if (perseus_decoder_open(&m_coreDecoder, &coreCfg) != 0) {
+        m_coreTaskPool.release();
         return false;
     }
     perseus_decoder_debug(m_coreDecoder,
@@ -116,6 +126,7 @@ void Decoder::releaseCoreDecoder()
 {
     perseus_decoder_close(m_coreDecoder);
     m_coreDecoder = nullptr;
+    m_coreTaskPool.release();
 }
 
 void Decoder::releaseLcevcProcessor() { m_lcevcProcessor.release(); }
@@ -27,6 +27,7 @@
 #include "decoder_config.h"
 #include "lcevc_processor.h"
 #include "picture_lock.h"
+#include "task_pool_executor.h"
 //
 #include <cassert>
 #include <cstdint>
@@ -90,7 +91,8 @@ class Decoder : public pipeline::Pipeline
     using Clock = utility::ScopedTimer<utility::MicroSecond>;
 
 public:
-    Decoder(const DecoderConfig& config, pipeline::EventSink* eventSink);
+    Decoder(const DecoderConfig& config, pipeline::EventSink* eventSink,
+            LdcTaskPool* taskPool = nullptr);
     ~Decoder();
 
     // Send/receive
@@ -188,6 +190,8 @@ private:
 
     // Decoder & decoding tools (Crucially, m_bufferManager comes before m_picturePool, because it
     // must be created before, and destroyed after, m_picturePool).
+    TaskPoolExecutor m_coreTaskPool; // Optionally runs the Core decoder's jobs
+    LdcTaskPool* m_sharedTaskPool = nullptr; // External pool for m_coreTaskPool, if any
     perseus_decoder m_coreDecoder = nullptr;
     Clock m_clock;
 
@@ -77,12 +77,18 @@ bool DecoderBuilder::configure(std::string_view name, const std::vector<std::str
 //
 std::unique_ptr<pipeline::Pipeline> DecoderBuilder::finish(pipeline::EventSink* eventSink) const
 {
-    auto decoder = std::make_unique<Decoder>(m_config, eventSink);
+    auto decoder = std::make_unique<Decoder>(m_config, eventSink, m_taskPool);
 
     decoder->initialize();
     return decoder;
 }
 
+bool DecoderBuilder::setTaskPool(LdcTaskPool* taskPool)
+{
+    m_taskPool = taskPool;
+    return true;
+}
+
 } // namespace lcevc_dec::decoder
 
 // Factory function - extern "C" so it can be grabbed from DLLs
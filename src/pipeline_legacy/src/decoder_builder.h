@@ -48,6 +48,7 @@ public:
 
     //
     std::unique_ptr<pipeline::Pipeline> finish(pipeline::EventSink* eventSink) const override;
+    bool setTaskPool(LdcTaskPool* taskPool) override;
 
     DecoderBuilder();
 
@@ -55,6 +56,7 @@ private:
     friend std::unique_ptr<pipeline::PipelineBuilder> createPipelineBuilder();
 
     DecoderConfig m_config;
+    LdcTaskPool* m_taskPool = nullptr;
 };
 
 } // namespace lcevc_dec::decoder
@@ -17,6 +17,7 @@
 #include <LCEVC/common/acceleration.h>
 #include <LCEVC/common/diagnostics.h>
 #include <LCEVC/common/printf_macros.h>
+#include <LCEVC/common/threads.h>
 #include <LCEVC/legacy/PerseusDecoder.h>
 #include <LCEVC/pipeline/event_sink.h>
 //
@@ -65,6 +66,7 @@ const ConfigMap<DecoderConfig> DecoderConfig::kConfigMap({
     {"pss_surface_fp_setting", makeBinding(&DecoderConfig::m_residualSurfaceFPSetting)},
     {"results_queue_cap", makeBinding(&DecoderConfig::m_resultsQueueCap)},
     {"s_filter_strength", makeBinding(&DecoderConfig::m_sFilterStrength)},
+    {"use_task_pool", makeBinding(&DecoderConfig::m_useTaskPool)},
     {"events", makeBinding(&DecoderConfig::m_events)},
 });
 
@@ -151,16 +153,27 @@ bool DecoderConfig::validate() const
                 "\tpassthrough_mode          : %d\n"
                 "\tpredicted_average_method  : %d\n"
                 "\tpss_surface_fp_setting    : %d\n"
-                "\tresults_queue_cap         : %d\n",
+                "\tresults_queue_cap         : %d\n"
+                "\tuse_task_pool             : %d\n",
                 m_allowDithering, m_coreParallelDecode, m_enableLogoOverlay, m_generateCmdbuffers,
                 m_highlightResiduals, m_highPrecision, m_sFilterStrength, m_coreDecoderNumThreads,
                 m_ditherSeed, m_ditherStrength, m_forceBitstreamVersion, m_logoOverlayDelayFrames,
                 m_logoOverlayPositionX, m_logoOverlayPositionY, m_loqUnprocessedCap, m_passthroughMode,
-                m_predictedAverageMethod, m_residualSurfaceFPSetting, m_resultsQueueCap);
+                m_predictedAverageMethod, m_residualSurfaceFPSetting, m_resultsQueueCap,
+                m_useTaskPool);
 
     return valid;
 }
 
+uint32_t DecoderConfig::getCoreDecoderNumThreads() const
+{
+    if (m_coreDecoderNumThreads > 0) {
+        return static_cast<uint32_t>(m_coreDecoderNumThreads);
+    }
+    const int32_t numCores = threadNumCores();
+    return (numCores > 0) ? static_cast<uint32_t>(numCores) : 1;
+}
+
 void DecoderConfig::initialiseCoreConfig(perseus_decoder_config& cfgOut) const
 {
     perseus_decoder_config_init(&cfgOut);
@@ -51,6 +51,8 @@ public:
         return static_cast<PassthroughPolicy>(m_passthroughMode);
     }
     int32_t getResidualSurfaceFPSetting() const { return m_residualSurfaceFPSetting; }
+    bool getUseTaskPool() const { return m_useTaskPool; }
+    uint32_t getCoreDecoderNumThreads() const;
 
     // Turn off clang-format to keep these boilerplate functions on one line each.
     // clang-format off
@@ -73,6 +75,7 @@ private:
     bool m_generateCmdbuffers = true;
     bool m_highlightResiduals = false;
     bool m_highPrecision = true;
+    bool m_useTaskPool = false;
 
     float m_sFilterStrength = -1.0f;
 
@@ -0,0 +1,125 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#define VNComponentCurrent LdcComponentDecoder
+
+#include "task_pool_executor.h"
+//
+#include <LCEVC/common/log.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/common/platform.h>
+//
+#include <atomic>
+
+// ------------------------------------------------------------------------------------------------
+
+namespace lcevc_dec::decoder {
+
+namespace {
+    // Core decoder calls made from inside a job are nested - they run on the calling thread, as
+    // waiting in a pool thread for more pool work could leave no thread free to do that work.
+    VNThreadLocal() bool tlInJob = false;
+
+    constexpr uint32_t kReservedTasks = 16;
+
+    struct JobBatch
+    {
+        perseus_job_function job;
+        void* context;
+        std::atomic<bool>* failed;
+    };
+
+    bool runJobs(void* argument, uint32_t offset, uint32_t count)
+    {
+        const JobBatch* batch = static_cast<const JobBatch*>(argument);
+        const bool wasInJob = tlInJob;
+        tlInJob = true;
+
+        for (uint32_t index = offset; index < offset + count; ++index) {
+            if (batch->job(batch->context, index) != 0) {
+                batch->failed->store(true, std::memory_order_relaxed);
+            }
+        }
+
+        tlInJob = wasInJob;
+        return true;
+    }
+} // namespace
+
+// - TaskPoolExecutor -----------------------------------------------------------------------------
+
+bool TaskPoolExecutor::initialize(LdcTaskPool* sharedPool, uint32_t numThreads)
+{
+    release();
+
+    m_numThreads = (numThreads > 0) ? numThreads : 1;
+    if (sharedPool) {
+        m_taskPool = sharedPool;
+        m_initialized = true;
+        return true;
+    }
+
+    // Pool threads is 1 less than total threads - the thread waiting on the pool is the other one
+    LdcMemoryAllocator* const allocator = ldcMemoryAllocatorMalloc();
+    if (!ldcTaskPoolInitialize(&m_privateTaskPool, allocator, allocator, m_numThreads - 1,
+                               kReservedTasks)) {
+        VNLogError("Failed to initialize task pool for Core decoder");
+        return false;
+    }
+
+    m_taskPool = &m_privateTaskPool;
+    m_initialized = true;
+    return true;
+}
+
+void TaskPoolExecutor::release()
+{
+    if (m_initialized) {
+        if (m_taskPool == &m_privateTaskPool) {
+            ldcTaskPoolDestroy(&m_privateTaskPool);
+        }
+        m_taskPool = nullptr;
+        m_initialized = false;
+    }
+}
+
+void TaskPoolExecutor::setCoreConfig(perseus_decoder_config& cfg)
+{
+    cfg.num_worker_threads = static_cast<int>(m_numThreads);
+    cfg.job_executor = &TaskPoolExecutor::execute;
+    cfg.job_executor_userdata = this;
+}
+
+int TaskPoolExecutor::execute(void* userData, perseus_job_function job, void* context,
+                              uint32_t count)
+{
+    auto* executor = static_cast<TaskPoolExecutor*>(userData);
+    std::atomic<bool> failed{false};
+    JobBatch batch{job, context, &failed};
+
+    if (tlInJob || count <= 1) {
+        runJobs(&batch, 0, count);
+    } else {
+        // Parts can be as small as a single job, so that jobs spread over every free thread
+        const LdcTaskSliceHints hints = {1, 0, nullptr};
+        if (!ldcTaskPoolAddSlicedDeferred(executor->m_taskPool, nullptr, &runJobs, nullptr,
+                                          &batch, sizeof(batch), count, &hints)) {
+            return -1;
+        }
+    }
+
+    return failed.load(std::memory_order_relaxed) ? -1 : 0;
+}
+
+} // namespace lcevc_dec::decoder
@@ -0,0 +1,62 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Runs the parallel work of the Core decoder on an LdcTaskPool, rather than on the worker threads
+// that the Core decoder would otherwise create for itself.
+//
+#ifndef VN_LCEVC_PIPELINE_LEGACY_TASK_POOL_EXECUTOR_H
+#define VN_LCEVC_PIPELINE_LEGACY_TASK_POOL_EXECUTOR_H
+
+#include <LCEVC/common/class_utils.hpp>
+#include <LCEVC/common/task_pool.h>
+#include <LCEVC/legacy/PerseusDecoder.h>
+//
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------------------
+
+namespace lcevc_dec::decoder {
+
+class TaskPoolExecutor
+{
+public:
+    TaskPoolExecutor() = default;
+    ~TaskPoolExecutor() { release(); }
+
+    VNNoCopyNoMove(TaskPoolExecutor);
+
+    //! Run on an externally owned pool, which must outlive the executor, or if that is null,
+    //! start a private pool. Either way, the work is split for a total of numThreads threads,
+    //! including the thread that waits on the pool.
+    //!
+    bool initialize(LdcTaskPool* sharedPool, uint32_t numThreads);
+    void release();
+
+    //! Point the Core decoder configuration at this executor. The Core decoder splits its work
+    //! into as many jobs as there are threads.
+    //!
+    void setCoreConfig(perseus_decoder_config& cfg);
+
+private:
+    static int execute(void* userData, perseus_job_function job, void* context, uint32_t count);
+
+    LdcTaskPool* m_taskPool = nullptr;
+    LdcTaskPool m_privateTaskPool = {};
+    uint32_t m_numThreads = 0;
+    bool m_initialized = false;
+};
+
+} // namespace lcevc_dec::decoder
+
+#endif // VN_LCEVC_PIPELINE_LEGACY_TASK_POOL_EXECUTOR_H
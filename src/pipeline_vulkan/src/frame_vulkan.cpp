@@ -72,7 +72,7 @@ bool FrameVulkan::initialize()
         }
     }
 
-    return ldppDitherFrameInitialise(&m_frameDither, m_pipeline->globalDitherBuffer(), timestamp, strength);
+    return ldppDitherFrameInitialise(&m_frameDither, m_pipeline->globalDither(), timestamp, strength);
 }
 
 // Generate task graph
@@ -110,9 +110,11 @@ void FrameVulkan::release()
     ldcTaskGroupWait(&m_taskGroup);
     ldcTaskGroupDestroy(&m_taskGroup);
 
-    VNFree(m_pipeline->allocator(), &m_enhancementData);
+    // Release config first - chunks point into the enhancement data
+    ldeConfigPoolFrameRelease(m_pipeline->configPool(), &config, globalConfig);
+    globalConfig = nullptr;
 
-    ldeConfigsReleaseFrame(&config);
+    VNFree(m_pipeline->allocator(), &m_enhancementData);
 
     releaseCommandBuffers();
     releaseIntermediateBuffers();
@@ -1412,7 +1412,7 @@ PipelineVulkan::PipelineVulkan(const PipelineBuilderVulkan& builder, pipeline::E
 
 {
     // Set up dithering
-    ldppDitherGlobalInitialize(m_allocator, &m_dither, m_configuration.ditherSeed);
+    ldppDitherGlobalInitialize(&m_dither, m_configuration.ditherSeed);
 
     // Set up an allocator for per frame data
     ldcRollingArenaInitialize(&m_rollingArena, m_allocator, m_configuration.initialArenaCount,
@@ -1473,8 +1473,6 @@ PipelineVulkan::~PipelineVulkan()
             VNFree(m_allocator, &tb->allocation);
         }
     }
-    // Release dither
-    ldppDitherGlobalRelease(&m_dither);
 
     ldeConfigPoolRelease(&m_configPool);
 
@@ -2013,12 +2011,13 @@ void PipelineVulkan::startReadyFrames()
         }
 
         if (!frame->m_passthrough) {
-            // Parse the LCEVC configuration into distinct per-frame data
+            // Parse the LCEVC configuration into distinct per-frame data. The frame owns its copy
+            // of the enhancement data until release, so it is unescaped and parsed in place.
             // Switch to pass-through if configuration parse failed.
-            goodConfig = ldeConfigPoolFrameInsert(&m_configPool, timestamp,
-                                                  VNAllocationPtr(frame->m_enhancementData, uint8_t),
-                                                  VNAllocationSize(frame->m_enhancementData, uint8_t),
-                                                  &frame->globalConfig, &frame->config);
+            goodConfig = ldeConfigPoolFrameInsertInPlace(
+                &m_configPool, timestamp, VNAllocationPtr(frame->m_enhancementData, uint8_t),
+                VNAllocationSize(frame->m_enhancementData, uint8_t), false, &frame->globalConfig,
+                &frame->config);
 
             if (!goodConfig) {
                 frame->m_passthrough = true;
@@ -2597,7 +2596,8 @@ void* PipelineVulkan::taskGenerateCmdBuffer(LdcTask* task, const LdcTaskPart* /*
 
     if (!ldeDecodeEnhancement(frame->globalConfig, &frame->config, data.enhancementTile->loq,
                               data.enhancementTile->plane, data.enhancementTile->tile, nullptr,
-                              &data.enhancementTile->bufferGpu, &data.enhancementTile->bufferGpuBuilder)) {
+                              &data.enhancementTile->bufferGpu,
+                              &data.enhancementTile->bufferGpuBuilder, nullptr)) {
         VNLogError("ldeDecodeEnhancement failed");
     }
 
@@ -2967,6 +2967,7 @@ void* PipelineVulkan::taskOutputDone(LdcTask* task, const LdcTaskPart* part)
         frame->m_decodeInfo.baseWidth = frame->baseWidth;
         frame->m_decodeInfo.baseHeight = frame->baseHeight;
         frame->m_decodeInfo.baseBitdepth = frame->baseBitdepth;
+        frame->m_decodeInfo.degradation = LdpDegradationNone;
         frame->m_decodeInfo.userData = frame->userData;
 
         pipeline->m_interTaskFrameDone.signal();
@@ -214,7 +214,8 @@ public:
     const PipelineConfigVulkan& configuration() const { return m_configuration; }
     LdcMemoryAllocator* allocator() const { return m_allocator; }
     LdcTaskPool* taskPool() { return &m_taskPool; }
-    LdppDitherGlobal* globalDitherBuffer() { return &m_dither; }
+    LdeConfigPool* configPool() { return &m_configPool; }
+    LdppDitherGlobal* globalDither() { return &m_dither; }
 
     // Buffer allocation
     BufferVulkan* allocateBuffer(uint32_t requiredSize);
@@ -41,6 +41,40 @@ bool ldppApplyCmdBuffer(LdcTaskPool* taskPool, LdcTask* parent, LdpEnhancementTi
                         LdpFixedPoint fixedPoint, const LdpPicturePlaneDesc* plane,
                         bool rasterOrder, bool forceScalar, bool highlight);
 
+/*! \brief Applies a bitmask (GPU format) cmdbuffer to a plane
+ *
+ * Each command of a bitmask cmdbuffer covers a single block, so the apply is split across the task
+ * pool by bands of blocks rather than by entry points.
+ *
+ * \param[in]    taskPool        A task pool for multi-threaded apply of the cmdbuffer
+ * \param[in]    parent          If not NULL, task whose dependencies the apply will take over
+ * \param[in]    enhancementTile Structure containing the bitmask cmdbuffer and tile metadata
+ * \param[in]    fixedPoint      Datatype of the plane
+ * \param[inout] plane           Plane of pixels to apply residuals to
+ * \param[in]    rasterOrder     True if the cmdbuffer was generated in surface raster order
+ * \param[in]    forceScalar     Set to true to disable SIMD
+ * \param[in]    highlight       Set to true to ignore residual values and apply maximum values at
+ *                               residual locations for debugging residual distribution
+ */
+bool ldppApplyCmdBufferBitmask(LdcTaskPool* taskPool, LdcTask* parent,
+                               LdpEnhancementTile* enhancementTile, LdpFixedPoint fixedPoint,
+                               const LdpPicturePlaneDesc* plane, bool rasterOrder,
+                               bool forceScalar, bool highlight);
+
+/*! \brief Marks the 32x32 blocks of a plane that a block ordered cmdbuffer writes to
+ *
+ * The byte for every block touched by a command in the tile is set to 1, and other bytes are left
+ * alone, so that maps can be accumulated across tiles and frames. Tiles are block aligned, so
+ * the tiles of a plane can be marked concurrently.
+ *
+ * \param[in]    enhancementTile Structure containing the cmdbuffer and tile metadata
+ * \param[in]    bitmask         True to use the bitmask (GPU format) cmdbuffer of the tile
+ * \param[inout] blockMap        One byte per block of the whole plane, in raster order
+ * \param[in]    blocksAcross    Number of blocks in a row of the plane
+ */
+bool ldppCmdBufferMarkBlocks(const LdpEnhancementTile* enhancementTile, bool bitmask,
+                             uint8_t* blockMap, uint32_t blocksAcross);
+
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +89,13 @@ extern "C"
  * \note The copy does not need to perform conversion since the shift of the radix is
  *       implied by the representation & range of values, this falls back to a normal copy
  *       with the destination having the requested fixed-point representation.
+ *
+ * # Semi-planar pictures
+ * Pictures whose chroma components share an interleaved plane (NV12, NV16, P010 etc.) are
+ * converted to and from internal planes without a separate (de)interleaving pass. A chroma
+ * plane index (1 or 2) picks one component out of the interleaved source plane, and
+ * ldppPlaneBlitInterleave() writes both components of an interleaved destination plane at once.
+ * 16 bit semi-planar formats hold their samples in the high bits of each word.
  */
 
 /*------------------------------------------------------------------------------*/
@@ -118,6 +125,43 @@ bool ldppPlaneBlit(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar, uin
                    LdpPicturePlaneDesc* srcPlane, LdpPicturePlaneDesc* dstPlane,
                    LdppBlendingMode blending);
 
+/*! \brief Copies two internal chroma planes into the interleaved chroma plane of a semi-planar
+ *         destination, eg: U and V into the UV plane of NV12 or P010.
+ *
+ * \param taskPool       The task pool to create a sliced blit task from
+ * \param forceScalar    Doesn't use SSE accelerated functions when true.
+ * \param srcLayout      The source picture layout
+ * \param dstLayout      The destination picture layout, which must be semi-planar
+ * \param srcPlanes      The U and V source planes, in that order.
+ * \param dstPlane       The destination interleaved plane to blit to.
+ *
+ * \return True if the blit operation was successful. */
+bool ldppPlaneBlitInterleave(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar,
+                             const LdpPictureLayout* srcLayout, const LdpPictureLayout* dstLayout,
+                             const LdpPicturePlaneDesc srcPlanes[2], LdpPicturePlaneDesc* dstPlane);
+
+/*! \brief Blits only the 32x32 blocks of a plane that are marked in a block map, eg: adding
+ *         a temporal buffer where it may hold non-zero residuals. Unmarked blocks of the
+ *         destination are left untouched.
+ *
+ * \param taskPool       The task pool to create a sliced blit task from
+ * \param forceScalar    Doesn't use SSE or NEON accelerated functions when true.
+ * \param planeIndex     The plane index in src/dst layout
+ * \param srcLayout      The source plane picture layout, which must be planar
+ * \param dstLayout      The destination picture layout, which must be planar
+ * \param srcPlane       The source plane to blit from.
+ * \param dstPlane       The destination plane to blit to.
+ * \param blending       The blending operation to apply during the blit.
+ * \param blockMap       One byte per block of the plane in raster order, non-zero to blit.
+ * \param blocksAcross   Number of blocks in a row of the block map.
+ *
+ * \return True if the blit operation was successful. */
+bool ldppPlaneBlitBlocks(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar,
+                         uint32_t planeIndex, const LdpPictureLayout* srcLayout,
+                         const LdpPictureLayout* dstLayout, const LdpPicturePlaneDesc* srcPlane,
+                         const LdpPicturePlaneDesc* dstPlane, LdppBlendingMode blending,
+                         const uint8_t* blockMap, uint32_t blocksAcross);
+
 /*------------------------------------------------------------------------------*/
 
 #ifdef __cplusplus
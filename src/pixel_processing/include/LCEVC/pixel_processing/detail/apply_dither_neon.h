@@ -20,27 +20,53 @@
 #include <LCEVC/common/neon.h>
 
 /*!
- * Apply dithering to values using supplied host buffer pointer containing pre-randomised
- * values.
+ * Load the generator lanes seeded by ldppDitherRowInitialise into registers.
  *
- * This function loads in values from the entropy buffer and scales the random value by the
- * desired amount then moves the buffer pointer forward for the next invocation of this function.
+ * \param row    The seeded generator state.
+ * \param state  The lanes, 4 per register.
+ */
+static inline void ldppDitherLoadNEON(const LdppDitherRow* row, uint32x4x2_t* state)
+{
+    state->val[0] = vld1q_u32(&row->state[0]);
+    state->val[1] = vld1q_u32(&row->state[4]);
+}
+
+/*!
+ * Step a register of xorshift32 generator lanes.
+ */
+static inline uint32x4_t ldppDitherStepNEON(uint32x4_t x)
+{
+    x = veorq_u32(x, vshlq_n_u32(x, 13));
+    x = veorq_u32(x, vshrq_n_u32(x, 17));
+    return veorq_u32(x, vshlq_n_u32(x, 5));
+}
+
+/*!
+ * Apply dithering to values using the next 16 values of the generator, held in registers.
+ *
+ * This function steps the generator lanes and scales each 16 bit half of the lanes by the
+ * desired amount. The values are de-interleaved as a vld2q_u16 of ldppDitherApply's sequence
+ * would be.
  *
  * \param values   The values to apply dithering to.
- * \param buffer   A double pointer to the dither buffer
+ * \param state    The generator lanes, loaded by ldppDitherLoadNEON
  * \param shift    The left shift to apply to the dither to account for the fixed point format of
  *                 the incoming pixel values (see ldppDitherGetShiftS16)
  * \param strength Dithering strength to scale the random value by
  */
-static inline void ldppDitherApplyNEON(int16x8x2_t* values, const uint16_t** buffer,
+static inline void ldppDitherApplyNEON(int16x8x2_t* values, uint32x4x2_t* state,
                                        const uint8_t shift, const uint8_t strength)
 {
     const int16x8_t offset = vdupq_n_s16(strength);
     const int16x8_t shft = vdupq_n_s16(shift);
 
-    // Load and increment dither buffer pointer
-    uint16x8x2_t dither = vld2q_u16(*buffer);
-    *buffer += 16;
+    // Step the lanes, each of which gives an even (low half) and odd (high half) value
+    state->val[0] = ldppDitherStepNEON(state->val[0]);
+    state->val[1] = ldppDitherStepNEON(state->val[1]);
+
+    uint16x8x2_t dither;
+    dither.val[0] = vcombine_u16(vmovn_u32(state->val[0]), vmovn_u32(state->val[1]));
+    dither.val[1] = vcombine_u16(vshrn_n_u32(state->val[0], 16), vshrn_n_u32(state->val[1], 16));
 
     // Multiply by scalar
     uint32x4x2_t lowHalf;
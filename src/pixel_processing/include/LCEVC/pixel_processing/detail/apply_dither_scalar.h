@@ -16,23 +16,85 @@
 #define VN_LCEVC_PIXEL_PROCESSING_DETAIL_APPLY_DITHER_SCALAR_H
 
 /*!
- * Apply dithering to values using supplied host buffer pointer containing pre-randomised
- * values.
+ * Hash used to derive generator keys and seeds (the SplitMix64 finaliser).
+ */
+static inline uint64_t ldppDitherHash(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+/*!
+ * Seed the generator lanes for the run of pixels starting at `x` in the slice's rows. Runs
+ * starting at different x have independent noise.
  *
- * This function loads in values from the entropy buffer and scales the random value by the
- * desired amount then moves the buffer pointer forward for the next invocation of this function.
+ * This is inline so that the kernels' generator state does not escape, and can stay in
+ * registers.
  *
- * \param values   The values to apply dithering to.
- * \param buffer   A double pointer to the dither buffer
+ * \param dither  The slice dither module.
+ * \param row     The generator state to seed.
+ * \param x       The first pixel of the run.
+ */
+static inline void ldppDitherRowInitialise(const LdppDitherSlice* dither, LdppDitherRow* row,
+                                           uint32_t x)
+{
+    /* Each 64-bit hash seeds a pair of lanes. A lane of xorshift32 must never be zero. */
+    const uint64_t counter = ((uint64_t)dither->row << 32 | x) * LDPP_DITHER_LANES;
+
+    for (uint32_t lane = 0; lane < LDPP_DITHER_LANES; lane += 2) {
+        const uint64_t hash = ldppDitherHash(dither->key + ldppDitherHash(counter + lane));
+        row->state[lane] = (uint32_t)hash | 1;
+        row->state[lane + 1] = (uint32_t)(hash >> 32) | 1;
+    }
+
+    /* The first value read steps the lanes, as the SIMD helpers do. */
+    row->position = 2 * LDPP_DITHER_LANES;
+}
+
+/*!
+ * Advance each xorshift32 lane of the dither generator by one step.
+ *
+ * \param state  The generator lanes.
+ */
+static inline void ldppDitherStep(uint32_t state[LDPP_DITHER_LANES])
+{
+    for (uint32_t lane = 0; lane < LDPP_DITHER_LANES; ++lane) {
+        uint32_t x = state[lane];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state[lane] = x;
+    }
+}
+
+/*!
+ * Apply dithering to a value using the next value from the generator.
+ *
+ * Each step of the lanes gives 16 values, low then high half of each lane in turn, which is the
+ * order that the SIMD helpers apply them to a pair of vectors. The random value is scaled by the
+ * desired amount.
+ *
+ * \param value    The value to apply dithering to.
+ * \param row      The generator state, seeded by ldppDitherRowInitialise
  * \param shift    The left shift to apply to the dither to account for the fixed point format of
  *                 the incoming pixel values (see ldppDitherGetShiftS16)
  * \param strength Dither strength to scale the random value by
  */
-static inline void ldppDitherApply(int32_t* value, const uint16_t** ditherBuffer,
-                                   const uint8_t shift, const uint8_t strength)
+static inline void ldppDitherApply(int32_t* value, LdppDitherRow* row, const uint8_t shift,
+                                   const uint8_t strength)
 {
-    *value += (strength - ((**ditherBuffer * (strength * 2 + 1)) >> 16)) << shift;
-    *ditherBuffer += 1;
+    if (row->position == 2 * LDPP_DITHER_LANES) {
+        ldppDitherStep(row->state);
+        for (uint32_t lane = 0; lane < LDPP_DITHER_LANES; ++lane) {
+            row->values[lane * 2] = (uint16_t)row->state[lane];
+            row->values[lane * 2 + 1] = (uint16_t)(row->state[lane] >> 16);
+        }
+        row->position = 0;
+    }
+
+    *value += (strength - ((row->values[row->position] * (strength * 2 + 1)) >> 16)) << shift;
+    row->position += 1;
 }
 
 #endif // VN_LCEVC_PIXEL_PROCESSING_DETAIL_APPLY_DITHER_SCALAR_H
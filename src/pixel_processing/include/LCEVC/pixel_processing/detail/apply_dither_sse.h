@@ -20,34 +20,53 @@
 #include <LCEVC/common/sse.h>
 
 /*!
- * Apply dithering to values using supplied host buffer pointer containing pre-randomised
- * values.
+ * Load the generator lanes seeded by ldppDitherRowInitialise into registers.
  *
- * This function loads in values from the entropy buffer and scales the random value by the
- * desired amount then moves the buffer pointer forward for the next invocation of this function.
+ * \param row    The seeded generator state.
+ * \param state  The lanes, 4 per register.
+ */
+static inline void ldppDitherLoadSSE(const LdppDitherRow* row, __m128i state[2])
+{
+    state[0] = _mm_loadu_si128((const __m128i*)&row->state[0]);
+    state[1] = _mm_loadu_si128((const __m128i*)&row->state[4]);
+}
+
+/*!
+ * Step a register of xorshift32 generator lanes.
+ */
+static inline __m128i ldppDitherStepSSE(__m128i x)
+{
+    x = _mm_xor_si128(x, _mm_slli_epi32(x, 13));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+    return _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+}
+
+/*!
+ * Apply dithering to values using the next 16 values of the generator, held in registers.
+ *
+ * This function steps the generator lanes and scales each 16 bit half of the lanes by the
+ * desired amount, giving the same values in the same order as ldppDitherApply.
  *
  * \param values   The values to apply dithering to.
- * \param buffer   A double pointer to the dither buffer
+ * \param state    The generator lanes, loaded by ldppDitherLoadSSE
  * \param shift    The left shift to apply to the dither to account for the fixed point format of
  *                 the incoming pixel values (see ldppDitherGetShiftS16)
  * \param strength Dithering strength to scale the random value by
  */
-static inline void ldppDitherApplySSE(__m128i values[2], const uint16_t** ditherBuffer,
-                                      const uint8_t shift, const uint8_t strength)
+static inline void ldppDitherApplySSE(__m128i values[2], __m128i state[2], const uint8_t shift,
+                                      const uint8_t strength)
 {
     const __m128i scalar = _mm_set1_epi16(strength * 2 + 1);
     const __m128i offset = _mm_set1_epi16(strength);
     __m128i dither[2];
 
-    // Load and increment dither buffer pointer
-    dither[0] = _mm_loadu_si128((const __m128i*)*ditherBuffer);
-    *ditherBuffer += 8;
-    dither[1] = _mm_loadu_si128((const __m128i*)*ditherBuffer);
-    *ditherBuffer += 8;
+    // Step the lanes, each of which gives two 16 bit values
+    state[0] = ldppDitherStepSSE(state[0]);
+    state[1] = ldppDitherStepSSE(state[1]);
 
     // Multiply by scalar
-    dither[0] = _mm_mulhi_epu16(dither[0], scalar);
-    dither[1] = _mm_mulhi_epu16(dither[1], scalar);
+    dither[0] = _mm_mulhi_epu16(state[0], scalar);
+    dither[1] = _mm_mulhi_epu16(state[1], scalar);
 
     // Subtract offset to get values into -strength to +strength range
     dither[0] = _mm_sub_epi16(offset, dither[0]);
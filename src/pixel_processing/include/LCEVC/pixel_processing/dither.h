@@ -19,9 +19,7 @@
 #include "stdint.h"
 #include "string.h"
 
-#include <LCEVC/common/memory.h>
 #include <LCEVC/common/platform.h>
-#include <LCEVC/common/random.h>
 #include <LCEVC/enhancement/bitstream_types.h>
 #include <LCEVC/pipeline/types.h>
 
@@ -48,117 +46,100 @@ extern "C"
  *     - None (i.e. disabled)
  *     - Uniform (i.e. uniformly random).
  *
- * In our implementation we opt to use a xor-shift-rotate algorithm for performance
- * reasons, we have not performed analysis to determine if it is uniform, but it
- * does appear to provide subjectively sound noise.
+ * Noise is generated as it is applied by 8 lanes of xorshift32, so that a step of all lanes
+ * gives the 16 values needed by one SIMD application. We have not performed analysis to
+ * determine if it is uniform, but it does appear to provide subjectively sound noise.
  *
  * # Usage
- * As mutiple frames may be decoded in paralel each with their own required strength
- * a global buffer of unscaled entropy is shared between threads this entropy
- * is scaled down to the frames's strength at application of dithering.
+ * The generator is counter based: the lanes are seeded by hashing a key with the position
+ * of the pixels being upscaled, so the noise for any part of a frame depends only on the
+ * seeds and that position, not on which thread or slice it is decoded by.
  *
- * At the start of each slice we generate a random offset into the buffer to avoid
- * repeating patterns
+ * ldppDitherGlobalInitialize records the decoder's seed.
  *
- * ldppDitherGlobalInitialize is used to initalise the global entropy buffer with a
- * particular seed if desired.
+ * ldppDitherFrameInitialise combines the global seed with a unique seed for a frame,
+ * and stores the dithering strength for that frame.
  *
- * This global buffer can then be passed to ldppDitherFrameInitialise which
- * also stores the dithering strength for a particular frame along with a unique
- * seed for that frame.
+ * ldppDitherSliceInitialise adds the plane index and the row to the key. It is cheap,
+ * and is called for each pair of rows that an upscale kernel processes.
  *
- * As it is possible to apply dithering to multiple slices of the same frame
- * in paralell, a unique seed for each slice is created from the slice's vertical
- * offset and plane index via ldppDitherSliceInitialise. This seed initalises the
- * RNG used to create random offsets into the entropy buffer. This stops the dither
- * pattern repeating at slice boundaries.
- *
- * The offset into the entropy buffer for a particular slice is retrevied via
- * ldppDitherGetBuffer. The entropy values can be scaled down and applied to
- * incoming pixel values using the inline helpers: ldppDitherApply(SSE/NEON)
+ * The kernel then seeds the lanes for the run of pixels it is about to process via
+ * ldppDitherRowInitialise, and applies noise scaled down to the frame's strength with
+ * the inline helpers: ldppDitherApply(SSE/NEON)
  */
 /*------------------------------------------------------------------------------*/
 
-/*! Structure to hold global entropy buffer
+/*! Number of 32-bit generator lanes, each step of which gives 16 dither values. */
+#define LDPP_DITHER_LANES 8
+
+/*! Structure to hold the global dither seed
  */
 typedef struct LdppDitherGlobal
 {
-    LdcMemoryAllocator* allocator;
-    LdcMemoryAllocation allocationBuffer;
-    uint16_t* buffer;
+    uint64_t seed;
 } LdppDitherGlobal;
 
 /*! Structure to hold per-frame dithering information.
  */
 typedef struct LdppDitherFrame
 {
-    LdppDitherGlobal* global;
-    uint64_t frameSeed;
+    uint64_t key;
     uint8_t strength;
 } LdppDitherFrame;
 
-/*! Structure to hold per-slice dithering information and RNG for buffer offsets
+/*! Structure to hold dithering information for a pair of rows of a plane
  */
 typedef struct LdppDitherSlice
 {
-    LdppDitherGlobal* global;
-    LdcRandom random;
+    uint64_t key;
+    uint32_t row;
     uint8_t strength;
 } LdppDitherSlice;
 
+/*! Generator state for a run of pixels, with the values of the last step unpacked for
+ *  ldppDitherApply. The SIMD helpers keep the lanes in registers instead.
+ */
+typedef struct LdppDitherRow
+{
+    uint32_t state[LDPP_DITHER_LANES];
+    uint16_t values[2 * LDPP_DITHER_LANES];
+    uint32_t position;
+} LdppDitherRow;
+
 /*------------------------------------------------------------------------------*/
 
 /*! Initializes the global dither module
  *
- * \param allocator        The memory allocator.
  * \param dither           The dither module to initialize.
- * \param seed             The seed to initialize the random number generator
- *                         with, if 0 it will use time()
- *
- * \return false if memory allocation failed, otherwise true.
+ * \param seed             The seed for all dither noise, if 0 it will use time()
  */
-bool ldppDitherGlobalInitialize(LdcMemoryAllocator* allocator, LdppDitherGlobal* dither, uint64_t seed);
-
-/*! Releases the dither module and any associated memory. */
-void ldppDitherGlobalRelease(LdppDitherGlobal* dither);
+void ldppDitherGlobalInitialize(LdppDitherGlobal* dither, uint64_t seed);
 
 /*! Initializes the per-frame dither module
  *
- * \param dither           The frame dither module to initialize.
- * \param global           The global dither module to retrieve entropy from.
+ * \param frame            The frame dither module to initialize.
+ * \param global           The global dither module to take the seed from.
  * \param seed             The seed for this particular frame, this should be unique
  *                         for each frame to avoid repitition, the frames timestamp is
- *                         a ideal seed. if 0 it will use time()
- * \param global           The dithering strength for this particular frame
+ *                         a ideal seed.
+ * \param strength         The dithering strength for this particular frame
  *
  * \return false if dithering strength is greater than 31 otherwise true.
  */
-bool ldppDitherFrameInitialise(LdppDitherFrame* frame, LdppDitherGlobal* global, uint64_t seed,
-                               uint8_t strength);
+bool ldppDitherFrameInitialise(LdppDitherFrame* frame, const LdppDitherGlobal* global,
+                               uint64_t seed, uint8_t strength);
 
-/*! Initializes the per-slice dither module
+/*! Initializes the dither module for a pair of rows of a plane
  *
  * \param slice            The slice dither module to initialize.
- * \param frame            The frame dither module to retrieve entropy and strength from.
- * \param offset           The offset into the frame for this particular slice *
+ * \param frame            The frame dither module to retrieve the key and strength from.
+ * \param offset           The first of the pair of rows in the plane
  * \param planeIndex       The index of the plane of which this slice belongs to
- *                         this is combined with the frame seed along the offset above
- *                         to create a unique seed per slice for buffer offsets
- */
-void ldppDitherSliceInitialise(LdppDitherSlice* slice, LdppDitherFrame* frame, uint32_t offset,
-                               uint32_t planeIndex);
-
-/*! Query the local dithering module for a pointer to an array of
- *  values that contain unscaled random noise that is at least `length`
- *  elements long.
- *
- * \param dither  The slice dither module.
- * \param length  The number of elements to query.
- *
- * \return A valid pointer on success, otherwise NULL, noting if `length`
- *         is greater than 16384 the function will return NULL.
+ *                         this is combined with the frame key along the row above
+ *                         to key the generator
  */
-const uint16_t* ldppDitherGetBuffer(LdppDitherSlice* dither, size_t length);
+void ldppDitherSliceInitialise(LdppDitherSlice* slice, const LdppDitherFrame* frame,
+                               uint32_t offset, uint32_t planeIndex);
 
 /*! Query the bitshift required for a signed, fixed point pixel
  *
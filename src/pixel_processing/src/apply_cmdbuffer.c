@@ -17,7 +17,10 @@
 #include <LCEVC/common/acceleration.h>
 #include <LCEVC/common/log.h>
 #include <LCEVC/common/task_pool.h>
+#include <LCEVC/enhancement/bitstream_types.h>
 #include <LCEVC/enhancement/cmdbuffer_cpu.h>
+#include <LCEVC/enhancement/cmdbuffer_gpu.h>
+#include <LCEVC/enhancement/transform_unit.h>
 #include <LCEVC/pipeline/frame.h>
 #include <LCEVC/pipeline/types.h>
 #include <LCEVC/pixel_processing/apply_cmdbuffer.h>
@@ -51,6 +54,14 @@ static bool applyCmdBufferSlicedJob(void* argument, uint32_t offset, uint32_t co
     return r;
 }
 
+/* Entry points cover differing numbers of commands - balance the parts by command count. */
+static uint32_t applyCmdBufferSlicedJobWeight(const void* argument, uint32_t iteration)
+{
+    const ApplyCmdBufferSlicedJobContext* context = (const ApplyCmdBufferSlicedJobContext*)argument;
+
+    return context->enhancementTile->buffer.entryPoints[iteration].count;
+}
+
 bool ldppApplyCmdBuffer(LdcTaskPool* taskPool, LdcTask* parent, LdpEnhancementTile* enhancementTile,
                         LdpFixedPoint fixedPoint, const LdpPicturePlaneDesc* plane,
                         bool rasterOrder, bool forceScalar, bool highlight)
@@ -108,10 +119,187 @@ bool ldppApplyCmdBuffer(LdcTaskPool* taskPool, LdcTask* parent, LdpEnhancementTi
             .highlight = highlight,
         };
 
+        const LdcTaskSliceHints hints = {.weight = &applyCmdBufferSlicedJobWeight};
+
         return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &applyCmdBufferSlicedJob, NULL,
                                             &slicedJobContext, sizeof(slicedJobContext),
-                                            cmdBuffer->numEntryPoints);
+                                            cmdBuffer->numEntryPoints, &hints);
+    }
+    return true;
+}
+
+/*------------------------------------------------------------------------------*/
+
+typedef struct ApplyCmdBufferBitmaskSlicedJobContext
+{
+    CmdBufferBitmaskApplicator function;
+    const LdpEnhancementTile* enhancementTile;
+    const LdpPicturePlaneDesc plane;
+    LdpFixedPoint fixedPoint;
+    bool rasterOrder;
+    bool highlight;
+} ApplyCmdBufferBitmaskSlicedJobContext;
+
+/* Find the first command at or after a block - commands are generated in block order. */
+static uint32_t bitmaskCommandLowerBound(const LdeCmdBufferGpu* cmdBuffer, uint32_t blockIndex)
+{
+    uint32_t low = 0;
+    uint32_t high = cmdBuffer->commandCount;
+    while (low < high) {
+        const uint32_t mid = low + (high - low) / 2;
+        if (cmdBuffer->commands[mid].blockIndex < blockIndex) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Each slice is a run of whole blocks, applying every command that touches them. */
+static bool applyCmdBufferBitmaskSlicedJob(void* argument, uint32_t offset, uint32_t count)
+{
+    VNTraceScopedBegin();
+
+    const ApplyCmdBufferBitmaskSlicedJobContext* context =
+        (const ApplyCmdBufferBitmaskSlicedJobContext*)argument;
+    const LdeCmdBufferGpu* cmdBuffer = &context->enhancementTile->bufferGpu;
+
+    const uint32_t firstCommand = bitmaskCommandLowerBound(cmdBuffer, offset);
+    const uint32_t endCommand = bitmaskCommandLowerBound(cmdBuffer, offset + count);
+    const bool r = context->function(context->enhancementTile, firstCommand,
+                                     endCommand - firstCommand, &context->plane,
+                                     context->fixedPoint, context->rasterOrder, context->highlight);
+
+    VNTraceScopedEnd();
+    return r;
+}
+
+bool ldppApplyCmdBufferBitmask(LdcTaskPool* taskPool, LdcTask* parent,
+                               LdpEnhancementTile* enhancementTile, LdpFixedPoint fixedPoint,
+                               const LdpPicturePlaneDesc* plane, bool rasterOrder,
+                               bool forceScalar, bool highlight)
+{
+    if (!plane->firstSample) {
+        VNLogError("Apply cmdbuffer surface has no data pointer");
+        return false;
+    }
+
+    const LdeCmdBufferGpu* cmdBuffer = &enhancementTile->bufferGpu;
+    if (cmdBuffer->commandCount == 0) {
+        return true;
+    }
+
+    const LdcAcceleration* acceleration = ldcAccelerationGet();
+
+    CmdBufferBitmaskApplicator applicatorFunction = NULL;
+    if (!forceScalar && acceleration->NEON) {
+        applicatorFunction = cmdBufferApplicatorBitmaskNEON;
+    } else if (!forceScalar && acceleration->SSE) {
+        applicatorFunction = cmdBufferApplicatorBitmaskSSE;
+    }
+    if (!applicatorFunction) {
+        applicatorFunction = cmdBufferApplicatorBitmaskScalar;
+    }
+
+    ApplyCmdBufferBitmaskSlicedJobContext slicedJobContext = {
+        .function = applicatorFunction,
+        .enhancementTile = enhancementTile,
+        .plane = *plane,
+        .fixedPoint = fixedPoint,
+        .rasterOrder = rasterOrder,
+        .highlight = highlight,
+    };
+
+    /* Slice over blocks, keeping to at least a row of blocks per part in block order. */
+    const uint32_t blockCount = cmdBuffer->commands[cmdBuffer->commandCount - 1].blockIndex + 1;
+    const uint32_t blocksPerRow = (enhancementTile->tileWidth + ACBKBlockSize - 1) / ACBKBlockSize;
+    const LdcTaskSliceHints hints = {.minGrain = rasterOrder ? 1 : blocksPerRow};
+
+    return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &applyCmdBufferBitmaskSlicedJob, NULL,
+                                        &slicedJobContext, sizeof(slicedJobContext), blockCount,
+                                        &hints);
+}
+
+/*------------------------------------------------------------------------------*/
+
+/* Mark the block holding a TU, given the TU's index in block aligned raster order. */
+static inline void markTuBlock(const TUState* tuState, uint32_t tuIndex, uint8_t* blockMap,
+                               uint32_t blocksAcross)
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    ldeTuCoordsBlockAlignedRaster(tuState, tuIndex, &x, &y);
+    blockMap[(y >> BSTemporalShift) * blocksAcross + (x >> BSTemporalShift)] = 1;
+}
+
+static uint32_t cmdBufferJump(const uint8_t* commandPtr, int32_t* cmdOffset)
+{
+    const uint8_t jumpSignal = *commandPtr & 0x3F;
+    if (jumpSignal < CBCKBigJumpSignal) {
+        (*cmdOffset)++;
+        return jumpSignal;
+    }
+    if (jumpSignal == CBCKBigJumpSignal) {
+        (*cmdOffset) += 3;
+        return commandPtr[1] + (commandPtr[2] << 8);
     }
+    (*cmdOffset) += 4;
+    return commandPtr[1] + (commandPtr[2] << 8) + (commandPtr[3] << 16);
+}
+
+bool ldppCmdBufferMarkBlocks(const LdpEnhancementTile* enhancementTile, bool bitmask,
+                             uint8_t* blockMap, uint32_t blocksAcross)
+{
+    const bool dds = bitmask ? (enhancementTile->bufferGpu.layerCount == RCLayerCountDDS)
+                             : (enhancementTile->buffer.transformSize == 16);
+
+    TUState tuState;
+    if (!ldeTuStateInitialize(&tuState, enhancementTile->tileWidth, enhancementTile->tileHeight,
+                              enhancementTile->tileX, enhancementTile->tileY, dds ? 2 : 1)) {
+        return false;
+    }
+
+    if (bitmask) {
+        /* Each command covers exactly one block. */
+        const LdeCmdBufferGpu* cmdBuffer = &enhancementTile->bufferGpu;
+        const uint32_t commandTuShift = dds ? 6 : 8;
+        for (uint32_t cmdIndex = 0; cmdIndex < cmdBuffer->commandCount; ++cmdIndex) {
+            const uint32_t firstTu = (uint32_t)cmdBuffer->commands[cmdIndex].blockIndex
+                                     << commandTuShift;
+            markTuBlock(&tuState, firstTu, blockMap, blocksAcross);
+        }
+        return true;
+    }
+
+    /* Walk the commands of every entry point, only finding the coordinates of each new block. */
+    const LdeCmdBufferCpu* cmdBuffer = &enhancementTile->buffer;
+    const uint32_t tileFirstTu =
+        ldeTuCoordsBlockAlignedIndex(&tuState, enhancementTile->tileX, enhancementTile->tileY);
+
+    const bool hasEntryPoints = (cmdBuffer->numEntryPoints > 0 && cmdBuffer->entryPoints);
+    const uint32_t numEntryPoints = hasEntryPoints ? cmdBuffer->numEntryPoints : 1;
+
+    for (uint32_t entryPointIdx = 0; entryPointIdx < numEntryPoints; ++entryPointIdx) {
+        LdeCmdBufferCpuEntryPoint entryPoint = {.count = cmdBuffer->count};
+        if (hasEntryPoints) {
+            entryPoint = cmdBuffer->entryPoints[entryPointIdx];
+        }
+        uint32_t tuIndex = tileFirstTu + entryPoint.initialJump;
+        int32_t cmdOffset = entryPoint.commandOffset;
+        uint32_t lastBlock = UINT32_MAX;
+
+        for (uint32_t count = 0; count < entryPoint.count; count++) {
+            tuIndex += cmdBufferJump(cmdBuffer->data.start + cmdOffset, &cmdOffset);
+
+            const uint32_t block = tuIndex >> tuState.block.tuPerBlockShift;
+            if (block != lastBlock) {
+                markTuBlock(&tuState, tuIndex, blockMap, blocksAcross);
+                lastBlock = block;
+            }
+        }
+    }
+
     return true;
 }
 
@@ -17,8 +17,11 @@
 
 #include "apply_cmdbuffer_common.h"
 
+#include <LCEVC/common/bitutils.h>
+#include <LCEVC/common/platform.h>
 #include <LCEVC/enhancement/bitstream_types.h>
 #include <LCEVC/enhancement/cmdbuffer_cpu.h>
+#include <LCEVC/enhancement/cmdbuffer_gpu.h>
 #include <LCEVC/enhancement/transform_unit.h>
 #include <LCEVC/pipeline/frame.h>
 #include <LCEVC/pipeline/types.h>
@@ -29,12 +32,12 @@
 
 #define VN_PLANE_GETLINE(pl, offset) (pl->firstSample + (offset * pl->rowByteStride))
 
-#define VN_COMMON_CMDBUFFER_APPLICATOR_SETUP()                                                         \
+#define VN_COMMON_CMDBUFFER_APPLICATOR_SETUP(transformType)                                            \
     const LdeCmdBufferCpu* cmdBuffer = &enhancementTile->buffer;                                       \
-    const int32_t transformSize = cmdBuffer->transformSize;                                            \
+    const int32_t transformSize = ((transformType) == TransformDDS) ? 16 : 4;                          \
     const int32_t layerSize = transformSize * sizeof(int16_t);                                         \
-    const uint8_t tuWidthShift = (transformSize == 16) ? 2 : 1;                                        \
-    const LdeTransformType transformType = (transformSize == 16) ? TransformDDS : TransformDD;         \
+    const uint8_t tuWidthShift = ((transformType) == TransformDDS) ? 2 : 1;                            \
+    assert(cmdBuffer->transformSize == transformSize);                                                 \
                                                                                                        \
     const LdeCmdBufferCpuEntryPoint* entryPoint = &cmdBuffer->entryPoints[entryPointIdx];              \
     uint32_t tuIndex = entryPoint->initialJump;                                                        \
@@ -190,26 +193,79 @@ static uint32_t getJump(const uint8_t* commandPtr, int32_t* cmdOffsetOut)
     return jump;
 }
 
-/*! \brief This function is the loop to apply residuals in cmdbuffer temporal format to a standard
- *         raster plane. It exists in this .h file separately as it is shared between the scalar,
- *         NEON and SSE implementations.
- *
- * \param enhancementTile Cmdbuffer and tile location to apply to
- * \param entryPointIdx   An entrypoint index to apply
- * \param plane           Plane to apply to.
- * \param fixedPoint      Plane datatype
- * \param highlight       Set true to use highlight residual functions instead of ADD, SET and
- *                        SETZERO. Highlight mode is not SIMD optimized. */
-bool cmdBufferApplicatorBlockTemplate(const LdpEnhancementTile* enhancementTile,
-                                      size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
-                                      LdpFixedPoint fixedPoint, bool highlight)
+/*- Specialised applicators ---------------------------------------------------------------------*/
+/* The applicator loops below are force-inlined into one instance per transform, add fixed point
+ * and highlight mode, so that the residual functions are resolved at compile time rather than per
+ * command. All signed fixed points share the S16 add, so share an instance. */
+
+/*! \brief Apply an ADD with the transform and fixed point known at compile time. */
+static VNForceInline void applyAdd(LdeTransformType transformType, LdpFixedPoint addFP,
+                                   const ApplyCmdBufferArgs* args)
 {
-    VN_COMMON_CMDBUFFER_APPLICATOR_SETUP()
+    const bool dd = (transformType == TransformDD);
+    switch (addFP) {
+        case LdpFPU8: dd ? addDD_U8(args) : addDDS_U8(args); break;
+        case LdpFPU10: dd ? addDD_U10(args) : addDDS_U10(args); break;
+        case LdpFPU12: dd ? addDD_U12(args) : addDDS_U12(args); break;
+        case LdpFPU14: dd ? addDD_U14(args) : addDDS_U14(args); break;
+        default: dd ? addDD_S16(args) : addDDS_S16(args); break;
+    }
+}
+
+/*! \brief Apply any command with the transform, fixed point and highlight mode known at compile
+ *         time. Highlight is a debug feature so it keeps the table lookup. */
+static VNForceInline void applyCommand(LdeCmdBufferCpuCmd command, LdeTransformType transformType,
+                                       LdpFixedPoint addFP, bool highlight,
+                                       const ApplyCmdBufferArgs* args)
+{
+    if (highlight) {
+        getApplyFunction(command, transformType, args->fixedPoint, true)(args);
+        return;
+    }
+    const bool dd = (transformType == TransformDD);
+    switch (command) {
+        case CBCCAdd: applyAdd(transformType, addFP, args); break;
+        case CBCCSet: dd ? setDD(args) : setDDS(args); break;
+        case CBCCSetZero: dd ? setZeroDD(args) : setZeroDDS(args); break;
+        case CBCCClear: clear(args); break;
+    }
+}
+
+static VNForceInline bool applyBlock(const LdpEnhancementTile* enhancementTile,
+                                     size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
+                                     LdpFixedPoint fixedPoint, bool highlight,
+                                     LdeTransformType transformType, LdpFixedPoint addFP)
+{
+    VN_COMMON_CMDBUFFER_APPLICATOR_SETUP(transformType)
 
     ldeTuCoordsBlockAlignedRaster(&tuState, tuIndex, &args.x, &args.y);
 
     const size_t dataSize = ldeCmdBufferCpuGetResidualSize(cmdBuffer);
-    for (uint32_t count = 0; count < entryPoint->count; count++) {
+    const uint8_t* residualEnd = cmdBuffer->data.currentResidual + dataSize;
+    uint32_t count = 0;
+    while (count < entryPoint->count) {
+        /* Runs of ADDs with small jumps are the bulk of most command buffers, so apply them without
+         * any per-command dispatch: the jump is in the command byte and the ADD is inlined. */
+        while (!highlight && count < entryPoint->count) {
+            const uint8_t commandByte = cmdBuffer->data.start[cmdOffset];
+            const uint8_t jump = commandByte & 0x3F;
+            if ((commandByte & 0xC0) != CBCCAdd || jump >= CBCKBigJumpSignal) {
+                break;
+            }
+            cmdOffset++;
+            tuIndex += jump;
+            ldeTuCoordsBlockAlignedRaster(&tuState, tuIndex, &args.x, &args.y);
+            assert(args.x < args.width && args.y < args.height);
+
+            dataOffset += layerSize;
+            args.residuals = (const int16_t*)(residualEnd - dataOffset);
+            applyAdd(transformType, addFP, &args);
+            count++;
+        }
+        if (count == entryPoint->count) {
+            break;
+        }
+
         const uint8_t* commandPtr = cmdBuffer->data.start + cmdOffset;
         const LdeCmdBufferCpuCmd command = (const LdeCmdBufferCpuCmd)(*commandPtr & 0xC0);
 
@@ -224,38 +280,24 @@ bool cmdBufferApplicatorBlockTemplate(const LdpEnhancementTile* enhancementTile,
             dataPtr = cmdBuffer->data.currentResidual + dataSize - dataOffset;
             args.residuals = (int16_t*)dataPtr;
         }
-        const ApplyCmdBufferFunction applyFn =
-            getApplyFunction(command, transformType, fixedPoint, args.highlight);
-        applyFn(&args);
+        applyCommand(command, transformType, addFP, highlight, &args);
+        count++;
     }
     return true;
 }
 
-/*! \brief This function is the loop to apply residuals in cmdbuffer surface format to a standard
- *         raster plane. It exists in this .h file separately as it is shared between the scalar,
- *         NEON and SSE implementations.
- *
- * \param enhancementTile Cmdbuffer and tile location to apply to
- * \param entryPointIdx   An entrypoint index to apply
- * \param plane           Plane to apply to.
- * \param fixedPoint      Plane datatype
- * \param highlight       Set true to use highlight residual functions instead of ADD, SET and
- *                        SETZERO. Highlight mode is not SIMD optimized.
- */
-bool cmdBufferApplicatorSurfaceTemplate(const LdpEnhancementTile* enhancementTile,
-                                        size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
-                                        LdpFixedPoint fixedPoint, bool highlight)
+static VNForceInline bool applySurface(const LdpEnhancementTile* enhancementTile,
+                                       size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
+                                       LdpFixedPoint fixedPoint, bool highlight,
+                                       LdeTransformType transformType, LdpFixedPoint addFP)
 {
-    VN_COMMON_CMDBUFFER_APPLICATOR_SETUP()
+    VN_COMMON_CMDBUFFER_APPLICATOR_SETUP(transformType)
 
     ldeTuCoordsSurfaceRaster(&tuState, tuIndex, &args.x, &args.y);
 
     /* If we're applying in surface-raster order, we know we're adding (because we only use this
      * order when temporal is disabled). So, the apply function is just the add function, or else
      * highlight. */
-    const ApplyCmdBufferFunction applyFn = args.highlight ? kHighlightTable[transformType][fixedPoint]
-                                                          : kAddTable[transformType][fixedPoint];
-
     const size_t dataSize = ldeCmdBufferCpuGetResidualSize(cmdBuffer);
     for (uint32_t count = 0; count < entryPoint->count; count++) {
         const uint8_t* commandPtr = cmdBuffer->data.start + cmdOffset;
@@ -271,7 +313,202 @@ bool cmdBufferApplicatorSurfaceTemplate(const LdpEnhancementTile* enhancementTil
         dataOffset += layerSize;
         dataPtr = cmdBuffer->data.currentResidual + dataSize - dataOffset;
         args.residuals = (int16_t*)dataPtr;
-        applyFn(&args);
+        applyCommand(CBCCAdd, transformType, addFP, highlight, &args);
+    }
+    return true;
+}
+
+typedef bool (*ApplyCmdBufferInstance)(const LdpEnhancementTile* enhancementTile,
+                                       size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
+                                       LdpFixedPoint fixedPoint);
+
+/* An empty highlight suffix is the non-highlight instance. */
+#define VN_HIGHLIGHT_ false
+#define VN_HIGHLIGHT_Highlight true
+
+#define VN_CMDBUFFER_APPLICATOR_INSTANCE(loop, transform, fp, highlight)                           \
+    static bool loop##transform##_##fp##highlight(const LdpEnhancementTile* enhancementTile,       \
+                                                   size_t entryPointIdx,                           \
+                                                   const LdpPicturePlaneDesc* plane,               \
+                                                   LdpFixedPoint fixedPoint)                       \
+    {                                                                                              \
+        return loop(enhancementTile, entryPointIdx, plane, fixedPoint, VN_HIGHLIGHT_##highlight,   \
+                    Transform##transform, LdpFP##fp);                                              \
+    }
+
+#define VN_CMDBUFFER_APPLICATOR_INSTANCES(loop, transform)                                         \
+    VN_CMDBUFFER_APPLICATOR_INSTANCE(loop, transform, U8, )                                        \
+    VN_CMDBUFFER_APPLICATOR_INSTANCE(loop, transform, U10, )                                       \
+    VN_CMDBUFFER_APPLICATOR_INSTANCE(loop, transform, U12, )                                       \
+    VN_CMDBUFFER_APPLICATOR_INSTANCE(loop, transform, U14, )                                       \
+    VN_CMDBUFFER_APPLICATOR_INSTANCE(loop, transform, S8, )                                        \
+    VN_CMDBUFFER_APPLICATOR_INSTANCE(loop, transform, S8, Highlight)
+
+VN_CMDBUFFER_APPLICATOR_INSTANCES(applyBlock, DD)
+VN_CMDBUFFER_APPLICATOR_INSTANCES(applyBlock, DDS)
+VN_CMDBUFFER_APPLICATOR_INSTANCES(applySurface, DD)
+VN_CMDBUFFER_APPLICATOR_INSTANCES(applySurface, DDS)
+
+/* The specialised instances, indexed by [transform][fixedPoint], with a final highlight entry. */
+#define VN_CMDBUFFER_APPLICATOR_TABLE(loop, transform)                                             \
+    {                                                                                              \
+        loop##transform##_U8, loop##transform##_U10, loop##transform##_U12,                        \
+            loop##transform##_U14, loop##transform##_S8, loop##transform##_S8,                     \
+            loop##transform##_S8, loop##transform##_S8, loop##transform##_S8Highlight,             \
+    }
+
+static const ApplyCmdBufferInstance kBlockInstances[TransformCount][LdpFPCount + 1] = {
+    VN_CMDBUFFER_APPLICATOR_TABLE(applyBlock, DD),
+    VN_CMDBUFFER_APPLICATOR_TABLE(applyBlock, DDS),
+};
+
+static const ApplyCmdBufferInstance kSurfaceInstances[TransformCount][LdpFPCount + 1] = {
+    VN_CMDBUFFER_APPLICATOR_TABLE(applySurface, DD),
+    VN_CMDBUFFER_APPLICATOR_TABLE(applySurface, DDS),
+};
+
+/*! \brief Select the instance for a command buffer - once per entry point, not per command. */
+static inline ApplyCmdBufferInstance getInstance(
+    const ApplyCmdBufferInstance table[TransformCount][LdpFPCount + 1],
+    const LdeCmdBufferCpu* cmdBuffer, LdpFixedPoint fixedPoint, bool highlight)
+{
+    const LdeTransformType transformType =
+        (cmdBuffer->transformSize == 16) ? TransformDDS : TransformDD;
+    return table[transformType][highlight ? LdpFPCount : fixedPoint];
+}
+
+/*! \brief This function is the loop to apply residuals in cmdbuffer temporal format to a standard
+ *         raster plane. It exists in this .h file separately as it is shared between the scalar,
+ *         NEON and SSE implementations.
+ *
+ * \param enhancementTile Cmdbuffer and tile location to apply to
+ * \param entryPointIdx   An entrypoint index to apply
+ * \param plane           Plane to apply to.
+ * \param fixedPoint      Plane datatype
+ * \param highlight       Set true to use highlight residual functions instead of ADD, SET and
+ *                        SETZERO. Highlight mode is not SIMD optimized. */
+bool cmdBufferApplicatorBlockTemplate(const LdpEnhancementTile* enhancementTile,
+                                      size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
+                                      LdpFixedPoint fixedPoint, bool highlight)
+{
+    return getInstance(kBlockInstances, &enhancementTile->buffer, fixedPoint,
+                       highlight)(enhancementTile, entryPointIdx, plane, fixedPoint);
+}
+
+/*! \brief This function is the loop to apply residuals in cmdbuffer surface format to a standard
+ *         raster plane. It exists in this .h file separately as it is shared between the scalar,
+ *         NEON and SSE implementations.
+ *
+ * \param enhancementTile Cmdbuffer and tile location to apply to
+ * \param entryPointIdx   An entrypoint index to apply
+ * \param plane           Plane to apply to.
+ * \param fixedPoint      Plane datatype
+ * \param highlight       Set true to use highlight residual functions instead of ADD, SET and
+ *                        SETZERO. Highlight mode is not SIMD optimized.
+ */
+bool cmdBufferApplicatorSurfaceTemplate(const LdpEnhancementTile* enhancementTile,
+                                        size_t entryPointIdx, const LdpPicturePlaneDesc* plane,
+                                        LdpFixedPoint fixedPoint, bool highlight)
+{
+    return getInstance(kSurfaceInstances, &enhancementTile->buffer, fixedPoint,
+                       highlight)(enhancementTile, entryPointIdx, plane, fixedPoint);
+}
+
+/*! \brief This function is the loop to apply a range of commands from a bitmask (GPU format)
+ *         command buffer to a standard raster plane. Each command covers a single block, so any
+ *         range of commands can be applied independently of the others. It exists in this .h file
+ *         separately as it is shared between the scalar, NEON and SSE implementations.
+ *
+ * \param enhancementTile Bitmask cmdbuffer and tile location to apply to
+ * \param firstCommand    Index of the first command to apply
+ * \param commandCount    Number of commands to apply
+ * \param plane           Plane to apply to.
+ * \param fixedPoint      Plane datatype
+ * \param rasterOrder     True if the cmdbuffer was generated in surface raster order
+ * \param highlight       Set true to use highlight residual functions instead of ADD, SET and
+ *                        SETZERO. Highlight mode is not SIMD optimized. */
+bool cmdBufferApplicatorBitmaskTemplate(const LdpEnhancementTile* enhancementTile,
+                                        uint32_t firstCommand, uint32_t commandCount,
+                                        const LdpPicturePlaneDesc* plane, LdpFixedPoint fixedPoint,
+                                        bool rasterOrder, bool highlight)
+{
+    const LdeCmdBufferGpu* cmdBuffer = &enhancementTile->bufferGpu;
+    const bool dds = (cmdBuffer->layerCount == RCLayerCountDDS);
+    const uint8_t tuWidthShift = dds ? 2 : 1;
+    const LdeTransformType transformType = dds ? TransformDDS : TransformDD;
+
+    /* Block ordered DDS commands cover a block of 64 TUs, everything else covers 256 TUs. */
+    const uint32_t commandTuShift = (!rasterOrder && dds) ? 6 : 8;
+    const uint32_t maskWords = (1U << commandTuShift) >> 6;
+
+    TUState tuState;
+    if (!ldeTuStateInitialize(&tuState, enhancementTile->tileWidth, enhancementTile->tileHeight,
+                              enhancementTile->tileX, enhancementTile->tileY, tuWidthShift)) {
+        return false;
+    }
+
+    const uint16_t rowPixelStride = (bitdepthFromFixedPoint(fixedPoint) > 8)
+                                        ? plane->rowByteStride >> 1
+                                        : plane->rowByteStride;
+    ApplyCmdBufferArgs args = {
+        .firstSample = (int16_t*)VN_PLANE_GETLINE(plane, 0),
+        .rowPixelStride = rowPixelStride,
+        .x = 0,
+        .y = 0,
+        .width = enhancementTile->planeWidth,
+        .height = enhancementTile->planeHeight,
+        .highlight = highlight,
+        .fixedPoint = fixedPoint,
+    };
+
+    for (uint32_t cmdIndex = firstCommand; cmdIndex < firstCommand + commandCount; ++cmdIndex) {
+        const LdeCmdBufferGpuCmd* cmd = &cmdBuffer->commands[cmdIndex];
+        const LdeCmdBufferGpuOperation operation = (LdeCmdBufferGpuOperation)cmd->operation;
+        const uint32_t firstTu = (uint32_t)cmd->blockIndex << commandTuShift;
+
+        ApplyCmdBufferFunction applyFn = NULL;
+        if (highlight) {
+            applyFn = kHighlightTable[transformType][fixedPoint];
+        } else {
+            switch (operation) {
+                case CBGOAdd: applyFn = kAddTable[transformType][fixedPoint]; break;
+                case CBGOSet:
+                case CBGOClearAndSet: applyFn = dds ? &setDDS : &setDD; break;
+                case CBGOSetZero: applyFn = dds ? &setZeroDDS : &setZeroDD; break;
+            }
+        }
+
+        if (operation == CBGOClearAndSet) {
+            ldeTuCoordsBlockAlignedRaster(&tuState, firstTu, &args.x, &args.y);
+            clear(&args);
+        }
+
+        const int16_t* residuals = cmdBuffer->residuals + cmd->dataOffset;
+        for (uint32_t word = 0; word < maskWords; ++word) {
+            uint64_t bitmask = cmd->bitmask[word];
+            while (bitmask) {
+                /* TUs are stored from the most significant bit down */
+                const uint32_t bit = (uint32_t)clz64(bitmask);
+                bitmask &= ~(0x8000000000000000ULL >> bit);
+
+                const uint32_t tuIndex = firstTu + (word << 6) + bit;
+                if (rasterOrder) {
+                    if (ldeTuCoordsSurfaceRaster(&tuState, tuIndex, &args.x, &args.y) == TUError) {
+                        return false;
+                    }
+                } else {
+                    ldeTuCoordsBlockAlignedRaster(&tuState, tuIndex, &args.x, &args.y);
+                }
+                assert(args.x < args.width && args.y < args.height);
+
+                /* DDS residuals are reordered on append exactly as for CPU cmdbuffers. */
+                if (operation != CBGOSetZero) {
+                    args.residuals = (int16_t*)residuals;
+                    residuals += cmdBuffer->layerCount;
+                }
+                applyFn(&args);
+            }
+        }
     }
     return true;
 }
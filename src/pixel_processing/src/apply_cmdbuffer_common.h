@@ -81,6 +81,26 @@ bool cmdBufferApplicatorSurfaceSSE(const LdpEnhancementTile* enhancementTile, si
                                    const LdpPicturePlaneDesc* plane, LdpFixedPoint fixedPoint,
                                    bool highlight);
 
+typedef bool (*CmdBufferBitmaskApplicator)(const LdpEnhancementTile* enhancementTile,
+                                           uint32_t firstCommand, uint32_t commandCount,
+                                           const LdpPicturePlaneDesc* plane,
+                                           LdpFixedPoint fixedPoint, bool rasterOrder,
+                                           bool highlight);
+
+bool cmdBufferApplicatorBitmaskScalar(const LdpEnhancementTile* enhancementTile,
+                                      uint32_t firstCommand, uint32_t commandCount,
+                                      const LdpPicturePlaneDesc* plane, LdpFixedPoint fixedPoint,
+                                      bool rasterOrder, bool highlight);
+
+bool cmdBufferApplicatorBitmaskNEON(const LdpEnhancementTile* enhancementTile,
+                                    uint32_t firstCommand, uint32_t commandCount,
+                                    const LdpPicturePlaneDesc* plane, LdpFixedPoint fixedPoint,
+                                    bool rasterOrder, bool highlight);
+
+bool cmdBufferApplicatorBitmaskSSE(const LdpEnhancementTile* enhancementTile, uint32_t firstCommand,
+                                   uint32_t commandCount, const LdpPicturePlaneDesc* plane,
+                                   LdpFixedPoint fixedPoint, bool rasterOrder, bool highlight);
+
 #define VN_UNUSED_CMDBUFFER_APPLICATOR() \
     VNUnused(enhancementTile);           \
     VNUnused(entryPointIdx);             \
@@ -89,6 +109,16 @@ bool cmdBufferApplicatorSurfaceSSE(const LdpEnhancementTile* enhancementTile, si
     VNUnused(highlight);                 \
     return false;
 
+#define VN_UNUSED_CMDBUFFER_BITMASK_APPLICATOR() \
+    VNUnused(enhancementTile);                   \
+    VNUnused(firstCommand);                      \
+    VNUnused(commandCount);                      \
+    VNUnused(plane);                             \
+    VNUnused(fixedPoint);                        \
+    VNUnused(rasterOrder);                       \
+    VNUnused(highlight);                         \
+    return false;
+
 /*------------------------------------------------------------------------------*/
 
 #endif // VN_LCEVC_PIXEL_PROCESSING_APPLY_CMDBUFFER_COMMON_H
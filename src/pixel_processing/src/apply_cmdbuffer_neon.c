@@ -378,6 +378,7 @@ static inline void clear(const ApplyCmdBufferArgs* args)
 
 #define cmdBufferApplicatorBlockTemplate cmdBufferApplicatorBlockNEON
 #define cmdBufferApplicatorSurfaceTemplate cmdBufferApplicatorSurfaceNEON
+#define cmdBufferApplicatorBitmaskTemplate cmdBufferApplicatorBitmaskNEON
 #include "apply_cmdbuffer_applicator.h"
 
 #else
@@ -395,4 +396,12 @@ bool cmdBufferApplicatorSurfaceNEON(const LdpEnhancementTile* enhancementTile, s
     VN_UNUSED_CMDBUFFER_APPLICATOR()
 }
 
+bool cmdBufferApplicatorBitmaskNEON(const LdpEnhancementTile* enhancementTile,
+                                    uint32_t firstCommand, uint32_t commandCount,
+                                    const LdpPicturePlaneDesc* plane, LdpFixedPoint fixedPoint,
+                                    bool rasterOrder, bool highlight)
+{
+    VN_UNUSED_CMDBUFFER_BITMASK_APPLICATOR()
+}
+
 #endif
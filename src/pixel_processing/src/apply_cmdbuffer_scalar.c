@@ -235,4 +235,5 @@ static inline void clear(const ApplyCmdBufferArgs* args)
 
 #define cmdBufferApplicatorBlockTemplate cmdBufferApplicatorBlockScalar
 #define cmdBufferApplicatorSurfaceTemplate cmdBufferApplicatorSurfaceScalar
+#define cmdBufferApplicatorBitmaskTemplate cmdBufferApplicatorBitmaskScalar
 #include "apply_cmdbuffer_applicator.h"
@@ -348,6 +348,7 @@ static inline void clear(const ApplyCmdBufferArgs* args)
 
 #define cmdBufferApplicatorBlockTemplate cmdBufferApplicatorBlockSSE
 #define cmdBufferApplicatorSurfaceTemplate cmdBufferApplicatorSurfaceSSE
+#define cmdBufferApplicatorBitmaskTemplate cmdBufferApplicatorBitmaskSSE
 #include "apply_cmdbuffer_applicator.h"
 
 #else
@@ -364,4 +365,11 @@ bool cmdBufferApplicatorSurfaceSSE(const LdpEnhancementTile* enhancementTile, si
     VN_UNUSED_CMDBUFFER_APPLICATOR()
 }
 
+bool cmdBufferApplicatorBitmaskSSE(const LdpEnhancementTile* enhancementTile, uint32_t firstCommand,
+                                   uint32_t commandCount, const LdpPicturePlaneDesc* plane,
+                                   LdpFixedPoint fixedPoint, bool rasterOrder, bool highlight)
+{
+    VN_UNUSED_CMDBUFFER_BITMASK_APPLICATOR()
+}
+
 #endif
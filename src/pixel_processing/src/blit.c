@@ -15,45 +15,64 @@
 #include <LCEVC/pixel_processing/blit.h>
 //
 #include "blit_common.h"
+#include "fp_types.h"
 //
 #include <LCEVC/common/acceleration.h>
 #include <LCEVC/common/limit.h>
 #include <LCEVC/common/log.h>
+#include <LCEVC/enhancement/bitstream_types.h>
 //
 #include <assert.h>
 
 /*------------------------------------------------------------------------------*/
 
 PlaneBlitFunction planeBlitGetFunctionScalar(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
-                                             LdppBlendingMode blending, uint32_t planeIndex, bool isNV12);
+                                             LdppBlendingMode blending, BlitPacking srcPacking,
+                                             BlitPacking dstPacking);
 PlaneBlitFunction planeBlitGetFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
-                                          LdppBlendingMode blending, uint32_t planeIndex, bool isNV12);
+                                          LdppBlendingMode blending, BlitPacking srcPacking,
+                                          BlitPacking dstPacking);
 PlaneBlitFunction planeBlitGetFunctionNEON(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
                                            LdppBlendingMode blending);
 
 PlaneBlitFunction planeBlitGetFunction(LdpFixedPoint srcFP, LdpFixedPoint dstFP, LdppBlendingMode blending,
-                                       bool forceScalar, uint32_t planeIndex, bool isNV12)
+                                       bool forceScalar, BlitPacking srcPacking,
+                                       BlitPacking dstPacking)
 {
     PlaneBlitFunction res = NULL;
     const LdcAcceleration* acceleration = ldcAccelerationGet();
 
     if (!forceScalar && acceleration->SSE) {
-        res = planeBlitGetFunctionSSE(srcFP, dstFP, blending, planeIndex, isNV12);
+        res = planeBlitGetFunctionSSE(srcFP, dstFP, blending, srcPacking, dstPacking);
     }
 
-    if (!forceScalar && acceleration->NEON) {
+    if (!forceScalar && acceleration->NEON && srcPacking == BPPlanar && dstPacking == BPPlanar) {
         assert(res == NULL);
         // No SIMD functions for BMCopy on NEON - fallthrough to scalar
         res = planeBlitGetFunctionNEON(srcFP, dstFP, blending);
     }
 
     if (!res) {
-        res = planeBlitGetFunctionScalar(srcFP, dstFP, blending, planeIndex, isNV12);
+        res = planeBlitGetFunctionScalar(srcFP, dstFP, blending, srcPacking, dstPacking);
     }
 
     return res;
 }
 
+/* Work out how the samples of one plane of a layout are packed. */
+static BlitPacking blitPacking(const LdpPictureLayout* layout, uint32_t planeIndex)
+{
+    if (!ldpPictureLayoutIsSemiPlanar(layout)) {
+        return BPPlanar;
+    }
+
+    uint32_t packing = (planeIndex > 0) ? BPInterleaved : BPPlanar;
+    if (layout->layoutInfo->bits == 16 && !fixedPointIsSigned(layout->layoutInfo->fixedPoint)) {
+        packing |= BPMSBAligned;
+    }
+    return (BlitPacking)packing;
+}
+
 /*------------------------------------------------------------------------------*/
 
 typedef struct LdppBlitSlicedJobContext
@@ -62,14 +81,20 @@ typedef struct LdppBlitSlicedJobContext
     const LdpPicturePlaneDesc src;
     const LdpPicturePlaneDesc dst;
     uint32_t minWidth;
+    const LdpPicturePlaneDesc src2;
+    bool interleave;
 } LdppBlitSlicedJobContext;
 
+/* Smallest number of samples in a part of a sliced blit. */
+static const uint32_t kBlitMinPartSamples = 16384;
+
 static bool blitSlicedJob(void* argument, uint32_t offset, uint32_t count)
 {
     VNTraceScopedBegin();
 
     const LdppBlitSlicedJobContext* context = (const LdppBlitSlicedJobContext*)argument;
-    const LdppBlitArgs args = {&context->src, &context->dst, context->minWidth, offset, count};
+    const LdppBlitArgs args = {&context->src, &context->dst, context->minWidth, offset, count,
+                               context->interleave ? &context->src2 : NULL};
 
     context->function(&args);
 
@@ -89,29 +114,185 @@ bool ldppPlaneBlit(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar, con
         minU32(srcLayout->height >> srcLayout->layoutInfo->planeHeightShift[planeIndex],
                dstLayout->height >> dstLayout->layoutInfo->planeHeightShift[planeIndex]);
 
-    const bool isNV12 = srcLayout->layoutInfo->format == LdpColorFormatNV12_8 ||
-                        dstLayout->layoutInfo->format == LdpColorFormatNV12_8;
-    if (isNV12 && planeIndex == 2) {
-        if (srcLayout->layoutInfo->fixedPoint == LdpFPU8) {
-            srcPlane->firstSample++;
+    const BlitPacking srcPacking = blitPacking(srcLayout, planeIndex);
+    const BlitPacking dstPacking = blitPacking(dstLayout, planeIndex);
+    LdpPicturePlaneDesc src = *srcPlane;
+
+    if (srcPacking != dstPacking) {
+        if (dstPacking & BPInterleaved) {
+            VNLogError("interleaved destinations are written by ldppPlaneBlitInterleave()\n");
+            return false;
         }
-        if (dstLayout->layoutInfo->fixedPoint == LdpFPU8) {
-            dstPlane->firstSample++;
+        // Start at this plane's component within the interleaved plane
+        if (srcPacking & BPInterleaved) {
+            src.firstSample += srcLayout->layoutInfo->offset[planeIndex];
         }
     }
 
     LdppBlitSlicedJobContext slicedJobContext = {
         planeBlitGetFunction(srcLayout->layoutInfo->fixedPoint, dstLayout->layoutInfo->fixedPoint,
-                             blending, forceScalar, planeIndex, isNV12),
-        *srcPlane, *dstPlane, width};
+                             blending, forceScalar, srcPacking, dstPacking),
+        src, *dstPlane, width};
 
     if (!slicedJobContext.function) {
         VNLogError("failed to find function to perform blitting with\n");
         return false;
     }
 
+    // Keep parts of narrow planes big enough to be worth handing to another thread
+    const LdcTaskSliceHints hints = {.minGrain = maxU32(1, kBlitMinPartSamples / maxU32(width, 1))};
+
     return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &blitSlicedJob, NULL, &slicedJobContext,
-                                        sizeof(slicedJobContext), height);
+                                        sizeof(slicedJobContext), height, &hints);
+}
+
+/*------------------------------------------------------------------------------*/
+
+bool ldppPlaneBlitInterleave(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar,
+                             const LdpPictureLayout* srcLayout, const LdpPictureLayout* dstLayout,
+                             const LdpPicturePlaneDesc srcPlanes[2], LdpPicturePlaneDesc* dstPlane)
+{
+    // Chroma planes have the same dimensions, and the interleaved plane is plane 1
+    const uint32_t width = minU32(srcLayout->width >> srcLayout->layoutInfo->planeWidthShift[1],
+                                  dstLayout->width >> dstLayout->layoutInfo->planeWidthShift[1]);
+
+    const uint32_t height = minU32(srcLayout->height >> srcLayout->layoutInfo->planeHeightShift[1],
+                                   dstLayout->height >> dstLayout->layoutInfo->planeHeightShift[1]);
+
+    const BlitPacking srcPacking = blitPacking(srcLayout, 1);
+    const BlitPacking dstPacking = blitPacking(dstLayout, 1);
+
+    if (srcPacking != BPPlanar || !(dstPacking & BPInterleaved)) {
+        VNLogError("interleaving blit needs planar sources and an interleaved destination\n");
+        return false;
+    }
+
+    // Order the sources as their components are in memory, i.e. V first for NV21
+    const uint32_t first = (dstLayout->layoutInfo->offset[1] == 0) ? 0 : 1;
+
+    LdppBlitSlicedJobContext slicedJobContext = {
+        planeBlitGetFunction(srcLayout->layoutInfo->fixedPoint, dstLayout->layoutInfo->fixedPoint,
+                             BMCopy, forceScalar, srcPacking, dstPacking),
+        srcPlanes[first], *dstPlane, width, srcPlanes[1 - first], true};
+
+    if (!slicedJobContext.function) {
+        VNLogError("failed to find function to perform blitting with\n");
+        return false;
+    }
+
+    // Keep parts of narrow planes big enough to be worth handing to another thread
+    const LdcTaskSliceHints hints = {.minGrain = maxU32(1, kBlitMinPartSamples / maxU32(width, 1))};
+
+    return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &blitSlicedJob, NULL, &slicedJobContext,
+                                        sizeof(slicedJobContext), height, &hints);
+}
+
+/*------------------------------------------------------------------------------*/
+
+typedef struct LdppBlitBlocksSlicedJobContext
+{
+    PlaneBlitFunction function;
+    const LdpPicturePlaneDesc src;
+    const LdpPicturePlaneDesc dst;
+    uint32_t width;
+    uint32_t height;
+    uint32_t srcSampleSize;
+    uint32_t dstSampleSize;
+    const uint8_t* blockMap;
+    uint32_t blocksAcross;
+} LdppBlitBlocksSlicedJobContext;
+
+/* Each slice is a range of block rows - runs of marked blocks along a row are blitted together. */
+static bool blitBlocksSlicedJob(void* argument, uint32_t offset, uint32_t count)
+{
+    VNTraceScopedBegin();
+
+    const LdppBlitBlocksSlicedJobContext* context = (const LdppBlitBlocksSlicedJobContext*)argument;
+
+    for (uint32_t blockRow = offset; blockRow < offset + count; ++blockRow) {
+        const uint8_t* rowMap = context->blockMap + (size_t)blockRow * context->blocksAcross;
+        const uint32_t y = blockRow << BSTemporalShift;
+        const uint32_t rows = minU32(BSTemporal, context->height - y);
+
+        uint32_t block = 0;
+        while (block < context->blocksAcross) {
+            if (!rowMap[block]) {
+                block++;
+                continue;
+            }
+
+            const uint32_t runStart = block;
+            while (block < context->blocksAcross && rowMap[block]) {
+                block++;
+            }
+
+            const uint32_t x = runStart << BSTemporalShift;
+            LdpPicturePlaneDesc src = context->src;
+            LdpPicturePlaneDesc dst = context->dst;
+            src.firstSample += x * context->srcSampleSize;
+            dst.firstSample += x * context->dstSampleSize;
+
+            const LdppBlitArgs args = {
+                &src, &dst, minU32(block << BSTemporalShift, context->width) - x, y, rows, NULL};
+            context->function(&args);
+        }
+    }
+
+    VNTraceScopedEnd();
+    return true;
+}
+
+bool ldppPlaneBlitBlocks(LdcTaskPool* taskPool, LdcTask* parent, bool forceScalar,
+                         uint32_t planeIndex, const LdpPictureLayout* srcLayout,
+                         const LdpPictureLayout* dstLayout, const LdpPicturePlaneDesc* srcPlane,
+                         const LdpPicturePlaneDesc* dstPlane, LdppBlendingMode blending,
+                         const uint8_t* blockMap, uint32_t blocksAcross)
+{
+    const uint32_t width =
+        minU32(srcLayout->width >> srcLayout->layoutInfo->planeWidthShift[planeIndex],
+               dstLayout->width >> dstLayout->layoutInfo->planeWidthShift[planeIndex]);
+
+    const uint32_t height =
+        minU32(srcLayout->height >> srcLayout->layoutInfo->planeHeightShift[planeIndex],
+               dstLayout->height >> dstLayout->layoutInfo->planeHeightShift[planeIndex]);
+
+    if (blitPacking(srcLayout, planeIndex) != BPPlanar ||
+        blitPacking(dstLayout, planeIndex) != BPPlanar) {
+        VNLogError("block blits need planar source and destination\n");
+        return false;
+    }
+
+    if (blocksAcross < ((width + BSTemporal - 1) >> BSTemporalShift)) {
+        VNLogError("block map is narrower than the plane\n");
+        return false;
+    }
+
+    const LdpFixedPoint srcFP = srcLayout->layoutInfo->fixedPoint;
+    const LdpFixedPoint dstFP = dstLayout->layoutInfo->fixedPoint;
+
+    LdppBlitBlocksSlicedJobContext slicedJobContext = {
+        planeBlitGetFunction(srcFP, dstFP, blending, forceScalar, BPPlanar, BPPlanar),
+        *srcPlane,
+        *dstPlane,
+        width,
+        height,
+        fixedPointByteSize(srcFP),
+        fixedPointByteSize(dstFP),
+        blockMap,
+        blocksAcross};
+
+    if (!slicedJobContext.function) {
+        VNLogError("failed to find function to perform blitting with\n");
+        return false;
+    }
+
+    const uint32_t blockRows = (height + BSTemporal - 1) >> BSTemporalShift;
+    const uint32_t blockRowSamples = maxU32(width, 1) << BSTemporalShift;
+    const LdcTaskSliceHints hints = {.minGrain = maxU32(1, kBlitMinPartSamples / blockRowSamples)};
+
+    return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &blitBlocksSlicedJob, NULL,
+                                        &slicedJobContext, sizeof(slicedJobContext), blockRows,
+                                        &hints);
 }
 
 /*------------------------------------------------------------------------------*/
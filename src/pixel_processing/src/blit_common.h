@@ -55,7 +55,13 @@ typedef struct LdpPicturePlaneDesc LdpPicturePlaneDesc;
 
 #define VN_PLANE_GETLINE(pl, offset) (pl->firstSample + (offset * pl->rowByteStride))
 
-#define VN_BLIT_PER_PIXEL_BODY(Src_t, Dst_t, ...)                            \
+#define VN_BLIT_PER_PIXEL_BODY(Src_t, Dst_t, ...) \
+    VN_BLIT_PER_PIXEL_BODY_STEP(Src_t, Dst_t, 1, 1, __VA_ARGS__)
+
+/*! \brief As VN_BLIT_PER_PIXEL_BODY, but stepping over srcStep and dstStep samples per pixel,
+ *         to read or write one component of an interleaved plane, eg: the U of NV12's UV plane.
+ */
+#define VN_BLIT_PER_PIXEL_BODY_STEP(Src_t, Dst_t, srcStep, dstStep, ...)     \
     const LdpPicturePlaneDesc* src = args->src;                              \
     const LdpPicturePlaneDesc* dst = args->dst;                              \
     const uint32_t srcStride = src->rowByteStride / sizeof(Src_t);           \
@@ -67,14 +73,45 @@ typedef struct LdpPicturePlaneDesc LdpPicturePlaneDesc;
         const Src_t* srcPixel = srcRow;                                      \
         Dst_t* dstPixel = dstRow;                                            \
         for (uint32_t x = 0; x < args->minWidth; ++x) {                      \
-            int32_t srcValue = (int32_t)*srcPixel++;                         \
+            int32_t srcValue = (int32_t)*srcPixel;                           \
+            srcPixel += (srcStep);                                           \
             VN_CALL_OP(__VA_ARGS__);                                         \
-            *dstPixel++ = (Dst_t)dstValue;                                   \
+            *dstPixel = (Dst_t)dstValue;                                     \
+            dstPixel += (dstStep);                                           \
         }                                                                    \
         srcRow += srcStride;                                                 \
         dstRow += dstStride;                                                 \
     }
 
+/*! \brief As VN_BLIT_PER_PIXEL_BODY, but interleaving `args->src` and `args->src2` into pairs of
+ *         destination samples, eg: the U and V planes into NV12's UV plane.
+ */
+#define VN_BLIT_INTERLEAVE_BODY(Src_t, Dst_t, ...)                                 \
+    const LdpPicturePlaneDesc* src = args->src;                                    \
+    const LdpPicturePlaneDesc* src2 = args->src2;                                  \
+    const LdpPicturePlaneDesc* dst = args->dst;                                    \
+    const uint32_t srcStride = src->rowByteStride / sizeof(Src_t);                 \
+    const uint32_t src2Stride = src2->rowByteStride / sizeof(Src_t);               \
+    const uint32_t dstStride = dst->rowByteStride / sizeof(Dst_t);                 \
+    const Src_t* srcRow = (const Src_t*)VN_PLANE_GETLINE(src, args->offset);       \
+    const Src_t* src2Row = (const Src_t*)VN_PLANE_GETLINE(src2, args->offset);     \
+    Dst_t* dstRow = (Dst_t*)VN_PLANE_GETLINE(dst, args->offset);                   \
+    int32_t dstValue = 0;                                                          \
+    for (uint32_t y = 0; y < args->count; ++y) {                                   \
+        Dst_t* dstPixel = dstRow;                                                  \
+        for (uint32_t x = 0; x < args->minWidth; ++x) {                            \
+            int32_t srcValue = (int32_t)srcRow[x];                                 \
+            VN_CALL_OP(__VA_ARGS__);                                               \
+            *dstPixel++ = (Dst_t)dstValue;                                         \
+            srcValue = (int32_t)src2Row[x];                                        \
+            VN_CALL_OP(__VA_ARGS__);                                               \
+            *dstPixel++ = (Dst_t)dstValue;                                         \
+        }                                                                          \
+        srcRow += srcStride;                                                       \
+        src2Row += src2Stride;                                                     \
+        dstRow += dstStride;                                                       \
+    }
+
 /*! \brief Helper macro for setting up the boilerplate code used for each specialized
  *  implementation. It initializes several variables that each implementation
  *  will need
@@ -111,15 +148,29 @@ typedef struct LdpPicturePlaneDesc LdpPicturePlaneDesc;
 /*! \brief Arguments passed to the specialised blit function implementations. */
 typedef struct LdppBlitArgs
 {
-    const struct LdpPicturePlaneDesc* src; /**< Source plane to blit from. */
-    const struct LdpPicturePlaneDesc* dst; /**< Destination plane to blit to. */
-    uint32_t minWidth;                     /**< Minimum plane width. */
-    uint32_t offset;                       /**< Row offset to start processing from. */
-    uint32_t count;                        /**< Number of rows to process. */
+    const struct LdpPicturePlaneDesc* src;  /**< Source plane to blit from. */
+    const struct LdpPicturePlaneDesc* dst;  /**< Destination plane to blit to. */
+    uint32_t minWidth;                      /**< Minimum plane width. */
+    uint32_t offset;                        /**< Row offset to start processing from. */
+    uint32_t count;                         /**< Number of rows to process. */
+    const struct LdpPicturePlaneDesc* src2; /**< Second source to interleave, otherwise NULL. */
 } LdppBlitArgs;
 
 typedef void (*PlaneBlitFunction)(const LdppBlitArgs* args);
 
+/*! \brief How the samples of an external plane are packed, beyond what its fixed point type says.
+ *
+ * These are flags - a P010 chroma component is both interleaved and MSB aligned. Internal planes
+ * are always planar.
+ */
+typedef enum BlitPacking
+{
+    BPPlanar = 0,           /**< Contiguous samples in the low bits of each sample. */
+    BPInterleaved = 1 << 0, /**< Both chroma components of NV12/P010 etc. in alternate samples. */
+    BPMSBAligned = 1 << 1,  /**< Samples in the high bits of 16 bit containers, i.e. P010. */
+    BPCount = 4
+} BlitPacking;
+
 /*------------------------------------------------------------------------------*/
 
 #ifdef __cplusplus
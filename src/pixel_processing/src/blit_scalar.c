@@ -73,27 +73,37 @@ static void copyU12ToS16(const LdppBlitArgs* args) { VN_BLIT_PER_PIXEL_BODY(uint
 
 static void copyU14ToS16(const LdppBlitArgs* args) { VN_BLIT_PER_PIXEL_BODY(uint16_t, int16_t, 1) }
 
-static void copyU8ToS16Nv12(const LdppBlitArgs* args)
+static void copyU8ToS16Interleaved(const LdppBlitArgs* args)
 {
-    const LdpPicturePlaneDesc* src = args->src;
-    const LdpPicturePlaneDesc* dst = args->dst;
-    const uint32_t srcStride = src->rowByteStride / sizeof(uint8_t);
-    const uint32_t dstStride = dst->rowByteStride / sizeof(int16_t);
-    const uint8_t* srcRow = VN_PLANE_GETLINE(src, args->offset);
-    int16_t* dstRow = (int16_t*)VN_PLANE_GETLINE(dst, args->offset);
-    int32_t dstValue = 0;
-    for (uint32_t y = 0; y < args->count; ++y) {
-        const uint8_t* srcPixel = srcRow;
-        int16_t* dstPixel = dstRow;
-        for (uint32_t x = 0; x < args->minWidth; ++x) {
-            int32_t srcValue = (int32_t)*srcPixel;
-            srcPixel += 2;
-            VN_SURFACE_OP(7);
-            *dstPixel++ = (int16_t)dstValue;
-        }
-        srcRow += srcStride;
-        dstRow += dstStride;
-    }
+    VN_BLIT_PER_PIXEL_BODY_STEP(uint8_t, int16_t, 2, 1, 7)
+}
+
+#undef VN_SURFACE_OP
+
+/*------------------------------------------------------------------------------
+ * Copy MSB aligned UN to S16
+ *------------------------------------------------------------------------------*/
+
+#define VN_SURFACE_OP(msbShift, shift) dstValue = ((srcValue >> (msbShift)) << (shift)) - 16384;
+
+static void copyU10MsbToS16(const LdppBlitArgs* args)
+{
+    VN_BLIT_PER_PIXEL_BODY(uint16_t, int16_t, 6, 5)
+}
+
+static void copyU14MsbToS16(const LdppBlitArgs* args)
+{
+    VN_BLIT_PER_PIXEL_BODY(uint16_t, int16_t, 2, 1)
+}
+
+static void copyU10MsbToS16Interleaved(const LdppBlitArgs* args)
+{
+    VN_BLIT_PER_PIXEL_BODY_STEP(uint16_t, int16_t, 2, 1, 6, 5)
+}
+
+static void copyU14MsbToS16Interleaved(const LdppBlitArgs* args)
+{
+    VN_BLIT_PER_PIXEL_BODY_STEP(uint16_t, int16_t, 2, 1, 2, 1)
 }
 
 #undef VN_SURFACE_OP
@@ -126,27 +136,39 @@ static void copyS16ToU14(const LdppBlitArgs* args)
     VN_BLIT_PER_PIXEL_BODY(int16_t, uint16_t, 1, 1, 8192, 16383)
 }
 
-static void copyS16ToU8Nv12(const LdppBlitArgs* args)
+static void interleaveS16ToU8(const LdppBlitArgs* args)
 {
-    const LdpPicturePlaneDesc* src = args->src;
-    const LdpPicturePlaneDesc* dst = args->dst;
-    const uint32_t srcStride = src->rowByteStride / sizeof(int16_t);
-    const uint32_t dstStride = dst->rowByteStride / sizeof(uint8_t);
-    const int16_t* srcRow = (const int16_t*)VN_PLANE_GETLINE(src, args->offset);
-    uint8_t* dstRow = VN_PLANE_GETLINE(dst, args->offset);
-    int32_t dstValue = 0;
-    for (uint32_t y = 0; y < args->count; ++y) {
-        const int16_t* srcPixel = srcRow;
-        uint8_t* dstPixel = dstRow;
-        for (uint32_t x = 0; x < args->minWidth; ++x) {
-            int32_t srcValue = (int32_t)*srcPixel++;
-            VN_SURFACE_OP(64, 7, 128, 255);
-            *dstPixel = (uint8_t)dstValue;
-            dstPixel += 2;
-        }
-        srcRow += srcStride;
-        dstRow += dstStride;
-    }
+    VN_BLIT_INTERLEAVE_BODY(int16_t, uint8_t, 64, 7, 128, 255)
+}
+
+#undef VN_SURFACE_OP
+
+/*------------------------------------------------------------------------------
+ * Copy S16 to MSB aligned UN
+ *------------------------------------------------------------------------------*/
+
+#define VN_SURFACE_OP(rounding, shift, signOffset, maxValue, msbShift) \
+    srcValue = ((srcValue + (rounding)) >> (shift)) + (signOffset);    \
+    dstValue = (srcValue < 0 ? 0 : srcValue > (maxValue) ? (maxValue) : srcValue) << (msbShift)
+
+static void copyS16ToU10Msb(const LdppBlitArgs* args)
+{
+    VN_BLIT_PER_PIXEL_BODY(int16_t, uint16_t, 16, 5, 512, 1023, 6)
+}
+
+static void copyS16ToU14Msb(const LdppBlitArgs* args)
+{
+    VN_BLIT_PER_PIXEL_BODY(int16_t, uint16_t, 1, 1, 8192, 16383, 2)
+}
+
+static void interleaveS16ToU10Msb(const LdppBlitArgs* args)
+{
+    VN_BLIT_INTERLEAVE_BODY(int16_t, uint16_t, 16, 5, 512, 1023, 6)
+}
+
+static void interleaveS16ToU14Msb(const LdppBlitArgs* args)
+{
+    VN_BLIT_INTERLEAVE_BODY(int16_t, uint16_t, 1, 1, 8192, 16383, 2)
 }
 
 #undef VN_SURFACE_OP
@@ -186,6 +208,21 @@ static void copyU14ToU8(const LdppBlitArgs* args) { VN_BLIT_PER_PIXEL_BODY(uint1
 
 #undef VN_SURFACE_OP
 
+/*------------------------------------------------------------------------------
+ * Copy U8 between interleaved and planar - for reduced precision internal planes.
+ *------------------------------------------------------------------------------*/
+
+#define VN_SURFACE_OP() dstValue = srcValue
+
+static void copyU8InterleavedToU8(const LdppBlitArgs* args)
+{
+    VN_BLIT_PER_PIXEL_BODY_STEP(uint8_t, uint8_t, 2, 1)
+}
+
+static void interleaveU8ToU8(const LdppBlitArgs* args) { VN_BLIT_INTERLEAVE_BODY(uint8_t, uint8_t) }
+
+#undef VN_SURFACE_OP
+
 /*------------------------------------------------------------------------------
  * Copy identity - these are memory copies from one surface to another, consider at
  * the call-site to use the src surface in this situation where possible.
@@ -244,16 +281,77 @@ static const PlaneBlitFunction kCopyTable[LdpFPCount][LdpFPCount] = {
 	/* S14.1 */ {NULL,         NULL,          NULL,              &copyS16ToU14,     NULL,         NULL,          NULL,          NULL}
 };
 
+/* Conversions between packed external planes and internal planes, indexed by packing and the
+ * external plane's fixed point type. Interleaved destinations are written from both chroma planes
+ * at once. */
+static const PlaneBlitFunction kCopyFromPackedTable[BPCount][LdpFPU14 + 1] = {
+	/* packing           U8                       U10                          U12   U14 */
+	/* Planar        */ {NULL,                    NULL,                        NULL, NULL},
+	/* Interleaved   */ {&copyU8ToS16Interleaved, NULL,                        NULL, NULL},
+	/* MSB           */ {NULL,                    &copyU10MsbToS16,            NULL, &copyU14MsbToS16},
+	/* Interl. + MSB */ {NULL,                    &copyU10MsbToS16Interleaved, NULL, &copyU14MsbToS16Interleaved},
+};
+
+static const PlaneBlitFunction kCopyToPackedTable[BPCount][LdpFPU14 + 1] = {
+	/* packing           U8                       U10                          U12   U14 */
+	/* Planar        */ {NULL,                    NULL,                        NULL, NULL},
+	/* Interleaved   */ {&interleaveS16ToU8,      NULL,                        NULL, NULL},
+	/* MSB           */ {NULL,                    &copyS16ToU10Msb,            NULL, &copyS16ToU14Msb},
+	/* Interl. + MSB */ {NULL,                    &interleaveS16ToU10Msb,      NULL, &interleaveS16ToU14Msb},
+};
+
+/* Reduced precision internal planes keep the external unsigned fixed point, so only the packing
+ * changes. Indexed as above. */
+static const PlaneBlitFunction kUnpackTable[BPCount][LdpFPU14 + 1] = {
+	/* packing           U8                       U10   U12   U14 */
+	/* Planar        */ {NULL,                    NULL, NULL, NULL},
+	/* Interleaved   */ {&copyU8InterleavedToU8,  NULL, NULL, NULL},
+	/* MSB           */ {NULL,                    NULL, NULL, NULL},
+	/* Interl. + MSB */ {NULL,                    NULL, NULL, NULL},
+};
+
+static const PlaneBlitFunction kPackTable[BPCount][LdpFPU14 + 1] = {
+	/* packing           U8                       U10   U12   U14 */
+	/* Planar        */ {NULL,                    NULL, NULL, NULL},
+	/* Interleaved   */ {&interleaveU8ToU8,       NULL, NULL, NULL},
+	/* MSB           */ {NULL,                    NULL, NULL, NULL},
+	/* Interl. + MSB */ {NULL,                    NULL, NULL, NULL},
+};
+
 /* clang-format on */
 
 /*------------------------------------------------------------------------------*/
 
+static PlaneBlitFunction packedCopyFunction(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                            BlitPacking srcPacking, BlitPacking dstPacking)
+{
+    if (srcFP == dstFP && !fixedPointIsSigned(srcFP)) {
+        return (dstPacking == BPPlanar) ? kUnpackTable[srcPacking][srcFP]
+                                        : kPackTable[dstPacking][dstFP];
+    }
+
+    /* MSB aligned containers can hold any internal precision, otherwise keep to the planar rules */
+    if (!((srcPacking | dstPacking) & BPMSBAligned) && !kCopyTable[srcFP][dstFP]) {
+        return NULL;
+    }
+
+    if (dstPacking == BPPlanar && !fixedPointIsSigned(srcFP) && fixedPointIsSigned(dstFP)) {
+        return kCopyFromPackedTable[srcPacking][srcFP];
+    }
+    if (srcPacking == BPPlanar && fixedPointIsSigned(srcFP) && !fixedPointIsSigned(dstFP)) {
+        return kCopyToPackedTable[dstPacking][dstFP];
+    }
+
+    return NULL;
+}
+
 PlaneBlitFunction planeBlitGetFunctionScalar(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
-                                             LdppBlendingMode blending, uint32_t planeIndex, bool isNV12)
+                                             LdppBlendingMode blending, BlitPacking srcPacking,
+                                             BlitPacking dstPacking)
 {
     if (blending == BMAdd) {
         /* Additive blending is expecting srcFP to be residuals int16_t */
-        if (srcFP != fixedPointHighPrecision(dstFP)) {
+        if (srcFP != fixedPointHighPrecision(dstFP) || (srcPacking | dstPacking) != BPPlanar) {
             return NULL;
         }
 
@@ -261,16 +359,12 @@ PlaneBlitFunction planeBlitGetFunctionScalar(LdpFixedPoint srcFP, LdpFixedPoint
     }
 
     if (blending == BMCopy) {
-        if ((srcFP == dstFP) || (fixedPointIsSigned(srcFP) && fixedPointIsSigned(dstFP))) {
+        if (srcPacking == dstPacking &&
+            ((srcFP == dstFP) || (fixedPointIsSigned(srcFP) && fixedPointIsSigned(dstFP)))) {
             return &copyIdentity;
         }
-        if (isNV12 && planeIndex > 0) {
-            if (srcFP == LdpFPU8 && dstFP == LdpFPS8) {
-                return &copyU8ToS16Nv12;
-            } else if (srcFP == LdpFPS8 && dstFP == LdpFPU8) {
-                return &copyS16ToU8Nv12;
-            }
-            return NULL;
+        if (srcPacking != BPPlanar || dstPacking != BPPlanar) {
+            return packedCopyFunction(srcFP, dstFP, srcPacking, dstPacking);
         }
 
         return kCopyTable[srcFP][dstFP];
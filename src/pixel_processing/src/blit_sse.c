@@ -488,6 +488,316 @@ static void copyS16_U16_SSE(const LdppBlitArgs* args, const int16_t shift, const
     }
 }
 
+/* Copy one component of interleaved U8 to S16: (val << 7) - 0x4000 */
+static void copyU8Interleaved_S16_SSE(const LdppBlitArgs* args)
+{
+    static const int16_t kShift = 7;
+    const __m128i offset = _mm_set1_epi16(0x4000);
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+
+    VN_BLIT_SIMD_BOILERPLATE(uint8_t, int16_t);
+
+    /* The SIMD loop reads the byte after its last sample - keep that within the row. */
+    const uint32_t safeWidth =
+        (simdWidth == width && width > 0) ? simdAlignment(width - 1) : simdWidth;
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const uint8_t* srcPixel = srcRow;
+        int16_t* dstPixel0 = dstRow;
+        int16_t* dstPixel1 = dstRow + 8;
+        uint32_t x = 0;
+
+        for (; x < safeWidth;
+             x += kStep, srcPixel += 2 * kStep, dstPixel0 += kStep, dstPixel1 += kStep) {
+            /* Load 16 pairs, keeping the first of each */
+            __m128i left = _mm_loadu_si128((const __m128i*)srcPixel);
+            __m128i right = _mm_loadu_si128((const __m128i*)(srcPixel + 16));
+            left = _mm_and_si128(left, mask);
+            right = _mm_and_si128(right, mask);
+
+            /* val <<= shift */
+            left = _mm_slli_epi16(left, kShift);
+            right = _mm_slli_epi16(right, kShift);
+
+            /* val -= sign_offset */
+            left = _mm_sub_epi16(left, offset);
+            right = _mm_sub_epi16(right, offset);
+
+            /* Store 16-pixels */
+            _mm_storeu_si128((__m128i*)dstPixel0, left);
+            _mm_storeu_si128((__m128i*)dstPixel1, right);
+        }
+
+        for (; x < width; x++, srcPixel += 2, dstPixel0++) {
+            *dstPixel0 = fpU16ToS16(*srcPixel, kShift);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Keep the first of each pair of 16 bit samples in 4 vectors, and pack them into 2 vectors. */
+static inline void deinterleaveU16(const uint16_t* src, __m128i* left, __m128i* right)
+{
+    const __m128i mask = _mm_set1_epi32(0xFFFF);
+
+    const __m128i in0 = _mm_and_si128(_mm_loadu_si128((const __m128i*)src), mask);
+    const __m128i in1 = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + 8)), mask);
+    const __m128i in2 = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + 16)), mask);
+    const __m128i in3 = _mm_and_si128(_mm_loadu_si128((const __m128i*)(src + 24)), mask);
+
+    *left = _mm_packus_epi32(in0, in1);
+    *right = _mm_packus_epi32(in2, in3);
+}
+
+/* Copy MSB aligned U16 to S16, planar or one component of interleaved:
+ * ((val >> msbShift) << shift) - 0x4000 */
+static inline void copyU16Msb_S16_SSE(const LdppBlitArgs* args, const int16_t msbShift,
+                                      const int16_t shift, const bool interleaved)
+{
+    const __m128i offset = _mm_set1_epi16(0x4000);
+    const uint32_t step = interleaved ? 2 : 1;
+
+    VN_BLIT_SIMD_BOILERPLATE(uint16_t, int16_t);
+
+    /* An interleaved SIMD loop reads the sample after its last one - keep that within the row. */
+    const uint32_t safeWidth =
+        (interleaved && simdWidth == width && width > 0) ? simdAlignment(width - 1) : simdWidth;
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const uint16_t* srcPixel = srcRow;
+        int16_t* dstPixel0 = dstRow;
+        int16_t* dstPixel1 = dstRow + 8;
+        uint32_t x = 0;
+
+        for (; x < safeWidth;
+             x += kStep, srcPixel += step * kStep, dstPixel0 += kStep, dstPixel1 += kStep) {
+            __m128i left;
+            __m128i right;
+
+            /* Load 16-pixels */
+            if (interleaved) {
+                deinterleaveU16(srcPixel, &left, &right);
+            } else {
+                left = _mm_loadu_si128((const __m128i*)srcPixel);
+                right = _mm_loadu_si128((const __m128i*)(srcPixel + 8));
+            }
+
+            /* val = (val >> msbShift) << shift */
+            left = _mm_slli_epi16(_mm_srli_epi16(left, msbShift), shift);
+            right = _mm_slli_epi16(_mm_srli_epi16(right, msbShift), shift);
+
+            /* val -= signOffset */
+            left = _mm_sub_epi16(left, offset);
+            right = _mm_sub_epi16(right, offset);
+
+            /* Store 16-pixels */
+            _mm_storeu_si128((__m128i*)dstPixel0, left);
+            _mm_storeu_si128((__m128i*)dstPixel1, right);
+        }
+
+        for (; x < width; x++, srcPixel += step, dstPixel0++) {
+            *dstPixel0 = fpU16ToS16((uint16_t)(*srcPixel >> msbShift), shift);
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Convert 16 S8.7 samples to U8: ((val + 64) >> 7) + 128 */
+static inline __m128i convertS8_7_U8(const int16_t* src)
+{
+    const __m128i rounding = _mm_set1_epi16(0x40);
+    const __m128i offset = _mm_set1_epi16(0x80);
+
+    __m128i left = _mm_loadu_si128((const __m128i*)src);
+    __m128i right = _mm_loadu_si128((const __m128i*)(src + 8));
+
+    left = _mm_add_epi16(_mm_srai_epi16(_mm_adds_epi16(left, rounding), 7), offset);
+    right = _mm_add_epi16(_mm_srai_epi16(_mm_adds_epi16(right, rounding), 7), offset);
+
+    return _mm_packus_epi16(left, right);
+}
+
+/* Interleave 2 S8.7 planes into U8 pairs */
+static void interleaveS8_7_U8_SSE(const LdppBlitArgs* args)
+{
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint8_t);
+
+    const uint32_t src2Stride = args->src2->rowByteStride / sizeof(int16_t);
+    const int16_t* src2Row = (const int16_t*)VN_PLANE_GETLINE(args->src2, args->offset);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        uint8_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, dstPixel += 2 * kStep) {
+            const __m128i first = convertS8_7_U8(srcRow + x);
+            const __m128i second = convertS8_7_U8(src2Row + x);
+
+            /* Interleave & store 16 pairs */
+            _mm_storeu_si128((__m128i*)dstPixel, _mm_unpacklo_epi8(first, second));
+            _mm_storeu_si128((__m128i*)(dstPixel + 16), _mm_unpackhi_epi8(first, second));
+        }
+
+        for (; x < width; x++, dstPixel += 2) {
+            dstPixel[0] = fpS8ToU8(srcRow[x]);
+            dstPixel[1] = fpS8ToU8(src2Row[x]);
+        }
+
+        srcRow += srcStride;
+        src2Row += src2Stride;
+        dstRow += dstStride;
+    }
+}
+
+/* Copy one component of interleaved U8 to planar U8 */
+static void copyU8Interleaved_U8_SSE(const LdppBlitArgs* args)
+{
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+
+    VN_BLIT_SIMD_BOILERPLATE(uint8_t, uint8_t);
+
+    /* The SIMD loop reads the byte after its last sample - keep that within the row. */
+    const uint32_t safeWidth =
+        (simdWidth == width && width > 0) ? simdAlignment(width - 1) : simdWidth;
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        const uint8_t* srcPixel = srcRow;
+        uint8_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < safeWidth; x += kStep, srcPixel += 2 * kStep, dstPixel += kStep) {
+            /* Load 16 pairs, keeping the first of each */
+            const __m128i left = _mm_and_si128(_mm_loadu_si128((const __m128i*)srcPixel), mask);
+            const __m128i right =
+                _mm_and_si128(_mm_loadu_si128((const __m128i*)(srcPixel + 16)), mask);
+
+            _mm_storeu_si128((__m128i*)dstPixel, _mm_packus_epi16(left, right));
+        }
+
+        for (; x < width; x++, srcPixel += 2, dstPixel++) {
+            *dstPixel = *srcPixel;
+        }
+
+        srcRow += srcStride;
+        dstRow += dstStride;
+    }
+}
+
+/* Interleave 2 U8 planes into U8 pairs */
+static void interleaveU8_U8_SSE(const LdppBlitArgs* args)
+{
+    VN_BLIT_SIMD_BOILERPLATE(uint8_t, uint8_t);
+
+    const uint32_t src2Stride = args->src2->rowByteStride;
+    const uint8_t* src2Row = VN_PLANE_GETLINE(args->src2, args->offset);
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        uint8_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep, dstPixel += 2 * kStep) {
+            const __m128i first = _mm_loadu_si128((const __m128i*)(srcRow + x));
+            const __m128i second = _mm_loadu_si128((const __m128i*)(src2Row + x));
+
+            /* Interleave & store 16 pairs */
+            _mm_storeu_si128((__m128i*)dstPixel, _mm_unpacklo_epi8(first, second));
+            _mm_storeu_si128((__m128i*)(dstPixel + 16), _mm_unpackhi_epi8(first, second));
+        }
+
+        for (; x < width; x++, dstPixel += 2) {
+            dstPixel[0] = srcRow[x];
+            dstPixel[1] = src2Row[x];
+        }
+
+        srcRow += srcStride;
+        src2Row += src2Stride;
+        dstRow += dstStride;
+    }
+}
+
+/* Convert 8 S16 samples to MSB aligned U16:
+ * clamped(0, maxValue, ((((val + rounding) >> shift) + signed_offset)) << msbShift */
+static inline __m128i convertS16_U16Msb(__m128i val, const int16_t shift, const __m128i rounding,
+                                        const __m128i offset, const __m128i maxV,
+                                        const int16_t msbShift)
+{
+    val = _mm_add_epi16(_mm_srai_epi16(_mm_adds_epi16(val, rounding), shift), offset);
+    val = _mm_max_epi16(_mm_min_epi16(val, maxV), _mm_setzero_si128());
+    return _mm_slli_epi16(val, msbShift);
+}
+
+/* Copy S16 to MSB aligned U16, from one plane, or interleaving 2 planes */
+static inline void copyS16_U16Msb_SSE(const LdppBlitArgs* args, const int16_t shift,
+                                      const int16_t signOffset, const uint16_t maxValue,
+                                      const int16_t msbShift, const bool interleaved)
+{
+    const int16_t roundingValue = (int16_t)(1 << (shift - 1));
+    const __m128i rounding = _mm_set1_epi16(roundingValue);
+    const __m128i offset = _mm_set1_epi16(signOffset);
+    const __m128i maxV = _mm_set1_epi16((int16_t)maxValue);
+
+    VN_BLIT_SIMD_BOILERPLATE(int16_t, uint16_t);
+
+    const uint32_t src2Stride = interleaved ? args->src2->rowByteStride / sizeof(int16_t) : 0;
+    const int16_t* src2Row =
+        interleaved ? (const int16_t*)VN_PLANE_GETLINE(args->src2, args->offset) : NULL;
+
+    for (uint32_t y = 0; y < args->count; y++) {
+        uint16_t* dstPixel = dstRow;
+        uint32_t x = 0;
+
+        for (; x < simdWidth; x += kStep) {
+            const __m128i left = convertS16_U16Msb(_mm_loadu_si128((const __m128i*)(srcRow + x)),
+                                                   shift, rounding, offset, maxV, msbShift);
+            const __m128i right =
+                convertS16_U16Msb(_mm_loadu_si128((const __m128i*)(srcRow + x + 8)), shift,
+                                  rounding, offset, maxV, msbShift);
+
+            if (interleaved) {
+                const __m128i left2 =
+                    convertS16_U16Msb(_mm_loadu_si128((const __m128i*)(src2Row + x)), shift,
+                                      rounding, offset, maxV, msbShift);
+                const __m128i right2 =
+                    convertS16_U16Msb(_mm_loadu_si128((const __m128i*)(src2Row + x + 8)), shift,
+                                      rounding, offset, maxV, msbShift);
+
+                /* Interleave & store 16 pairs */
+                _mm_storeu_si128((__m128i*)dstPixel, _mm_unpacklo_epi16(left, left2));
+                _mm_storeu_si128((__m128i*)(dstPixel + 8), _mm_unpackhi_epi16(left, left2));
+                _mm_storeu_si128((__m128i*)(dstPixel + 16), _mm_unpacklo_epi16(right, right2));
+                _mm_storeu_si128((__m128i*)(dstPixel + 24), _mm_unpackhi_epi16(right, right2));
+                dstPixel += 2 * kStep;
+            } else {
+                /* Store 16-pixels */
+                _mm_storeu_si128((__m128i*)dstPixel, left);
+                _mm_storeu_si128((__m128i*)(dstPixel + 8), right);
+                dstPixel += kStep;
+            }
+        }
+
+        for (; x < width; x++) {
+            *dstPixel++ =
+                (uint16_t)(fpS16ToU16(srcRow[x], shift, roundingValue, signOffset, maxValue)
+                           << msbShift);
+            if (interleaved) {
+                *dstPixel++ = (uint16_t)(fpS16ToU16(src2Row[x], shift, roundingValue, signOffset,
+                                                    maxValue)
+                                         << msbShift);
+            }
+        }
+
+        srcRow += srcStride;
+        if (interleaved) {
+            src2Row += src2Stride;
+        }
+        dstRow += dstStride;
+    }
+}
+
 static void copyU8_U10_SSE(const LdppBlitArgs* args) { copyU8_U16_SSE(args, 2); }
 
 static void copyU8_U12_SSE(const LdppBlitArgs* args) { copyU8_U16_SSE(args, 4); }
@@ -512,6 +822,40 @@ static void copyS16_U12_SSE(const LdppBlitArgs* args) { copyS16_U16_SSE(args, 3,
 
 static void copyS16_U14_SSE(const LdppBlitArgs* args) { copyS16_U16_SSE(args, 1, 0x2000, 16383); }
 
+static void copyU10Msb_S16_SSE(const LdppBlitArgs* args) { copyU16Msb_S16_SSE(args, 6, 5, false); }
+
+static void copyU14Msb_S16_SSE(const LdppBlitArgs* args) { copyU16Msb_S16_SSE(args, 2, 1, false); }
+
+static void copyU10MsbInterleaved_S16_SSE(const LdppBlitArgs* args)
+{
+    copyU16Msb_S16_SSE(args, 6, 5, true);
+}
+
+static void copyU14MsbInterleaved_S16_SSE(const LdppBlitArgs* args)
+{
+    copyU16Msb_S16_SSE(args, 2, 1, true);
+}
+
+static void copyS16_U10Msb_SSE(const LdppBlitArgs* args)
+{
+    copyS16_U16Msb_SSE(args, 5, 0x200, 1023, 6, false);
+}
+
+static void copyS16_U14Msb_SSE(const LdppBlitArgs* args)
+{
+    copyS16_U16Msb_SSE(args, 1, 0x2000, 16383, 2, false);
+}
+
+static void interleaveS16_U10Msb_SSE(const LdppBlitArgs* args)
+{
+    copyS16_U16Msb_SSE(args, 5, 0x200, 1023, 6, true);
+}
+
+static void interleaveS16_U14Msb_SSE(const LdppBlitArgs* args)
+{
+    copyS16_U16Msb_SSE(args, 1, 0x2000, 16383, 2, true);
+}
+
 /*------------------------------------------------------------------------------
  * Tables
  *------------------------------------------------------------------------------*/
@@ -541,26 +885,89 @@ static const PlaneBlitFunction kCopyTable[LdpFPCount][LdpFPCount] = {
 	/* S14.1 */ {NULL,             NULL,             NULL,             &copyS16_U14_SSE, NULL,            NULL,             NULL,             NULL},
 };
 
+/* Conversions between packed external planes and internal planes, indexed by packing and the
+ * external plane's fixed point type - as for the scalar tables. */
+static const PlaneBlitFunction kCopyFromPackedTable[BPCount][LdpFPU14 + 1] = {
+	/* packing           U8                          U10                             U12   U14 */
+	/* Planar        */ {NULL,                       NULL,                           NULL, NULL},
+	/* Interleaved   */ {&copyU8Interleaved_S16_SSE, NULL,                           NULL, NULL},
+	/* MSB           */ {NULL,                       &copyU10Msb_S16_SSE,            NULL, &copyU14Msb_S16_SSE},
+	/* Interl. + MSB */ {NULL,                       &copyU10MsbInterleaved_S16_SSE, NULL, &copyU14MsbInterleaved_S16_SSE},
+};
+
+static const PlaneBlitFunction kCopyToPackedTable[BPCount][LdpFPU14 + 1] = {
+	/* packing           U8                          U10                             U12   U14 */
+	/* Planar        */ {NULL,                       NULL,                           NULL, NULL},
+	/* Interleaved   */ {&interleaveS8_7_U8_SSE,     NULL,                           NULL, NULL},
+	/* MSB           */ {NULL,                       &copyS16_U10Msb_SSE,            NULL, &copyS16_U14Msb_SSE},
+	/* Interl. + MSB */ {NULL,                       &interleaveS16_U10Msb_SSE,      NULL, &interleaveS16_U14Msb_SSE},
+};
+
+/* Packing changes of reduced precision internal planes - as for the scalar tables. */
+static const PlaneBlitFunction kUnpackTable[BPCount][LdpFPU14 + 1] = {
+	/* packing           U8                          U10   U12   U14 */
+	/* Planar        */ {NULL,                       NULL, NULL, NULL},
+	/* Interleaved   */ {&copyU8Interleaved_U8_SSE,  NULL, NULL, NULL},
+	/* MSB           */ {NULL,                       NULL, NULL, NULL},
+	/* Interl. + MSB */ {NULL,                       NULL, NULL, NULL},
+};
+
+static const PlaneBlitFunction kPackTable[BPCount][LdpFPU14 + 1] = {
+	/* packing           U8                          U10   U12   U14 */
+	/* Planar        */ {NULL,                       NULL, NULL, NULL},
+	/* Interleaved   */ {&interleaveU8_U8_SSE,       NULL, NULL, NULL},
+	/* MSB           */ {NULL,                       NULL, NULL, NULL},
+	/* Interl. + MSB */ {NULL,                       NULL, NULL, NULL},
+};
+
 /* clang-format on */
 
 /*------------------------------------------------------------------------------*/
 
-PlaneBlitFunction planeBlitGetFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
-                                          LdppBlendingMode blending, uint32_t planeIndex, bool isNV12)
+static PlaneBlitFunction packedCopyFunction(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                            BlitPacking srcPacking, BlitPacking dstPacking)
 {
-    VNUnused(planeIndex);
+    if (srcFP == dstFP && !fixedPointIsSigned(srcFP)) {
+        return (dstPacking == BPPlanar) ? kUnpackTable[srcPacking][srcFP]
+                                        : kPackTable[dstPacking][dstFP];
+    }
 
+    /* MSB aligned containers can hold any internal precision, otherwise keep to the planar rules */
+    if (!((srcPacking | dstPacking) & BPMSBAligned) && !kCopyTable[srcFP][dstFP]) {
+        return NULL;
+    }
+
+    if (dstPacking == BPPlanar && !fixedPointIsSigned(srcFP) && fixedPointIsSigned(dstFP)) {
+        return kCopyFromPackedTable[srcPacking][srcFP];
+    }
+    if (srcPacking == BPPlanar && fixedPointIsSigned(srcFP) && !fixedPointIsSigned(dstFP)) {
+        return kCopyToPackedTable[dstPacking][dstFP];
+    }
+
+    return NULL;
+}
+
+PlaneBlitFunction planeBlitGetFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
+                                          LdppBlendingMode blending, BlitPacking srcPacking,
+                                          BlitPacking dstPacking)
+{
     if (blending == BMAdd) {
         /* Ensure formats match */
         assert(fixedPointIsValid(dstFP));
         assert(fixedPointHighPrecision(dstFP) == srcFP);
 
+        if ((srcPacking | dstPacking) != BPPlanar) {
+            return NULL;
+        }
         return kAddTable[dstFP];
     }
 
     if (blending == BMCopy) {
-        if (isNV12) {
-            return NULL;
+        if (srcPacking != BPPlanar || dstPacking != BPPlanar) {
+            if (srcPacking == dstPacking) {
+                return NULL;
+            }
+            return packedCopyFunction(srcFP, dstFP, srcPacking, dstPacking);
         }
         return kCopyTable[srcFP][dstFP];
     }
@@ -573,13 +980,14 @@ PlaneBlitFunction planeBlitGetFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dst
 #else /* VN_CORE_FEATURE(SSE) */
 
 PlaneBlitFunction planeBlitGetFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
-                                          LdppBlendingMode blending, uint32_t planeIndex, bool isNV12)
+                                          LdppBlendingMode blending, BlitPacking srcPacking,
+                                          BlitPacking dstPacking)
 {
     VNUnused(srcFP);
     VNUnused(dstFP);
     VNUnused(blending);
-    VNUnused(planeIndex);
-    VNUnused(isNV12);
+    VNUnused(srcPacking);
+    VNUnused(dstPacking);
 
     return NULL;
 }
@@ -12,89 +12,40 @@
  * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
  * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
 
-#include <LCEVC/pipeline/buffer.h>
 #include <LCEVC/pixel_processing/dither.h>
 //
-#include <assert.h>
+#include <time.h>
 
 /*------------------------------------------------------------------------------*/
 
-static const size_t kDitherBufferSize = 16384;
 static const uint8_t kMaxDitherStrength = 31;
 
 /*------------------------------------------------------------------------------*/
 
-static void ldppDitherRegenerate(LdppDitherGlobal* dither, uint64_t seed)
+void ldppDitherGlobalInitialize(LdppDitherGlobal* dither, uint64_t seed)
 {
-    LdcRandom random;
-    ldcRandomInitialize(&random, seed);
-
-    for (size_t i = 0; i < kDitherBufferSize; ++i) {
-        dither->buffer[i] = (uint16_t)(ldcRandomValue(&random) >> 16);
-    }
-}
-
-bool ldppDitherGlobalInitialize(LdcMemoryAllocator* memoryAllocator, LdppDitherGlobal* dither, uint64_t seed)
-{
-    dither->allocator = memoryAllocator;
-
-    /* Prepare buffer & RNG */
-    dither->buffer = VNAllocateAlignedArray(memoryAllocator, &dither->allocationBuffer, uint16_t,
-                                            kBufferRowAlignment, kDitherBufferSize);
-
-    if (!dither->buffer) {
-        ldppDitherGlobalRelease(dither);
-        return false;
-    }
-
-    ldppDitherRegenerate(dither, seed);
-
-    return true;
+    dither->seed = (seed != 0) ? seed : (uint64_t)time(NULL);
 }
 
-void ldppDitherGlobalRelease(LdppDitherGlobal* dither)
-{
-    if (dither) {
-        VNFree(dither->allocator, &dither->allocationBuffer);
-    }
-}
-
-bool ldppDitherFrameInitialise(LdppDitherFrame* frame, LdppDitherGlobal* global, uint64_t seed, uint8_t strength)
+bool ldppDitherFrameInitialise(LdppDitherFrame* frame, const LdppDitherGlobal* global,
+                               uint64_t seed, uint8_t strength)
 {
     if (strength > kMaxDitherStrength) {
         return false;
     }
 
-    frame->global = global;
+    frame->key = ldppDitherHash(global->seed + ldppDitherHash(seed));
     frame->strength = strength;
-    frame->frameSeed = seed;
 
     return true;
 }
 
-void ldppDitherSliceInitialise(LdppDitherSlice* slice, LdppDitherFrame* frame, uint32_t offset,
-                               uint32_t planeIndex)
+void ldppDitherSliceInitialise(LdppDitherSlice* slice, const LdppDitherFrame* frame,
+                               uint32_t offset, uint32_t planeIndex)
 {
-    slice->global = frame->global;
+    slice->key = frame->key ^ ((uint64_t)planeIndex << 32);
+    slice->row = offset;
     slice->strength = frame->strength;
-
-    uint64_t seed = frame->frameSeed;
-    seed ^= offset;
-    seed ^= ((uint64_t)planeIndex) << 32;
-    ldcRandomInitialize(&slice->random, seed);
-}
-
-const uint16_t* ldppDitherGetBuffer(LdppDitherSlice* dither, size_t length)
-{
-    assert(dither->global != NULL);
-    assert(dither->global->buffer != NULL);
-
-    if (length > kDitherBufferSize) {
-        return NULL;
-    }
-
-    const size_t position = ldcRandomValue(&dither->random) % (kDitherBufferSize - length);
-    return &dither->global->buffer[position];
 }
 
 int8_t ldppDitherGetShiftS16(LdpFixedPoint bitDepth)
@@ -31,12 +31,13 @@
 /*! \brief  Helper function used to query the horizontal function look-up tables.
  *
  * It has a fall back mechanism when SIMD is desired to provide the non-SIMD
- * function if a SIMD function does not yet exists.
+ * function if a SIMD function does not yet exists. SIMD functions are specialised for the
+ * predicted-average mode, the non-SIMD functions select it from the base pointers at runtime.
  *
  * \return A valid function pointer on success, otherwise NULL. */
 UpscaleHorizontalFunction getHorizontalFunction(LdpFixedPoint srcFP, LdpFixedPoint dstFP,
-                                                LdpFixedPoint baseFP, Interleaving interleaving,
-                                                bool forceScalar)
+                                                LdpFixedPoint baseFP, PAMode paMode,
+                                                Interleaving interleaving, bool forceScalar)
 {
     if (!fixedPointIsValid(srcFP) || !fixedPointIsValid(dstFP)) {
         VNLogError("Invalid horizontal function request - src_fp, dst_fp is invalid\n");
@@ -49,7 +50,7 @@ UpscaleHorizontalFunction getHorizontalFunction(LdpFixedPoint srcFP, LdpFixedPoi
     /* Find a SIMD functions */
 
     if (!forceScalar && acceleration->SSE) {
-        res = upscaleGetHorizontalFunctionSSE(interleaving, srcFP, dstFP, baseFP);
+        res = upscaleGetHorizontalFunctionSSE(interleaving, srcFP, dstFP, baseFP, paMode);
     }
 
     if (!forceScalar && acceleration->NEON) {
@@ -181,14 +182,6 @@ static void internalInitialise(LdcMemoryAllocator* allocator, const LdppUpscaleA
 
 /*------------------------------------------------------------------------------*/
 
-/*! \brief defined predicted average modes of operation. */
-typedef enum PAMode
-{
-    PAMDisabled,
-    PAM1D,
-    PAM2D
-} PAMode;
-
 /*!
  * Helper function to determine the predicted_average_mode to apply.
  *
@@ -210,6 +203,9 @@ static inline uint8_t* surfaceGetLine(const LdpPicturePlaneDesc* desc, const uin
     return desc->firstSample + (lineOffset * desc->rowByteStride);
 }
 
+/* Smallest number of source samples in a part of a sliced upscale. */
+static const uint32_t kUpscaleMinPartSamples = 16384;
+
 /* Upscale threading shared state. */
 typedef struct UpscaleSlicedJobContext
 {
@@ -258,11 +254,12 @@ static void horizontalTask(const UpscaleSlicedJobContext* context, uint32_t ySta
     const uint8_t* srcPtrs[2];
     const uint8_t* basePtrs[2] = {NULL, NULL};
 
-    if (context->frameDither) {
-        ldppDitherSliceInitialise(&sliceDither, context->frameDither, yStart, context->planeIndex);
-    }
-
     for (uint32_t y = yStart; y < yEnd; y += 2) {
+        /* Dither is keyed by position, so is the same however the plane is sliced. */
+        if (context->frameDither) {
+            ldppDitherSliceInitialise(&sliceDither, context->frameDither, y, context->planeIndex);
+        }
+
         srcPtrs[0] = surfaceGetLine(horizontalInputPlane, y);
         dstPtrs[0] = surfaceGetLine(&context->dstPlane, y);
 
@@ -291,7 +288,8 @@ static void horizontalTask(const UpscaleSlicedJobContext* context, uint32_t ySta
                 basePtrs[0] = surfaceGetLine(&context->srcPlane, y >> 1);
                 break;
             }
-            case PAMDisabled:;
+            case PAMDisabled:
+            case PAMCount:;
         }
 
         context->lineFunction(context->frameDither ? &sliceDither : NULL, srcPtrs, dstPtrs,
@@ -428,6 +426,7 @@ static bool upscaleExecute(LdcMemoryAllocator* allocator, LdcTaskPool* taskPool,
     slicedJobContext.lineFunction =
         getHorizontalFunction(horizontalFPInput, dstLayoutInfo->fixedPoint,
                               params->applyPA ? srcLayoutInfo->fixedPoint : LdpFPCount,
+                              getPAMode(params->applyPA, is2D),
                               getInterleaving(srcLayoutInfo, params->planeIndex), params->forceScalar);
     slicedJobContext.colFunction =
         is2D ? getVerticalFunction(srcLayoutInfo->fixedPoint, dstLayoutInfo->fixedPoint,
@@ -452,8 +451,18 @@ static bool upscaleExecute(LdcMemoryAllocator* allocator, LdcTaskPool* taskPool,
     const uint32_t srcHeight = params->srcLayout->height >>
                                params->srcLayout->layoutInfo->planeHeightShift[params->planeIndex];
 
-    return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &upscaleSlicedJob, &upscaleSlicedJobCompletion,
-                                        &slicedJobContext, sizeof(slicedJobContext), srcHeight);
+    /* 1D upscales work on pairs of rows, so keep parts aligned to a pair - 2D iterations are
+     * already a pair of output rows. Narrow planes get fewer, taller parts. */
+    const uint32_t srcWidth = params->srcLayout->width >>
+                              params->srcLayout->layoutInfo->planeWidthShift[params->planeIndex];
+    const LdcTaskSliceHints hints = {
+        .minGrain = maxU32(1, kUpscaleMinPartSamples / maxU32(srcWidth, 1)),
+        .alignment = is2D ? 0 : 2,
+    };
+
+    return ldcTaskPoolAddSlicedDeferred(taskPool, parent, &upscaleSlicedJob,
+                                        &upscaleSlicedJobCompletion, &slicedJobContext,
+                                        sizeof(slicedJobContext), srcHeight, &hints);
 }
 
 /*------------------------------------------------------------------------------*/
@@ -42,6 +42,15 @@ typedef enum Interleaving
     ILCount
 } Interleaving;
 
+/*! \brief defined predicted average modes of operation. */
+typedef enum PAMode
+{
+    PAMDisabled,
+    PAM1D,
+    PAM2D,
+    PAMCount
+} PAMode;
+
 /*------------------------------------------------------------------------------*/
 
 /*! \brief This structure contains the horizontal coordinates for slicing an upscaling
@@ -455,7 +455,7 @@ void horizontalU8PlanarNEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8
     int16x8x2_t values[2];
     const bool paEnabled = (base[0] != NULL);
     const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    uint32x4x2_t ditherState = {{vdupq_n_u32(0), vdupq_n_u32(0)}};
 
     UpscaleHorizontalCoords coords = {0};
 
@@ -477,9 +477,11 @@ void horizontalU8PlanarNEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start << 1);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadNEON(&ditherRow, &ditherState);
     }
 
     /* Run middle SIMD loop */
@@ -501,9 +503,9 @@ void horizontalU8PlanarNEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8
             applyPA2DSpeed(basePels, values);
         }
 
-        if (ditherBuffer) {
-            ldppDitherApplyNEON(&values[0], &ditherBuffer, 0, dither->strength);
-            ldppDitherApplyNEON(&values[1], &ditherBuffer, 0, dither->strength);
+        if (dither != NULL) {
+            ldppDitherApplyNEON(&values[0], &ditherState, 0, dither->strength);
+            ldppDitherApplyNEON(&values[1], &ditherState, 0, dither->strength);
         }
 
         vst1q_u8(&out[0][storeOffset], packS16ToU8NEON(values[0]));
@@ -531,7 +533,7 @@ void horizontalS16PlanarNEON(LdppDitherSlice* dither, const uint8_t* in[2], uint
     int16x8x2_t values[2];
     const bool paEnabled = (base[0] != NULL);
     const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    uint32x4x2_t ditherState = {{vdupq_n_u32(0), vdupq_n_u32(0)}};
     int8_t shift = 0;
     int16_t* out16[2] = {(int16_t*)out[0], (int16_t*)out[1]};
     const int16_t* base16[2] = {(const int16_t*)base[0], (const int16_t*)base[1]};
@@ -556,9 +558,11 @@ void horizontalS16PlanarNEON(LdppDitherSlice* dither, const uint8_t* in[2], uint
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start << 1);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadNEON(&ditherRow, &ditherState);
         shift = ldppDitherGetShiftS16(dstFP);
     }
 
@@ -581,9 +585,9 @@ void horizontalS16PlanarNEON(LdppDitherSlice* dither, const uint8_t* in[2], uint
             applyPA2DPrecision(basePels, values);
         }
 
-        if (ditherBuffer) {
-            ldppDitherApplyNEON(&values[0], &ditherBuffer, shift, dither->strength);
-            ldppDitherApplyNEON(&values[1], &ditherBuffer, shift, dither->strength);
+        if (dither != NULL) {
+            ldppDitherApplyNEON(&values[0], &ditherState, shift, dither->strength);
+            ldppDitherApplyNEON(&values[1], &ditherState, shift, dither->strength);
         }
 
         /* Write out. */
@@ -616,7 +620,7 @@ static inline void horizontalU16PlanarNEON(LdppDitherSlice* dither, const uint8_
     int16x8x2_t values[2];
     const bool paEnabled = (base[0] != NULL);
     const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    uint32x4x2_t ditherState = {{vdupq_n_u32(0), vdupq_n_u32(0)}};
     uint16_t* out16[2] = {(uint16_t*)out[0], (uint16_t*)out[1]};
     const int16_t* base16[2] = {(const int16_t*)base[0], (const int16_t*)base[1]};
     const int16x8_t minV = vdupq_n_s16(0);
@@ -642,9 +646,11 @@ static inline void horizontalU16PlanarNEON(LdppDitherSlice* dither, const uint8_
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start << 1);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadNEON(&ditherRow, &ditherState);
     }
 
     /* Run middle SIMD loop */
@@ -671,9 +677,9 @@ static inline void horizontalU16PlanarNEON(LdppDitherSlice* dither, const uint8_
             }
         }
 
-        if (ditherBuffer) {
-            ldppDitherApplyNEON(&values[0], &ditherBuffer, 0, dither->strength);
-            ldppDitherApplyNEON(&values[1], &ditherBuffer, 0, dither->strength);
+        if (dither != NULL) {
+            ldppDitherApplyNEON(&values[0], &ditherState, 0, dither->strength);
+            ldppDitherApplyNEON(&values[1], &ditherState, 0, dither->strength);
         }
 
         vst1q_u16(&out16[0][storeOffset], clampS16ToU16(values[0].val[0], minV, maxV));
@@ -724,7 +730,7 @@ void horizontalU8NV12NEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
     int16x8x2_t values[2];
     const bool paEnabled = (base[0] != NULL);
     const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    uint32x4x2_t ditherState = {{vdupq_n_u32(0), vdupq_n_u32(0)}};
     uint32_t channelIdx = 0;
     uint8x8x2_t basePels[2];
     int16x8x2_t result[2][2];
@@ -750,9 +756,11 @@ void horizontalU8NV12NEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start << 2);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadNEON(&ditherRow, &ditherState);
     }
 
     /* Run middle SIMD loop */
@@ -778,9 +786,9 @@ void horizontalU8NV12NEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
                 applyPA2DSpeed(vreinterpretq_s16_u16(vmovl_u8(basePels[0].val[channelIdx])), values);
             }
 
-            if (ditherBuffer) {
-                ldppDitherApplyNEON(&values[0], &ditherBuffer, 0, dither->strength);
-                ldppDitherApplyNEON(&values[1], &ditherBuffer, 0, dither->strength);
+            if (dither != NULL) {
+                ldppDitherApplyNEON(&values[0], &ditherState, 0, dither->strength);
+                ldppDitherApplyNEON(&values[1], &ditherState, 0, dither->strength);
             }
 
             /* Stash result */
@@ -818,7 +826,7 @@ void horizontalU8RGBNEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t*
     int16x8x2_t values[2];
     const bool paEnabled = (base[0] != NULL);
     const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    uint32x4x2_t ditherState = {{vdupq_n_u32(0), vdupq_n_u32(0)}};
     uint32_t channelIdx = 0;
     uint8x8x3_t basePels[2];
     int16x8x2_t result[2][3];
@@ -844,9 +852,11 @@ void horizontalU8RGBNEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t*
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start * 6);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadNEON(&ditherRow, &ditherState);
     }
 
     /* Run middle SIMD loop */
@@ -872,9 +882,9 @@ void horizontalU8RGBNEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t*
                 applyPA2DSpeed(vreinterpretq_s16_u16(vmovl_u8(basePels[0].val[channelIdx])), values);
             }
 
-            if (ditherBuffer) {
-                ldppDitherApplyNEON(&values[0], &ditherBuffer, 0, dither->strength);
-                ldppDitherApplyNEON(&values[1], &ditherBuffer, 0, dither->strength);
+            if (dither != NULL) {
+                ldppDitherApplyNEON(&values[0], &ditherState, 0, dither->strength);
+                ldppDitherApplyNEON(&values[1], &ditherState, 0, dither->strength);
             }
 
             /* Stash result */
@@ -915,7 +925,7 @@ void horizontalU8RGBANEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
     int16x8x2_t values[2];
     const bool paEnabled = (base[0] != NULL);
     const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    uint32x4x2_t ditherState = {{vdupq_n_u32(0), vdupq_n_u32(0)}};
     uint32_t channelIdx = 0;
     uint8x8x4_t basePels[2];
     int16x8x2_t result[2][4];
@@ -941,9 +951,11 @@ void horizontalU8RGBANEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start << 3);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadNEON(&ditherRow, &ditherState);
     }
 
     /* Run middle SIMD loop */
@@ -969,9 +981,9 @@ void horizontalU8RGBANEON(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
                 applyPA2DSpeed(vreinterpretq_s16_u16(vmovl_u8(basePels[0].val[channelIdx])), values);
             }
 
-            if (ditherBuffer) {
-                ldppDitherApplyNEON(&values[0], &ditherBuffer, 0, dither->strength);
-                ldppDitherApplyNEON(&values[1], &ditherBuffer, 0, dither->strength);
+            if (dither != NULL) {
+                ldppDitherApplyNEON(&values[0], &ditherState, 0, dither->strength);
+                ldppDitherApplyNEON(&values[1], &ditherState, 0, dither->strength);
             }
 
             /* Stash result */
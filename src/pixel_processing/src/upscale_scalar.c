@@ -220,7 +220,7 @@ static inline void horizontalU8(LdppDitherSlice* dither, const uint8_t* in[2], u
     int32_t channelStoreOffset[4] = {initialStoreOffset, initialStoreOffset + 1,
                                      initialStoreOffset + 2, initialStoreOffset + 3};
 
-    const uint16_t* ditherBuffer = NULL;
+    LdppDitherRow ditherRow;
 
     assert((channelCount > 0) && (channelCount <= 4));
 
@@ -253,10 +253,9 @@ static inline void horizontalU8(LdppDitherSlice* dither, const uint8_t* in[2], u
         }
     }
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows
-     * for each channel */
+    /* Seed the dither generator for 2 fully upscaled rows of each channel */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, (xEnd - xStart) * (size_t)channelCount * 4);
+        ldppDitherRowInitialise(dither, &ditherRow, xStart);
     }
 
     for (uint32_t x = xStart; x < xEnd; ++x) {
@@ -311,11 +310,11 @@ static inline void horizontalU8(LdppDitherSlice* dither, const uint8_t* in[2], u
             }
 
             /* Apply dithering */
-            if (ditherBuffer) {
-                ldppDitherApply(&values[0], &ditherBuffer, 0, dither->strength);
-                ldppDitherApply(&values[1], &ditherBuffer, 0, dither->strength);
-                ldppDitherApply(&values[2], &ditherBuffer, 0, dither->strength);
-                ldppDitherApply(&values[3], &ditherBuffer, 0, dither->strength);
+            if (dither != NULL) {
+                ldppDitherApply(&values[0], &ditherRow, 0, dither->strength);
+                ldppDitherApply(&values[1], &ditherRow, 0, dither->strength);
+                ldppDitherApply(&values[2], &ditherRow, 0, dither->strength);
+                ldppDitherApply(&values[3], &ditherRow, 0, dither->strength);
             }
 
             out[0][storeOffset] = saturateU8(values[0]);
@@ -389,7 +388,7 @@ static void horizontalS16(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
     int32_t channelStoreOffset[4] = {initialStoreOffset, initialStoreOffset + 1,
                                      initialStoreOffset + 2, initialStoreOffset + 3};
 
-    const uint16_t* ditherBuffer = NULL;
+    LdppDitherRow ditherRow;
     int8_t shift = 0;
 
     assert((channelCount > 0) && (channelCount <= 4));
@@ -415,10 +414,9 @@ static void horizontalS16(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
         }
     }
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows
-     * for each channel */
+    /* Seed the dither generator for 2 fully upscaled rows of each channel */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, (xEnd - xStart) * (size_t)channelCount * 4);
+        ldppDitherRowInitialise(dither, &ditherRow, xStart);
         shift = ldppDitherGetShiftS16(dstFP);
     }
 
@@ -474,11 +472,11 @@ static void horizontalS16(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
             }
 
             /* Apply dithering */
-            if (ditherBuffer) {
-                ldppDitherApply(&values[0], &ditherBuffer, shift, dither->strength);
-                ldppDitherApply(&values[1], &ditherBuffer, shift, dither->strength);
-                ldppDitherApply(&values[2], &ditherBuffer, shift, dither->strength);
-                ldppDitherApply(&values[3], &ditherBuffer, shift, dither->strength);
+            if (dither != NULL) {
+                ldppDitherApply(&values[0], &ditherRow, shift, dither->strength);
+                ldppDitherApply(&values[1], &ditherRow, shift, dither->strength);
+                ldppDitherApply(&values[2], &ditherRow, shift, dither->strength);
+                ldppDitherApply(&values[3], &ditherRow, shift, dither->strength);
             }
 
             outI16[0][storeOffset] = saturateS16(values[0]);
@@ -553,7 +551,7 @@ static void horizontalU16(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
     int32_t channelStoreOffset[4] = {initialStoreOffset, initialStoreOffset + 1,
                                      initialStoreOffset + 2, initialStoreOffset + 3};
 
-    const uint16_t* ditherBuffer = NULL;
+    LdppDitherRow ditherRow;
 
     assert((channelCount > 0) && (channelCount <= 4));
 
@@ -578,10 +576,9 @@ static void horizontalU16(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
         }
     }
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows
-     * for each channel */
+    /* Seed the dither generator for 2 fully upscaled rows of each channel */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, (size_t)channelCount * (xEnd - xStart) * 4);
+        ldppDitherRowInitialise(dither, &ditherRow, xStart);
     }
 
     for (uint32_t x = xStart; x < xEnd; ++x) {
@@ -636,11 +633,11 @@ static void horizontalU16(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t
             }
 
             /* Apply dithering */
-            if (ditherBuffer) {
-                ldppDitherApply(&values[0], &ditherBuffer, 0, dither->strength);
-                ldppDitherApply(&values[1], &ditherBuffer, 0, dither->strength);
-                ldppDitherApply(&values[2], &ditherBuffer, 0, dither->strength);
-                ldppDitherApply(&values[3], &ditherBuffer, 0, dither->strength);
+            if (dither != NULL) {
+                ldppDitherApply(&values[0], &ditherRow, 0, dither->strength);
+                ldppDitherApply(&values[1], &ditherRow, 0, dither->strength);
+                ldppDitherApply(&values[2], &ditherRow, 0, dither->strength);
+                ldppDitherApply(&values[3], &ditherRow, 0, dither->strength);
             }
 
             outU16[0][storeOffset] = saturateUN(values[0], maxValue);
@@ -683,7 +680,7 @@ static void horizontalU8ToU16BaseUN(LdppDitherSlice* dither, const uint8_t* in[2
     int32_t channelStoreOffset[4] = {initialStoreOffset, initialStoreOffset + 1,
                                      initialStoreOffset + 2, initialStoreOffset + 3};
 
-    const uint16_t* ditherBuffer = NULL;
+    LdppDitherRow ditherRow;
 
     assert((channelCount > 0) && (channelCount <= 4));
 
@@ -710,10 +707,9 @@ static void horizontalU8ToU16BaseUN(LdppDitherSlice* dither, const uint8_t* in[2
         }
     }
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows
-     * for each channel */
+    /* Seed the dither generator for 2 fully upscaled rows of each channel */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, (xEnd - xStart) * (size_t)channelCount * 4);
+        ldppDitherRowInitialise(dither, &ditherRow, xStart);
     }
 
     for (uint32_t x = xStart; x < xEnd; ++x) {
@@ -792,11 +788,11 @@ static void horizontalU8ToU16BaseUN(LdppDitherSlice* dither, const uint8_t* in[2
             }
 
             /* Apply dithering */
-            if (ditherBuffer) {
-                ldppDitherApply(&values[0], &ditherBuffer, 0, dither->strength);
-                ldppDitherApply(&values[1], &ditherBuffer, 0, dither->strength);
-                ldppDitherApply(&values[2], &ditherBuffer, 0, dither->strength);
-                ldppDitherApply(&values[3], &ditherBuffer, 0, dither->strength);
+            if (dither != NULL) {
+                ldppDitherApply(&values[0], &ditherRow, 0, dither->strength);
+                ldppDitherApply(&values[1], &ditherRow, 0, dither->strength);
+                ldppDitherApply(&values[2], &ditherRow, 0, dither->strength);
+                ldppDitherApply(&values[3], &ditherRow, 0, dither->strength);
             }
 
             outU16[0][storeOffset] = saturateUN(values[0], maxValue);
@@ -443,9 +443,11 @@ static inline void applyPA2DPrecision(__m128i base, __m128i values[2][2])
 }
 
 /*! \brief U8 Planar horizontal upscaling of 2 rows. */
-static void horizontalU8PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
-                                  const uint8_t* base[2], uint32_t width, uint32_t xStart,
-                                  uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP)
+static VNForceInline void horizontalU8PlanarSSEImpl(LdppDitherSlice* dither, const uint8_t* in[2],
+                                                    uint8_t* out[2], const uint8_t* base[2],
+                                                    uint32_t width, uint32_t xStart, uint32_t xEnd,
+                                                    const LdeKernel* kernel,
+                                                    const LdpFixedPoint dstFP, PAMode paMode)
 {
     const int16_t* kernelCoeffs = kernel->coeffs[0];
     const uint32_t kernelLength = kernel->length;
@@ -453,9 +455,9 @@ static void horizontalU8PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2],
     __m128i values[2][2];
     __m128i kernelFwd[UCInterleavedStore];
     __m128i kernelRev[UCInterleavedStore];
-    const bool paEnabled = (base[0] != NULL);
-    const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    const bool paEnabled = (paMode != PAMDisabled);
+    const bool paEnabled1D = (paMode == PAM1D);
+    __m128i ditherState[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
 
     UpscaleHorizontalCoords coords = {0};
 
@@ -495,9 +497,11 @@ static void horizontalU8PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2],
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start << 1);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadSSE(&ditherRow, ditherState);
     }
 
     /* Run middle SIMD loop */
@@ -522,9 +526,9 @@ static void horizontalU8PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2],
             applyPA2DSpeed(_mm_cvtepu8_epi16(basePels), values);
         }
 
-        if (ditherBuffer) {
-            ldppDitherApplySSE(values[0], &ditherBuffer, 0, dither->strength);
-            ldppDitherApplySSE(values[1], &ditherBuffer, 0, dither->strength);
+        if (dither != NULL) {
+            ldppDitherApplySSE(values[0], ditherState, 0, dither->strength);
+            ldppDitherApplySSE(values[1], ditherState, 0, dither->strength);
         }
 
         /* Unsigned saturated pack back to 16 uint8_t and write them out. */
@@ -545,9 +549,11 @@ static void horizontalU8PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2],
 }
 
 /*! \brief S16 Planar horizontal upscaling of 2 rows. */
-static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
-                                   const uint8_t* base[2], uint32_t width, uint32_t xStart,
-                                   uint32_t xEnd, const LdeKernel* kernel, const LdpFixedPoint dstFP)
+static VNForceInline void horizontalS16PlanarSSEImpl(LdppDitherSlice* dither, const uint8_t* in[2],
+                                                     uint8_t* out[2], const uint8_t* base[2],
+                                                     uint32_t width, uint32_t xStart, uint32_t xEnd,
+                                                     const LdeKernel* kernel,
+                                                     const LdpFixedPoint dstFP, PAMode paMode)
 {
     const int16_t* kernelCoeffs = kernel->coeffs[0];
     const uint32_t kernelLength = kernel->length;
@@ -555,9 +561,9 @@ static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2]
     __m128i values[2][2];
     __m128i kernelFwd[UCInterleavedStore];
     __m128i kernelRev[UCInterleavedStore];
-    const bool paEnabled = (base[0] != NULL);
-    const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    const bool paEnabled = (paMode != PAMDisabled);
+    const bool paEnabled1D = (paMode == PAM1D);
+    __m128i ditherState[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
     int8_t shift = 0;
     int16_t* out16[2] = {(int16_t*)out[0], (int16_t*)out[1]};
     const int16_t* base16[2] = {(const int16_t*)base[0], (const int16_t*)base[1]};
@@ -599,9 +605,11 @@ static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2]
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start << 1);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadSSE(&ditherRow, ditherState);
         shift = ldppDitherGetShiftS16(dstFP);
     }
 
@@ -627,9 +635,9 @@ static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2]
             applyPA2DPrecision(basePels, values);
         }
 
-        if (ditherBuffer) {
-            ldppDitherApplySSE(values[0], &ditherBuffer, shift, dither->strength);
-            ldppDitherApplySSE(values[1], &ditherBuffer, shift, dither->strength);
+        if (dither != NULL) {
+            ldppDitherApplySSE(values[0], ditherState, shift, dither->strength);
+            ldppDitherApplySSE(values[1], ditherState, shift, dither->strength);
         }
 
         /* Write out (note that dither and PA used saturating add, so we're safely within S16). */
@@ -649,10 +657,11 @@ static void horizontalS16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2]
 }
 
 /*! \brief U16 Planar horizontal upscaling of 2 rows. */
-static inline void horizontalU16PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2],
-                                          uint8_t* out[2], const uint8_t* base[2], uint32_t width,
-                                          uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel,
-                                          int16_t maxValue, bool is14Bit)
+static VNForceInline void horizontalU16PlanarSSEImpl(LdppDitherSlice* dither, const uint8_t* in[2],
+                                                     uint8_t* out[2], const uint8_t* base[2],
+                                                     uint32_t width, uint32_t xStart, uint32_t xEnd,
+                                                     const LdeKernel* kernel, int16_t maxValue,
+                                                     bool is14Bit, PAMode paMode)
 {
     const int16_t* kernelCoeffs = kernel->coeffs[0];
     const uint32_t kernelLength = kernel->length;
@@ -662,9 +671,9 @@ static inline void horizontalU16PlanarSSE(LdppDitherSlice* dither, const uint8_t
     __m128i kernelRev[UCInterleavedStore];
     const __m128i minV = _mm_set1_epi16(0);
     const __m128i maxV = _mm_set1_epi16(maxValue);
-    const bool paEnabled = (base[0] != NULL);
-    const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    const bool paEnabled = (paMode != PAMDisabled);
+    const bool paEnabled1D = (paMode == PAM1D);
+    __m128i ditherState[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
     uint16_t* out16[2] = {(uint16_t*)out[0], (uint16_t*)out[1]};
     const uint16_t* base16[2] = {(const uint16_t*)base[0], (const uint16_t*)base[1]};
 
@@ -706,9 +715,11 @@ static inline void horizontalU16PlanarSSE(LdppDitherSlice* dither, const uint8_t
     loadOffset += UCHoriStepping;
     int32_t storeOffset = (int32_t)(coords.start << 1);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(4 * (xEnd - xStart), 16));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadSSE(&ditherRow, ditherState);
     }
 
     /* Run middle SIMD loop */
@@ -738,9 +749,9 @@ static inline void horizontalU16PlanarSSE(LdppDitherSlice* dither, const uint8_t
             }
         }
 
-        if (ditherBuffer) {
-            ldppDitherApplySSE(values[0], &ditherBuffer, 0, dither->strength);
-            ldppDitherApplySSE(values[1], &ditherBuffer, 0, dither->strength);
+        if (dither != NULL) {
+            ldppDitherApplySSE(values[0], ditherState, 0, dither->strength);
+            ldppDitherApplySSE(values[1], ditherState, 0, dither->strength);
         }
 
         /* Saturate to unsigned N-bit and write out. */
@@ -765,29 +776,12 @@ static inline void horizontalU16PlanarSSE(LdppDitherSlice* dither, const uint8_t
     }
 }
 
-/* Generate unsigned 2-byte wide planar upscale functions */
-#define VN_HORI_MAX_VALUE_U10() , 1023, false
-#define VN_HORI_MAX_VALUE_U12() , 4095, false
-#define VN_HORI_MAX_VALUE_U14() , 16383, true
-
-#define horizontalU16PlanarSSE(fp)                                                                 \
-    static void horizontal##fp##PlanarSSE(LdppDitherSlice* dither, const uint8_t* in[2],           \
-                                          uint8_t* out[2], const uint8_t* base[2], uint32_t width, \
-                                          uint32_t xStart, uint32_t xEnd, const LdeKernel* kernel, \
-                                          const LdpFixedPoint dstFP)                               \
-    {                                                                                              \
-        horizontalU16PlanarSSE(dither, in, out, base, width, xStart, xEnd,                         \
-                               kernel VN_HORI_MAX_VALUE_##fp());                                   \
-    }
-
-horizontalU16PlanarSSE(U10);
-horizontalU16PlanarSSE(U12);
-horizontalU16PlanarSSE(U14);
-
 /*! \brief NV12 horizontal upscaling of 2 rows. */
-static void horizontalU8NV12SSE(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],
-                                const uint8_t* base[2], uint32_t width, uint32_t xStart,
-                                uint32_t xEnd, const LdeKernel* kernel, LdpFixedPoint dstFP)
+static VNForceInline void horizontalU8NV12SSEImpl(LdppDitherSlice* dither, const uint8_t* in[2],
+                                                  uint8_t* out[2], const uint8_t* base[2],
+                                                  uint32_t width, uint32_t xStart, uint32_t xEnd,
+                                                  const LdeKernel* kernel, LdpFixedPoint dstFP,
+                                                  PAMode paMode)
 {
     const int16_t* kernelCoeffs = kernel->coeffs[0];
     const uint32_t kernelLength = kernel->length;
@@ -799,9 +793,9 @@ static void horizontalU8NV12SSE(LdppDitherSlice* dither, const uint8_t* in[2], u
     __m128i basePels[2][2];
     __m128i kernelFwd[UCInterleavedStore];
     __m128i kernelRev[UCInterleavedStore];
-    const bool paEnabled = (base[0] != NULL);
-    const bool paEnabled1D = paEnabled && (base[1] != NULL);
-    const uint16_t* ditherBuffer = NULL;
+    const bool paEnabled = (paMode != PAMDisabled);
+    const bool paEnabled1D = (paMode == PAM1D);
+    __m128i ditherState[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
     uint32_t channelIdx = 0;
 
     UpscaleHorizontalCoords coords = {0};
@@ -844,9 +838,11 @@ static void horizontalU8NV12SSE(LdppDitherSlice* dither, const uint8_t* in[2], u
     loadOffset += UCHoriStepping;
     storeOffset = (int32_t)(coords.start << 2);
 
-    /* Prepare dither buffer containing enough values for 2 fully upscaled rows. */
+    /* Seed the dither generator for 2 fully upscaled rows, in registers. */
     if (dither != NULL) {
-        ditherBuffer = ldppDitherGetBuffer(dither, alignU32(8 * (xEnd - xStart), 32));
+        LdppDitherRow ditherRow;
+        ldppDitherRowInitialise(dither, &ditherRow, coords.start);
+        ldppDitherLoadSSE(&ditherRow, ditherState);
     }
 
     /* Run middle SIMD loop */
@@ -872,9 +868,9 @@ static void horizontalU8NV12SSE(LdppDitherSlice* dither, const uint8_t* in[2], u
                 applyPA2DSpeed(basePels[0][channelIdx], values);
             }
 
-            if (ditherBuffer) {
-                ldppDitherApplySSE(values[0], &ditherBuffer, 0, dither->strength);
-                ldppDitherApplySSE(values[1], &ditherBuffer, 0, dither->strength);
+            if (dither != NULL) {
+                ldppDitherApplySSE(values[0], ditherState, 0, dither->strength);
+                ldppDitherApplySSE(values[1], ditherState, 0, dither->strength);
             }
 
             /* Unsigned saturated pack back to 16 uint8_t and write them out. */
@@ -900,6 +896,36 @@ static void horizontalU8NV12SSE(LdppDitherSlice* dither, const uint8_t* in[2], u
     }
 }
 
+/* Generate the PA specialised horizontal upscale functions. Each instance passes its PA mode as a
+ * compile time constant to a force-inlined body, so the PA branches are folded out of the SIMD
+ * loop. The `args` macro expands to the body specific arguments that follow the kernel. */
+#define VN_HORI_ARGS_S16() , dstFP
+#define VN_HORI_ARGS_U8() , dstFP
+#define VN_HORI_ARGS_U10() , 1023, false
+#define VN_HORI_ARGS_U12() , 4095, false
+#define VN_HORI_ARGS_U14() , 16383, true
+
+#define VN_HORI_PA_FUNCTION(name, impl, args, paMode)                                              \
+    static void name(LdppDitherSlice* dither, const uint8_t* in[2], uint8_t* out[2],               \
+                     const uint8_t* base[2], uint32_t width, uint32_t xStart, uint32_t xEnd,       \
+                     const LdeKernel* kernel, const LdpFixedPoint dstFP)                           \
+    {                                                                                              \
+        VNUnused(dstFP);                                                                           \
+        impl(dither, in, out, base, width, xStart, xEnd, kernel args(), paMode);                   \
+    }
+
+#define VN_HORI_PA_FUNCTIONS(name, impl, args)                                                     \
+    VN_HORI_PA_FUNCTION(name##NoPA, impl, args, PAMDisabled)                                       \
+    VN_HORI_PA_FUNCTION(name##PA1D, impl, args, PAM1D)                                             \
+    VN_HORI_PA_FUNCTION(name##PA2D, impl, args, PAM2D)
+
+VN_HORI_PA_FUNCTIONS(horizontalU8PlanarSSE, horizontalU8PlanarSSEImpl, VN_HORI_ARGS_U8)
+VN_HORI_PA_FUNCTIONS(horizontalU10PlanarSSE, horizontalU16PlanarSSEImpl, VN_HORI_ARGS_U10)
+VN_HORI_PA_FUNCTIONS(horizontalU12PlanarSSE, horizontalU16PlanarSSEImpl, VN_HORI_ARGS_U12)
+VN_HORI_PA_FUNCTIONS(horizontalU14PlanarSSE, horizontalU16PlanarSSEImpl, VN_HORI_ARGS_U14)
+VN_HORI_PA_FUNCTIONS(horizontalS16PlanarSSE, horizontalS16PlanarSSEImpl, VN_HORI_ARGS_S16)
+VN_HORI_PA_FUNCTIONS(horizontalU8NV12SSE, horizontalU8NV12SSEImpl, VN_HORI_ARGS_U8)
+
 /*------------------------------------------------------------------------------*/
 
 /*!
@@ -1451,15 +1477,36 @@ static void verticalU14SSE(const uint8_t* in, uint32_t inStride, uint8_t* out, u
 
 /* clang-format off */
 
-/* kHorizontalFunctionTable[ilv][fp] */
-static const UpscaleHorizontalFunction kHorizontalFunctionTable[ILCount][LdpFPCount] = {
-    /* U8,                  U10,                    U12,                    U14,                    S8.7,                   S10.5,                  S12.3,                  S14.1 */
-    {horizontalU8PlanarSSE, horizontalU10PlanarSSE, horizontalU12PlanarSSE, horizontalU14PlanarSSE, horizontalS16PlanarSSE, horizontalS16PlanarSSE, horizontalS16PlanarSSE, horizontalS16PlanarSSE}, /* None*/
-    {NULL,                  NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL},                   /* YUYV */
-    {horizontalU8NV12SSE,   NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL},                   /* NV12 */
-    {NULL,                  NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL},                   /* UYVY */
-    {NULL,                  NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL},                   /* RGB */
-    {NULL,                  NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL,                   NULL},                   /* RGBA */
+/* kHorizontalFunctionTable[paMode][ilv][fp] */
+static const UpscaleHorizontalFunction kHorizontalFunctionTable[PAMCount][ILCount][LdpFPCount] = {
+    /* U8, U10, U12, U14, S8.7, S10.5, S12.3, S14.1 */
+    {
+        /* PA disabled */
+        {horizontalU8PlanarSSENoPA,  horizontalU10PlanarSSENoPA, horizontalU12PlanarSSENoPA, horizontalU14PlanarSSENoPA, horizontalS16PlanarSSENoPA, horizontalS16PlanarSSENoPA, horizontalS16PlanarSSENoPA, horizontalS16PlanarSSENoPA}, /* None */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* YUYV */
+        {horizontalU8NV12SSENoPA,    NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* NV12 */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* UYVY */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* RGB */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* RGBA */
+    },
+    {
+        /* PA 1D */
+        {horizontalU8PlanarSSEPA1D,  horizontalU10PlanarSSEPA1D, horizontalU12PlanarSSEPA1D, horizontalU14PlanarSSEPA1D, horizontalS16PlanarSSEPA1D, horizontalS16PlanarSSEPA1D, horizontalS16PlanarSSEPA1D, horizontalS16PlanarSSEPA1D}, /* None */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* YUYV */
+        {horizontalU8NV12SSEPA1D,    NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* NV12 */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* UYVY */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* RGB */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* RGBA */
+    },
+    {
+        /* PA 2D */
+        {horizontalU8PlanarSSEPA2D,  horizontalU10PlanarSSEPA2D, horizontalU12PlanarSSEPA2D, horizontalU14PlanarSSEPA2D, horizontalS16PlanarSSEPA2D, horizontalS16PlanarSSEPA2D, horizontalS16PlanarSSEPA2D, horizontalS16PlanarSSEPA2D}, /* None */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* YUYV */
+        {horizontalU8NV12SSEPA2D,    NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* NV12 */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* UYVY */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* RGB */
+        {NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL,                       NULL}, /* RGBA */
+    },
 };
 
 /* kVerticalFunctionTable[fp] */
@@ -1479,14 +1526,15 @@ static const UpscaleVerticalFunction kVerticalFunctionTable[LdpFPCount] = {
 /*------------------------------------------------------------------------------*/
 
 UpscaleHorizontalFunction upscaleGetHorizontalFunctionSSE(Interleaving ilv, LdpFixedPoint srcFP,
-                                                          LdpFixedPoint dstFP, LdpFixedPoint baseFP)
+                                                          LdpFixedPoint dstFP, LdpFixedPoint baseFP,
+                                                          PAMode paMode)
 {
     /* Conversion is not currently supported in SIMD. */
     if ((srcFP != dstFP) || ((baseFP != dstFP) && fixedPointIsValid(baseFP))) {
         return NULL;
     }
 
-    return kHorizontalFunctionTable[ilv][srcFP];
+    return kHorizontalFunctionTable[paMode][ilv][srcFP];
 }
 
 UpscaleVerticalFunction upscaleGetVerticalFunctionSSE(LdpFixedPoint srcFP, LdpFixedPoint dstFP)
@@ -1504,12 +1552,14 @@ UpscaleVerticalFunction upscaleGetVerticalFunctionSSE(LdpFixedPoint srcFP, LdpFi
 #else
 
 UpscaleHorizontalFunction upscaleGetHorizontalFunctionSSE(Interleaving ilv, LdpFixedPoint srcFP,
-                                                          LdpFixedPoint dstFP, LdpFixedPoint baseFP)
+                                                          LdpFixedPoint dstFP, LdpFixedPoint baseFP,
+                                                          PAMode paMode)
 {
     VNUnused(ilv);
     VNUnused(srcFP);
     VNUnused(dstFP);
     VNUnused(baseFP);
+    VNUnused(paMode);
     return NULL;
 }
 
@@ -23,10 +23,12 @@
  *  \param srcFP    The source data fixedpoint type to upscale from.
  *  \param dstFP    The destination data fixedpoint type to upscale to.
  *  \param baseFP   The base data fixedpoint type to read from for PA.
+ *  \param paMode   The predicted-average mode the returned function is specialised for.
  *
  *  \return A valid function pointer on success otherwise NULL. */
 UpscaleHorizontalFunction upscaleGetHorizontalFunctionSSE(Interleaving ilv, LdpFixedPoint srcFP,
-                                                          LdpFixedPoint dstFP, LdpFixedPoint baseFP);
+                                                          LdpFixedPoint dstFP, LdpFixedPoint baseFP,
+                                                          PAMode paMode);
 
 /*! \brief Retrieves a function pointer to a vertical upscaling function using SSE.
  *
@@ -0,0 +1,214 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Compare applying the sequential CPU command buffers against the block bitmask (GPU format)
+// command buffers, for the same synthetic residuals.
+//
+#include <benchmark/benchmark.h>
+#include <LCEVC/common/acceleration.h>
+#include <LCEVC/common/memory.h>
+#include <LCEVC/enhancement/cmdbuffer_cpu.h>
+#include <LCEVC/enhancement/cmdbuffer_gpu.h>
+#include <LCEVC/enhancement/transform_unit.h>
+#include <LCEVC/pipeline/frame.h>
+#include <LCEVC/pipeline/types.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// The applicator internals have no C++ guards of their own
+extern "C"
+{
+#include "apply_cmdbuffer_common.h"
+}
+
+namespace {
+
+constexpr uint32_t kWidth = 1920;
+constexpr uint32_t kHeight = 1080;
+
+// Arguments: transform size (4 or 16), percentage of TUs with residuals, force scalar
+class ApplyCmdBufferFixture : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& state) override
+    {
+        const auto transformSize = static_cast<uint8_t>(state.range(0));
+        const auto density = static_cast<uint32_t>(state.range(1));
+        forceScalar = state.range(2) != 0;
+
+        plane.resize(static_cast<size_t>(kWidth) * kHeight);
+        planeDesc.firstSample = reinterpret_cast<uint8_t*>(plane.data());
+        planeDesc.rowByteStride = kWidth * sizeof(int16_t);
+
+        enhancementTile = {};
+        enhancementTile.tileWidth = kWidth;
+        enhancementTile.tileHeight = kHeight;
+        enhancementTile.planeWidth = kWidth;
+        enhancementTile.planeHeight = kHeight;
+
+        LdcMemoryAllocator* allocator = ldcMemoryAllocatorMalloc();
+        ldeCmdBufferCpuInitialize(allocator, &enhancementTile.buffer, 0);
+        ldeCmdBufferCpuReset(&enhancementTile.buffer, transformSize);
+        ldeCmdBufferGpuInitialize(allocator, &enhancementTile.bufferGpu,
+                                  &enhancementTile.bufferGpuBuilder);
+        ldeCmdBufferGpuReset(&enhancementTile.bufferGpu, &enhancementTile.bufferGpuBuilder,
+                             transformSize);
+
+        fillCmdBuffers(transformSize, density);
+
+        // A single entry point covering the whole CPU command buffer
+        entryPoint = {};
+        entryPoint.count = enhancementTile.buffer.count;
+        enhancementTile.buffer.entryPoints = &entryPoint;
+    }
+
+    void TearDown(benchmark::State& /*state*/) override
+    {
+        enhancementTile.buffer.entryPoints = nullptr;
+        ldeCmdBufferCpuFree(&enhancementTile.buffer);
+        ldeCmdBufferGpuFree(&enhancementTile.bufferGpu, &enhancementTile.bufferGpuBuilder);
+    }
+
+    // Block ordered Add, Set and SetZero TUs at the given density, with some cleared blocks
+    void fillCmdBuffers(uint8_t transformSize, uint32_t density)
+    {
+        const uint8_t tuWidthShift = (transformSize == 16) ? 2 : 1;
+        TUState tuState;
+        ldeTuStateInitialize(&tuState, kWidth, kHeight, 0, 0, tuWidthShift);
+
+        std::vector<uint32_t> tuIndices;
+        for (uint32_t y = 0; y < kHeight; y += (1 << tuWidthShift)) {
+            for (uint32_t x = 0; x < kWidth; x += (1 << tuWidthShift)) {
+                tuIndices.push_back(ldeTuCoordsBlockAlignedIndex(&tuState, x, y));
+            }
+        }
+        std::sort(tuIndices.begin(), tuIndices.end());
+
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int32_t> residualDist(-512, 511);
+        std::uniform_int_distribution<uint32_t> percentDist(0, 99);
+
+        const uint32_t tuPerBlock = tuState.block.tuPerBlock;
+        int16_t residuals[16] = {};
+        uint32_t lastTuIndex = 0;
+        uint32_t clearedBlock = UINT32_MAX;
+
+        for (const uint32_t tuIndex : tuIndices) {
+            const uint32_t block = tuIndex / tuPerBlock;
+            if ((tuIndex % tuPerBlock) == 0 && percentDist(rng) < 10) {
+                ldeCmdBufferCpuAppend(&enhancementTile.buffer, CBCCClear, nullptr,
+                                      tuIndex - lastTuIndex);
+                ldeCmdBufferGpuAppend(&enhancementTile.bufferGpu, &enhancementTile.bufferGpuBuilder,
+                                      CBGOClearAndSet, nullptr, tuIndex, false);
+                lastTuIndex = tuIndex;
+                clearedBlock = block;
+            }
+
+            if (percentDist(rng) >= density) {
+                continue;
+            }
+            for (int16_t& residual : residuals) {
+                residual = static_cast<int16_t>(residualDist(rng));
+            }
+
+            LdeCmdBufferCpuCmd command = CBCCAdd;
+            LdeCmdBufferGpuOperation operation = CBGOAdd;
+            const uint32_t choice = percentDist(rng);
+            if (block == clearedBlock || choice < 10) {
+                command = CBCCSet;
+                operation = CBGOSet;
+            } else if (choice < 15) {
+                command = CBCCSetZero;
+                operation = CBGOSetZero;
+            }
+
+            ldeCmdBufferCpuAppend(&enhancementTile.buffer, command, residuals,
+                                  tuIndex - lastTuIndex);
+            ldeCmdBufferGpuAppend(&enhancementTile.bufferGpu, &enhancementTile.bufferGpuBuilder,
+                                  operation, residuals, tuIndex, false);
+            lastTuIndex = tuIndex;
+        }
+
+        ldeCmdBufferGpuBuild(&enhancementTile.bufferGpu, &enhancementTile.bufferGpuBuilder, false);
+    }
+
+    std::vector<int16_t> plane;
+    LdpPicturePlaneDesc planeDesc = {};
+    LdpEnhancementTile enhancementTile = {};
+    LdeCmdBufferCpuEntryPoint entryPoint = {};
+    bool forceScalar = false;
+};
+
+CmdBufferApplicator blockApplicator(bool forceScalar)
+{
+    const LdcAcceleration* acceleration = ldcAccelerationGet();
+    if (!forceScalar && acceleration->NEON) {
+        return cmdBufferApplicatorBlockNEON;
+    }
+    if (!forceScalar && acceleration->SSE) {
+        return cmdBufferApplicatorBlockSSE;
+    }
+    return cmdBufferApplicatorBlockScalar;
+}
+
+CmdBufferBitmaskApplicator bitmaskApplicator(bool forceScalar)
+{
+    const LdcAcceleration* acceleration = ldcAccelerationGet();
+    if (!forceScalar && acceleration->NEON) {
+        return cmdBufferApplicatorBitmaskNEON;
+    }
+    if (!forceScalar && acceleration->SSE) {
+        return cmdBufferApplicatorBitmaskSSE;
+    }
+    return cmdBufferApplicatorBitmaskScalar;
+}
+
+void cmdBufferArguments(benchmark::internal::Benchmark* b)
+{
+    for (const int64_t transformSize : {4, 16}) {
+        for (const int64_t density : {5, 25, 75}) {
+            for (const int64_t forceScalar : {0, 1}) {
+                b->Args({transformSize, density, forceScalar});
+            }
+        }
+    }
+}
+
+} // namespace
+
+BENCHMARK_DEFINE_F(ApplyCmdBufferFixture, Block)(benchmark::State& state)
+{
+    const CmdBufferApplicator applicator = blockApplicator(forceScalar);
+    for (auto _ : state) {
+        applicator(&enhancementTile, 0, &planeDesc, LdpFPS14, false);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * enhancementTile.buffer.count);
+}
+
+BENCHMARK_DEFINE_F(ApplyCmdBufferFixture, Bitmask)(benchmark::State& state)
+{
+    const CmdBufferBitmaskApplicator applicator = bitmaskApplicator(forceScalar);
+    for (auto _ : state) {
+        applicator(&enhancementTile, 0, enhancementTile.bufferGpu.commandCount, &planeDesc,
+                   LdpFPS14, false, false);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * enhancementTile.buffer.count);
+}
+
+BENCHMARK_REGISTER_F(ApplyCmdBufferFixture, Block)->Apply(cmdBufferArguments);
+BENCHMARK_REGISTER_F(ApplyCmdBufferFixture, Bitmask)->Apply(cmdBufferArguments);
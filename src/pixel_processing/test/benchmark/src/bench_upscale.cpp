@@ -0,0 +1,206 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Compare the horizontal upscale pass with predicted-average disabled, 1D and 2D, for the SIMD
+// kernels specialised per PA mode against the scalar kernels that select PA at runtime, and
+// with dithering against without.
+//
+#include <benchmark/benchmark.h>
+#include <LCEVC/common/acceleration.h>
+#include <LCEVC/enhancement/bitstream_types.h>
+#include <LCEVC/pixel_processing/dither.h>
+#include <LCEVC/pipeline/types.h>
+
+#include <iterator>
+#include <random>
+#include <vector>
+
+// The upscale internals have no C++ guards of their own
+extern "C"
+{
+#include "fp_types.h"
+#include "upscale_neon.h"
+#include "upscale_scalar.h"
+#include "upscale_sse.h"
+}
+
+namespace {
+
+// Source (base) plane size - the horizontal pass doubles the width
+constexpr uint32_t kWidth = 960;
+constexpr uint32_t kHeight = 540;
+
+// Strongest dither the bitstream can signal
+constexpr uint8_t kDitherStrength = 31;
+
+struct UpscaleFormat
+{
+    LdpFixedPoint fixedPoint;
+    Interleaving interleaving;
+};
+
+// Indexed by the first benchmark argument
+constexpr UpscaleFormat kFormats[] = {
+    {LdpFPU8, ILNone},
+    {LdpFPU10, ILNone},
+    {LdpFPS8, ILNone},
+    {LdpFPU8, ILNV12},
+};
+
+// Arguments: format index, PA mode, force scalar
+class UpscaleHorizontalFixture : public benchmark::Fixture
+{
+public:
+    void SetUp(benchmark::State& state) override
+    {
+        const UpscaleFormat& format = kFormats[state.range(0)];
+        fixedPoint = format.fixedPoint;
+        paMode = static_cast<PAMode>(state.range(1));
+        forceScalar = state.range(2) != 0;
+
+        const uint32_t channels = (format.interleaving == ILNV12) ? 2 : 1;
+        width = kWidth / channels;
+        srcStride = kWidth * fixedPointByteSize(fixedPoint);
+        dstStride = srcStride * 2;
+
+        src.resize(static_cast<size_t>(srcStride) * kHeight * 2);
+        base.resize(static_cast<size_t>(srcStride) * kHeight);
+        dst.resize(static_cast<size_t>(dstStride) * kHeight * 2);
+        fillSamples(src);
+        fillSamples(base);
+
+        const LdpFixedPoint baseFP = (paMode == PAMDisabled) ? LdpFPCount : fixedPoint;
+        function = horizontalFunction(format.interleaving, baseFP);
+    }
+
+    // Samples stay inside the smallest format range, so the same data suits all of them
+    void fillSamples(std::vector<uint8_t>& samples) const
+    {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<uint16_t> dist(0, 255);
+        if (fixedPointByteSize(fixedPoint) == 1) {
+            for (uint8_t& value : samples) {
+                value = static_cast<uint8_t>(dist(rng));
+            }
+            return;
+        }
+        auto* samples16 = reinterpret_cast<uint16_t*>(samples.data());
+        for (size_t i = 0; i < samples.size() / sizeof(uint16_t); ++i) {
+            samples16[i] = dist(rng);
+        }
+    }
+
+    UpscaleHorizontalFunction horizontalFunction(Interleaving interleaving,
+                                                 LdpFixedPoint baseFP) const
+    {
+        UpscaleHorizontalFunction res = nullptr;
+        const LdcAcceleration* acceleration = ldcAccelerationGet();
+        if (!forceScalar && acceleration->SSE) {
+            res = upscaleGetHorizontalFunctionSSE(interleaving, fixedPoint, fixedPoint, baseFP,
+                                                  paMode);
+        }
+        if (!forceScalar && acceleration->NEON) {
+            res = upscaleGetHorizontalFunctionNEON(interleaving, fixedPoint, fixedPoint, baseFP);
+        }
+        if (!res) {
+            res = upscaleGetHorizontalFunction(interleaving, fixedPoint, fixedPoint, baseFP);
+        }
+        return res;
+    }
+
+    // Upscale a 2D-sized frame of row pairs, pointing at base rows and keying dither by row as
+    // the upscale task does
+    void upscaleFrame(const LdeKernel& kernel, const LdppDitherFrame* frameDither)
+    {
+        const uint8_t* srcPtrs[2];
+        uint8_t* dstPtrs[2];
+        const uint8_t* basePtrs[2] = {nullptr, nullptr};
+        LdppDitherSlice sliceDither;
+
+        for (uint32_t y = 0; y < kHeight * 2; y += 2) {
+            if (frameDither) {
+                ldppDitherSliceInitialise(&sliceDither, frameDither, y, 0);
+            }
+            srcPtrs[0] = &src[static_cast<size_t>(y) * srcStride];
+            srcPtrs[1] = srcPtrs[0] + srcStride;
+            dstPtrs[0] = &dst[static_cast<size_t>(y) * dstStride];
+            dstPtrs[1] = dstPtrs[0] + dstStride;
+
+            if (paMode == PAM1D) {
+                basePtrs[0] = srcPtrs[0];
+                basePtrs[1] = srcPtrs[1];
+            } else if (paMode == PAM2D) {
+                basePtrs[0] = &base[static_cast<size_t>(y >> 1) * srcStride];
+            }
+
+            function(frameDither ? &sliceDither : nullptr, srcPtrs, dstPtrs, basePtrs, width, 0,
+                     width, &kernel, fixedPoint);
+        }
+    }
+
+    std::vector<uint8_t> src;
+    std::vector<uint8_t> base;
+    std::vector<uint8_t> dst;
+    uint32_t width = 0;
+    uint32_t srcStride = 0;
+    uint32_t dstStride = 0;
+    LdpFixedPoint fixedPoint = LdpFPU8;
+    PAMode paMode = PAMDisabled;
+    bool forceScalar = false;
+    UpscaleHorizontalFunction function = nullptr;
+};
+
+void upscaleArguments(benchmark::internal::Benchmark* b)
+{
+    for (int64_t format = 0; format < static_cast<int64_t>(std::size(kFormats)); ++format) {
+        for (const int64_t paMode : {PAMDisabled, PAM1D, PAM2D}) {
+            for (const int64_t forceScalar : {0, 1}) {
+                b->Args({format, paMode, forceScalar});
+            }
+        }
+    }
+}
+
+} // namespace
+
+static const LdeKernel kCubicKernel = {
+    {{-1382, 14285, 3942, -461}, {-461, 3942, 14285, -1382}}, 4, false};
+
+BENCHMARK_DEFINE_F(UpscaleHorizontalFixture, Cubic)(benchmark::State& state)
+{
+    for (auto _ : state) {
+        upscaleFrame(kCubicKernel, nullptr);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kWidth * kHeight * 4);
+}
+
+BENCHMARK_REGISTER_F(UpscaleHorizontalFixture, Cubic)->Apply(upscaleArguments);
+
+// As Cubic, with dither noise generated and added to every output pixel
+BENCHMARK_DEFINE_F(UpscaleHorizontalFixture, CubicDither)(benchmark::State& state)
+{
+    LdppDitherGlobal globalDither;
+    LdppDitherFrame frameDither;
+    ldppDitherGlobalInitialize(&globalDither, 1234);
+    ldppDitherFrameInitialise(&frameDither, &globalDither, 0, kDitherStrength);
+
+    for (auto _ : state) {
+        upscaleFrame(kCubicKernel, &frameDither);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kWidth * kHeight * 4);
+}
+
+BENCHMARK_REGISTER_F(UpscaleHorizontalFixture, CubicDither)->Apply(upscaleArguments);
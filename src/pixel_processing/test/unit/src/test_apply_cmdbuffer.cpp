@@ -19,6 +19,8 @@
 #include <LCEVC/common/diagnostics.h>
 #include <LCEVC/common/memory.h>
 #include <LCEVC/enhancement/cmdbuffer_cpu.h>
+#include <LCEVC/enhancement/cmdbuffer_gpu.h>
+#include <LCEVC/enhancement/transform_unit.h>
 #include <LCEVC/pipeline/types.h>
 #include <LCEVC/pixel_processing/apply_cmdbuffer.h>
 #include <LCEVC/utility/md5.h>
@@ -26,7 +28,10 @@
 #include <range/v3/view/cartesian_product.hpp>
 #include <stdint.h>
 
+#include <algorithm>
 #include <sstream>
+#include <tuple>
+#include <vector>
 
 namespace rg = ranges;
 namespace rv = ranges::views;
@@ -183,4 +188,193 @@ INSTANTIATE_TEST_SUITE_P(
         applyCmdBufferTestParams{16, LdpFPU12, 3, true, false, false, "9ad5b2cd7aa4115fea6f9d51e38c670c"},
         applyCmdBufferTestParams{16, LdpFPS8, 0, false, false, true, "6fc6eee07ccad0a2f1d271360d9da5aa"},
         applyCmdBufferTestParams{4, LdpFPU10, 0, false, false, true, "d8e7eb2cee934527d5cf0c49bc86b441"}),
-    testNames);
\ No newline at end of file
+    testNames);
+
+// Bitmask (GPU format) cmdbuffers should apply exactly as the equivalent CPU cmdbuffer
+//
+using ApplyCmdBufferBitmaskParams = std::tuple<uint8_t, bool, bool, LdpFixedPoint>;
+
+class ApplyCmdBufferBitmask : public testing::TestWithParam<ApplyCmdBufferBitmaskParams>
+{
+protected:
+    void SetUp() override
+    {
+        const auto [transformSize, rasterOrder, forceScalar, fixedPoint] = GetParam();
+
+        allocator = ldcMemoryAllocatorMalloc();
+        ldcTaskPoolInitialize(&taskPool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(),
+                              4, 4);
+
+        cpuPlane.initialize(kWidth, kHeight, kWidth, fixedPoint);
+        bitmaskPlane.initialize(kWidth, kHeight, kWidth, fixedPoint);
+        fillPlaneWithNoise(cpuPlane);
+        memcpy(bitmaskPlane.planeDesc.firstSample, cpuPlane.planeDesc.firstSample, cpuPlane.size());
+
+        enhancementTile.tileWidth = kWidth;
+        enhancementTile.tileHeight = kHeight;
+        enhancementTile.planeWidth = kWidth;
+        enhancementTile.planeHeight = kHeight;
+
+        ldeCmdBufferCpuInitialize(allocator, &enhancementTile.buffer, 0);
+        ldeCmdBufferCpuReset(&enhancementTile.buffer, transformSize);
+        ldeCmdBufferGpuInitialize(allocator, &enhancementTile.bufferGpu,
+                                  &enhancementTile.bufferGpuBuilder);
+        ldeCmdBufferGpuReset(&enhancementTile.bufferGpu, &enhancementTile.bufferGpuBuilder,
+                             transformSize);
+    }
+
+    void TearDown() override
+    {
+        ldeCmdBufferCpuFree(&enhancementTile.buffer);
+        ldeCmdBufferGpuFree(&enhancementTile.bufferGpu, &enhancementTile.bufferGpuBuilder);
+        ldcTaskPoolDestroy(&taskPool);
+    }
+
+    // Append the same randomly generated TUs to both CPU and bitmask cmdbuffers
+    void fillCmdBuffers(uint8_t transformSize, bool rasterOrder, bool signedPlane)
+    {
+        const uint8_t tuWidthShift = (transformSize == 16) ? 2 : 1;
+        TUState tuState;
+        ASSERT_TRUE(ldeTuStateInitialize(&tuState, kWidth, kHeight, 0, 0, tuWidthShift));
+
+        // TU indices in the order a decoder would visit them
+        std::vector<uint32_t> tuIndices;
+        for (uint32_t y = 0; y < kHeight; y += (1 << tuWidthShift)) {
+            for (uint32_t x = 0; x < kWidth; x += (1 << tuWidthShift)) {
+                tuIndices.push_back(rasterOrder ? ldeTuCoordsSurfaceIndex(&tuState, x, y)
+                                                : ldeTuCoordsBlockAlignedIndex(&tuState, x, y));
+            }
+        }
+        std::sort(tuIndices.begin(), tuIndices.end());
+
+        lcevc_dec::utility::RNG rng(1024);
+        int16_t residuals[16] = {};
+        uint32_t lastTuIndex = 0;
+        uint32_t clearedBlock = UINT32_MAX;
+        uint32_t emptyBlock = UINT32_MAX;
+        const uint32_t tuPerBlock = tuState.block.tuPerBlock;
+
+        for (const uint32_t tuIndex : tuIndices) {
+            // Temporal style operations are only used in block order on signed planes
+            const bool temporal = !rasterOrder && signedPlane;
+            const uint32_t block = tuIndex / tuPerBlock;
+
+            // Leave the first and some other blocks without any commands at all
+            if ((tuIndex % tuPerBlock) == 0 && (block == 0 || rng() % 4 == 0)) {
+                emptyBlock = block;
+            }
+
+            if (temporal && block != emptyBlock && (tuIndex % tuPerBlock) == 0 && rng() % 4 == 0) {
+                const uint32_t blockStart = block * tuPerBlock;
+                ASSERT_TRUE(ldeCmdBufferCpuAppend(&enhancementTile.buffer, CBCCClear, nullptr,
+                                                  blockStart - lastTuIndex));
+                ASSERT_TRUE(ldeCmdBufferGpuAppend(&enhancementTile.bufferGpu,
+                                                  &enhancementTile.bufferGpuBuilder,
+                                                  CBGOClearAndSet, nullptr, blockStart, false));
+                lastTuIndex = blockStart;
+                clearedBlock = block;
+            }
+
+            if (block == emptyBlock || rng() % 3 == 0) {
+                continue;
+            }
+
+            for (int16_t& residual : residuals) {
+                residual = static_cast<int16_t>(static_cast<int32_t>(rng()) - 512);
+            }
+
+            LdeCmdBufferCpuCmd command = CBCCAdd;
+            LdeCmdBufferGpuOperation operation = CBGOAdd;
+            if (temporal) {
+                switch (rng() % 3) {
+                    case 0: break;
+                    case 1:
+                        command = CBCCSet;
+                        operation = CBGOSet;
+                        break;
+                    default:
+                        command = CBCCSetZero;
+                        operation = CBGOSetZero;
+                        break;
+                }
+                // Adds into a cleared block are sets
+                if (block == clearedBlock && command == CBCCAdd) {
+                    command = CBCCSet;
+                    operation = CBGOSet;
+                }
+            }
+
+            ASSERT_TRUE(ldeCmdBufferCpuAppend(&enhancementTile.buffer, command, residuals,
+                                              tuIndex - lastTuIndex));
+            ASSERT_TRUE(ldeCmdBufferGpuAppend(&enhancementTile.bufferGpu,
+                                              &enhancementTile.bufferGpuBuilder, operation,
+                                              residuals, tuIndex, rasterOrder));
+            lastTuIndex = tuIndex;
+        }
+
+        ASSERT_TRUE(ldeCmdBufferGpuBuild(&enhancementTile.bufferGpu,
+                                         &enhancementTile.bufferGpuBuilder, rasterOrder));
+    }
+
+    LdcMemoryAllocator* allocator = {};
+    LdcTaskPool taskPool = {};
+    LdpEnhancementTile enhancementTile = {};
+    TestPlane cpuPlane = {};
+    TestPlane bitmaskPlane = {};
+};
+
+TEST_P(ApplyCmdBufferBitmask, MatchesCpuCmdBuffer)
+{
+    const auto [transformSize, rasterOrder, forceScalar, fixedPoint] = GetParam();
+    fillCmdBuffers(transformSize, rasterOrder, fixedPointIsSigned(fixedPoint));
+
+    EXPECT_TRUE(ldppApplyCmdBuffer(&taskPool, NULL, &enhancementTile, fixedPoint,
+                                   &cpuPlane.planeDesc, rasterOrder, forceScalar, false));
+    EXPECT_TRUE(ldppApplyCmdBufferBitmask(&taskPool, NULL, &enhancementTile, fixedPoint,
+                                          &bitmaskPlane.planeDesc, rasterOrder, forceScalar,
+                                          false));
+
+    EXPECT_EQ(memcmp(cpuPlane.planeDesc.firstSample, bitmaskPlane.planeDesc.firstSample,
+                     cpuPlane.size()),
+              0);
+}
+
+// Every sample written by a block ordered cmdbuffer should lie in a block it marks
+TEST_P(ApplyCmdBufferBitmask, MarkBlocksCoversWrites)
+{
+    const auto [transformSize, rasterOrder, forceScalar, fixedPoint] = GetParam();
+    if (rasterOrder) {
+        GTEST_SKIP() << "Block maps are only built from block ordered cmdbuffers";
+    }
+    fillCmdBuffers(transformSize, rasterOrder, fixedPointIsSigned(fixedPoint));
+
+    memset(cpuPlane.planeDesc.firstSample, 0, cpuPlane.size());
+    EXPECT_TRUE(ldppApplyCmdBuffer(&taskPool, NULL, &enhancementTile, fixedPoint,
+                                   &cpuPlane.planeDesc, rasterOrder, forceScalar, false));
+
+    const uint32_t blocksAcross = (kWidth + 31) / 32;
+    const uint32_t blocksDown = (kHeight + 31) / 32;
+    std::vector<uint8_t> cpuMap(blocksAcross * blocksDown, 0);
+    std::vector<uint8_t> bitmaskMap(blocksAcross * blocksDown, 0);
+    EXPECT_TRUE(ldppCmdBufferMarkBlocks(&enhancementTile, false, cpuMap.data(), blocksAcross));
+    EXPECT_TRUE(ldppCmdBufferMarkBlocks(&enhancementTile, true, bitmaskMap.data(), blocksAcross));
+    EXPECT_EQ(cpuMap, bitmaskMap);
+    EXPECT_NE(std::count(cpuMap.begin(), cpuMap.end(), 0), 0);
+
+    const uint32_t sampleSize = fixedPointByteSize(fixedPoint);
+    for (uint32_t y = 0; y < kHeight; ++y) {
+        const uint8_t* row = cpuPlane.planeDesc.firstSample + y * cpuPlane.planeDesc.rowByteStride;
+        for (uint32_t x = 0; x < kWidth; ++x) {
+            const bool zero = std::all_of(row + x * sampleSize, row + (x + 1) * sampleSize,
+                                          [](uint8_t byte) { return byte == 0; });
+            if (!zero) {
+                ASSERT_EQ(cpuMap[(y / 32) * blocksAcross + (x / 32)], 1)
+                    << "Unmarked write at " << x << "," << y;
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(ApplyCmdBufferBitmask, ApplyCmdBufferBitmask,
+                         testing::Combine(testing::Values(4, 16), testing::Bool(), testing::Bool(),
+                                          testing::Values(LdpFPU8, LdpFPU10, LdpFPS10, LdpFPS14)));
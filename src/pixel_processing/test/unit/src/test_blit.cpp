@@ -17,6 +17,8 @@
 #include "test_plane.h"
 
 #include <gtest/gtest.h>
+#include <LCEVC/common/task_pool.h>
+#include <LCEVC/pipeline/picture_layout.h>
 #include <LCEVC/pixel_processing/blit.h>
 #include <range/v3/view.hpp>
 #include <rng.h>
@@ -28,7 +30,8 @@
 extern "C"
 {
 PlaneBlitFunction planeBlitGetFunction(LdpFixedPoint srcFP, LdpFixedPoint dstFP, LdppBlendingMode blending,
-                                       bool forceScalar, uint32_t planeIndex, bool isNV12);
+                                       bool forceScalar, BlitPacking srcPacking,
+                                       BlitPacking dstPacking);
 }
 
 namespace rg = ranges;
@@ -59,9 +62,10 @@ protected:
     void SetUp() override
     {
         const auto& params = GetParam();
-        m_scalarFunction =
-            planeBlitGetFunction(params.srcFP, params.dstFP, BMCopy, kForceScalar, 0, false);
-        m_simdFunction = planeBlitGetFunction(params.srcFP, params.dstFP, BMCopy, kSelectSIMD, 0, false);
+        m_scalarFunction = planeBlitGetFunction(params.srcFP, params.dstFP, BMCopy, kForceScalar,
+                                                BPPlanar, BPPlanar);
+        m_simdFunction = planeBlitGetFunction(params.srcFP, params.dstFP, BMCopy, kSelectSIMD,
+                                              BPPlanar, BPPlanar);
 
         m_src.initialize(kWidth, kHeight, kStride, params.srcFP);
         m_dstScalar.initialize(kWidth, kHeight, kStride, params.dstFP);
@@ -115,7 +119,8 @@ TEST_P(AddTest, CompareSIMD)
     // Copy scalar destination over to simd destination. As we are testing additive
     // blits, it's useful to have plenty of random noise in both m_src and dst.
     const auto& params = GetParam();
-    auto copyFunction = planeBlitGetFunction(params.dstFP, params.dstFP, BMCopy, kSelectSIMD, 0, false);
+    auto copyFunction = planeBlitGetFunction(params.dstFP, params.dstFP, BMCopy, kSelectSIMD,
+                                             BPPlanar, BPPlanar);
     LdppBlitArgs copyArgs;
     copyArgs.src = &m_dstScalar.planeDesc;
     copyArgs.dst = &m_dstSIMD.planeDesc;
@@ -208,3 +213,214 @@ const auto kBlitParams = kFixedPointAll | rv::transform([](auto value) {
 INSTANTIATE_TEST_SUITE_P(BlitTests, AddTest, testing::ValuesIn(kBlitParams), BlitToString);
 
 // -----------------------------------------------------------------------------
+
+// Semi-planar (interleaved and/or MSB aligned) conversions to and from the internal format.
+//
+struct PackedBlitTestParams
+{
+    LdpFixedPoint externalFP;
+    BlitPacking packing;
+    bool reducedPrecision = false; // Internal planes keep the external fixed point
+};
+
+class PackedBlitTest : public testing::TestWithParam<PackedBlitTestParams>
+{
+protected:
+    void SetUp() override
+    {
+        const auto& params = GetParam();
+        const LdpFixedPoint internalFP = params.reducedPrecision
+                                             ? params.externalFP
+                                             : fixedPointHighPrecision(params.externalFP);
+        const uint32_t components = (params.packing & BPInterleaved) ? 2 : 1;
+
+        for (uint32_t i = 0; i < 2; ++i) {
+            m_fromPacked[i] = planeBlitGetFunction(params.externalFP, internalFP, BMCopy,
+                                                   i == 0, params.packing, BPPlanar);
+            m_toPacked[i] = planeBlitGetFunction(internalFP, params.externalFP, BMCopy, i == 0,
+                                                 BPPlanar, params.packing);
+        }
+
+        // External planes hold their samples in a 16 bit container when MSB aligned
+        const LdpFixedPoint containerFP = (params.packing & BPMSBAligned) ? LdpFPU14 : LdpFPU8;
+        m_packed.initialize(kWidth * components, kHeight, kStride * components, containerFP);
+        m_packedScalar.initialize(kWidth * components, kHeight, kStride * components, containerFP);
+        m_packedSIMD.initialize(kWidth * components, kHeight, kStride * components, containerFP);
+        for (auto& plane : m_internal) {
+            plane.initialize(kWidth, kHeight, kStride, internalFP);
+        }
+    }
+
+    // Fill the packed plane with valid samples of the external fixed point.
+    void fillPacked()
+    {
+        const auto& params = GetParam();
+        const uint32_t msbShift =
+            (params.packing & BPMSBAligned) ? 16 - bitdepthFromFixedPoint(params.externalFP) : 0;
+        lcevc_dec::utility::RNG data(static_cast<uint32_t>(fixedPointMaxValue(params.externalFP)));
+
+        for (uint32_t y = 0; y < m_packed.height; ++y) {
+            uint8_t* row = m_packed.planeDesc.firstSample + y * m_packed.planeDesc.rowByteStride;
+            for (uint32_t x = 0; x < m_packed.width; ++x) {
+                if (params.packing & BPMSBAligned) {
+                    reinterpret_cast<uint16_t*>(row)[x] = static_cast<uint16_t>(data() << msbShift);
+                } else {
+                    row[x] = static_cast<uint8_t>(data());
+                }
+            }
+        }
+    }
+
+    LdppBlitArgs makeArgs(const LdpPicturePlaneDesc* src, const LdpPicturePlaneDesc* dst,
+                          const LdpPicturePlaneDesc* src2 = nullptr) const
+    {
+        LdppBlitArgs args;
+        args.src = src;
+        args.dst = dst;
+        args.minWidth = kWidth;
+        args.offset = 0;
+        args.count = kHeight;
+        args.src2 = src2;
+        return args;
+    }
+
+    // Plane description of one component of the packed plane.
+    LdpPicturePlaneDesc component(const TestPlane& plane, uint32_t index) const
+    {
+        const uint32_t sampleSize = (GetParam().packing & BPMSBAligned) ? 2 : 1;
+        LdpPicturePlaneDesc desc = plane.planeDesc;
+        desc.firstSample += index * sampleSize;
+        return desc;
+    }
+
+    TestPlane m_packed{};
+    TestPlane m_packedScalar{};
+    TestPlane m_packedSIMD{};
+    TestPlane m_internal[2]{};
+
+    PlaneBlitFunction m_fromPacked[2]{};
+    PlaneBlitFunction m_toPacked[2]{};
+};
+
+TEST_P(PackedBlitTest, RoundTrip)
+{
+    const bool interleaved = GetParam().packing & BPInterleaved;
+    fillPacked();
+
+    for (uint32_t select = 0; select < 2; ++select) {
+        ASSERT_NE(m_fromPacked[select], nullptr);
+        ASSERT_NE(m_toPacked[select], nullptr);
+
+        TestPlane& output = (select == 0) ? m_packedScalar : m_packedSIMD;
+        const uint32_t components = interleaved ? 2 : 1;
+
+        for (uint32_t index = 0; index < components; ++index) {
+            const LdpPicturePlaneDesc src = component(m_packed, index);
+            const LdppBlitArgs args = makeArgs(&src, &m_internal[index].planeDesc);
+            m_fromPacked[select](&args);
+        }
+
+        const LdppBlitArgs args = makeArgs(&m_internal[0].planeDesc, &output.planeDesc,
+                                           interleaved ? &m_internal[1].planeDesc : nullptr);
+        m_toPacked[select](&args);
+
+        EXPECT_EQ(hashActiveRegion(output), hashActiveRegion(m_packed)) << "select " << select;
+    }
+}
+
+// Helper for printing a meaningful name for the test parameter
+std::string PackedToString(const testing::TestParamInfo<PackedBlitTestParams>& value)
+{
+    std::stringstream ss;
+    ss << fixedPointToString(value.param.externalFP);
+    if (value.param.packing & BPInterleaved) {
+        ss << "_interleaved";
+    }
+    if (value.param.packing & BPMSBAligned) {
+        ss << "_msb";
+    }
+    if (value.param.reducedPrecision) {
+        ss << "_reduced";
+    }
+    return ss.str();
+}
+
+const std::vector<PackedBlitTestParams> kPackedParams = {
+    {LdpFPU8, BPInterleaved},
+    {LdpFPU8, BPInterleaved, true},
+    {LdpFPU10, BPMSBAligned},
+    {LdpFPU10, static_cast<BlitPacking>(BPInterleaved | BPMSBAligned)},
+    {LdpFPU14, BPMSBAligned},
+    {LdpFPU14, static_cast<BlitPacking>(BPInterleaved | BPMSBAligned)},
+};
+
+INSTANTIATE_TEST_SUITE_P(BlitTests, PackedBlitTest, testing::ValuesIn(kPackedParams),
+                         PackedToString);
+
+// -----------------------------------------------------------------------------
+
+// Adding only the marked blocks of a plane should match adding the whole plane, when the unmarked
+// blocks of the source are zero.
+//
+class BlockBlitTest : public testing::TestWithParam<bool>
+{
+protected:
+    void SetUp() override
+    {
+        ldcTaskPoolInitialize(&m_taskPool, ldcMemoryAllocatorMalloc(), ldcMemoryAllocatorMalloc(),
+                              4, 4);
+        ldpInternalPictureLayoutInitialize(&m_layout, LdpColorFormatGRAY_8, kWidth, kHeight, 0);
+
+        m_src.initialize(kWidth, kHeight, kStride, LdpFPS8);
+        m_dstFull.initialize(kWidth, kHeight, kStride, LdpFPS8);
+        m_dstBlocks.initialize(kWidth, kHeight, kStride, LdpFPS8);
+    }
+
+    void TearDown() override { ldcTaskPoolDestroy(&m_taskPool); }
+
+    LdcTaskPool m_taskPool = {};
+    LdpPictureLayout m_layout = {};
+    TestPlane m_src{};
+    TestPlane m_dstFull{};
+    TestPlane m_dstBlocks{};
+};
+
+TEST_P(BlockBlitTest, MatchesFullAdd)
+{
+    const bool forceScalar = GetParam();
+    const uint32_t blocksAcross = (kWidth + 31) / 32;
+    const uint32_t blocksDown = (kHeight + 31) / 32;
+
+    fillPlaneWithNoise(m_src);
+    fillPlaneWithNoise(m_dstFull);
+    memcpy(m_dstBlocks.planeDesc.firstSample, m_dstFull.planeDesc.firstSample, m_dstFull.size());
+
+    // Mark about half of the blocks, and clear the source in the others
+    lcevc_dec::utility::RNG rng(2);
+    std::vector<uint8_t> blockMap(blocksAcross * blocksDown);
+    for (uint32_t blockY = 0; blockY < blocksDown; ++blockY) {
+        for (uint32_t blockX = 0; blockX < blocksAcross; ++blockX) {
+            blockMap[blockY * blocksAcross + blockX] = static_cast<uint8_t>(rng() % 2);
+            if (blockMap[blockY * blocksAcross + blockX]) {
+                continue;
+            }
+            for (uint32_t y = blockY * 32; y < std::min(kHeight, (blockY + 1) * 32); ++y) {
+                uint8_t* row = m_src.planeDesc.firstSample + y * m_src.planeDesc.rowByteStride;
+                const uint32_t x = blockX * 32;
+                memset(row + x * 2, 0, (std::min(kWidth, x + 32) - x) * 2);
+            }
+        }
+    }
+
+    EXPECT_TRUE(ldppPlaneBlit(&m_taskPool, NULL, forceScalar, 0, &m_layout, &m_layout,
+                              &m_src.planeDesc, &m_dstFull.planeDesc, BMAdd));
+    EXPECT_TRUE(ldppPlaneBlitBlocks(&m_taskPool, NULL, forceScalar, 0, &m_layout, &m_layout,
+                                    &m_src.planeDesc, &m_dstBlocks.planeDesc, BMAdd,
+                                    blockMap.data(), blocksAcross));
+
+    EXPECT_EQ(hashActiveRegion(m_dstBlocks), hashActiveRegion(m_dstFull));
+}
+
+INSTANTIATE_TEST_SUITE_P(BlitTests, BlockBlitTest, testing::Values(kForceScalar, kSelectSIMD));
+
+// -----------------------------------------------------------------------------
@@ -16,14 +16,13 @@
 #include <LCEVC/pixel_processing/dither.h>
 
 #include <array>
-#include <memory>
-#include <numeric>
+#include <vector>
 
 // -----------------------------------------------------------------------------
 
 static constexpr uint8_t kValidDitherStrength = 31;
 static constexpr uint8_t kInvalidDitherStrength = 32;
-static constexpr size_t kInvalidBufferLength = 16385;
+static constexpr uint64_t kDitherSeed = 1234;
 
 // -----------------------------------------------------------------------------
 
@@ -32,12 +31,22 @@ class DitherFixture : public testing::Test
 protected:
     void SetUp() override
     {
-        ldppDitherGlobalInitialize(ldcMemoryAllocatorMalloc(), &dither, 0);
+        ldppDitherGlobalInitialize(&dither, kDitherSeed);
         ldppDitherFrameInitialise(&frame, &dither, 0, 0);
         ldppDitherSliceInitialise(&slice, &frame, 0, 0);
     }
 
-    void TearDown() override { ldppDitherGlobalRelease(&dither); }
+    // Unscaled generator output for the run of pixels at x in the slice's rows
+    std::vector<int32_t> rowValues(const LdppDitherSlice& rowSlice, uint32_t x, size_t length)
+    {
+        std::vector<int32_t> values(length, 0);
+        LdppDitherRow row;
+        ldppDitherRowInitialise(&rowSlice, &row, x);
+        for (int32_t& value : values) {
+            ldppDitherApply(&value, &row, 0, kValidDitherStrength);
+        }
+        return values;
+    }
 
     LdppDitherGlobal dither;
     LdppDitherFrame frame;
@@ -52,61 +61,85 @@ TEST_F(DitherFixture, CheckInvalidStrength)
     EXPECT_TRUE(ldppDitherFrameInitialise(&frame, &dither, 0, kValidDitherStrength));
 }
 
-TEST_F(DitherFixture, CheckInvalidLength)
-{
-    EXPECT_EQ(ldppDitherGetBuffer(&slice, kInvalidBufferLength), nullptr);
-}
-
 TEST_F(DitherFixture, CheckValuesAreWithinStrength)
 {
-    // This relies on knowing that the internal dither buffer is
-    // 16k long.
-    static constexpr size_t kDitherBufferCheckLength = 8192;
+    static constexpr size_t kDitherCheckLength = 8192;
 
     for (uint8_t strength = 1; strength <= kValidDitherStrength; ++strength) {
-        const uint16_t* entropy = ldppDitherGetBuffer(&slice, kDitherBufferCheckLength);
+        LdppDitherRow row;
+        ldppDitherRowInitialise(&slice, &row, strength);
         const int32_t minimumValue = -strength;
         const int32_t maximumValue = strength;
 
-        for (size_t j = 0; j < kDitherBufferCheckLength; j++) {
+        for (size_t j = 0; j < kDitherCheckLength; j++) {
             int32_t result = 0;
-            ldppDitherApply(&result, &entropy, 0, strength);
+            ldppDitherApply(&result, &row, 0, strength);
             EXPECT_GE(result, minimumValue);
             EXPECT_LE(result, maximumValue);
         }
     }
 }
 
+TEST_F(DitherFixture, CheckDeterministicByPosition)
+{
+    static constexpr size_t kLength = 256;
+    const std::vector<int32_t> values = rowValues(slice, 0, kLength);
+
+    // The same seeds and position give the same noise however the slice was reached
+    LdppDitherFrame otherFrame;
+    LdppDitherSlice otherSlice;
+    ldppDitherFrameInitialise(&otherFrame, &dither, 0, 0);
+    ldppDitherSliceInitialise(&otherSlice, &otherFrame, 0, 0);
+    EXPECT_EQ(values, rowValues(otherSlice, 0, kLength));
+
+    // Any change of position or seed gives different noise
+    EXPECT_NE(values, rowValues(slice, 16, kLength));
+    ldppDitherSliceInitialise(&otherSlice, &frame, 2, 0);
+    EXPECT_NE(values, rowValues(otherSlice, 0, kLength));
+    ldppDitherSliceInitialise(&otherSlice, &frame, 0, 1);
+    EXPECT_NE(values, rowValues(otherSlice, 0, kLength));
+    ldppDitherFrameInitialise(&otherFrame, &dither, 1, 0);
+    ldppDitherSliceInitialise(&otherSlice, &otherFrame, 0, 0);
+    EXPECT_NE(values, rowValues(otherSlice, 0, kLength));
+}
+
 TEST_F(DitherFixture, CheckSIMDAccuracy)
 {
-    static constexpr size_t kEntropyRange = 0x10000;
-    std::array<uint16_t, 16> entropyValues{};
+    static constexpr size_t kSteps = 0x1000;
     std::array<int16_t, 16> simdResults{};
 
     for (uint8_t strength = 1; strength <= kValidDitherStrength; ++strength) {
-        for (size_t simdIndex = 0; simdIndex < kEntropyRange; simdIndex += 16) {
-            std::iota(entropyValues.begin(), entropyValues.end(), static_cast<uint16_t>(simdIndex));
-            const uint16_t* pEntropySIMD = entropyValues.data();
-            const uint16_t* pEntropyScalar = entropyValues.data();
+        LdppDitherRow scalarRow;
+        ldppDitherRowInitialise(&slice, &scalarRow, strength);
+
+#if VN_CORE_FEATURE(SSE)
+        __m128i state[2];
+        ldppDitherLoadSSE(&scalarRow, state);
+#elif VN_CORE_FEATURE(NEON)
+        uint32x4x2_t state;
+        ldppDitherLoadNEON(&scalarRow, &state);
+#endif
+
+        for (size_t step = 0; step < kSteps; ++step) {
             simdResults.fill(0);
 
 #if VN_CORE_FEATURE(SSE)
-            ldppDitherApplySSE((__m128i*)simdResults.data(), &pEntropySIMD, 0, strength);
+            ldppDitherApplySSE((__m128i*)simdResults.data(), state, 0, strength);
 #elif VN_CORE_FEATURE(NEON)
             // Explicit copy to/from result buffer for NEON
             int16x8x2_t neonResult = vld2q_s16(simdResults.data());
-            ldppDitherApplyNEON(&neonResult, &pEntropySIMD, 0, strength);
+            ldppDitherApplyNEON(&neonResult, &state, 0, strength);
             vst2q_s16(simdResults.data(), neonResult);
 #endif
 
             // Compare SIMD result against scalar
             for (auto simdResult : simdResults) {
                 int32_t scalarResult = 0;
-                ldppDitherApply(&scalarResult, &pEntropyScalar, 0, strength);
+                ldppDitherApply(&scalarResult, &scalarRow, 0, strength);
                 EXPECT_EQ(simdResult, scalarResult);
             }
         }
     }
 }
 
-// -----------------------------------------------------------------------------
\ No newline at end of file
+// -----------------------------------------------------------------------------
@@ -19,6 +19,7 @@ list(
     "src/bin_writer.cpp"
     "src/check.cpp"
     "src/get_program_dir.cpp"
+    "src/mapped_file.cpp"
     "src/md5.cpp"
     "src/parse_raw_name.cpp"
     "src/picture_functions.cpp"
@@ -44,7 +45,7 @@ if (VN_SDK_JSON_CONFIG)
     list(APPEND SOURCES "src/configure.cpp")
 endif ()
 
-list(APPEND HEADERS "src/bin_writer.h" "src/enum_map.h" "src/parse_raw_name.h"
+list(APPEND HEADERS "src/bin_writer.h" "src/enum_map.h" "src/mapped_file.h" "src/parse_raw_name.h"
      "src/base_decoder_bin.h")
 
 list(
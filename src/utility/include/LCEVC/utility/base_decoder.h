@@ -97,6 +97,9 @@ public:
     virtual bool hasImage() const = 0;
     // Copy image pointer, size & timestamp - pointer will be valid until next update()
     virtual bool getImage(Data& packet) const = 0;
+    // Return true if image pointers stay valid for the lifetime of the decoder, rather than until
+    // the next update() - e.g. they point into a memory mapped file.
+    virtual bool imagePersistent() const { return false; }
     // Image data has been consumed
     virtual void clearImage() = 0;
 
@@ -131,10 +134,13 @@ createBaseDecoderLibAV(std::string_view source, std::string_view sourceFormat =
  * @param[in]       rawFile         The raw file with base pictures - the base format and size is
  *                                  parsed from this name.
  * @param[in]       binFile         The LCEVC bin file with enhancement data.
+ * @param[in]       readAhead       Number of raw base frames to read ahead on a background thread.
  *
  * @return                          Unique pointer to a new base Decoder, or nullptr if failed.
  */
-std::unique_ptr<BaseDecoder> createBaseDecoderBinLinear(std::string_view rawFile, std::string_view binFile);
+std::unique_ptr<BaseDecoder> createBaseDecoderBinLinear(std::string_view rawFile,
+                                                        std::string_view binFile,
+                                                        uint32_t readAhead = 0);
 
 /*!
  * \brief Create a base video stream decoder that reads LCEVC bin files and raw base frames in
@@ -143,11 +149,13 @@ std::unique_ptr<BaseDecoder> createBaseDecoderBinLinear(std::string_view rawFile
  * @param[in]       rawFile         The raw file with base pictures - the base format and size is
  *                                  parsed from this name.
  * @param[in]       binFile         The LCEVC bin file with enhancement data.
+ * @param[in]       readAhead       Number of raw base frames to read ahead on a background thread.
  *
  * @return                          Unique pointer to a new base Decoder, or nullptr if failed.
  */
 std::unique_ptr<BaseDecoder> createBaseDecoderBinNonLinear(std::string_view rawFile,
-                                                           std::string_view binFile);
+                                                           std::string_view binFile,
+                                                           uint32_t readAhead = 0);
 
 } // namespace lcevc_dec::utility
 
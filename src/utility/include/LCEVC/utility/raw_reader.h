@@ -20,16 +20,30 @@
 #include <LCEVC/api_utility/picture_layout.h>
 #include <LCEVC/lcevc_dec.h>
 
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 namespace lcevc_dec::utility {
 
+class MappedFile;
+
 class RawReader
 {
 public:
+    ~RawReader();
+
+    RawReader(const RawReader&) = delete;
+    RawReader(RawReader&&) = delete;
+    RawReader& operator=(const RawReader&) = delete;
+    RawReader& operator=(RawReader&&) = delete;
+
     // Information
     const LCEVC_PictureDesc& description() const { return m_description; }
     const PictureLayout& layout() const { return m_layout; }
@@ -40,11 +54,29 @@ public:
     // Read into Picture
     bool read(LCEVC_DecoderHandle decoder, LCEVC_PictureHandle pictureHandle);
 
+    // True if the file is memory mapped, and readMapped() can be used
+    bool isMapped() const { return m_file != nullptr; }
+
+    // Read without copying - returns a pointer to the next picture in the mapped file, valid for
+    // the lifetime of the reader, or nullptr if the file is not mapped or has no more pictures. The
+    // pages are copy-on-write, so the data can be bound to a writable external picture.
+    uint8_t* readMapped();
+
+    // Start a thread that reads up to `frames` pictures ahead of the caller. For mapped files, the
+    // thread faults in the upcoming pages, otherwise it reads into a queue of buffers that read()
+    // then takes from. Zero stops the thread.
+    void setReadAhead(uint32_t frames);
+
     // Byte offset in stream
     uint64_t offset() const;
 
 private:
-    explicit RawReader(const LCEVC_PictureDesc& description, std::unique_ptr<std::istream> stream);
+    explicit RawReader(const LCEVC_PictureDesc& description, std::unique_ptr<std::istream> stream,
+                       std::shared_ptr<MappedFile> file);
+
+    bool readAheadRunning() const { return m_readAheadThread.joinable(); }
+    bool popReadAhead(std::vector<uint8_t>& memory);
+    void readAheadThread();
 
     friend std::unique_ptr<RawReader> createRawReader(const LCEVC_PictureDesc& description,
                                                       std::string_view name);
@@ -54,6 +86,18 @@ private:
     LCEVC_PictureDesc m_description;
     PictureLayout m_layout;
     std::unique_ptr<std::istream> m_stream;
+    std::shared_ptr<MappedFile> m_file;
+
+    // Read-ahead state - everything below is guarded by m_readAheadMutex while the thread runs
+    std::thread m_readAheadThread;
+    std::mutex m_readAheadMutex;
+    std::condition_variable m_readAheadCondition;
+    std::deque<std::vector<uint8_t>> m_readAheadFrames;
+    uint32_t m_readAheadLimit = 0;
+    uint64_t m_readOffset = 0;
+    uint64_t m_touchedOffset = 0;
+    bool m_readAheadStop = false;
+    bool m_readAheadEnd = false;
 };
 
 /*!
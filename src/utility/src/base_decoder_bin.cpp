@@ -30,6 +30,15 @@ namespace lcevc_dec::utility {
 
 bool BaseDecoderBin::isInitialized() const { return m_rawReader && m_binReader; }
 
+const uint8_t* BaseDecoderBin::rawRead(std::vector<uint8_t>& memory)
+{
+    if (m_rawReader->isMapped()) {
+        return m_rawReader->readMapped();
+    }
+
+    return m_rawReader->read(memory) ? memory.data() : nullptr;
+}
+
 // Work out starting PTS and PTS increment - by looking at up to first 100 frames
 //
 bool BaseDecoderBin::probe(std::string_view binFile)
@@ -86,7 +95,8 @@ bool BaseDecoderBin::probe(std::string_view binFile)
     return true;
 }
 
-BaseDecoderBin::BaseDecoderBin(std::string_view rawFile, std::string_view binFile)
+BaseDecoderBin::BaseDecoderBin(std::string_view rawFile, std::string_view binFile,
+                               uint32_t readAhead)
 {
     if (!probe(binFile)) {
         return;
@@ -102,6 +112,8 @@ BaseDecoderBin::BaseDecoderBin(std::string_view rawFile, std::string_view binFil
         return;
     }
 
+    rawReader->setReadAhead(readAhead);
+
     m_pictureDesc = rawReader->description();
     m_pictureLayout = PictureLayout(m_pictureDesc);
     m_rawReader = std::move(rawReader);
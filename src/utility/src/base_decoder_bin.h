@@ -36,13 +36,15 @@ protected:
     BaseDecoderBin() = default;
 
 public:
-    BaseDecoderBin(std::string_view rawFile, std::string_view binFile);
+    BaseDecoderBin(std::string_view rawFile, std::string_view binFile, uint32_t readAhead);
 
     bool isInitialized() const;
 
     const LCEVC_PictureDesc& description() const override { return m_pictureDesc; }
     const PictureLayout& layout() const override { return m_pictureLayout; }
 
+    bool imagePersistent() const override { return m_rawReader && m_rawReader->isMapped(); }
+
     int maxReorder() const override { return 0; }
 
 protected:
@@ -55,7 +57,9 @@ protected:
     {
         return m_binReader->read(decodeIndex, presentationIndex, payload);
     }
-    bool rawRead(std::vector<uint8_t>& memory) { return m_rawReader->read(memory); }
+    // Read the next raw image - returns a pointer into the mapped RAW file if possible, otherwise
+    // reads into `memory`. Returns nullptr at the end of the file.
+    const uint8_t* rawRead(std::vector<uint8_t>& memory);
 
     int64_t getLastBaseTimestamp() const { return m_lastBaseTimestamp; }
     void incrementLastBaseTimestamp() { m_lastBaseTimestamp += m_timestampStep; }
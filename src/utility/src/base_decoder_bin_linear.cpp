@@ -40,8 +40,8 @@ class BaseDecoderBinLinear final : public BaseDecoderBin
 
 public:
     BaseDecoderBinLinear() = default;
-    BaseDecoderBinLinear(std::string_view rawFile, std::string_view binFile)
-        : BaseClass(rawFile, binFile)
+    BaseDecoderBinLinear(std::string_view rawFile, std::string_view binFile, uint32_t readAhead)
+        : BaseClass(rawFile, binFile, readAhead)
     {}
     ~BaseDecoderBinLinear() override;
 
@@ -64,15 +64,19 @@ public:
 
 private:
     friend std::unique_ptr<BaseDecoder> createBaseDecoderBinLinear(std::string_view rawFile,
-                                                                   std::string_view binFile);
+                                                                   std::string_view binFile,
+                                                                   uint32_t readAhead);
 
     bool hasData() const;
 
     // Internally buffer image and enhancement data, then provide them simultaneously.
     // ManagedData m_imageData = {nullptr};
     // ManagedData m_enhancementData = {nullptr};
-    std::map<int64_t, std::vector<uint8_t>> m_imageDataList = {};
+    std::map<int64_t, Data> m_imageDataList = {};
     std::map<int64_t, std::vector<uint8_t>> m_enhancementDataList = {};
+
+    // Copies of images, if the RAW file is not mapped
+    std::map<int64_t, std::vector<uint8_t>> m_imageStorage = {};
 };
 
 BaseDecoderBinLinear::~BaseDecoderBinLinear() = default;
@@ -89,7 +93,7 @@ bool BaseDecoderBinLinear::getImage(Data& data) const
         return false;
     }
 
-    data = Data(*m_imageDataList.begin());
+    data = m_imageDataList.begin()->second;
     return true;
 }
 
@@ -97,6 +101,7 @@ bool BaseDecoderBinLinear::getImage(Data& data) const
 // enhancement pairs
 void BaseDecoderBinLinear::clearImage()
 {
+    m_imageStorage.erase(m_imageDataList.begin()->first);
     m_imageDataList.erase(m_imageDataList.begin());
     m_enhancementDataList.erase(m_enhancementDataList.begin());
 }
@@ -136,8 +141,15 @@ bool BaseDecoderBinLinear::update()
         }
 
         if (getRawGood()) {
-            if (std::vector<uint8_t> buffer; rawRead(buffer)) {
-                m_imageDataList[getLastBaseTimestamp()] = buffer;
+            if (std::vector<uint8_t> buffer; const uint8_t* image = rawRead(buffer)) {
+                const int64_t timestamp = getLastBaseTimestamp();
+                Data& data = m_imageDataList[timestamp];
+                data.ptr = image;
+                data.size = static_cast<uint32_t>(layout().size());
+                data.pts = timestamp;
+                if (image == buffer.data()) {
+                    data.ptr = (m_imageStorage[timestamp] = std::move(buffer)).data();
+                }
                 incrementLastBaseTimestamp();
             } else {
                 // End of RAW file
@@ -150,9 +162,11 @@ bool BaseDecoderBinLinear::update()
     return true;
 }
 
-std::unique_ptr<BaseDecoder> createBaseDecoderBinLinear(std::string_view rawFile, std::string_view binFile)
+std::unique_ptr<BaseDecoder> createBaseDecoderBinLinear(std::string_view rawFile,
+                                                        std::string_view binFile,
+                                                        uint32_t readAhead)
 {
-    auto decoder = std::make_unique<BaseDecoderBinLinear>(rawFile, binFile);
+    auto decoder = std::make_unique<BaseDecoderBinLinear>(rawFile, binFile, readAhead);
     if (!decoder || !decoder->isInitialized()) {
         return nullptr;
     }
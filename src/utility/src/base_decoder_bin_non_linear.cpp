@@ -32,8 +32,8 @@ class BaseDecoderBinNonLinear final : public BaseDecoderBin
 
 public:
     BaseDecoderBinNonLinear() = default;
-    BaseDecoderBinNonLinear(std::string_view rawFile, std::string_view binFile)
-        : BaseClass(rawFile, binFile)
+    BaseDecoderBinNonLinear(std::string_view rawFile, std::string_view binFile, uint32_t readAhead)
+        : BaseClass(rawFile, binFile, readAhead)
     {}
     ~BaseDecoderBinNonLinear() override;
 
@@ -56,13 +56,14 @@ public:
 
 private:
     friend std::unique_ptr<BaseDecoder> createBaseDecoderBinNonLinear(std::string_view rawFile,
-                                                                      std::string_view binFile);
+                                                                      std::string_view binFile,
+                                                                      uint32_t readAhead);
 
     // Holding buffers for output packets
     Data m_imageData;
     Data m_enhancementData;
 
-    // Holding buffer for output images
+    // Holding buffer for output images, if the RAW file is not mapped
     std::vector<uint8_t> m_image;
 
     // Holding buffer for enhanced data
@@ -131,9 +132,9 @@ bool BaseDecoderBinNonLinear::update()
 
     if (!hasImage() && getRawGood() && !m_pendingBase.empty() &&
         *m_pendingBase.begin() == getLastBaseTimestamp()) {
-        if (rawRead(m_image)) {
-            m_imageData.ptr = m_image.data();
-            m_imageData.size = static_cast<uint32_t>(m_image.size());
+        if (const uint8_t* image = rawRead(m_image)) {
+            m_imageData.ptr = image;
+            m_imageData.size = static_cast<uint32_t>(layout().size());
             m_imageData.pts = getLastBaseTimestamp();
             // Remove decoded timestamp from pending set
             m_pendingBase.erase(m_pendingBase.begin());
@@ -149,9 +150,11 @@ bool BaseDecoderBinNonLinear::update()
     return true;
 }
 
-std::unique_ptr<BaseDecoder> createBaseDecoderBinNonLinear(std::string_view rawFile, std::string_view binFile)
+std::unique_ptr<BaseDecoder> createBaseDecoderBinNonLinear(std::string_view rawFile,
+                                                           std::string_view binFile,
+                                                           uint32_t readAhead)
 {
-    auto decoder = std::make_unique<BaseDecoderBinNonLinear>(rawFile, binFile);
+    auto decoder = std::make_unique<BaseDecoderBinNonLinear>(rawFile, binFile, readAhead);
     if (!decoder || !decoder->isInitialized()) {
         return nullptr;
     }
@@ -755,6 +755,12 @@ namespace {
 #endif
             case AV_PIX_FMT_NV12: return LCEVC_NV12_8;
             case AV_PIX_FMT_NV21: return LCEVC_NV21_8;
+            case AV_PIX_FMT_NV16: return LCEVC_NV16_8;
+            case AV_PIX_FMT_P010LE: return LCEVC_P010_LE;
+            case AV_PIX_FMT_P016LE: return LCEVC_P016_LE;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 37, 100)
+            case AV_PIX_FMT_P210LE: return LCEVC_P210_LE;
+#endif
             case AV_PIX_FMT_RGB24: return LCEVC_RGB_8;
             case AV_PIX_FMT_BGR24: return LCEVC_BGR_8;
             case AV_PIX_FMT_RGBA: return LCEVC_RGBA_8;
@@ -863,6 +869,10 @@ namespace {
             case LCEVC_I420_16_LE: return "format=pix_fmts=yuv420p16le";
             case LCEVC_NV12_8: return "format=pix_fmts=nv12";
             case LCEVC_NV21_8: return "format=pix_fmts=nv21";
+            case LCEVC_NV16_8: return "format=pix_fmts=nv16";
+            case LCEVC_P010_LE: return "format=pix_fmts=p010le";
+            case LCEVC_P016_LE: return "format=pix_fmts=p016le";
+            case LCEVC_P210_LE: return "format=pix_fmts=p210le";
             case LCEVC_RGB_8: return "format=pix_fmts=rgb24";
             case LCEVC_BGR_8: return "format=pix_fmts=bgr24";
             case LCEVC_RGBA_8: return "format=pix_fmts=rgba";
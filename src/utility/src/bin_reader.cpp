@@ -15,6 +15,7 @@
 // Reader for V-Nova internal .bin format.
 //
 #include "bin_format.h"
+#include "mapped_file.h"
 
 #include <fmt/core.h>
 #include <LCEVC/utility/bin_reader.h>
@@ -105,6 +106,11 @@ std::unique_ptr<BinReader> createBinReader(std::unique_ptr<std::istream> stream)
 
 std::unique_ptr<BinReader> createBinReader(std::string_view name)
 {
+    // Prefer a mapped file - block reads are then plain copies, with no buffered file I/O
+    if (auto file = createMappedFile(name)) {
+        return createBinReader(std::make_unique<MappedStream>(std::move(file)));
+    }
+
     auto stream = std::make_unique<std::ifstream>(std::string(name), std::ios::binary);
     if (!stream->good()) {
         fmt::print(stderr, "Cannot open bin file {}\n", name);
@@ -0,0 +1,177 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Read-only memory mapping of a whole file, and an input stream that reads from it.
+//
+#include "mapped_file.h"
+
+#include <LCEVC/build_config.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#if VN_OS(WINDOWS)
+#include <windows.h>
+#elif VN_OS(LINUX) || VN_OS(ANDROID) || VN_OS(APPLE)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lcevc_dec::utility {
+
+MappedFile::MappedFile(uint8_t* data, size_t size, void* handle)
+    : m_data(data)
+    , m_size(size)
+    , m_handle(handle)
+{}
+
+#if VN_OS(WINDOWS)
+
+MappedFile::~MappedFile()
+{
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_handle));
+}
+
+std::shared_ptr<MappedFile> createMappedFile(std::string_view name)
+{
+    HANDLE file = CreateFileA(std::string(name).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0 ||
+        static_cast<uint64_t>(fileSize.QuadPart) > SIZE_MAX) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    // The mapping object keeps the file open, so the file handle can be closed straight away
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return nullptr;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+
+    return std::shared_ptr<MappedFile>(new MappedFile(
+        static_cast<uint8_t*>(data), static_cast<size_t>(fileSize.QuadPart), mapping));
+}
+
+#elif VN_OS(LINUX) || VN_OS(ANDROID) || VN_OS(APPLE)
+
+MappedFile::~MappedFile() { munmap(m_data, m_size); }
+
+std::shared_ptr<MappedFile> createMappedFile(std::string_view name)
+{
+    const int fd = open(std::string(name).c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat status = {};
+    if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    // Private (copy-on-write) mapping so that pictures bound to the pages may be written to
+    const size_t size = static_cast<size_t>(status.st_size);
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // Files are mostly read front to back
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    return std::shared_ptr<MappedFile>(new MappedFile(static_cast<uint8_t*>(data), size, nullptr));
+}
+
+#else
+
+MappedFile::~MappedFile() = default;
+
+std::shared_ptr<MappedFile> createMappedFile(std::string_view /*name*/) { return nullptr; }
+
+#endif
+
+MappedStreamBuf::MappedStreamBuf(std::shared_ptr<MappedFile> file)
+    : m_file(std::move(file))
+{
+    char* begin = static_cast<char*>(static_cast<void*>(m_file->data()));
+    setg(begin, begin, begin + m_file->size());
+}
+
+MappedStreamBuf::pos_type MappedStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                   std::ios_base::openmode which)
+{
+    if (!(which & std::ios_base::in)) {
+        return pos_type(off_type(-1));
+    }
+
+    off_type base = 0;
+    if (dir == std::ios_base::cur) {
+        base = gptr() - eback();
+    } else if (dir == std::ios_base::end) {
+        base = egptr() - eback();
+    }
+
+    const off_type pos = base + off;
+    if (pos < 0 || pos > egptr() - eback()) {
+        return pos_type(off_type(-1));
+    }
+
+    setg(eback(), eback() + pos, egptr());
+    return pos_type(pos);
+}
+
+MappedStreamBuf::pos_type MappedStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+// Bulk reads are a single copy out of the mapping
+std::streamsize MappedStreamBuf::xsgetn(char_type* s, std::streamsize count)
+{
+    const std::streamsize available = egptr() - gptr();
+    const std::streamsize n = std::min(count, available);
+
+    if (n > 0) {
+        memcpy(s, gptr(), static_cast<size_t>(n));
+        setg(eback(), gptr() + n, egptr());
+    }
+
+    return n;
+}
+
+MappedStream::MappedStream(std::shared_ptr<MappedFile> file)
+    : std::istream(nullptr)
+    , m_buffer(std::move(file))
+{
+    rdbuf(&m_buffer);
+}
+
+} // namespace lcevc_dec::utility
@@ -0,0 +1,94 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+// Read-only memory mapping of a whole file, and an input stream that reads from it.
+//
+#ifndef VN_LCEVC_UTILITY_MAPPED_FILE_H
+#define VN_LCEVC_UTILITY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string_view>
+
+namespace lcevc_dec::utility {
+
+class MappedFile
+{
+public:
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    // Pages are mapped copy-on-write, so writes through the pointer never reach the file
+    uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    MappedFile(uint8_t* data, size_t size, void* handle);
+    friend std::shared_ptr<MappedFile> createMappedFile(std::string_view name);
+
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    // Platform mapping handle, if the platform needs one to unmap
+    void* m_handle = nullptr;
+};
+
+// Stream buffer over a mapped file - keeps the mapping alive for as long as the stream
+//
+class MappedStreamBuf : public std::streambuf
+{
+public:
+    explicit MappedStreamBuf(std::shared_ptr<MappedFile> file);
+
+    const std::shared_ptr<MappedFile>& file() const { return m_file; }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which = std::ios_base::in) override;
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in) override;
+    std::streamsize xsgetn(char_type* s, std::streamsize count) override;
+
+private:
+    std::shared_ptr<MappedFile> m_file;
+};
+
+class MappedStream : public std::istream
+{
+public:
+    explicit MappedStream(std::shared_ptr<MappedFile> file);
+
+    const std::shared_ptr<MappedFile>& file() const { return m_buffer.file(); }
+
+private:
+    MappedStreamBuf m_buffer;
+};
+
+/*!
+ * \brief Map a whole file into memory.
+ *
+ * @param[in]       name Filename to map
+ * @return          Shared pointer to the mapping, or nullptr if the file cannot be mapped (e.g. it
+ *                  is empty, is not a regular file, or the platform does not support mapping).
+ */
+std::shared_ptr<MappedFile> createMappedFile(std::string_view name);
+
+} // namespace lcevc_dec::utility
+
+#endif // VN_LCEVC_UTILITY_MAPPED_FILE_H
@@ -24,7 +24,8 @@
 
 namespace lcevc_dec::utility {
 
-// Maps format names and bit depth to LCEVC_ColorFormat
+// Maps format names and bit depth to LCEVC_ColorFormat - a bit depth of 0 is for formats whose
+// name already says what the depth is.
 static const struct
 {
     const char* name;
@@ -40,7 +41,8 @@ static const struct
     {"y", 14, LCEVC_GRAY_14_LE},    {"y", 16, LCEVC_GRAY_16_LE},    {"nv12", 8, LCEVC_NV12_8},
     {"nv21", 8, LCEVC_NV21_8},      {"rgb", 8, LCEVC_RGB_8},        {"bgr", 8, LCEVC_BGR_8},
     {"rgba", 8, LCEVC_RGBA_8},      {"bgra", 8, LCEVC_BGRA_8},      {"argb", 8, LCEVC_ARGB_8},
-    {"abgr", 8, LCEVC_ABGR_8},
+    {"abgr", 8, LCEVC_ABGR_8},      {"nv16", 8, LCEVC_NV16_8},      {"p010", 0, LCEVC_P010_LE},
+    {"p016", 0, LCEVC_P016_LE},     {"p210", 0, LCEVC_P210_LE},
 };
 
 // Parse filename for picture description
@@ -53,7 +55,8 @@ LCEVC_PictureDesc parseRawName(std::string_view name, float& rate)
     static const std::regex kFormatP420Re("(420|p420|420p|yuv)"); // YUV420 formats (420 is default yuv format)
     static const std::regex kFormatP422Re("(422|p422|422p)"); // YUV422 formats
     static const std::regex kFormatP444Re("(444|p444|444p)"); // YUV444 formats
-    static const std::regex kFormatOtherRe("(y|yuyv|rgb|bgr|rgba|argb|abgr|bgra|nv12|nv21)"); // Other formats
+    static const std::regex kFormatOtherRe( // Other formats
+        "(y|yuyv|rgb|bgr|rgba|argb|abgr|bgra|nv12|nv21|nv16|p010|p016|p210)");
 
     std::string format;
     unsigned bits = 8;
@@ -98,7 +101,7 @@ LCEVC_PictureDesc parseRawName(std::string_view name, float& rate)
     // Convert format name and bitdepth to a specific LCEVC_ColorFormat
     LCEVC_ColorFormat colorFormat = LCEVC_ColorFormat_Unknown;
     for (const auto& pf : kPictureFormats) {
-        if (format == pf.name && bits == pf.bits) {
+        if (format == pf.name && (bits == pf.bits || pf.bits == 0)) {
             colorFormat = pf.format;
             break;
         }
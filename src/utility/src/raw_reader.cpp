@@ -14,31 +14,77 @@
 
 // Class for reading raw image files from streams or filesystem.
 //
+#include "mapped_file.h"
 #include "parse_raw_name.h"
 
 #include <fmt/core.h>
 #include <LCEVC/api_utility/picture_layout.h>
 #include <LCEVC/utility/check.h>
+#include <LCEVC/utility/picture_functions.h>
 #include <LCEVC/utility/picture_lock.h>
 #include <LCEVC/utility/raw_reader.h>
 #include <LCEVC/utility/string_utils.h>
 
+#include <algorithm>
 #include <fstream>
 
 namespace lcevc_dec::utility {
 
-RawReader::RawReader(const LCEVC_PictureDesc& description, std::unique_ptr<std::istream> stream)
+// Granularity for touching pages of mapped files - smaller than any real page size is harmless
+static constexpr uint64_t kReadAheadPageSize = 4096;
+
+RawReader::RawReader(const LCEVC_PictureDesc& description, std::unique_ptr<std::istream> stream,
+                     std::shared_ptr<MappedFile> file)
     : m_description(description)
     , m_layout(description)
     , m_stream(std::move(stream))
-{}
+    , m_file(std::move(file))
+{
+    if (const std::streamoff start = m_stream->tellg(); start > 0) {
+        m_readOffset = static_cast<uint64_t>(start);
+    }
+}
+
+RawReader::~RawReader() { setReadAhead(0); }
+
+uint64_t RawReader::offset() const { return m_readOffset; }
+
+uint8_t* RawReader::readMapped()
+{
+    if (!m_file) {
+        return nullptr;
+    }
+
+    std::lock_guard lock(m_readAheadMutex);
+
+    if (m_readOffset + m_layout.size() > m_file->size()) {
+        return nullptr;
+    }
+
+    uint8_t* data = m_file->data() + m_readOffset;
+    m_readOffset += m_layout.size();
+    m_readAheadCondition.notify_all();
 
-uint64_t RawReader::offset() const { return m_stream->tellg(); }
+    return data;
+}
 
 bool RawReader::read(LCEVC_DecoderHandle decoder, LCEVC_PictureHandle picture)
 {
     VN_LCEVC_CHECK(LCEVC_SetPictureDesc(decoder, picture, &m_description));
 
+    if (m_file) {
+        const uint8_t* data = readMapped();
+        const auto size = static_cast<uint32_t>(m_layout.size());
+        return data && copyPictureFromMemory(decoder, picture, data, size) == LCEVC_Success;
+    }
+
+    if (readAheadRunning()) {
+        std::vector<uint8_t> memory;
+        return popReadAhead(memory) &&
+               copyPictureFromMemory(decoder, picture, memory.data(),
+                                     static_cast<uint32_t>(memory.size())) == LCEVC_Success;
+    }
+
     PictureLock lock(decoder, picture, LCEVC_Access_Write);
 
     for (uint32_t plane = 0; plane < lock.numPlanes(); ++plane) {
@@ -50,11 +96,25 @@ bool RawReader::read(LCEVC_DecoderHandle decoder, LCEVC_PictureHandle picture)
         }
     }
 
+    m_readOffset += m_layout.size();
     return true;
 }
 
 bool RawReader::read(std::vector<uint8_t>& memory)
 {
+    if (m_file) {
+        const uint8_t* data = readMapped();
+        if (!data) {
+            return false;
+        }
+        memory.assign(data, data + m_layout.size());
+        return true;
+    }
+
+    if (readAheadRunning()) {
+        return popReadAhead(memory);
+    }
+
     memory.resize(m_layout.size());
 
     m_stream->read(static_cast<char*>(static_cast<void*>(memory.data())), m_layout.size());
@@ -63,14 +123,109 @@ bool RawReader::read(std::vector<uint8_t>& memory)
         return false;
     }
 
+    m_readOffset += m_layout.size();
     return true;
 }
 
+// Take the next picture from the read-ahead queue, waiting for the thread if it is behind
+//
+bool RawReader::popReadAhead(std::vector<uint8_t>& memory)
+{
+    std::unique_lock lock(m_readAheadMutex);
+    m_readAheadCondition.wait(lock,
+                              [this] { return !m_readAheadFrames.empty() || m_readAheadEnd; });
+
+    if (m_readAheadFrames.empty()) {
+        return false;
+    }
+
+    memory = std::move(m_readAheadFrames.front());
+    m_readAheadFrames.pop_front();
+    m_readOffset += m_layout.size();
+    m_readAheadCondition.notify_all();
+
+    return true;
+}
+
+void RawReader::setReadAhead(uint32_t frames)
+{
+    if (readAheadRunning()) {
+        {
+            std::lock_guard lock(m_readAheadMutex);
+            m_readAheadStop = true;
+        }
+        m_readAheadCondition.notify_all();
+        m_readAheadThread.join();
+    }
+
+    // Hand back any unconsumed pictures to the stream position, so reading carries on in order
+    if (!m_readAheadFrames.empty()) {
+        m_readAheadFrames.clear();
+        m_stream->clear();
+        m_stream->seekg(static_cast<std::streamoff>(m_readOffset));
+    }
+
+    m_readAheadLimit = frames;
+    m_readAheadStop = false;
+    m_readAheadEnd = false;
+    m_touchedOffset = m_readOffset;
+
+    if (frames > 0) {
+        m_readAheadThread = std::thread(&RawReader::readAheadThread, this);
+    }
+}
+
+void RawReader::readAheadThread()
+{
+    const size_t frameSize = m_layout.size();
+    std::unique_lock lock(m_readAheadMutex);
+
+    while (!m_readAheadStop) {
+        if (m_file) {
+            // Fault in the pages of upcoming pictures here, rather than in the reading thread
+            const uint64_t end = std::min<uint64_t>(m_readOffset + m_readAheadLimit * frameSize,
+                                                    m_file->size());
+            if (m_touchedOffset < end) {
+                const uint64_t begin = std::max(m_touchedOffset, m_readOffset);
+                lock.unlock();
+                for (uint64_t offset = begin; offset < end; offset += kReadAheadPageSize) {
+                    const volatile uint8_t* page = m_file->data() + offset;
+                    static_cast<void>(*page);
+                }
+                lock.lock();
+                m_touchedOffset = end;
+                continue;
+            }
+        } else if (!m_readAheadEnd && m_readAheadFrames.size() < m_readAheadLimit) {
+            std::vector<uint8_t> memory(frameSize);
+            lock.unlock();
+            m_stream->read(static_cast<char*>(static_cast<void*>(memory.data())),
+                           static_cast<std::streamsize>(frameSize));
+            const bool good = m_stream->good();
+            lock.lock();
+
+            if (good) {
+                m_readAheadFrames.push_back(std::move(memory));
+            } else {
+                m_readAheadEnd = true;
+            }
+            m_readAheadCondition.notify_all();
+            continue;
+        }
+
+        m_readAheadCondition.wait(lock);
+    }
+}
+
 std::unique_ptr<RawReader> createRawReader(const LCEVC_PictureDesc& pictureDescription,
                                            std::string_view filename)
 {
-    std::unique_ptr<std::istream> stream =
-        std::make_unique<std::ifstream>(std::string(filename), std::ios::binary);
+    std::unique_ptr<std::istream> stream;
+    if (auto file = createMappedFile(filename)) {
+        stream = std::make_unique<MappedStream>(std::move(file));
+    } else {
+        stream = std::make_unique<std::ifstream>(std::string(filename), std::ios::binary);
+    }
     return createRawReader(pictureDescription, std::move(stream));
 }
 
@@ -80,8 +235,16 @@ std::unique_ptr<RawReader> createRawReader(const LCEVC_PictureDesc& pictureDescr
     if (!stream->good()) {
         return nullptr;
     }
+
+    // Mapped streams can be read in place
+    std::shared_ptr<MappedFile> file;
+    if (const auto* mappedStream = dynamic_cast<const MappedStream*>(stream.get())) {
+        file = mappedStream->file();
+    }
+
     // NB: The constructor is private, so make_unique is not a good option here.
-    return std::unique_ptr<RawReader>(new RawReader(pictureDescription, std::move(stream)));
+    return std::unique_ptr<RawReader>(
+        new RawReader(pictureDescription, std::move(stream), std::move(file)));
 }
 
 std::unique_ptr<RawReader> createRawReader(std::string_view filename)
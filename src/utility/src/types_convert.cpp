@@ -41,6 +41,10 @@ static const EnumMap<LCEVC_ColorFormat> kColorFormatTable{
     {LCEVC_I444_16_LE, "I444_16_LE"},
     {LCEVC_NV12_8, "NV12_8"},
     {LCEVC_NV21_8, "NV21_8"},
+    {LCEVC_NV16_8, "NV16_8"},
+    {LCEVC_P010_LE, "P010_LE"},
+    {LCEVC_P016_LE, "P016_LE"},
+    {LCEVC_P210_LE, "P210_LE"},
     {LCEVC_RGB_8, "RGB_8"},
     {LCEVC_BGR_8, "BGR_8"},
     {LCEVC_RGBA_8, "RGBA_8"},
@@ -58,6 +62,7 @@ static const EnumMap<LCEVC_ColorFormat> kColorFormatTable{
     {LCEVC_I420_8, "P420"},
     {LCEVC_NV12_8, "NV12"},
     {LCEVC_NV21_8, "NV21"},
+    {LCEVC_NV16_8, "NV16"},
     {LCEVC_RGB_8, "RGB"},
     {LCEVC_BGR_8, "BGR"},
     {LCEVC_RGBA_8, "RGBA"},
@@ -76,6 +81,9 @@ static const EnumMap<LCEVC_ColorFormat> kColorFormatTable{
     {LCEVC_GRAY_12_LE, "GRAY_12"},
     {LCEVC_GRAY_14_LE, "GRAY_14"},
     {LCEVC_GRAY_16_LE, "GRAY_16"},
+    {LCEVC_P010_LE, "P010"},
+    {LCEVC_P016_LE, "P016"},
+    {LCEVC_P210_LE, "P210"},
 
     // Other common synony,s
     {LCEVC_I420_8, "I420"},
@@ -92,6 +100,10 @@ static const EnumMap<LCEVC_ColorFormat> kColorFormatTable{
     {LCEVC_I420_12_LE, "yuv420p12le"},
     {LCEVC_I420_14_LE, "yuv420p14le"},
     {LCEVC_I420_16_LE, "yuv420p16le"},
+    {LCEVC_NV16_8, "nv16"},
+    {LCEVC_P010_LE, "p010le"},
+    {LCEVC_P016_LE, "p016le"},
+    {LCEVC_P210_LE, "p210le"},
     {LCEVC_RGB_8, "rgb24"},
     {LCEVC_BGR_8, "bgr24"},
     {LCEVC_RGBA_10_2_LE, "x2rgb10le"},
@@ -27,6 +27,7 @@ list(
     "src/test_md5.cpp"
     "src/test_parse_raw_name.cpp"
     "src/test_picture_layout.cpp"
+    "src/test_raw_reader.cpp"
     "src/test_string_utils.cpp")
 
 set(ALL_FILES ${SOURCES} "Sources.cmake")
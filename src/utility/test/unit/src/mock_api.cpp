@@ -301,10 +301,25 @@ LCEVC_ReturnCode LCEVC_SynchronizeDecoder(LCEVC_DecoderHandle decHandle, bool dr
     return LCEVC_Error;
 }
 
+LCEVC_ReturnCode LCEVC_GetDecoderMemoryUsage(LCEVC_DecoderHandle decHandle,
+                                             LCEVC_MemoryUsage* memoryUsage)
+{
+    assert(0);
+    return LCEVC_Error;
+}
+
 LCEVC_ReturnCode LCEVC_SetDecoderEventCallback(LCEVC_DecoderHandle decHandle,
                                                LCEVC_EventCallback callback, void* userData)
 {
     assert(0);
     return LCEVC_Error;
 }
+
+LCEVC_ReturnCode LCEVC_SetDecoderCompletionCallback(LCEVC_DecoderHandle decHandle,
+                                                    LCEVC_CompletionCallback callback,
+                                                    void* userData)
+{
+    assert(0);
+    return LCEVC_Error;
+}
 #endif
@@ -0,0 +1,104 @@
+/* Copyright (c) V-Nova International Limited 2025. All rights reserved.
+ * This software is licensed under the BSD-3-Clause-Clear License by V-Nova Limited.
+ * No patent licenses are granted under this license. For enquiries about patent licenses,
+ * please contact legal@v-nova.com.
+ * The LCEVCdec software is a stand-alone project and is NOT A CONTRIBUTION to any other project.
+ * If the software is incorporated into another project, THE TERMS OF THE BSD-3-CLAUSE-CLEAR LICENSE
+ * AND THE ADDITIONAL LICENSING INFORMATION CONTAINED IN THIS FILE MUST BE MAINTAINED, AND THE
+ * SOFTWARE DOES NOT AND MUST NOT ADOPT THE LICENSE OF THE INCORPORATING PROJECT. However, the
+ * software may be incorporated into a project under a compatible license provided the requirements
+ * of the BSD-3-Clause-Clear license are respected, and V-Nova Limited remains
+ * licensor of the software ONLY UNDER the BSD-3-Clause-Clear license (not the compatible license).
+ * ANY ONWARD DISTRIBUTION, WHETHER STAND-ALONE OR AS PART OF ANY OTHER PROJECT, REMAINS SUBJECT TO
+ * THE EXCLUSION OF PATENT LICENSES PROVISION OF THE BSD-3-CLAUSE-CLEAR LICENSE. */
+
+#include <gtest/gtest.h>
+#include <LCEVC/utility/raw_reader.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace filesystem = std::filesystem;
+using namespace lcevc_dec::utility;
+
+namespace {
+
+constexpr uint32_t kFrameCount = 5;
+constexpr size_t kFrameSize = 64 * 32 * 3 / 2;
+
+uint8_t expectedByte(size_t offset) { return static_cast<uint8_t>(offset * 7 + offset / kFrameSize); }
+
+class RawReaderTest : public testing::TestWithParam<uint32_t>
+{
+public:
+    void SetUp() override
+    {
+        m_path = filesystem::temp_directory_path() / "lcevc_raw_reader_64x32_p420.yuv";
+        std::ofstream file(m_path, std::ios::binary);
+        for (size_t i = 0; i < kFrameSize * kFrameCount; ++i) {
+            file.put(static_cast<char>(expectedByte(i)));
+        }
+    }
+
+    void TearDown() override { filesystem::remove(m_path); }
+
+    // Check a whole frame, and that the reader has moved past it
+    static void checkFrame(const RawReader& reader, const uint8_t* data, uint32_t frame)
+    {
+        for (size_t i = 0; i < kFrameSize; ++i) {
+            ASSERT_EQ(data[i], expectedByte(frame * kFrameSize + i)) << "frame " << frame;
+        }
+        EXPECT_EQ(reader.offset(), (frame + 1) * kFrameSize);
+    }
+
+protected:
+    filesystem::path m_path;
+};
+
+} // namespace
+
+TEST_P(RawReaderTest, ReadStream)
+{
+    const LCEVC_PictureDesc description = createRawReader(m_path.string())->description();
+    auto reader = createRawReader(description, std::make_unique<std::ifstream>(m_path, std::ios::binary));
+    ASSERT_NE(reader, nullptr);
+    EXPECT_FALSE(reader->isMapped());
+    EXPECT_EQ(reader->readMapped(), nullptr);
+
+    reader->setReadAhead(GetParam());
+
+    std::vector<uint8_t> memory;
+    for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+        ASSERT_TRUE(reader->read(memory));
+        checkFrame(*reader, memory.data(), frame);
+    }
+    EXPECT_FALSE(reader->read(memory));
+}
+
+TEST_P(RawReaderTest, ReadMapped)
+{
+    auto reader = createRawReader(m_path.string());
+    ASSERT_NE(reader, nullptr);
+    ASSERT_TRUE(reader->isMapped());
+
+    reader->setReadAhead(GetParam());
+
+    // Alternate between copying and in-place reads
+    std::vector<uint8_t> memory;
+    for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+        if (frame & 1) {
+            const uint8_t* data = reader->readMapped();
+            ASSERT_NE(data, nullptr);
+            checkFrame(*reader, data, frame);
+        } else {
+            ASSERT_TRUE(reader->read(memory));
+            checkFrame(*reader, memory.data(), frame);
+        }
+    }
+    EXPECT_EQ(reader->readMapped(), nullptr);
+    EXPECT_FALSE(reader->read(memory));
+}
+
+INSTANTIATE_TEST_SUITE_P(ReadAhead, RawReaderTest, testing::Values(0u, 1u, 3u));